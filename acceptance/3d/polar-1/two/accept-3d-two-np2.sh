@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+
+set -x # echo commands
+set -e # exit on first error
+set -u # Treat unset variables as error
+
+if [ $# -gt 0 ] ; then
+    one=$1/one
+    two=$1/src
+else
+    one=${HOME}/refine/zoltan/one
+    two=${HOME}/refine/zoltan/src
+fi
+
+# one multi-sweep driver call on two parts, guards the split cascade
+# against refining part interiors past a coarse part interface
+
+field=polar-1
+proj=accept-3d-two-np2
+
+${two}/ref_acceptance 1 ${proj}-init.b8.ugrid
+${two}/ref_acceptance -ugawg ${field} ${proj}-init.b8.ugrid ${proj}-init.metric
+
+mpiexec -np 2 ${two}/ref_driver -i ${proj}-init.b8.ugrid \
+        -m ${proj}-init.metric -s 6 -o ${proj}
+
+# the metric the driver carried to the final grid
+${two}/ref_metric_test ${proj}.meshb ${proj}-final-metric.solb \
+                       > ${proj}.status
+
+cat ${proj}.status
+../../../check.rb ${proj}.status 0.05 2.5
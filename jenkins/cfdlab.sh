@@ -138,6 +138,7 @@ mpiexec -np 2 ./ref_migrate_test >> $LOG 2>&1
 mpiexec -np 2 ./ref_cavity_test >> $LOG 2>&1
 mpiexec -np 2 ./ref_elast_test >> $LOG 2>&1
 mpiexec -np 2 ./ref_recon_test >> $LOG 2>&1
+mpiexec -np 2 ./ref_queue_test >> $LOG 2>&1
 mpiexec -np 8 ./ref_agents_test >> $LOG 2>&1
 mpiexec -np 8 ./ref_edge_test >> $LOG 2>&1
 mpiexec -np 8 ./ref_gather_test >> $LOG 2>&1
@@ -150,6 +151,7 @@ mpiexec -np 8 ./ref_migrate_test >> $LOG 2>&1
 mpiexec -np 8 ./ref_cavity_test >> $LOG 2>&1
 mpiexec -np 8 ./ref_elast_test >> $LOG 2>&1
 mpiexec -np 8 ./ref_recon_test >> $LOG 2>&1
+mpiexec -np 8 ./ref_queue_test >> $LOG 2>&1
 trap - EXIT
 
 LOG=${root_dir}/log.accept-2d-linear-two
@@ -194,6 +196,12 @@ cd ${source_dir}/acceptance/3d/linear/two
 time ./accept-3d-two-para.sh ${zoltan_dir} > $LOG 2>&1
 trap - EXIT
 
+LOG=${root_dir}/log.accept-3d-polar-1-two-np2
+trap "cat $LOG" EXIT
+cd ${source_dir}/acceptance/3d/polar-1/two
+time ./accept-3d-two-np2.sh ${zoltan_dir} > $LOG 2>&1
+trap - EXIT
+
 LOG=${root_dir}/log.accept-cube-cylinder-uniform-two
 trap "cat $LOG" EXIT
 cd ${source_dir}/acceptance/cube-cylinder/uniform/two
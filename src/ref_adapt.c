@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include "ref_adapt.h"
+#include "ref_census.h"
 #include "ref_edge.h"
 
 #include "ref_malloc.h"
@@ -61,11 +62,15 @@ REF_STATUS ref_adapt_create(REF_ADAPT *ref_adapt_ptr) {
   ref_adapt->smooth_min_quality = 1.0e-3;
   ref_adapt->smooth_min_normdev = 0.0;
 
+  ref_adapt->swap_per_pass = 1;
+  ref_adapt->swap_min_quality = 0.3;
+
   ref_adapt->post_min_ratio = 1.0e-3;
   ref_adapt->post_max_ratio = 3.0;
 
   ref_adapt->instrument = REF_FALSE;
   ref_adapt->watch_param = REF_FALSE;
+  ref_adapt->watch_topo = REF_FALSE;
 
   return REF_SUCCESS;
 }
@@ -92,11 +97,15 @@ REF_STATUS ref_adapt_deep_copy(REF_ADAPT *ref_adapt_ptr, REF_ADAPT original) {
   ref_adapt->smooth_min_quality = original->smooth_min_quality;
   ref_adapt->smooth_min_normdev = original->smooth_min_normdev;
 
+  ref_adapt->swap_per_pass = original->swap_per_pass;
+  ref_adapt->swap_min_quality = original->swap_min_quality;
+
   ref_adapt->post_min_ratio = original->post_min_ratio;
   ref_adapt->post_max_ratio = original->post_max_ratio;
 
   ref_adapt->instrument = original->instrument;
   ref_adapt->watch_param = original->watch_param;
+  ref_adapt->watch_topo = original->watch_topo;
 
   return REF_SUCCESS;
 }
@@ -108,148 +117,43 @@ REF_STATUS ref_adapt_free(REF_ADAPT ref_adapt) {
 }
 
 REF_STATUS ref_adapt_parameter(REF_GRID ref_grid, REF_BOOL *all_done) {
-  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
-  REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_ADAPT ref_adapt = ref_grid->adapt;
-  REF_CELL ref_cell;
-  REF_INT cell, ncell;
-  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-  REF_DBL det, complexity;
-  REF_DBL quality, min_quality;
-  REF_DBL dot, min_dot;
-  REF_DBL volume, min_volume, max_volume;
-  REF_BOOL active_twod;
-  REF_DBL target_quality;
-  REF_INT cell_node;
-  REF_INT node, nnode;
-  REF_DBL nodes_per_complexity;
-  REF_INT degree, max_degree;
-  REF_DBL ratio, min_ratio, max_ratio, old_min_ratio, old_max_ratio;
-  REF_INT edge, part;
-  REF_INT age, max_age;
-  REF_BOOL active;
-  REF_EDGE ref_edge;
+  REF_CENSUS ref_census;
 
-  if (ref_grid_twod(ref_grid)) {
-    ref_cell = ref_grid_tri(ref_grid);
-  } else {
-    ref_cell = ref_grid_tet(ref_grid);
-  }
+  RSS(ref_census_create(&ref_census, ref_grid), "census");
+  RSS(ref_adapt_parameter_census(ref_grid, ref_census, all_done), "param");
+  RSS(ref_census_free(ref_census), "free census");
 
-  min_quality = 1.0;
-  min_volume = 1.0e100;
-  max_volume = -1.0e100;
-  complexity = 0.0;
-  ncell = 0;
-  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-    if (ref_grid_twod(ref_grid)) {
-      RSS(ref_node_node_twod(ref_grid_node(ref_grid), nodes[0], &active_twod),
-          "active twod tri");
-      if (!active_twod) continue;
-      RSS(ref_node_tri_quality(ref_grid_node(ref_grid), nodes, &quality),
-          "qual");
-      RSS(ref_node_tri_area(ref_grid_node(ref_grid), nodes, &volume), "vol");
-    } else {
-      RSS(ref_node_tet_quality(ref_grid_node(ref_grid), nodes, &quality),
-          "qual");
-      RSS(ref_node_tet_vol(ref_grid_node(ref_grid), nodes, &volume), "vol");
-    }
-    min_quality = MIN(min_quality, quality);
-    min_volume = MIN(min_volume, volume);
-    max_volume = MAX(max_volume, volume);
-
-    for (cell_node = 0; cell_node < ref_cell_node_per(ref_cell); cell_node++) {
-      if (ref_node_owned(ref_node, nodes[cell_node])) {
-        RSS(ref_matrix_det_m(ref_node_metric_ptr(ref_node, nodes[cell_node]),
-                             &det),
-            "det");
-        complexity +=
-            sqrt(det) * volume / ((REF_DBL)ref_cell_node_per(ref_cell));
-      }
-    }
-    RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "owner");
-    if (part == ref_mpi_rank(ref_mpi)) ncell++;
-  }
-  quality = min_quality;
-  RSS(ref_mpi_min(ref_mpi, &quality, &min_quality, REF_DBL_TYPE), "min");
-  RSS(ref_mpi_bcast(ref_mpi, &quality, 1, REF_DBL_TYPE), "min");
-  volume = min_volume;
-  RSS(ref_mpi_min(ref_mpi, &volume, &min_volume, REF_DBL_TYPE), "mpi min");
-  RSS(ref_mpi_bcast(ref_mpi, &min_volume, 1, REF_DBL_TYPE), "min");
-  volume = max_volume;
-  RSS(ref_mpi_max(ref_mpi, &volume, &max_volume, REF_DBL_TYPE), "mpi max");
-  RSS(ref_mpi_bcast(ref_mpi, &max_volume, 1, REF_DBL_TYPE), "min");
-
-  RSS(ref_mpi_allsum(ref_mpi, &complexity, 1, REF_DBL_TYPE), "dbl sum");
-  RSS(ref_mpi_allsum(ref_mpi, &ncell, 1, REF_INT_TYPE), "cell int sum");
+  return REF_SUCCESS;
+}
 
-  nnode = 0;
-  each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
-      nnode++;
-    }
-  }
-  RSS(ref_mpi_allsum(ref_mpi, &nnode, 1, REF_INT_TYPE), "int sum");
-  if (ref_grid_twod(ref_grid)) nnode = nnode / 2;
+REF_STATUS ref_adapt_parameter_census(REF_GRID ref_grid, REF_CENSUS ref_census,
+                                      REF_BOOL *all_done) {
+  REF_ADAPT ref_adapt = ref_grid->adapt;
+  REF_DBL complexity;
+  REF_DBL min_quality;
+  REF_DBL min_dot;
+  REF_DBL min_volume, max_volume;
+  REF_DBL target_quality;
+  REF_GLOB nnode, ncell;
+  REF_DBL nodes_per_complexity;
+  REF_INT max_degree;
+  REF_DBL min_ratio, max_ratio, old_min_ratio, old_max_ratio;
+  REF_INT max_age;
+
+  min_quality = ref_census_min_quality(ref_census);
+  min_volume = ref_census_min_volume(ref_census);
+  max_volume = ref_census_max_volume(ref_census);
+  complexity = ref_census_complexity(ref_census);
+  ncell = ref_census_ncell(ref_census);
+  nnode = ref_census_nnode(ref_census);
+  max_degree = ref_census_max_degree(ref_census);
+  max_age = ref_census_max_age(ref_census);
+  min_ratio = ref_census_min_ratio(ref_census);
+  max_ratio = ref_census_max_ratio(ref_census);
+  min_dot = ref_census_min_normdev(ref_census);
 
   nodes_per_complexity = (REF_DBL)nnode / complexity;
 
-  max_degree = 0;
-  each_ref_node_valid_node(ref_node, node) {
-    RSS(ref_adj_degree(ref_cell_adj(ref_cell), node, &degree), "cell degree");
-    max_degree = MAX(max_degree, degree);
-  }
-  degree = max_degree;
-  RSS(ref_mpi_max(ref_mpi, &degree, &max_degree, REF_INT_TYPE), "mpi max");
-  RSS(ref_mpi_bcast(ref_mpi, &max_degree, 1, REF_INT_TYPE), "min");
-
-  max_age = 0;
-  each_ref_node_valid_node(ref_node, node) {
-    max_age = MAX(max_age, ref_node_age(ref_node, node));
-  }
-  age = max_age;
-  RSS(ref_mpi_max(ref_mpi, &age, &max_age, REF_INT_TYPE), "mpi max");
-  RSS(ref_mpi_bcast(ref_mpi, &max_age, 1, REF_INT_TYPE), "min");
-
-  min_dot = 2.0;
-  if (ref_geom_model_loaded(ref_grid_geom(ref_grid))) {
-    ref_cell = ref_grid_tri(ref_grid);
-    each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-      RSS(ref_geom_tri_norm_deviation(ref_grid, nodes, &dot), "norm dev");
-      min_dot = MIN(min_dot, dot);
-    }
-  }
-  dot = min_dot;
-  RSS(ref_mpi_min(ref_mpi, &dot, &min_dot, REF_DBL_TYPE), "mpi max");
-  RSS(ref_mpi_bcast(ref_mpi, &min_dot, 1, REF_DBL_TYPE), "min");
-
-  min_ratio = 1.0e100;
-  max_ratio = -1.0e100;
-  RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
-  for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
-    RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
-    RSS(ref_node_edge_twod(ref_grid_node(ref_grid),
-                           ref_edge_e2n(ref_edge, 0, edge),
-                           ref_edge_e2n(ref_edge, 1, edge), &active),
-        "twod edge");
-    active = (active || !ref_grid_twod(ref_grid));
-    if (part == ref_mpi_rank(ref_grid_mpi(ref_grid)) && active) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
-      min_ratio = MIN(min_ratio, ratio);
-      max_ratio = MAX(max_ratio, ratio);
-    }
-  }
-  RSS(ref_edge_free(ref_edge), "free edge");
-  ratio = min_ratio;
-  RSS(ref_mpi_min(ref_mpi, &ratio, &min_ratio, REF_DBL_TYPE), "mpi min");
-  RSS(ref_mpi_bcast(ref_mpi, &min_ratio, 1, REF_DBL_TYPE), "min");
-  ratio = max_ratio;
-  RSS(ref_mpi_max(ref_mpi, &ratio, &max_ratio, REF_DBL_TYPE), "mpi max");
-  RSS(ref_mpi_bcast(ref_mpi, &max_ratio, 1, REF_DBL_TYPE), "max");
-
   target_quality = MAX(MIN(0.1, min_quality), 1.0e-3);
   ref_adapt->collapse_quality_absolute = target_quality;
   ref_adapt->smooth_min_quality = target_quality;
@@ -266,6 +170,7 @@ REF_STATUS ref_adapt_parameter(REF_GRID ref_grid, REF_BOOL *all_done) {
         (4.0 / ref_adapt->post_max_ratio) * ref_adapt->post_min_ratio;
   }
 
+  /* census values are global, so every part reaches the same answer */
   if (ABS(old_min_ratio - ref_adapt->post_min_ratio) < 1e-12 &&
       ABS(old_max_ratio - ref_adapt->post_max_ratio) < 1e-12 && max_age < 10) {
     *all_done = REF_TRUE;
@@ -275,16 +180,16 @@ REF_STATUS ref_adapt_parameter(REF_GRID ref_grid, REF_BOOL *all_done) {
   } else {
     *all_done = REF_FALSE;
   }
-  RSS(ref_mpi_bcast(ref_mpi, all_done, 1, REF_INT_TYPE), "done");
 
   if (ref_grid_once(ref_grid)) {
     printf("quality floor %6.4f ratio %6.4f %6.2f\n", target_quality,
            ref_adapt->post_min_ratio, ref_adapt->post_max_ratio);
     printf("max degree %d max age %d min dot %7.4f\n", max_degree, max_age,
            min_dot);
-    printf("nnode %10d complexity %12.1f ratio %5.2f\nvolume range %e %e ",
+    printf("nnode " REF_GLOB_FMT
+           " complexity %12.1f ratio %5.2f\nvolume range %e %e ",
            nnode, complexity, nodes_per_complexity, max_volume, min_volume);
-    printf("ncell %10d\n", ncell);
+    printf("ncell " REF_GLOB_FMT "\n", ncell);
   }
 
   return REF_SUCCESS;
@@ -299,8 +204,10 @@ REF_STATUS ref_adapt_tattle(REF_GRID ref_grid) {
   REF_DBL quality, min_quality;
   REF_DBL dot, min_dot;
   REF_BOOL active_twod;
-  REF_INT node, nnode;
+  REF_INT node;
+  REF_GLOB nnode;
   REF_DBL ratio, min_ratio, max_ratio;
+  REF_DBL *edge_ratio;
   REF_INT edge, part;
   REF_BOOL active;
   REF_EDGE ref_edge;
@@ -338,7 +245,7 @@ REF_STATUS ref_adapt_tattle(REF_GRID ref_grid) {
       nnode++;
     }
   }
-  RSS(ref_mpi_allsum(ref_mpi, &nnode, 1, REF_INT_TYPE), "int sum");
+  RSS(ref_mpi_allsum(ref_mpi, &nnode, 1, REF_GLOB_TYPE), "glob sum");
   if (ref_grid_twod(ref_grid)) nnode = nnode / 2;
 
   min_dot = 2.0;
@@ -356,6 +263,10 @@ REF_STATUS ref_adapt_tattle(REF_GRID ref_grid) {
   min_ratio = 1.0e100;
   max_ratio = -1.0e100;
   RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_node_ratio_many(ref_grid_node(ref_grid), ref_edge_n(ref_edge),
+                          &ref_edge_e2n(ref_edge, 0, 0), edge_ratio),
+      "rat");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
     RSS(ref_node_edge_twod(ref_grid_node(ref_grid),
@@ -364,14 +275,11 @@ REF_STATUS ref_adapt_tattle(REF_GRID ref_grid) {
         "twod edge");
     active = (active || !ref_grid_twod(ref_grid));
     if (part == ref_mpi_rank(ref_grid_mpi(ref_grid)) && active) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
-      min_ratio = MIN(min_ratio, ratio);
-      max_ratio = MAX(max_ratio, ratio);
+      min_ratio = MIN(min_ratio, edge_ratio[edge]);
+      max_ratio = MAX(max_ratio, edge_ratio[edge]);
     }
   }
+  ref_free(edge_ratio);
   RSS(ref_edge_free(ref_edge), "free edge");
   ratio = min_ratio;
   RSS(ref_mpi_min(ref_mpi, &ratio, &min_ratio, REF_DBL_TYPE), "mpi min");
@@ -390,24 +298,37 @@ REF_STATUS ref_adapt_tattle(REF_GRID ref_grid) {
       short_met = not_ok;
     if (max_ratio > ref_grid_adapt(ref_grid, post_max_ratio)) long_met = not_ok;
 
-    printf("quality %c %6.4f ratio %c %6.4f %6.2f %c nnode %d\n", quality_met,
-           min_quality, short_met, min_ratio, max_ratio, long_met, nnode);
+    printf("quality %c %6.4f ratio %c %6.4f %6.2f %c nnode " REF_GLOB_FMT "\n",
+           quality_met, min_quality, short_met, min_ratio, max_ratio, long_met,
+           nnode);
   }
 
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_adapt_pass(REF_GRID ref_grid) {
+  RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "adapt"), "timer");
+  RSS(ref_grid_track_edges(ref_grid), "track edges");
   if (ref_grid_twod(ref_grid)) {
     RSS(ref_adapt_twod_pass(ref_grid), "pass");
   } else {
     RSS(ref_adapt_threed_pass(ref_grid), "pass");
   }
+  RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "adapt"), "timer");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_adapt_verify_topo(REF_GRID ref_grid) {
+  if (ref_grid_adapt(ref_grid, watch_topo)) {
+    RSS(ref_geom_verify_topo(ref_grid), "full");
+  } else {
+    RSS(ref_geom_verify_topo_dirty(ref_grid), "touched");
+  }
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_adapt_threed_pass(REF_GRID ref_grid) {
-  REF_INT ngeom;
+  REF_GLOB ngeom;
   REF_INT pass;
 
   RSS(ref_gather_ngeom(ref_grid_node(ref_grid), ref_grid_geom(ref_grid),
@@ -415,17 +336,19 @@ REF_STATUS ref_adapt_threed_pass(REF_GRID ref_grid) {
       "count ngeom");
 
   ref_gather_blocking_frame(ref_grid, "threed pass");
-  if (ngeom > 0) RSS(ref_geom_verify_topo(ref_grid), "adapt preflight check");
+  if (ngeom > 0) RSS(ref_adapt_verify_topo(ref_grid), "adapt preflight check");
   if (ref_grid_adapt(ref_grid, watch_param))
     RSS(ref_adapt_tattle(ref_grid), "tattle");
   if (ref_grid_adapt(ref_grid, instrument))
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt start");
 
   for (pass = 0; pass < ref_grid_adapt(ref_grid, collapse_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "collapse"), "timer");
     RSS(ref_collapse_pass(ref_grid), "col pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "collapse"), "timer");
     ref_gather_blocking_frame(ref_grid, "collapse");
     if (ngeom > 0)
-      RSS(ref_geom_verify_topo(ref_grid), "collapse geom topo check");
+      RSS(ref_adapt_verify_topo(ref_grid), "collapse geom topo check");
     if (ref_grid_adapt(ref_grid, watch_param))
       RSS(ref_adapt_tattle(ref_grid), "tattle");
     if (ref_grid_adapt(ref_grid, instrument))
@@ -433,20 +356,38 @@ REF_STATUS ref_adapt_threed_pass(REF_GRID ref_grid) {
   }
 
   for (pass = 0; pass < ref_grid_adapt(ref_grid, split_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "split"), "timer");
     RSS(ref_split_pass(ref_grid), "split pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "split"), "timer");
     ref_gather_blocking_frame(ref_grid, "split");
-    if (ngeom > 0) RSS(ref_geom_verify_topo(ref_grid), "split geom topo check");
+    if (ngeom > 0)
+      RSS(ref_adapt_verify_topo(ref_grid), "split geom topo check");
     if (ref_grid_adapt(ref_grid, watch_param))
       RSS(ref_adapt_tattle(ref_grid), "tattle");
     if (ref_grid_adapt(ref_grid, instrument))
       ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt spl");
   }
 
+  for (pass = 0; pass < ref_grid_adapt(ref_grid, swap_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "swap"), "timer");
+    RSS(ref_swap_threed_pass(ref_grid), "swap pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "swap"), "timer");
+    ref_gather_blocking_frame(ref_grid, "swap");
+    if (ngeom > 0)
+      RSS(ref_adapt_verify_topo(ref_grid), "swap geom topo check");
+    if (ref_grid_adapt(ref_grid, watch_param))
+      RSS(ref_adapt_tattle(ref_grid), "tattle");
+    if (ref_grid_adapt(ref_grid, instrument))
+      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swp");
+  }
+
   for (pass = 0; pass < ref_grid_adapt(ref_grid, smooth_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "smooth"), "timer");
     RSS(ref_smooth_threed_pass(ref_grid), "smooth pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "smooth"), "timer");
     ref_gather_blocking_frame(ref_grid, "smooth");
     if (ngeom > 0)
-      RSS(ref_geom_verify_topo(ref_grid), "smooth geom topo check");
+      RSS(ref_adapt_verify_topo(ref_grid), "smooth geom topo check");
     if (ref_grid_adapt(ref_grid, watch_param))
       RSS(ref_adapt_tattle(ref_grid), "tattle");
     if (ref_grid_adapt(ref_grid, instrument))
@@ -464,21 +405,27 @@ REF_STATUS ref_adapt_twod_pass(REF_GRID ref_grid) {
   ref_gather_blocking_frame(ref_grid, "twod pass");
 
   for (pass = 0; pass < ref_grid_adapt(ref_grid, collapse_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "collapse"), "timer");
     RSS(ref_collapse_twod_pass(ref_grid), "col pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "collapse"), "timer");
     if (ref_grid_adapt(ref_grid, watch_param))
       RSS(ref_adapt_tattle(ref_grid), "tattle");
     ref_gather_blocking_frame(ref_grid, "collapse");
   }
 
   for (pass = 0; pass < ref_grid_adapt(ref_grid, split_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "split"), "timer");
     RSS(ref_split_twod_pass(ref_grid), "split pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "split"), "timer");
     if (ref_grid_adapt(ref_grid, watch_param))
       RSS(ref_adapt_tattle(ref_grid), "tattle");
     ref_gather_blocking_frame(ref_grid, "split");
   }
 
   for (pass = 0; pass < ref_grid_adapt(ref_grid, smooth_per_pass); pass++) {
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "smooth"), "timer");
     RSS(ref_smooth_twod_pass(ref_grid), "smooth pass");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "smooth"), "timer");
     if (ref_grid_adapt(ref_grid, watch_param))
       RSS(ref_adapt_tattle(ref_grid), "tattle");
     ref_gather_blocking_frame(ref_grid, "smooth");
@@ -26,6 +26,7 @@ typedef struct REF_ADAPT_STRUCT REF_ADAPT_STRUCT;
 typedef REF_ADAPT_STRUCT *REF_ADAPT;
 END_C_DECLORATION
 
+#include "ref_census.h"
 #include "ref_grid.h"
 
 BEGIN_C_DECLORATION
@@ -46,11 +47,15 @@ struct REF_ADAPT_STRUCT {
   REF_DBL smooth_min_quality;
   REF_DBL smooth_min_normdev;
 
+  REF_INT swap_per_pass;
+  REF_DBL swap_min_quality; /* swap around tets below this quality */
+
   REF_DBL post_min_ratio;
   REF_DBL post_max_ratio;
 
   REF_BOOL instrument;
   REF_BOOL watch_param;
+  REF_BOOL watch_topo; /* full geom topo sweep, not only touched nodes */
 };
 
 REF_STATUS ref_adapt_create(REF_ADAPT *ref_adapt);
@@ -58,6 +63,8 @@ REF_STATUS ref_adapt_deep_copy(REF_ADAPT *ref_adapt_ptr, REF_ADAPT original);
 REF_STATUS ref_adapt_free(REF_ADAPT ref_adapt);
 
 REF_STATUS ref_adapt_parameter(REF_GRID ref_grid, REF_BOOL *all_done);
+REF_STATUS ref_adapt_parameter_census(REF_GRID ref_grid, REF_CENSUS ref_census,
+                                      REF_BOOL *all_done);
 REF_STATUS ref_adapt_tattle(REF_GRID ref_grid);
 REF_STATUS ref_adapt_pass(REF_GRID ref_grid);
 REF_STATUS ref_adapt_threed_pass(REF_GRID ref_grid);
@@ -77,7 +77,8 @@ REF_STATUS ref_agents_inspect(REF_AGENTS ref_agents) {
 
 REF_STATUS ref_agents_tattle(REF_AGENTS ref_agents, REF_INT id,
                              const char *context) {
-  printf("%d: %d id %d mode %d home %d node %d part %d seed %s\n",
+  printf("%d: %d id %d mode %d home " REF_GLOB_FMT " node %d part " REF_GLOB_FMT
+         " seed %s\n",
          ref_mpi_rank(ref_agents->ref_mpi), id,
          (int)ref_agent_mode(ref_agents, id), ref_agent_home(ref_agents, id),
          ref_agent_node(ref_agents, id), ref_agent_part(ref_agents, id),
@@ -191,9 +192,9 @@ REF_STATUS ref_agents_pop(REF_AGENTS ref_agents, REF_INT *node, REF_INT *part,
 
   id = ref_agents->last;
 
-  *node = ref_agent_node(ref_agents, id);
+  *node = (REF_INT)ref_agent_node(ref_agents, id);
   *part = ref_agent_part(ref_agents, id);
-  *seed = ref_agent_seed(ref_agents, id);
+  *seed = (REF_INT)ref_agent_seed(ref_agents, id);
   for (i = 0; i < 3; i++) xyz[i] = ref_agent_xyz(ref_agents, i, id);
 
   RSS(ref_agents_remove(ref_agents, id), "rm");
@@ -245,7 +246,8 @@ REF_STATUS ref_agents_migrate(REF_AGENTS ref_agents) {
   REF_MPI ref_mpi = ref_agents->ref_mpi;
   REF_INT i, id, nsend, nrecv, dest, rec;
   REF_INT n_ints, n_dbls;
-  REF_INT *destination, *send_int, *recv_int;
+  REF_INT *destination;
+  REF_GLOB *send_int, *recv_int;
   REF_DBL *send_dbl, *recv_dbl;
   nsend = 0;
   each_active_ref_agent(ref_agents, id) {
@@ -257,14 +259,14 @@ REF_STATUS ref_agents_migrate(REF_AGENTS ref_agents) {
   n_ints = 6;
   n_dbls = 7;
   ref_malloc_init(destination, nsend, REF_INT, REF_EMPTY);
-  ref_malloc_init(send_int, nsend * n_ints, REF_INT, REF_EMPTY);
+  ref_malloc_init(send_int, nsend * n_ints, REF_GLOB, REF_EMPTY);
   ref_malloc_init(send_dbl, nsend * n_dbls, REF_DBL, 0.0);
   nsend = 0;
   each_active_ref_agent(ref_agents, id) {
     RSS(ref_agents_dest(ref_agents, id, &dest), "dest");
     if (ref_mpi_rank(ref_mpi) != dest) {
       destination[nsend] = dest;
-      send_int[0 + nsend * n_ints] = (REF_INT)ref_agent_mode(ref_agents, id);
+      send_int[0 + nsend * n_ints] = (REF_GLOB)ref_agent_mode(ref_agents, id);
       send_int[1 + nsend * n_ints] = ref_agent_home(ref_agents, id);
       send_int[2 + nsend * n_ints] = ref_agent_node(ref_agents, id);
       send_int[3 + nsend * n_ints] = ref_agent_part(ref_agents, id);
@@ -283,7 +285,7 @@ REF_STATUS ref_agents_migrate(REF_AGENTS ref_agents) {
   }
 
   RSS(ref_mpi_blindsend(ref_mpi, destination, (void *)send_int, n_ints, nsend,
-                        (void **)(&recv_int), &nrecv, REF_INT_TYPE),
+                        (void **)(&recv_int), &nrecv, REF_GLOB_TYPE),
       "is");
   RSS(ref_mpi_blindsend(ref_mpi, destination, (void *)send_dbl, n_dbls, nsend,
                         (void **)(&recv_dbl), &nrecv, REF_DBL_TYPE),
@@ -295,11 +297,11 @@ REF_STATUS ref_agents_migrate(REF_AGENTS ref_agents) {
   for (rec = 0; rec < nrecv; rec++) {
     RSS(ref_agents_new(ref_agents, &id), "new");
     ref_agent_mode(ref_agents, id) = (REF_AGENT_MODE)recv_int[0 + rec * n_ints];
-    ref_agent_home(ref_agents, id) = recv_int[1 + rec * n_ints];
+    ref_agent_home(ref_agents, id) = (REF_INT)recv_int[1 + rec * n_ints];
     ref_agent_node(ref_agents, id) = recv_int[2 + rec * n_ints];
-    ref_agent_part(ref_agents, id) = recv_int[3 + rec * n_ints];
+    ref_agent_part(ref_agents, id) = (REF_INT)recv_int[3 + rec * n_ints];
     ref_agent_seed(ref_agents, id) = recv_int[4 + rec * n_ints];
-    ref_agent_step(ref_agents, id) = recv_int[5 + rec * n_ints];
+    ref_agent_step(ref_agents, id) = (REF_INT)recv_int[5 + rec * n_ints];
 
     for (i = 0; i < 3; i++)
       ref_agent_xyz(ref_agents, i, id) = recv_dbl[i + rec * n_dbls];
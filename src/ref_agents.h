@@ -46,12 +46,12 @@ struct REF_AGENT_STRUCT {
   REF_INT previous; /* agent list navigation */
   REF_INT next;
 
-  REF_INT home; /* mpi rank of the to node that needs an interpolant */
-  REF_INT node; /* the to node that needs an interpolant (global for SUGGEST)*/
-  REF_INT part; /* mpi rank of the seed */
-  REF_INT seed; /* cell guess when WALKING or BOUNDARY,
-                 * global node guess when HOP_PART or SUGGESTION
-                 * from cell when ENCLOSE */
+  REF_INT home;  /* mpi rank of the to node that needs an interpolant */
+  REF_GLOB node; /* the to node needing an interpolant (global for SUGGEST)*/
+  REF_INT part;  /* mpi rank of the seed */
+  REF_GLOB seed; /* cell guess when WALKING or BOUNDARY,
+                  * global node guess when HOP_PART or SUGGESTION
+                  * from cell when ENCLOSE */
   REF_INT step; /* number of cells visited */
   REF_DBL xyz[3];  /* the to xyz that needs an interpolant */
   REF_DBL bary[4]; /* the from bary of the from cell when ENCLOSE */
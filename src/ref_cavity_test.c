@@ -341,7 +341,8 @@ int main(int argc, char *argv[]) {
     REF_GRID ref_grid;
     REF_NODE ref_node;
     REF_CAVITY ref_cavity;
-    REF_INT global, node, clone;
+    REF_INT node, clone;
+    REF_GLOB global;
 
     RSS(ref_fixture_pri_grid(&ref_grid, ref_mpi), "pri");
     ref_node = ref_grid_node(ref_grid);
@@ -370,7 +371,8 @@ int main(int argc, char *argv[]) {
     REF_GRID ref_grid;
     REF_NODE ref_node;
     REF_CAVITY ref_cavity;
-    REF_INT global, node;
+    REF_INT node;
+    REF_GLOB global;
 
     RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "pri");
     ref_node = ref_grid_node(ref_grid);
@@ -398,7 +400,8 @@ int main(int argc, char *argv[]) {
     REF_GRID ref_grid;
     REF_NODE ref_node;
     REF_CAVITY ref_cavity;
-    REF_INT global, node, face;
+    REF_INT node, face;
+    REF_GLOB global;
     REF_BOOL visible;
 
     RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "pri");
@@ -436,7 +439,8 @@ int main(int argc, char *argv[]) {
     REF_GRID ref_grid;
     REF_NODE ref_node;
     REF_CAVITY ref_cavity;
-    REF_INT global, node, face;
+    REF_INT node, face;
+    REF_GLOB global;
     REF_BOOL visible;
 
     RSS(ref_fixture_pri_grid(&ref_grid, ref_mpi), "pri");
@@ -546,7 +550,8 @@ int main(int argc, char *argv[]) {
     REF_GRID ref_grid;
     REF_NODE ref_node;
     REF_CAVITY ref_cavity;
-    REF_INT global, node, clone, opp;
+    REF_INT node, clone, opp;
+    REF_GLOB global;
 
     RSS(ref_fixture_pri_grid(&ref_grid, ref_mpi), "pri");
     ref_node = ref_grid_node(ref_grid);
@@ -65,6 +65,13 @@ REF_STATUS ref_cell_initialize(REF_CELL ref_cell, REF_INT node_per,
     }
   }
 
+  ref_cell_edge(ref_cell) = NULL;
+  ref_cell_dirty(ref_cell) = NULL;
+  ref_cell_frozen(ref_cell) = 0;
+  ref_cell->frozen_nnode = 0;
+  ref_cell->frozen_first = NULL;
+  ref_cell->frozen_ref = NULL;
+
   ref_cell->e2n = NULL;
   if (ref_cell_edge_per(ref_cell) > 0)
     ref_malloc(ref_cell->e2n, 2 * ref_cell_edge_per(ref_cell), REF_INT);
@@ -354,6 +361,9 @@ REF_STATUS ref_cell_create(REF_CELL *ref_cell_ptr, REF_INT node_per,
 
 REF_STATUS ref_cell_free(REF_CELL ref_cell) {
   if (NULL == (void *)ref_cell) return REF_NULL;
+  RSS(ref_cell_untrack_dirty(ref_cell), "untrack");
+  ref_free(ref_cell->frozen_ref);
+  ref_free(ref_cell->frozen_first);
   ref_adj_free(ref_cell->ref_adj);
   ref_free(ref_cell->c2n);
   ref_free(ref_cell->f2n);
@@ -392,20 +402,8 @@ REF_STATUS ref_cell_deep_copy(REF_CELL *ref_cell_ptr, REF_CELL original) {
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_cell_pack(REF_CELL ref_cell, REF_INT *o2n) {
-  REF_INT node, cell, new;
-  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-
-  new = 0;
-  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-    for (node = 0; node < ref_cell_node_per(ref_cell); node++)
-      ref_cell_c2n(ref_cell, node, new) = o2n[nodes[node]];
-    if (ref_cell_last_node_is_an_id(ref_cell))
-      ref_cell_c2n(ref_cell, ref_cell_node_per(ref_cell), new) =
-          nodes[ref_cell_node_per(ref_cell)];
-    new ++;
-  }
-  REIS(new, ref_cell_n(ref_cell), "count is off");
+static REF_STATUS ref_cell_pack_blank_and_adj(REF_CELL ref_cell) {
+  REF_INT node, cell;
 
   if (ref_cell_n(ref_cell) < ref_cell_max(ref_cell)) {
     for (cell = ref_cell_n(ref_cell); cell < ref_cell_max(ref_cell); cell++) {
@@ -430,6 +428,72 @@ REF_STATUS ref_cell_pack(REF_CELL ref_cell, REF_INT *o2n) {
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_cell_pack(REF_CELL ref_cell, REF_INT *o2n) {
+  REF_INT node, cell, new;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+
+  RAS(!ref_cell_frozen(ref_cell), "pack while frozen");
+
+  new = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++)
+      ref_cell_c2n(ref_cell, node, new) = o2n[nodes[node]];
+    if (ref_cell_last_node_is_an_id(ref_cell))
+      ref_cell_c2n(ref_cell, ref_cell_node_per(ref_cell), new) =
+          nodes[ref_cell_node_per(ref_cell)];
+    new ++;
+  }
+  REIS(new, ref_cell_n(ref_cell), "count is off");
+
+  RSS(ref_cell_pack_blank_and_adj(ref_cell), "blank and adj");
+  if (NULL != (void *)ref_cell_dirty(ref_cell))
+    RSS(ref_list_apply_o2n(ref_cell_dirty(ref_cell), o2n), "dirty");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_cell_pack_by_node(REF_CELL ref_cell, REF_INT *o2n) {
+  REF_INT node, cell, new;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT size_per = ref_cell_size_per(ref_cell);
+  REF_INT *c2n, *first, *order;
+
+  RAS(!ref_cell_frozen(ref_cell), "pack while frozen");
+
+  ref_malloc(c2n, size_per * ref_cell_n(ref_cell), REF_INT);
+  ref_malloc(first, ref_cell_n(ref_cell), REF_INT);
+  ref_malloc(order, ref_cell_n(ref_cell), REF_INT);
+
+  new = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    first[new] = o2n[nodes[0]];
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++) {
+      c2n[node + size_per * new] = o2n[nodes[node]];
+      first[new] = MIN(first[new], o2n[nodes[node]]);
+    }
+    if (ref_cell_last_node_is_an_id(ref_cell))
+      c2n[ref_cell_node_per(ref_cell) + size_per * new] =
+          nodes[ref_cell_node_per(ref_cell)];
+    new ++;
+  }
+  REIS(new, ref_cell_n(ref_cell), "count is off");
+
+  RSS(ref_sort_heap_int(ref_cell_n(ref_cell), first, order), "sort first");
+  for (new = 0; new < ref_cell_n(ref_cell); new ++)
+    for (node = 0; node < size_per; node++)
+      ref_cell_c2n(ref_cell, node, new) = c2n[node + size_per * order[new]];
+
+  ref_free(order);
+  ref_free(first);
+  ref_free(c2n);
+
+  RSS(ref_cell_pack_blank_and_adj(ref_cell), "blank and adj");
+  if (NULL != (void *)ref_cell_dirty(ref_cell))
+    RSS(ref_list_apply_o2n(ref_cell_dirty(ref_cell), o2n), "dirty");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_cell_inspect(REF_CELL ref_cell) {
   REF_INT cell, node;
   printf("ref_cell = %p\n", (void *)ref_cell);
@@ -460,12 +524,118 @@ REF_STATUS ref_cell_tattle(REF_CELL ref_cell, REF_INT cell) {
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_cell_track_dirty(REF_CELL ref_cell) {
+  if (NULL != (void *)ref_cell_dirty(ref_cell)) return REF_SUCCESS;
+  RSS(ref_list_create(&(ref_cell_dirty(ref_cell))), "create dirty");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_cell_untrack_dirty(REF_CELL ref_cell) {
+  if (NULL == (void *)ref_cell_dirty(ref_cell)) return REF_SUCCESS;
+  RSS(ref_list_free(ref_cell_dirty(ref_cell)), "free dirty");
+  ref_cell_dirty(ref_cell) = NULL;
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_cell_freeze(REF_CELL ref_cell) {
+  REF_ADJ ref_adj = ref_cell_adj(ref_cell);
+  REF_INT nnode = ref_adj_nnode(ref_adj);
+  REF_INT node, item, cell, degree;
+
+  ref_cell_frozen(ref_cell)++;
+  if (1 < ref_cell_frozen(ref_cell)) return REF_SUCCESS;
+
+  /* same per node order as the lists, so traversals see no change */
+  ref_malloc_init(ref_cell->frozen_first, nnode + 1, REF_INT, 0);
+  for (node = 0; node < nnode; node++) {
+    degree = 0;
+    each_ref_adj_node_item_with_ref(ref_adj, node, item, cell) { degree++; }
+    ref_cell->frozen_first[node + 1] = ref_cell->frozen_first[node] + degree;
+  }
+  ref_malloc(ref_cell->frozen_ref, MAX(1, ref_cell->frozen_first[nnode]),
+             REF_INT);
+  for (node = 0; node < nnode; node++) {
+    degree = 0;
+    each_ref_adj_node_item_with_ref(ref_adj, node, item, cell) {
+      ref_cell->frozen_ref[ref_cell->frozen_first[node] + degree] = cell;
+      degree++;
+    }
+  }
+  ref_cell->frozen_nnode = nnode;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_cell_thaw(REF_CELL ref_cell) {
+  RAS(0 < ref_cell_frozen(ref_cell), "thaw without freeze");
+  ref_cell_frozen(ref_cell)--;
+  if (0 < ref_cell_frozen(ref_cell)) return REF_SUCCESS;
+
+  ref_free(ref_cell->frozen_ref);
+  ref_free(ref_cell->frozen_first);
+  ref_cell->frozen_ref = NULL;
+  ref_cell->frozen_first = NULL;
+  ref_cell->frozen_nnode = 0;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_cell_degree(REF_CELL ref_cell, REF_INT node, REF_INT *degree) {
+  if (!ref_cell_frozen(ref_cell))
+    return ref_adj_degree(ref_cell_adj(ref_cell), node, degree);
+
+  *degree = 0;
+  if (node < 0 || node >= ref_cell->frozen_nnode) return REF_SUCCESS;
+  *degree = ref_cell->frozen_first[node + 1] - ref_cell->frozen_first[node];
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_cell_mark_dirty(REF_CELL ref_cell, REF_INT cell) {
+  REF_INT node;
+  if (NULL == (void *)ref_cell_dirty(ref_cell)) return REF_SUCCESS;
+  for (node = 0; node < ref_cell_node_per(ref_cell); node++)
+    RSS(ref_list_push(ref_cell_dirty(ref_cell),
+                      ref_cell_c2n(ref_cell, node, cell)),
+        "push dirty");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_cell_edge_add(REF_CELL ref_cell, REF_INT cell) {
+  REF_INT cell_edge;
+
+  if (NULL == (void *)ref_cell_edge(ref_cell)) return REF_SUCCESS;
+  each_ref_cell_cell_edge(ref_cell, cell_edge) {
+    RSS(ref_edge_add_cell_edge(ref_cell_edge(ref_cell),
+                               ref_cell_e2n(ref_cell, 0, cell_edge, cell),
+                               ref_cell_e2n(ref_cell, 1, cell_edge, cell)),
+        "add edge");
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_cell_edge_remove(REF_CELL ref_cell, REF_INT cell) {
+  REF_INT cell_edge;
+
+  if (NULL == (void *)ref_cell_edge(ref_cell)) return REF_SUCCESS;
+  each_ref_cell_cell_edge(ref_cell, cell_edge) {
+    RSS(ref_edge_remove_cell_edge(ref_cell_edge(ref_cell),
+                                  ref_cell_e2n(ref_cell, 0, cell_edge, cell),
+                                  ref_cell_e2n(ref_cell, 1, cell_edge, cell)),
+        "remove edge");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_cell_add(REF_CELL ref_cell, REF_INT *nodes, REF_INT *new_cell) {
   REF_INT node, cell;
   REF_INT orig, chunk;
   REF_INT max_limit = REF_INT_MAX / 4;
 
   (*new_cell) = REF_EMPTY;
+  RAS(!ref_cell_frozen(ref_cell), "add while frozen");
 
   if (REF_EMPTY == ref_cell_blank(ref_cell)) {
     RAS(ref_cell_max(ref_cell) != max_limit,
@@ -498,6 +668,8 @@ REF_STATUS ref_cell_add(REF_CELL ref_cell, REF_INT *nodes, REF_INT *new_cell) {
 
   for (node = 0; node < ref_cell_node_per(ref_cell); node++)
     RSS(ref_adj_add(ref_cell->ref_adj, nodes[node], cell), "register cell");
+  RSS(ref_cell_edge_add(ref_cell, cell), "add edges");
+  RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty");
 
   ref_cell_n(ref_cell)++;
 
@@ -507,15 +679,15 @@ REF_STATUS ref_cell_add(REF_CELL ref_cell, REF_INT *nodes, REF_INT *new_cell) {
 }
 
 REF_STATUS ref_cell_add_many_global(REF_CELL ref_cell, REF_NODE ref_node,
-                                    REF_INT n, REF_INT *c2n, REF_INT *part,
+                                    REF_INT n, REF_GLOB *c2n, REF_INT *part,
                                     REF_INT exclude_part_id) {
-  REF_INT *global;
+  REF_GLOB *global;
   REF_INT nnode;
   REF_INT node, cell;
   REF_INT local, local_nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT new_cell;
 
-  ref_malloc(global, ref_cell_node_per(ref_cell) * n, REF_INT);
+  ref_malloc(global, ref_cell_node_per(ref_cell) * n, REF_GLOB);
 
   nnode = 0;
   for (cell = 0; cell < n; cell++)
@@ -540,8 +712,8 @@ REF_STATUS ref_cell_add_many_global(REF_CELL ref_cell, REF_NODE ref_node,
     }
     if (ref_cell_last_node_is_an_id(ref_cell))
       local_nodes[ref_cell_size_per(ref_cell) - 1] =
-          c2n[(ref_cell_size_per(ref_cell) - 1) +
-              ref_cell_size_per(ref_cell) * cell];
+          (REF_INT)c2n[(ref_cell_size_per(ref_cell) - 1) +
+                       ref_cell_size_per(ref_cell) * cell];
 
     RXS(ref_cell_with(ref_cell, local_nodes, &new_cell), REF_NOT_FOUND,
         "with failed");
@@ -553,10 +725,42 @@ REF_STATUS ref_cell_add_many_global(REF_CELL ref_cell, REF_NODE ref_node,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_cell_adopt(REF_CELL ref_cell, REF_INT n, REF_INT *c2n) {
+  REF_INT node, cell;
+
+  RAS(0 == ref_cell_n(ref_cell), "adopt needs an empty ref_cell");
+  RAS(!ref_cell_frozen(ref_cell), "adopt while frozen");
+  RAS(0 < n, "adopt needs cells");
+  for (cell = 0; cell < n; cell++)
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++)
+      RAS(0 <= c2n[node + ref_cell_size_per(ref_cell) * cell],
+          "invalid cell node");
+
+  ref_free(ref_cell->c2n);
+  ref_cell->c2n = c2n;
+  ref_cell_max(ref_cell) = n;
+  ref_cell_n(ref_cell) = n;
+  ref_cell_blank(ref_cell) = REF_EMPTY;
+
+  for (cell = 0; cell < n; cell++) {
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++)
+      RSS(ref_adj_add(ref_cell->ref_adj, ref_cell_c2n(ref_cell, node, cell),
+                      cell),
+          "register cell");
+    RSS(ref_cell_edge_add(ref_cell, cell), "add edges");
+    RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_cell_remove(REF_CELL ref_cell, REF_INT cell) {
   REF_INT node;
+  RAS(!ref_cell_frozen(ref_cell), "remove while frozen");
   if (!ref_cell_valid(ref_cell, cell)) return REF_INVALID;
   ref_cell_n(ref_cell)--;
+  RSS(ref_cell_edge_remove(ref_cell, cell), "remove edges");
+  RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty");
 
   for (node = 0; node < ref_cell_node_per(ref_cell); node++)
     RSS(ref_adj_remove(ref_cell->ref_adj, ref_cell_c2n(ref_cell, node, cell),
@@ -573,8 +777,11 @@ REF_STATUS ref_cell_remove(REF_CELL ref_cell, REF_INT cell) {
 REF_STATUS ref_cell_replace_whole(REF_CELL ref_cell, REF_INT cell,
                                   REF_INT *nodes) {
   REF_INT node;
+  RAS(!ref_cell_frozen(ref_cell), "replace while frozen");
   if (!ref_cell_valid(ref_cell, cell)) return REF_FAILURE;
 
+  RSS(ref_cell_edge_remove(ref_cell, cell), "remove edges");
+  RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty old");
   for (node = 0; node < ref_cell_node_per(ref_cell); node++) {
     RSS(ref_adj_remove(ref_cell->ref_adj, ref_cell_c2n(ref_cell, node, cell),
                        cell),
@@ -588,6 +795,8 @@ REF_STATUS ref_cell_replace_whole(REF_CELL ref_cell, REF_INT cell,
     node = ref_cell_size_per(ref_cell) - 1;
     ref_cell_c2n(ref_cell, node, cell) = nodes[node];
   }
+  RSS(ref_cell_edge_add(ref_cell, cell), "add edges");
+  RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty new");
 
   return REF_SUCCESS;
 }
@@ -599,11 +808,14 @@ REF_STATUS ref_cell_replace_node(REF_CELL ref_cell, REF_INT old_node,
   REF_INT item, cell;
 
   if (old_node == new_node) return REF_SUCCESS;
+  RAS(!ref_cell_frozen(ref_cell), "replace while frozen");
 
   item = ref_adj_first(ref_adj, old_node);
   while (ref_adj_valid(item)) {
     cell = ref_adj_item_ref(ref_adj, item);
 
+    RSS(ref_cell_edge_remove(ref_cell, cell), "remove edges");
+    RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty old");
     for (node = 0; node < ref_cell_node_per(ref_cell); node++)
       if (old_node == ref_cell_c2n(ref_cell, node, cell)) {
         RSS(ref_adj_remove(ref_cell->ref_adj,
@@ -614,6 +826,8 @@ REF_STATUS ref_cell_replace_node(REF_CELL ref_cell, REF_INT old_node,
                         cell),
             "register cell with id");
       }
+    RSS(ref_cell_edge_add(ref_cell, cell), "add edges");
+    RSS(ref_cell_mark_dirty(ref_cell, cell), "dirty new");
 
     item = ref_adj_first(ref_adj, old_node);
   }
@@ -657,8 +871,8 @@ REF_STATUS ref_cell_nodes(REF_CELL ref_cell, REF_INT cell, REF_INT *nodes) {
 
 REF_STATUS ref_cell_part(REF_CELL ref_cell, REF_NODE ref_node, REF_INT cell,
                          REF_INT *output_part) {
-  REF_INT global, part;
-  REF_INT smallest_global, smallest_global_part;
+  REF_GLOB global, smallest_global;
+  REF_INT part, smallest_global_part;
   REF_INT node;
   *output_part = REF_EMPTY;
   if (cell < 0 || cell > ref_cell_max(ref_cell)) return REF_INVALID;
@@ -719,26 +933,45 @@ REF_STATUS ref_cell_orient_node0(REF_INT nnode, REF_INT node0, REF_INT *nodes) {
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_cell_cell_has_side(REF_CELL ref_cell, REF_INT cell,
+                                         REF_INT node0, REF_INT node1,
+                                         REF_BOOL *has_side) {
+  REF_INT cell_edge;
+
+  each_ref_cell_cell_edge(ref_cell, cell_edge) {
+    if ((node0 == ref_cell_e2n(ref_cell, 0, cell_edge, cell) &&
+         node1 == ref_cell_e2n(ref_cell, 1, cell_edge, cell)) ||
+        (node0 == ref_cell_e2n(ref_cell, 1, cell_edge, cell) &&
+         node1 == ref_cell_e2n(ref_cell, 0, cell_edge, cell))) {
+      *has_side = REF_TRUE;
+      return REF_SUCCESS;
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_cell_has_side(REF_CELL ref_cell, REF_INT node0, REF_INT node1,
                              REF_BOOL *has_side) {
   REF_INT item, cell;
-  REF_INT cell_edge;
 
   *has_side = REF_FALSE;
 
-  each_ref_adj_node_item_with_ref(ref_cell_adj(ref_cell), node0, item, cell)
-      each_ref_cell_cell_edge(
-          ref_cell,
-          cell_edge) if ((node0 == ref_cell_e2n(ref_cell, 0, cell_edge, cell) &&
-                          node1 ==
-                              ref_cell_e2n(ref_cell, 1, cell_edge, cell)) ||
-                         (node0 == ref_cell_e2n(ref_cell, 1, cell_edge, cell) &&
-                          node1 ==
-                              ref_cell_e2n(ref_cell, 0, cell_edge, cell))) {
-    *has_side = REF_TRUE;
+  if (ref_cell_frozen(ref_cell)) {
+    each_ref_cell_frozen_having_node(ref_cell, node0, item, cell) {
+      RSS(ref_cell_cell_has_side(ref_cell, cell, node0, node1, has_side),
+          "frozen side");
+      if (*has_side) return REF_SUCCESS;
+    }
     return REF_SUCCESS;
   }
 
+  each_ref_adj_node_item_with_ref(ref_cell_adj(ref_cell), node0, item, cell) {
+    RSS(ref_cell_cell_has_side(ref_cell, cell, node0, node1, has_side),
+        "side");
+    if (*has_side) return REF_SUCCESS;
+  }
+
   return REF_SUCCESS;
 }
 
@@ -773,42 +1006,61 @@ REF_STATUS ref_cell_side_has_id(REF_CELL ref_cell, REF_INT node0, REF_INT node1,
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_cell_cell_with_face(REF_CELL ref_cell, REF_INT cell,
+                                          REF_INT ntarget, REF_INT *target,
+                                          REF_INT *cell0, REF_INT *cell1) {
+  REF_INT node, same, cell_face;
+  REF_INT ncanidate, canidate[REF_CELL_MAX_SIZE_PER];
+  REF_INT orig[REF_CELL_MAX_SIZE_PER];
+
+  each_ref_cell_cell_face(ref_cell, cell_face) {
+    for (node = 0; node < 4; node++) {
+      orig[node] = ref_cell_f2n(ref_cell, node, cell_face, cell);
+    }
+    RSS(ref_sort_unique_int(4, orig, &ncanidate, canidate), "c uniq");
+
+    if (ntarget == ncanidate) {
+      same = 0;
+      for (node = 0; node < ntarget; node++) {
+        if (target[node] == canidate[node]) same++;
+      }
+
+      if (ntarget == same) {
+        if (REF_EMPTY == *cell0) {
+          (*cell0) = cell;
+        } else {
+          if (REF_EMPTY != *cell1)
+            return REF_INVALID; /* more than 2 cells with face */
+          (*cell1) = cell;
+        }
+      }
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_cell_with_face(REF_CELL ref_cell, REF_INT *face_nodes,
                               REF_INT *cell0, REF_INT *cell1) {
-  REF_INT item, node, same, cell_face, cell;
+  REF_INT item, cell;
   REF_INT ntarget, target[REF_CELL_MAX_SIZE_PER];
-  REF_INT ncanidate, canidate[REF_CELL_MAX_SIZE_PER];
-  REF_INT orig[REF_CELL_MAX_SIZE_PER];
 
   (*cell0) = REF_EMPTY;
   (*cell1) = REF_EMPTY;
 
   RSS(ref_sort_unique_int(4, face_nodes, &ntarget, target), "t uniq");
 
-  each_ref_cell_having_node(ref_cell, face_nodes[0], item, cell) {
-    each_ref_cell_cell_face(ref_cell, cell_face) {
-      for (node = 0; node < 4; node++) {
-        orig[node] = ref_cell_f2n(ref_cell, node, cell_face, cell);
-      }
-      RSS(ref_sort_unique_int(4, orig, &ncanidate, canidate), "c uniq");
-
-      if (ntarget == ncanidate) {
-        same = 0;
-        for (node = 0; node < ntarget; node++) {
-          if (target[node] == canidate[node]) same++;
-        }
-
-        if (ntarget == same) {
-          if (REF_EMPTY == *cell0) {
-            (*cell0) = cell;
-          } else {
-            if (REF_EMPTY != *cell1)
-              return REF_INVALID; /* more than 2 cells with face */
-            (*cell1) = cell;
-          }
-        }
-      }
+  if (ref_cell_frozen(ref_cell)) {
+    each_ref_cell_frozen_having_node(ref_cell, face_nodes[0], item, cell) {
+      RAISE(ref_cell_cell_with_face(ref_cell, cell, ntarget, target, cell0,
+                                    cell1));
     }
+    return REF_SUCCESS;
+  }
+
+  each_ref_cell_having_node(ref_cell, face_nodes[0], item, cell) {
+    RAISE(ref_cell_cell_with_face(ref_cell, cell, ntarget, target, cell0,
+                                  cell1));
   }
 
   return REF_SUCCESS;
@@ -896,17 +1148,13 @@ REF_STATUS ref_cell_list_with2(REF_CELL ref_cell, REF_INT node0, REF_INT node1,
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_cell_node_list_around(REF_CELL ref_cell, REF_INT node,
-                                     REF_INT max_node, REF_INT *nnode,
-                                     REF_INT *node_list) {
-  REF_INT cell, item, cell_node, haves;
+static REF_STATUS ref_cell_node_list_add(REF_CELL ref_cell, REF_INT node,
+                                         REF_INT cell, REF_INT max_node,
+                                         REF_INT *nnode, REF_INT *node_list) {
+  REF_INT cell_node, haves;
   REF_BOOL already_have_it;
 
-  *nnode = 0;
-  each_ref_cell_having_node(ref_cell, node, item,
-                            cell) for (cell_node = 0;
-                                       cell_node < ref_cell_node_per(ref_cell);
-                                       cell_node++) {
+  each_ref_cell_cell_node(ref_cell, cell_node) {
     if (node == ref_cell_c2n(ref_cell, cell_node, cell)) continue;
     already_have_it = REF_FALSE;
     for (haves = 0; haves < *nnode; haves++)
@@ -915,7 +1163,7 @@ REF_STATUS ref_cell_node_list_around(REF_CELL ref_cell, REF_INT node,
         break;
       }
     if (!already_have_it) {
-      if (*nnode >= max_node) RSS(REF_INCREASE_LIMIT, "max_node too small");
+      if (*nnode >= max_node) return REF_INCREASE_LIMIT;
       node_list[*nnode] = ref_cell_c2n(ref_cell, cell_node, cell);
       (*nnode)++;
     }
@@ -924,6 +1172,30 @@ REF_STATUS ref_cell_node_list_around(REF_CELL ref_cell, REF_INT node,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_cell_node_list_around(REF_CELL ref_cell, REF_INT node,
+                                     REF_INT max_node, REF_INT *nnode,
+                                     REF_INT *node_list) {
+  REF_INT cell, item;
+
+  *nnode = 0;
+  if (ref_cell_frozen(ref_cell)) {
+    each_ref_cell_frozen_having_node(ref_cell, node, item, cell) {
+      RSS(ref_cell_node_list_add(ref_cell, node, cell, max_node, nnode,
+                                 node_list),
+          "max_node too small");
+    }
+    return REF_SUCCESS;
+  }
+
+  each_ref_cell_having_node(ref_cell, node, item, cell) {
+    RSS(ref_cell_node_list_add(ref_cell, node, cell, max_node, nnode,
+                               node_list),
+        "max_node too small");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_cell_id_list_around(REF_CELL ref_cell, REF_INT node,
                                    REF_INT max_ids, REF_INT *n_ids,
                                    REF_INT *ids) {
@@ -987,19 +1259,38 @@ REF_STATUS ref_cell_gen_edge_face(REF_CELL ref_cell, REF_INT edge,
   return REF_SUCCESS;
 }
 
+/* widened to REF_GLOB so one exchange serves both widths */
 REF_STATUS ref_cell_ghost_int(REF_CELL ref_cell, REF_NODE ref_node,
                               REF_INT *data) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_GLOB *wide;
+  REF_INT cell;
+
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+
+  ref_malloc(wide, ref_cell_max(ref_cell), REF_GLOB);
+  each_ref_cell_valid_cell(ref_cell, cell) wide[cell] = (REF_GLOB)data[cell];
+  RSS(ref_cell_ghost_glob(ref_cell, ref_node, wide), "ghost glob");
+  each_ref_cell_valid_cell(ref_cell, cell) data[cell] = (REF_INT)wide[cell];
+  ref_free(wide);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_cell_ghost_glob(REF_CELL ref_cell, REF_NODE ref_node,
+                               REF_GLOB *data) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT *a_size, *b_size;
   REF_INT a_total, b_total;
   REF_INT cell;
   REF_INT part;
   REF_INT *a_next, *a_cell;
-  REF_INT *a_nodes, *b_nodes;
-  REF_INT *a_data, *b_data;
+  REF_GLOB *a_nodes, *b_nodes;
+  REF_GLOB *a_data, *b_data;
 
   REF_INT cell_node, nodes[REF_CELL_MAX_SIZE_PER];
-  REF_INT local, global;
+  REF_INT local;
+  REF_GLOB global;
   REF_INT request;
 
   if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
@@ -1017,14 +1308,14 @@ REF_STATUS ref_cell_ghost_int(REF_CELL ref_cell, REF_NODE ref_node,
 
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-  ref_malloc(a_nodes, ref_cell_node_per(ref_cell) * a_total, REF_INT);
-  ref_malloc(a_data, a_total, REF_INT);
+  ref_malloc(a_nodes, ref_cell_node_per(ref_cell) * a_total, REF_GLOB);
+  ref_malloc(a_data, a_total, REF_GLOB);
   ref_malloc(a_cell, a_total, REF_INT);
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-  ref_malloc(b_nodes, ref_cell_node_per(ref_cell) * b_total, REF_INT);
-  ref_malloc(b_data, b_total, REF_INT);
+  ref_malloc(b_nodes, ref_cell_node_per(ref_cell) * b_total, REF_GLOB);
+  ref_malloc(b_data, b_total, REF_GLOB);
 
   ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
   a_next[0] = 0;
@@ -1045,7 +1336,7 @@ REF_STATUS ref_cell_ghost_int(REF_CELL ref_cell, REF_NODE ref_node,
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_nodes, a_size, b_nodes, b_size,
-                        ref_cell_node_per(ref_cell), REF_INT_TYPE),
+                        ref_cell_node_per(ref_cell), REF_GLOB_TYPE),
       "alltoallv requested nodes");
 
   for (request = 0; request < b_total; request++) {
@@ -1059,7 +1350,7 @@ REF_STATUS ref_cell_ghost_int(REF_CELL ref_cell, REF_NODE ref_node,
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, b_data, b_size, a_data, a_size, 1,
-                        REF_INT_TYPE),
+                        REF_GLOB_TYPE),
       "alltoallv return data");
 
   for (request = 0; request < a_total; request++) {
@@ -1083,11 +1374,12 @@ REF_STATUS ref_cell_ghost_int(REF_CELL ref_cell, REF_NODE ref_node,
 }
 
 REF_STATUS ref_cell_global(REF_CELL ref_cell, REF_NODE ref_node,
-                           REF_INT **global) {
+                           REF_GLOB **global) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT ncell, cell, part, *counts, offset, proc;
+  REF_INT cell, part, proc;
+  REF_GLOB ncell, *counts, offset;
 
-  ref_malloc(*global, ref_cell_max(ref_cell), REF_INT);
+  ref_malloc(*global, ref_cell_max(ref_cell), REF_GLOB);
 
   ncell = 0;
   each_ref_cell_valid_cell(ref_cell, cell) {
@@ -1097,8 +1389,8 @@ REF_STATUS ref_cell_global(REF_CELL ref_cell, REF_NODE ref_node,
     }
   }
 
-  ref_malloc(counts, ref_mpi_n(ref_mpi), REF_INT);
-  RSS(ref_mpi_allgather(ref_mpi, &ncell, counts, REF_INT_TYPE), "gather size");
+  ref_malloc(counts, ref_mpi_n(ref_mpi), REF_GLOB);
+  RSS(ref_mpi_allgather(ref_mpi, &ncell, counts, REF_GLOB_TYPE), "gather size");
   offset = 0;
   for (proc = 0; proc < ref_mpi_rank(ref_mpi); proc++) offset += counts[proc];
   ref_free(counts);
@@ -1111,7 +1403,7 @@ REF_STATUS ref_cell_global(REF_CELL ref_cell, REF_NODE ref_node,
     }
   }
 
-  RSS(ref_cell_ghost_int(ref_cell, ref_node, *global), "ghost");
+  RSS(ref_cell_ghost_glob(ref_cell, ref_node, *global), "ghost");
 
   return REF_SUCCESS;
 }
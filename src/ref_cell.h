@@ -29,6 +29,9 @@ END_C_DECLORATION
 #include "ref_adj.h"
 #include "ref_node.h"
 
+#include "ref_edge.h"
+#include "ref_list.h"
+
 BEGIN_C_DECLORATION
 
 #define REF_CELL_MAX_SIZE_PER (8)
@@ -43,6 +46,12 @@ struct REF_CELL_STRUCT {
   REF_INT blank;
   REF_INT *c2n;
   REF_ADJ ref_adj;
+  REF_EDGE ref_edge;
+  REF_LIST dirty;
+  REF_INT frozen;
+  REF_INT frozen_nnode;
+  REF_INT *frozen_first;
+  REF_INT *frozen_ref;
 };
 
 #define ref_cell_last_node_is_an_id(ref_cell) ((ref_cell)->last_node_is_an_id)
@@ -56,6 +65,12 @@ struct REF_CELL_STRUCT {
 #define ref_cell_max(ref_cell) ((ref_cell)->max)
 #define ref_cell_blank(ref_cell) ((ref_cell)->blank)
 #define ref_cell_adj(ref_cell) ((ref_cell)->ref_adj)
+/* counted edges shared by the volume cells of a grid, or NULL */
+#define ref_cell_edge(ref_cell) ((ref_cell)->ref_edge)
+/* nodes of cells added or removed since the last erase, or NULL */
+#define ref_cell_dirty(ref_cell) ((ref_cell)->dirty)
+/* nonzero while the packed node to cell snapshot is current */
+#define ref_cell_frozen(ref_cell) ((ref_cell)->frozen)
 
 #define ref_cell_valid(ref_cell, cell)          \
   ((cell) >= 0 && (cell) < ((ref_cell)->max) && \
@@ -78,6 +93,18 @@ struct REF_CELL_STRUCT {
   ((ref_cell)->c2n[(ref_cell)->f2n[(node) + 4 * (cell_face)] + \
                    ref_cell_size_per(ref_cell) * (cell)])
 
+#define ref_cell_frozen_first(ref_cell, node)          \
+  ((node) >= 0 && (node) < (ref_cell)->frozen_nnode && \
+           (ref_cell)->frozen_first[(node)] <          \
+               (ref_cell)->frozen_first[(node) + 1]    \
+       ? (ref_cell)->frozen_first[(node)]              \
+       : REF_EMPTY)
+#define ref_cell_frozen_next(ref_cell, node, item)                \
+  ((item) + 1 < (ref_cell)->frozen_first[(node) + 1] ? (item) + 1 \
+                                                     : REF_EMPTY)
+#define ref_cell_frozen_safe_ref(ref_cell, item) \
+  (ref_adj_valid(item) ? (ref_cell)->frozen_ref[(item)] : REF_EMPTY)
+
 #define ref_cell_node_empty(ref_cell, node) \
   ref_adj_empty((ref_cell)->ref_adj, node)
 
@@ -92,6 +119,14 @@ struct REF_CELL_STRUCT {
 #define each_ref_cell_having_node(ref_cell, node, item, cell) \
   each_ref_adj_node_item_with_ref((ref_cell)->ref_adj, node, item, cell)
 
+/* walks the packed snapshot, only between ref_cell_freeze and thaw */
+#define each_ref_cell_frozen_having_node(ref_cell, node, item, cell) \
+  for ((item) = ref_cell_frozen_first(ref_cell, node),               \
+      (cell) = ref_cell_frozen_safe_ref(ref_cell, item);             \
+       ref_adj_valid(item);                                          \
+       (item) = ref_cell_frozen_next(ref_cell, node, item),          \
+      (cell) = ref_cell_frozen_safe_ref(ref_cell, item))
+
 #define each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) \
   for ((cell) = 0; (cell) < ref_cell_max(ref_cell); (cell)++)      \
     if (REF_SUCCESS == ref_cell_nodes(ref_cell, cell, nodes))
@@ -114,6 +149,16 @@ REF_STATUS ref_cell_free(REF_CELL ref_cell);
 
 REF_STATUS ref_cell_deep_copy(REF_CELL *ref_cell, REF_CELL original);
 REF_STATUS ref_cell_pack(REF_CELL ref_cell, REF_INT *o2n);
+/* pack with cells ordered by their lowest new node */
+REF_STATUS ref_cell_pack_by_node(REF_CELL ref_cell, REF_INT *o2n);
+
+REF_STATUS ref_cell_track_dirty(REF_CELL ref_cell);
+REF_STATUS ref_cell_untrack_dirty(REF_CELL ref_cell);
+
+/* pack the node to cell lists for read-only traversals, nests, no edits */
+REF_STATUS ref_cell_freeze(REF_CELL ref_cell);
+REF_STATUS ref_cell_thaw(REF_CELL ref_cell);
+REF_STATUS ref_cell_degree(REF_CELL ref_cell, REF_INT node, REF_INT *degree);
 
 REF_STATUS ref_cell_inspect(REF_CELL ref_cell);
 REF_STATUS ref_cell_tattle(REF_CELL ref_cell, REF_INT cell);
@@ -121,9 +166,13 @@ REF_STATUS ref_cell_tattle(REF_CELL ref_cell, REF_INT cell);
 REF_STATUS ref_cell_add(REF_CELL ref_cell, REF_INT *nodes, REF_INT *cell);
 
 REF_STATUS ref_cell_add_many_global(REF_CELL ref_cell, REF_NODE ref_node,
-                                    REF_INT n, REF_INT *c2n, REF_INT *part,
+                                    REF_INT n, REF_GLOB *c2n, REF_INT *part,
                                     REF_INT exclude_part_id);
 
+/* takes ownership of n malloc'd cells of size_per local nodes,
+ * which is later grown in place */
+REF_STATUS ref_cell_adopt(REF_CELL ref_cell, REF_INT n, REF_INT *c2n);
+
 REF_STATUS ref_cell_remove(REF_CELL ref_cell, REF_INT cell);
 REF_STATUS ref_cell_replace_whole(REF_CELL ref_cell, REF_INT cell,
                                   REF_INT *nodes);
@@ -168,9 +217,11 @@ REF_STATUS ref_cell_gen_edge_face(REF_CELL ref_cell, REF_INT edge,
 
 REF_STATUS ref_cell_ghost_int(REF_CELL ref_cell, REF_NODE ref_node,
                               REF_INT *data);
+REF_STATUS ref_cell_ghost_glob(REF_CELL ref_cell, REF_NODE ref_node,
+                               REF_GLOB *data);
 
 REF_STATUS ref_cell_global(REF_CELL ref_cell, REF_NODE ref_node,
-                           REF_INT **global);
+                           REF_GLOB **global);
 
 END_C_DECLORATION
 
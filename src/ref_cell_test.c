@@ -61,6 +61,62 @@ int main(int argc, char *argv[]) {
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "create mpi");
 
+  if (2 == argc) { /* node ball benchmark of linked list vs frozen */
+    REF_CELL ref_cell;
+    REF_INT n, ncube, i, cube, ii, jj, kk, tet, corner;
+    REF_INT hex[8], nodes[REF_CELL_MAX_SIZE_PER];
+    REF_INT kuhn[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6},
+                          {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+    REF_INT nnode, node, sweep, item, cell;
+    REF_LONG list_sum, frozen_sum;
+
+    n = atoi(argv[1]);
+    ncube = n * n * n;
+    nnode = (n + 1) * (n + 1) * (n + 1);
+    RSS(ref_tet(&ref_cell), "create");
+    /* scrambled cube order, like adaptation leaves the lists */
+    for (i = 0; i < ncube; i++) {
+      cube = (REF_INT)((7919L * (long)i) % ncube);
+      ii = cube % n;
+      jj = (cube / n) % n;
+      kk = cube / n / n;
+      for (corner = 0; corner < 8; corner++)
+        hex[corner] = (ii + ((corner + 1) / 2) % 2) +
+                      (n + 1) * ((jj + (corner / 2) % 2) +
+                                 (n + 1) * (kk + corner / 4));
+      for (tet = 0; tet < 6; tet++) {
+        for (corner = 0; corner < 4; corner++)
+          nodes[corner] = hex[kuhn[tet][corner]];
+        RSS(ref_cell_add(ref_cell, nodes, &cell), "add");
+      }
+    }
+
+    ref_mpi_stopwatch_start(ref_mpi);
+    list_sum = 0;
+    for (sweep = 0; sweep < 10; sweep++)
+      for (node = 0; node < nnode; node++)
+        each_ref_cell_having_node(ref_cell, node, item, cell) {
+          list_sum += ref_cell_c2n(ref_cell, 0, cell);
+        }
+    ref_mpi_stopwatch_stop(ref_mpi, "list ball");
+    RSS(ref_cell_freeze(ref_cell), "freeze");
+    ref_mpi_stopwatch_stop(ref_mpi, "freeze");
+    frozen_sum = 0;
+    for (sweep = 0; sweep < 10; sweep++)
+      for (node = 0; node < nnode; node++)
+        each_ref_cell_frozen_having_node(ref_cell, node, item, cell) {
+          frozen_sum += ref_cell_c2n(ref_cell, 0, cell);
+        }
+    ref_mpi_stopwatch_stop(ref_mpi, "frozen ball");
+    RSS(ref_cell_thaw(ref_cell), "thaw");
+    REIS(list_sum, frozen_sum, "same balls");
+
+    RSS(ref_cell_free(ref_cell), "free");
+    RSS(ref_mpi_free(ref_mpi), "mpi free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   REIS(REF_NULL, ref_cell_free(NULL), "dont free NULL");
 
   { /* deep copy empty */
@@ -100,10 +156,87 @@ int main(int argc, char *argv[]) {
     RSS(ref_cell_free(ref_cell), "cleanup");
   }
 
+  { /* frozen traversal matches lists */
+    REF_CELL ref_cell;
+    REF_INT nodes[4];
+    REF_INT cell, item, degree;
+    REF_INT list[4], nlist;
+    REF_INT around[6], naround, frozen_around[6], nfrozen;
+    REF_INT face[4], cell0, cell1, list_cell0, list_cell1;
+    REF_BOOL has_side;
+
+    RSS(ref_tet(&ref_cell), "create");
+    nodes[0] = 0;
+    nodes[1] = 1;
+    nodes[2] = 2;
+    nodes[3] = 3;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add cell");
+    nodes[3] = 4;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add cell");
+    nodes[0] = 5;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add cell");
+
+    nlist = 0;
+    each_ref_cell_having_node(ref_cell, 1, item, cell) {
+      list[nlist] = cell;
+      nlist++;
+    }
+    REIS(3, nlist, "list ball");
+    RSS(ref_cell_node_list_around(ref_cell, 1, 6, &naround, around), "around");
+    face[0] = 1;
+    face[1] = 2;
+    face[2] = 4;
+    face[3] = face[0];
+    RSS(ref_cell_with_face(ref_cell, face, &list_cell0, &list_cell1), "face");
+    RAS(REF_EMPTY != list_cell1, "two cells with face");
+
+    RSS(ref_cell_freeze(ref_cell), "freeze");
+    RSS(ref_cell_freeze(ref_cell), "nested freeze");
+    nlist = 0;
+    each_ref_cell_frozen_having_node(ref_cell, 1, item, cell) {
+      REIS(list[nlist], cell, "same order");
+      nlist++;
+    }
+    REIS(3, nlist, "frozen ball");
+    nlist = 0;
+    each_ref_cell_frozen_having_node(ref_cell, 6, item, cell) { nlist++; }
+    REIS(0, nlist, "node 6 empty");
+    RSS(ref_cell_degree(ref_cell, 0, &degree), "degree");
+    REIS(2, degree, "node 0");
+    RSS(ref_cell_degree(ref_cell, 7, &degree), "degree");
+    REIS(0, degree, "past nodes");
+    RSS(ref_cell_node_list_around(ref_cell, 1, 6, &nfrozen, frozen_around),
+        "frozen around");
+    REIS(naround, nfrozen, "same around count");
+    for (item = 0; item < naround; item++)
+      REIS(around[item], frozen_around[item], "same around order");
+    RSS(ref_cell_has_side(ref_cell, 5, 4, &has_side), "side");
+    RAS(has_side, "side 5-4");
+    RSS(ref_cell_has_side(ref_cell, 0, 5, &has_side), "side");
+    RAS(!has_side, "no side 0-5");
+    RSS(ref_cell_with_face(ref_cell, face, &cell0, &cell1), "with face");
+    REIS(list_cell0, cell0, "same first with face");
+    REIS(list_cell1, cell1, "same second with face");
+    for (item = 0; item < 6; item++) around[item] = 5 - item;
+    REIS(REF_FAILURE, ref_cell_pack(ref_cell, around), "pack frozen");
+    REIS(REF_FAILURE, ref_cell_pack_by_node(ref_cell, around), "pack frozen");
+    REIS(1, ref_cell_c2n(ref_cell, 1, 0), "c2n untouched by frozen pack");
+    RSS(ref_cell_thaw(ref_cell), "nested thaw");
+    RAS(ref_cell_frozen(ref_cell), "still frozen");
+    RSS(ref_cell_thaw(ref_cell), "thaw");
+    RAS(!ref_cell_frozen(ref_cell), "thawed");
+
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add after thaw");
+    RSS(ref_cell_degree(ref_cell, 5, &degree), "degree");
+    REIS(2, degree, "node 5");
+
+    RSS(ref_cell_free(ref_cell), "cleanup");
+  }
+
   { /* add many global */
     REF_CELL ref_cell;
     REF_NODE ref_node;
-    REF_INT nodes[4];
+    REF_GLOB nodes[4];
     REF_INT parts[4];
     REF_INT retrieved[4];
 
@@ -137,6 +270,38 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "cleanup");
   }
 
+  { /* adopt c2n, then grow */
+    REF_CELL ref_cell;
+    REF_INT *c2n, nodes[4], cell, ncell;
+    REF_INT list[2];
+
+    RSS(ref_tet(&ref_cell), "create");
+    ref_malloc(c2n, 8, REF_INT);
+    for (cell = 0; cell < 2; cell++) {
+      c2n[0 + 4 * cell] = 0 + cell;
+      c2n[1 + 4 * cell] = 1 + cell;
+      c2n[2 + 4 * cell] = 2 + cell;
+      c2n[3 + 4 * cell] = 3 + cell;
+    }
+
+    RSS(ref_cell_adopt(ref_cell, 2, c2n), "adopt");
+    REIS(2, ref_cell_n(ref_cell), "n");
+    RAS(c2n == ref_cell->c2n, "not adopted in place");
+    RSS(ref_cell_list_with2(ref_cell, 1, 3, 2, &ncell, list), "adj");
+    REIS(2, ncell, "shared edge");
+
+    nodes[0] = 4;
+    nodes[1] = 5;
+    nodes[2] = 6;
+    nodes[3] = 7;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "grow");
+    REIS(2, cell, "appended");
+    RSS(ref_cell_nodes(ref_cell, 1, nodes), "kept");
+    REIS(4, nodes[3], "adopted node");
+
+    RSS(ref_cell_free(ref_cell), "cleanup");
+  }
+
   { /* remove */
     REF_CELL ref_cell;
     REF_INT nodes[4];
@@ -173,6 +338,44 @@ int main(int argc, char *argv[]) {
     RSS(ref_cell_free(ref_cell), "cleanup");
   }
 
+  { /* dirty nodes of add, remove and pack */
+    REF_CELL ref_cell;
+    REF_INT nodes[4];
+    REF_INT cell;
+    REF_INT o2n[7] = {0, 1, 2, 3, REF_EMPTY, 4, 5};
+
+    RSS(ref_tri(&ref_cell), "create");
+    RAS(NULL == (void *)ref_cell_dirty(ref_cell), "tracking off by default");
+
+    nodes[0] = 0;
+    nodes[1] = 1;
+    nodes[2] = 2;
+    nodes[3] = 10;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add cell");
+
+    RSS(ref_cell_track_dirty(ref_cell), "track");
+    REIS(0, ref_list_n(ref_cell_dirty(ref_cell)), "start clean");
+
+    nodes[0] = 4;
+    nodes[1] = 5;
+    nodes[2] = 6;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add cell");
+    REIS(3, ref_list_n(ref_cell_dirty(ref_cell)), "add marks");
+    RSS(ref_cell_remove(ref_cell, 0), "remove cell");
+    REIS(6, ref_list_n(ref_cell_dirty(ref_cell)), "remove marks");
+    RSS(ref_cell_replace_node(ref_cell, 4, 3), "replace");
+    REIS(12, ref_list_n(ref_cell_dirty(ref_cell)), "replace marks");
+
+    RSS(ref_cell_pack(ref_cell, o2n), "pack");
+    REIS(10, ref_list_n(ref_cell_dirty(ref_cell)), "pack drops node 4");
+    REIS(4, ref_list_value(ref_cell_dirty(ref_cell), 0), "pack renumbers");
+
+    RSS(ref_cell_untrack_dirty(ref_cell), "untrack");
+    RAS(NULL == (void *)ref_cell_dirty(ref_cell), "untracked");
+
+    RSS(ref_cell_free(ref_cell), "cleanup");
+  }
+
   { /* compact */
     REF_CELL ref_cell;
     REF_INT nodes[4];
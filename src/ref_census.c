@@ -0,0 +1,303 @@
+
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_census.h"
+
+#include "ref_adj.h"
+#include "ref_cell.h"
+#include "ref_edge.h"
+#include "ref_geom.h"
+#include "ref_malloc.h"
+#include "ref_matrix.h"
+#include "ref_mpi.h"
+#include "ref_node.h"
+
+static REF_STATUS ref_census_cell(REF_GRID ref_grid, REF_CELL ref_cell,
+                                  REF_INT cell, REF_BOOL *active,
+                                  REF_DBL *quality, REF_DBL *volume,
+                                  REF_DBL *complexity) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT cell_node;
+  REF_DBL det;
+
+  RSS(ref_cell_nodes(ref_cell, cell, nodes), "nodes");
+  *active = REF_TRUE;
+  *quality = 1.0;
+  *complexity = 0.0;
+  if (ref_grid_twod(ref_grid)) {
+    RSS(ref_node_tri_area(ref_node, nodes, volume), "area");
+    RSS(ref_node_node_twod(ref_node, nodes[0], active), "active twod tri");
+    if (!(*active)) return REF_SUCCESS;
+    RSS(ref_node_tri_quality(ref_node, nodes, quality), "qual");
+  } else {
+    RSS(ref_node_tet_vol(ref_node, nodes, volume), "vol");
+    RSS(ref_node_tet_quality(ref_node, nodes, quality), "qual");
+  }
+
+  for (cell_node = 0; cell_node < ref_cell_node_per(ref_cell); cell_node++) {
+    if (ref_node_owned(ref_node, nodes[cell_node])) {
+      RSS(ref_matrix_det_m(ref_node_metric_ptr(ref_node, nodes[cell_node]),
+                           &det),
+          "det");
+      *complexity +=
+          sqrt(det) * (*volume) / ((REF_DBL)ref_cell_node_per(ref_cell));
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_census_cells(REF_CENSUS ref_census, REF_GRID ref_grid) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_DBL *observed;
+  REF_INT cell, part, nfail, ncell, invalid;
+  REF_BOOL active;
+  REF_DBL quality, volume, complexity;
+  REF_DBL min_quality, min_volume, max_volume, total;
+
+  ref_cell = ref_grid_tet(ref_grid);
+  if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_tri(ref_grid);
+
+  ref_malloc(observed, ref_cell_max(ref_cell), REF_DBL);
+
+  nfail = 0;
+  ncell = 0;
+  invalid = REF_INT_MAX;
+  min_quality = 1.0;
+  min_volume = 1.0e100;
+  max_volume = -1.0e100;
+  total = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for private(part, active, quality, volume, complexity) \
+    reduction(+ : nfail, ncell, total) reduction(min : invalid, min_quality, \
+                                                  min_volume)              \
+    reduction(max : max_volume)
+#endif
+  for (cell = 0; cell < ref_cell_max(ref_cell); cell++) {
+    observed[cell] = -1.0;
+    if (!ref_cell_valid(ref_cell, cell)) continue;
+    if (REF_SUCCESS != ref_census_cell(ref_grid, ref_cell, cell, &active,
+                                       &quality, &volume, &complexity)) {
+      nfail++;
+      continue;
+    }
+    if (volume <= 0.0) invalid = MIN(invalid, cell);
+    if (!active) continue;
+    min_quality = MIN(min_quality, quality);
+    min_volume = MIN(min_volume, volume);
+    max_volume = MAX(max_volume, volume);
+    total += complexity;
+    if (REF_SUCCESS != ref_cell_part(ref_cell, ref_node, cell, &part)) {
+      nfail++;
+      continue;
+    }
+    if (part == ref_mpi_rank(ref_mpi)) ncell++;
+    if (ref_node_part(ref_node, ref_cell_c2n(ref_cell, 0, cell)) ==
+            ref_mpi_rank(ref_mpi) &&
+        quality > 0.0)
+      observed[cell] = quality;
+  }
+  REIS(0, nfail, "census cell");
+
+  ref_census->nquality = 0;
+  for (cell = 0; cell < ref_cell_max(ref_cell); cell++)
+    if (observed[cell] > 0.0) ref_census->nquality++;
+  ref_malloc(ref_census->quality, ref_census->nquality, REF_DBL);
+  ref_census->nquality = 0;
+  for (cell = 0; cell < ref_cell_max(ref_cell); cell++)
+    if (observed[cell] > 0.0) {
+      ref_census->quality[ref_census->nquality] = observed[cell];
+      ref_census->nquality++;
+    }
+  ref_free(observed);
+
+  ref_census->invalid_cell = (REF_INT_MAX == invalid ? REF_EMPTY : invalid);
+  ref_census->min_quality = min_quality;
+  ref_census->min_volume = min_volume;
+  ref_census->max_volume = max_volume;
+  ref_census->complexity = total;
+  ref_census->ncell = ncell;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_census_edges(REF_CENSUS ref_census, REF_GRID ref_grid) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_EDGE ref_edge;
+  REF_DBL *edge_ratio;
+  REF_BOOL *owned;
+  REF_INT edge, part, nfail;
+  REF_BOOL active;
+
+  RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  ref_malloc(owned, ref_edge_n(ref_edge), REF_BOOL);
+  RSS(ref_node_ratio_many(ref_node, ref_edge_n(ref_edge),
+                          &ref_edge_e2n(ref_edge, 0, 0), edge_ratio),
+      "rat");
+
+  nfail = 0;
+#ifdef _OPENMP
+#pragma omp parallel for private(part, active) reduction(+ : nfail)
+#endif
+  for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
+    owned[edge] = REF_FALSE;
+    if (REF_SUCCESS != ref_edge_part(ref_edge, edge, &part) ||
+        REF_SUCCESS != ref_node_edge_twod(ref_node,
+                                          ref_edge_e2n(ref_edge, 0, edge),
+                                          ref_edge_e2n(ref_edge, 1, edge),
+                                          &active)) {
+      nfail++;
+      continue;
+    }
+    active = (active || !ref_grid_twod(ref_grid));
+    owned[edge] = (part == ref_mpi_rank(ref_mpi) && active);
+  }
+  REIS(0, nfail, "census edge");
+
+  ref_census->nratio = 0;
+  each_ref_edge(ref_edge, edge) {
+    if (owned[edge]) ref_census->nratio++;
+  }
+  ref_malloc(ref_census->ratio, ref_census->nratio, REF_DBL);
+  ref_census->nratio = 0;
+  ref_census->min_ratio = 1.0e100;
+  ref_census->max_ratio = -1.0e100;
+  each_ref_edge(ref_edge, edge) {
+    if (!owned[edge]) continue;
+    ref_census->ratio[ref_census->nratio] = edge_ratio[edge];
+    ref_census->nratio++;
+    ref_census->min_ratio = MIN(ref_census->min_ratio, edge_ratio[edge]);
+    ref_census->max_ratio = MAX(ref_census->max_ratio, edge_ratio[edge]);
+  }
+
+  ref_free(owned);
+  ref_free(edge_ratio);
+  RSS(ref_edge_free(ref_edge), "free edge");
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_census_nodes(REF_CENSUS ref_census, REF_GRID ref_grid) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT node, nnode, degree, max_degree, max_age, nfail;
+
+  ref_cell = ref_grid_tet(ref_grid);
+  if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_tri(ref_grid);
+
+  nfail = 0;
+  nnode = 0;
+  max_degree = 0;
+  max_age = 0;
+#ifdef _OPENMP
+#pragma omp parallel for private(degree) reduction(+ : nfail, nnode) \
+    reduction(max : max_degree, max_age)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    if (!ref_node_valid(ref_node, node)) continue;
+    if (ref_node_owned(ref_node, node)) nnode++;
+    if (REF_SUCCESS != ref_cell_degree(ref_cell, node, &degree)) {
+      nfail++;
+      continue;
+    }
+    max_degree = MAX(max_degree, degree);
+    max_age = MAX(max_age, ref_node_age(ref_node, node));
+  }
+  REIS(0, nfail, "census node");
+
+  ref_census->nnode = nnode;
+  ref_census->max_degree = max_degree;
+  ref_census->max_age = max_age;
+
+  return REF_SUCCESS;
+}
+
+/* serial, the geometry evaluations are cached */
+static REF_STATUS ref_census_faces(REF_CENSUS ref_census, REF_GRID ref_grid) {
+  REF_CELL ref_cell = ref_grid_tri(ref_grid);
+  REF_INT cell, nodes[REF_CELL_MAX_SIZE_PER];
+  REF_DBL dot;
+
+  ref_census->min_normdev = 2.0;
+  if (!ref_geom_model_loaded(ref_grid_geom(ref_grid))) return REF_SUCCESS;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    RSS(ref_geom_tri_norm_deviation(ref_grid, nodes, &dot), "norm dev");
+    ref_census->min_normdev = MIN(ref_census->min_normdev, dot);
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_census_create(REF_CENSUS *ref_census_ptr, REF_GRID ref_grid) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_CENSUS ref_census;
+  REF_DBL reduce[11];
+
+  ref_malloc(*ref_census_ptr, 1, REF_CENSUS_STRUCT);
+  ref_census = (*ref_census_ptr);
+
+  RSS(ref_census_cells(ref_census, ref_grid), "cells");
+  RSS(ref_census_edges(ref_census, ref_grid), "edges");
+  RSS(ref_census_nodes(ref_census, ref_grid), "nodes");
+  RSS(ref_census_faces(ref_census, ref_grid), "faces");
+
+  /* every extrema in one max and every total in one sum, minimums negated */
+  reduce[0] = -ref_census->min_quality;
+  reduce[1] = -ref_census->min_volume;
+  reduce[2] = ref_census->max_volume;
+  reduce[3] = -ref_census->min_ratio;
+  reduce[4] = ref_census->max_ratio;
+  reduce[5] = (REF_DBL)ref_census->max_degree;
+  reduce[6] = (REF_DBL)ref_census->max_age;
+  reduce[7] = -ref_census->min_normdev;
+  reduce[8] = ref_census->complexity;
+  reduce[9] = (REF_DBL)ref_census->nnode;
+  reduce[10] = (REF_DBL)ref_census->ncell;
+  RSS(ref_mpi_allmaxsum(ref_mpi, reduce, 8, 3), "reduce");
+  ref_census->min_quality = -reduce[0];
+  ref_census->min_volume = -reduce[1];
+  ref_census->max_volume = reduce[2];
+  ref_census->min_ratio = -reduce[3];
+  ref_census->max_ratio = reduce[4];
+  ref_census->max_degree = (REF_INT)reduce[5];
+  ref_census->max_age = (REF_INT)reduce[6];
+  ref_census->min_normdev = -reduce[7];
+  ref_census->complexity = reduce[8];
+  ref_census->nnode = (REF_GLOB)reduce[9];
+  ref_census->ncell = (REF_GLOB)reduce[10];
+  if (ref_grid_twod(ref_grid)) ref_census->nnode = ref_census->nnode / 2;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_census_free(REF_CENSUS ref_census) {
+  if (NULL == (void *)ref_census) return REF_NULL;
+  ref_free(ref_census->ratio);
+  ref_free(ref_census->quality);
+  ref_free(ref_census);
+  return REF_SUCCESS;
+}
@@ -0,0 +1,78 @@
+
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_CENSUS_H
+#define REF_CENSUS_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_CENSUS_STRUCT REF_CENSUS_STRUCT;
+typedef REF_CENSUS_STRUCT *REF_CENSUS;
+END_C_DECLORATION
+
+#include "ref_grid.h"
+
+BEGIN_C_DECLORATION
+
+/* one sweep of cell, edge, node and face statistics, one max and one sum */
+struct REF_CENSUS_STRUCT {
+  REF_INT nquality;
+  REF_DBL *quality;
+  REF_INT nratio;
+  REF_DBL *ratio;
+  REF_INT invalid_cell;
+  REF_DBL min_quality;
+  REF_DBL min_volume, max_volume;
+  REF_DBL min_ratio, max_ratio;
+  REF_DBL min_normdev;
+  REF_DBL complexity;
+  REF_GLOB nnode, ncell;
+  REF_INT max_degree, max_age;
+};
+
+REF_STATUS ref_census_create(REF_CENSUS *ref_census, REF_GRID ref_grid);
+REF_STATUS ref_census_free(REF_CENSUS ref_census);
+
+/* local observations for histograms, quality of cells of this part */
+#define ref_census_nquality(ref_census) ((ref_census)->nquality)
+#define ref_census_quality(ref_census, i) ((ref_census)->quality[(i)])
+/* ratio of edges owned by this part */
+#define ref_census_nratio(ref_census) ((ref_census)->nratio)
+#define ref_census_ratio(ref_census, i) ((ref_census)->ratio[(i)])
+
+/* lowest local cell with a volume that is not positive, or REF_EMPTY */
+#define ref_census_invalid_cell(ref_census) ((ref_census)->invalid_cell)
+
+/* global */
+#define ref_census_min_quality(ref_census) ((ref_census)->min_quality)
+#define ref_census_min_volume(ref_census) ((ref_census)->min_volume)
+#define ref_census_max_volume(ref_census) ((ref_census)->max_volume)
+#define ref_census_min_ratio(ref_census) ((ref_census)->min_ratio)
+#define ref_census_max_ratio(ref_census) ((ref_census)->max_ratio)
+/* surface normal deviation, 2.0 without a geometry model */
+#define ref_census_min_normdev(ref_census) ((ref_census)->min_normdev)
+#define ref_census_complexity(ref_census) ((ref_census)->complexity)
+#define ref_census_nnode(ref_census) ((ref_census)->nnode)
+#define ref_census_ncell(ref_census) ((ref_census)->ncell)
+#define ref_census_max_degree(ref_census) ((ref_census)->max_degree)
+#define ref_census_max_age(ref_census) ((ref_census)->max_age)
+
+END_C_DECLORATION
+
+#endif /* REF_CENSUS_H */
@@ -0,0 +1,132 @@
+
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_census.h"
+
+#include "ref_adapt.h"
+#include "ref_cell.h"
+#include "ref_fixture.h"
+#include "ref_grid.h"
+#include "ref_histogram.h"
+#include "ref_import.h"
+#include "ref_metric.h"
+#include "ref_mpi.h"
+#include "ref_node.h"
+#include "ref_part.h"
+#include "ref_validation.h"
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  if (argc == 3) { /* separate sweeps against one census */
+    REF_GRID ref_grid;
+    REF_CENSUS ref_census;
+    REF_BOOL all_done;
+
+    if (!ref_mpi_para(ref_mpi)) {
+      RSS(ref_import_by_extension(&ref_grid, ref_mpi, argv[1]), "import");
+    } else {
+      RSS(ref_part_by_extension(&ref_grid, ref_mpi, argv[1]), "part");
+    }
+    RSS(ref_part_metric(ref_grid_node(ref_grid), argv[2]), "get metric");
+
+    ref_mpi_stopwatch_start(ref_mpi);
+    RSS(ref_adapt_parameter(ref_grid, &all_done), "param");
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+    RSS(ref_histogram_quality(ref_grid), "qual");
+    RSS(ref_histogram_ratio(ref_grid), "rat");
+    ref_mpi_stopwatch_stop(ref_mpi, "separate");
+
+    RSS(ref_census_create(&ref_census, ref_grid), "census");
+    RSS(ref_adapt_parameter_census(ref_grid, ref_census, &all_done), "param");
+    RSS(ref_validation_cell_volume_census(ref_grid, ref_census), "vol");
+    RSS(ref_histogram_quality_census(ref_grid, ref_census), "qual");
+    RSS(ref_histogram_ratio_census(ref_grid, ref_census), "rat");
+    RSS(ref_census_free(ref_census), "free");
+    ref_mpi_stopwatch_stop(ref_mpi, "census");
+
+    RSS(ref_grid_free(ref_grid), "free");
+    RSS(ref_mpi_free(ref_mpi), "free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
+  REIS(REF_NULL, ref_census_free(NULL), "dont free NULL");
+
+  { /* unit tet */
+    REF_GRID ref_grid;
+    REF_CENSUS ref_census;
+    REF_DBL tol = -1.0;
+
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "tet");
+    RSS(ref_metric_unit_node(ref_grid_node(ref_grid)), "unit");
+    RSS(ref_census_create(&ref_census, ref_grid), "census");
+
+    REIS(REF_EMPTY, ref_census_invalid_cell(ref_census), "positive volume");
+    RWDS(1.0 / 6.0, ref_census_min_volume(ref_census), tol, "min vol");
+    RWDS(1.0 / 6.0, ref_census_max_volume(ref_census), tol, "max vol");
+    RWDS(1.0 / 6.0, ref_census_complexity(ref_census), tol, "complexity");
+    RWDS(1.0, ref_census_min_ratio(ref_census), tol, "min ratio");
+    RWDS(sqrt(2.0), ref_census_max_ratio(ref_census), tol, "max ratio");
+    RAS(0.0 < ref_census_min_quality(ref_census), "quality low");
+    RAS(1.0 > ref_census_min_quality(ref_census), "quality high");
+    REIS(4, ref_census_nnode(ref_census), "nnode");
+    REIS(1, ref_census_ncell(ref_census), "ncell");
+    REIS(1, ref_census_max_degree(ref_census), "degree");
+    REIS(0, ref_census_max_age(ref_census), "age");
+    RWDS(2.0, ref_census_min_normdev(ref_census), tol, "no geometry");
+
+    RSS(ref_census_free(ref_census), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  { /* each cell and edge observed by one part */
+    REF_GRID ref_grid;
+    REF_CENSUS ref_census;
+    REF_INT nquality, nratio;
+
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+    RSS(ref_metric_unit_node(ref_grid_node(ref_grid)), "unit");
+    RSS(ref_census_create(&ref_census, ref_grid), "census");
+
+    /* every part holds and owns its own copy of the brick */
+    REIS(64 * ref_mpi_n(ref_mpi), ref_census_nnode(ref_census), "nnode");
+    REIS(162 * ref_mpi_n(ref_mpi), ref_census_ncell(ref_census), "ncell");
+    nquality = ref_census_nquality(ref_census);
+    RSS(ref_mpi_allsum(ref_mpi, &nquality, 1, REF_INT_TYPE), "sum");
+    REIS(ref_census_ncell(ref_census), nquality, "cell observations");
+
+    nratio = ref_census_nratio(ref_census);
+    RSS(ref_mpi_allsum(ref_mpi, &nratio, 1, REF_INT_TYPE), "sum");
+    /* 3x3x3 cubes of 6 tets: 144 axis, 108 face and 27 body edges */
+    REIS(279 * ref_mpi_n(ref_mpi), nratio, "edge observations");
+
+    RSS(ref_census_free(ref_census), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
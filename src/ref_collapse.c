@@ -23,9 +23,11 @@
 #include "ref_cell.h"
 #include "ref_collapse.h"
 #include "ref_edge.h"
+#include "ref_heap.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
 #include "ref_mpi.h"
+#include "ref_queue.h"
 #include "ref_sort.h"
 
 #include "ref_adapt.h"
@@ -36,77 +38,171 @@
 #define MAX_CELL_COLLAPSE (100)
 #define MAX_NODE_LIST (1000)
 
+/* shortest tet edge ratio at node */
+static REF_STATUS ref_collapse_node_ratio(REF_GRID ref_grid, REF_INT node,
+                                          REF_DBL *ratio) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT nnode, neighbors[MAX_NODE_LIST], i;
+  REF_DBL edge_ratio;
+  REF_STATUS status;
+
+  *ratio = 2.0 * ref_grid_adapt(ref_grid, collapse_ratio);
+  status = ref_cell_node_list_around(ref_grid_tet(ref_grid), node,
+                                     MAX_NODE_LIST, &nnode, neighbors);
+  if (REF_INCREASE_LIMIT == status) return REF_SUCCESS;
+  RSS(status, "neighbors");
+  for (i = 0; i < nnode; i++) {
+    RSS(ref_node_ratio(ref_node, node, neighbors[i], &edge_ratio), "ratio");
+    *ratio = MIN(*ratio, edge_ratio);
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_collapse_remove_node1(REF_GRID ref_grid,
+                                            REF_QUEUE ref_queue,
+                                            REF_INT *actual_node0,
+                                            REF_INT node1);
+
 REF_STATUS ref_collapse_pass(REF_GRID ref_grid) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
   REF_EDGE ref_edge;
-  REF_DBL *ratio;
-  REF_INT *order;
-  REF_INT ntarget, *target, *node2target;
+  REF_HEAP ref_heap;
+  REF_DBL *ratio, node_ratio;
   REF_INT node, node0, node1;
-  REF_INT i, edge;
-  REF_INT item, cell, nodes[REF_CELL_MAX_SIZE_PER];
-  REF_DBL edge_ratio;
+  REF_INT edge;
+  REF_INT nnode, neighbors[MAX_NODE_LIST + 1];
+  REF_DBL *edge_ratio;
+  REF_STATUS status;
+  REF_QUEUE ref_queue = NULL;
+
+  if (ref_mpi_para(ref_grid_mpi(ref_grid)))
+    RSS(ref_queue_create(&ref_queue, ref_grid), "queue");
 
   RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
 
   ref_malloc_init(ratio, ref_node_max(ref_node), REF_DBL,
                   2.0 * ref_grid_adapt(ref_grid, collapse_ratio));
 
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_node_ratio_many(ref_node, ref_edge_n(ref_edge),
+                          &ref_edge_e2n(ref_edge, 0, 0), edge_ratio),
+      "ratio");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     node0 = ref_edge_e2n(ref_edge, 0, edge);
     node1 = ref_edge_e2n(ref_edge, 1, edge);
-    RSS(ref_node_ratio(ref_node, node0, node1, &edge_ratio), "ratio");
-    ratio[node0] = MIN(ratio[node0], edge_ratio);
-    ratio[node1] = MIN(ratio[node1], edge_ratio);
+    ratio[node0] = MIN(ratio[node0], edge_ratio[edge]);
+    ratio[node1] = MIN(ratio[node1], edge_ratio[edge]);
   }
+  ref_free(edge_ratio);
+  ref_edge_free(ref_edge);
 
-  ref_malloc(target, ref_node_n(ref_node), REF_INT);
-  ref_malloc_init(node2target, ref_node_max(ref_node), REF_INT, REF_EMPTY);
-
-  ntarget = 0;
+  RSS(ref_heap_create(&ref_heap, REF_FALSE), "heap");
   for (node = 0; node < ref_node_max(ref_node); node++)
-    if (ratio[node] < ref_grid_adapt(ref_grid, collapse_ratio)) {
-      node2target[node] = ntarget;
-      target[ntarget] = node;
-      ratio[ntarget] = ratio[node];
-      ntarget++;
+    if (ratio[node] < ref_grid_adapt(ref_grid, collapse_ratio))
+      RSS(ref_heap_push(ref_heap, node, ratio[node]), "push");
+  ref_free(ratio);
+
+  /* shortest first, the ball of each survivor is rekeyed */
+  while (REF_SUCCESS == ref_heap_pop(ref_heap, &node1, &node_ratio)) {
+    if (!ref_node_valid(ref_node, node1)) continue;
+    RSS(ref_collapse_remove_node1(ref_grid, ref_queue, &node0, node1),
+        "collapse rm");
+    if (ref_node_valid(ref_node, node1)) continue;
+    ref_node_age(ref_node, node0) = 0;
+    status = ref_cell_node_list_around(ref_cell, node0, MAX_NODE_LIST, &nnode,
+                                       neighbors);
+    if (REF_INCREASE_LIMIT == status) continue;
+    RSS(status, "ball");
+    neighbors[nnode] = node0;
+    for (node = 0; node <= nnode; node++) {
+      RSS(ref_collapse_node_ratio(ref_grid, neighbors[node], &node_ratio),
+          "node ratio");
+      if (node_ratio < ref_grid_adapt(ref_grid, collapse_ratio)) {
+        RSS(ref_heap_push(ref_heap, neighbors[node], node_ratio), "push");
+      } else {
+        RXS(ref_heap_remove(ref_heap, neighbors[node]), REF_NOT_FOUND,
+            "rm");
+      }
     }
+  }
 
-  ref_malloc(order, ntarget, REF_INT);
+  RSS(ref_heap_free(ref_heap), "heap");
 
-  RSS(ref_sort_heap_dbl(ntarget, ratio, order), "sort lengths");
+  if (ref_mpi_para(ref_grid_mpi(ref_grid))) {
+    RSS(ref_queue_apply(ref_queue), "ship queued collapses");
+    RSS(ref_queue_free(ref_queue), "queue");
+  }
 
-  for (i = 0; i < ntarget; i++) {
-    if (ratio[order[i]] > ref_grid_adapt(ref_grid, collapse_ratio)) continue;
-    node1 = target[order[i]];
-    RSS(ref_collapse_to_remove_node1(ref_grid, &node0, node1), "collapse rm");
-    if (!ref_node_valid(ref_node, node1)) {
-      ref_node_age(ref_node, node0) = 0;
-      each_ref_cell_having_node(ref_cell, node0, item, cell) {
-        RSS(ref_cell_nodes(ref_cell, cell, nodes), "cell nodes");
-        for (node = 0; node < ref_cell_node_per(ref_cell); node++) {
-          if (REF_EMPTY != node2target[nodes[node]]) {
-            ratio[node2target[nodes[node]]] =
-                2.0 * ref_grid_adapt(ref_grid, collapse_ratio);
-          }
-        }
-      }
+  return REF_SUCCESS;
+}
+
+/* collapse next to ghosts shipped in a queue, the new ghosts of the
+ * survivor part are interior so they do not need geometry */
+REF_STATUS ref_collapse_edge_queue(REF_GRID ref_grid, REF_INT node0,
+                                   REF_INT node1, REF_BOOL *allowed) {
+  REF_INT nnode, node, nodes[MAX_NODE_LIST];
+  REF_STATUS status;
+
+  SUPRESS_UNUSED_COMPILER_WARNING(node0);
+  *allowed = REF_FALSE;
+
+  if (!ref_cell_node_empty(ref_grid_tri(ref_grid), node1)) return REF_SUCCESS;
+  status = ref_cell_node_list_around(ref_grid_tet(ref_grid), node1,
+                                     MAX_NODE_LIST, &nnode, nodes);
+  if (REF_INCREASE_LIMIT == status) return REF_SUCCESS;
+  RSS(status, "ball");
+  for (node = 0; node < nnode; node++)
+    if (!ref_cell_node_empty(ref_grid_tri(ref_grid), nodes[node]))
+      return REF_SUCCESS;
+
+  RSS(ref_queue_allowed(ref_grid, node1, REF_EMPTY, allowed), "queue");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_collapse_edge_queued(REF_GRID ref_grid, REF_QUEUE ref_queue,
+                                    REF_INT node0, REF_INT node1) {
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT item, cell, node, ncell, cell_in_list, nnode;
+  REF_INT cell_to_keep[MAX_CELL_COLLAPSE];
+  REF_INT nodes[MAX_NODE_LIST];
+  REF_BOOL has_node0;
+
+  RSS(ref_cell_node_list_around(ref_cell, node1, MAX_NODE_LIST, &nnode,
+                                nodes),
+      "ball");
+  ncell = 0;
+  each_ref_cell_having_node(ref_cell, node1, item, cell) {
+    RSS(ref_queue_remove_cell(ref_queue, 0, cell), "old tet");
+    has_node0 = REF_FALSE;
+    each_ref_cell_cell_node(ref_cell, node) {
+      if (node0 == ref_cell_c2n(ref_cell, node, cell)) has_node0 = REF_TRUE;
     }
+    if (has_node0) continue;
+    RAS(ncell < MAX_CELL_COLLAPSE, "increase MAX_CELL_COLLAPSE");
+    cell_to_keep[ncell] = cell;
+    ncell++;
   }
 
-  ref_free(order);
-  ref_free(node2target);
-  ref_free(target);
-  ref_free(ratio);
+  RSS(ref_collapse_edge(ref_grid, node0, node1), "col!");
 
-  ref_edge_free(ref_edge);
+  /* node records before the cells that use them */
+  for (node = 0; node < nnode; node++)
+    RSS(ref_queue_node(ref_queue, nodes[node]), "ball node");
+  for (cell_in_list = 0; cell_in_list < ncell; cell_in_list++)
+    RSS(ref_queue_add_cell(ref_queue, 0, cell_to_keep[cell_in_list]),
+        "new tet");
+  RSS(ref_queue_commit(ref_queue), "commit");
 
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_collapse_to_remove_node1(REF_GRID ref_grid,
-                                        REF_INT *actual_node0, REF_INT node1) {
+static REF_STATUS ref_collapse_remove_node1(REF_GRID ref_grid,
+                                            REF_QUEUE ref_queue,
+                                            REF_INT *actual_node0,
+                                            REF_INT node1) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
   REF_INT nnode, node;
@@ -114,7 +210,7 @@ REF_STATUS ref_collapse_to_remove_node1(REF_GRID ref_grid,
   REF_INT order[MAX_NODE_LIST];
   REF_DBL ratio_to_collapse[MAX_NODE_LIST];
   REF_INT node0;
-  REF_BOOL allowed, have_geometry_support;
+  REF_BOOL allowed, queued, have_geometry_support;
 
   *actual_node0 = REF_EMPTY;
 
@@ -160,14 +256,22 @@ REF_STATUS ref_collapse_to_remove_node1(REF_GRID ref_grid,
 
     RSS(ref_collapse_edge_local_tets(ref_grid, node0, node1, &allowed),
         "colloc");
-    if (!allowed) {
+    queued = REF_FALSE;
+    if (!allowed && NULL != (void *)ref_queue)
+      RSS(ref_collapse_edge_queue(ref_grid, node0, node1, &queued), "queue");
+    if (!allowed && !queued) {
       ref_node_age(ref_node, node0)++;
       ref_node_age(ref_node, node1)++;
       continue;
     }
 
     *actual_node0 = node0;
-    RSS(ref_collapse_edge(ref_grid, node0, node1), "col!");
+    if (queued) {
+      RSS(ref_collapse_edge_queued(ref_grid, ref_queue, node0, node1),
+          "queued col");
+    } else {
+      RSS(ref_collapse_edge(ref_grid, node0, node1), "col!");
+    }
 
     break;
   }
@@ -175,6 +279,13 @@ REF_STATUS ref_collapse_to_remove_node1(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_collapse_to_remove_node1(REF_GRID ref_grid,
+                                        REF_INT *actual_node0, REF_INT node1) {
+  RSS(ref_collapse_remove_node1(ref_grid, NULL, actual_node0, node1),
+      "remove node1");
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_collapse_edge(REF_GRID ref_grid, REF_INT node0, REF_INT node1)
 /*                               keep node0,  remove node1 */
 {
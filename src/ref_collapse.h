@@ -22,6 +22,7 @@
 #include "ref_defs.h"
 
 #include "ref_grid.h"
+#include "ref_queue.h"
 
 BEGIN_C_DECLORATION
 
@@ -46,6 +47,11 @@ REF_STATUS ref_collapse_edge_mixed(REF_GRID ref_grid, REF_INT node0,
 
 REF_STATUS ref_collapse_edge_local_tets(REF_GRID ref_grid, REF_INT node0,
                                         REF_INT node1, REF_BOOL *allowed);
+/* volume edge next to ghosts that can be collapsed and shipped in a queue */
+REF_STATUS ref_collapse_edge_queue(REF_GRID ref_grid, REF_INT node0,
+                                   REF_INT node1, REF_BOOL *allowed);
+REF_STATUS ref_collapse_edge_queued(REF_GRID ref_grid, REF_QUEUE ref_queue,
+                                    REF_INT node0, REF_INT node1);
 
 REF_STATUS ref_collapse_edge_cad_constrained(REF_GRID ref_grid, REF_INT node0,
                                              REF_INT node1, REF_BOOL *allowed);
@@ -29,6 +29,8 @@
 
 #include <limits.h>
 
+#include "ref_glob.h"
+
 BEGIN_C_DECLORATION
 
 typedef int REF_BOOL;
@@ -53,6 +55,20 @@ typedef int REF_INT;
 #define REF_INT_MAX (INT_MAX)
 #define REF_INT_MIN (INT_MIN)
 
+typedef long REF_LONG;
+#define REF_LONG_MAX (LONG_MAX)
+
+/* global ids, global counts and file offsets, local indices stay REF_INT */
+#if defined(REF_GLOB_64)
+typedef REF_LONG REF_GLOB;
+#define REF_GLOB_MAX (LONG_MAX)
+#define REF_GLOB_FMT "%ld"
+#else
+typedef REF_INT REF_GLOB;
+#define REF_GLOB_MAX (INT_MAX)
+#define REF_GLOB_FMT "%d"
+#endif
+
 typedef double REF_DBL;
 
 typedef char REF_BYTE;
@@ -135,31 +151,31 @@ typedef int REF_STATUS;
     }                            \
   }
 
-#define REIB(a, b, msg, block)                                           \
-  {                                                                      \
-    REF_INT ref_private_status_reib_ai, ref_private_status_reib_bi;      \
-    ref_private_status_reib_ai = (a);                                    \
-    ref_private_status_reib_bi = (b);                                    \
-    if (ref_private_status_reib_ai != ref_private_status_reib_bi) {      \
-      printf("%s: %d: %s: %s\nexpected %d was %d\n", __FILE__, __LINE__, \
-             __func__, (msg), ref_private_status_reib_ai,                \
-             ref_private_status_reib_bi);                                \
-      block;                                                             \
-      return REF_FAILURE;                                                \
-    }                                                                    \
-  }
-
-#define REIS(a, b, msg)                                                  \
-  {                                                                      \
-    REF_INT ref_private_status_reis_ai, ref_private_status_reis_bi;      \
-    ref_private_status_reis_ai = (a);                                    \
-    ref_private_status_reis_bi = (b);                                    \
-    if (ref_private_status_reis_ai != ref_private_status_reis_bi) {      \
-      printf("%s: %d: %s: %s\nexpected %d was %d\n", __FILE__, __LINE__, \
-             __func__, (msg), ref_private_status_reis_ai,                \
-             ref_private_status_reis_bi);                                \
-      return REF_FAILURE;                                                \
-    }                                                                    \
+#define REIB(a, b, msg, block)                                             \
+  {                                                                        \
+    REF_LONG ref_private_status_reib_ai, ref_private_status_reib_bi;       \
+    ref_private_status_reib_ai = (a);                                      \
+    ref_private_status_reib_bi = (b);                                      \
+    if (ref_private_status_reib_ai != ref_private_status_reib_bi) {        \
+      printf("%s: %d: %s: %s\nexpected %ld was %ld\n", __FILE__, __LINE__, \
+             __func__, (msg), ref_private_status_reib_ai,                  \
+             ref_private_status_reib_bi);                                  \
+      block;                                                               \
+      return REF_FAILURE;                                                  \
+    }                                                                      \
+  }
+
+#define REIS(a, b, msg)                                                    \
+  {                                                                        \
+    REF_LONG ref_private_status_reis_ai, ref_private_status_reis_bi;       \
+    ref_private_status_reis_ai = (a);                                      \
+    ref_private_status_reis_bi = (b);                                      \
+    if (ref_private_status_reis_ai != ref_private_status_reis_bi) {        \
+      printf("%s: %d: %s: %s\nexpected %ld was %ld\n", __FILE__, __LINE__, \
+             __func__, (msg), ref_private_status_reis_ai,                  \
+             ref_private_status_reis_bi);                                  \
+      return REF_FAILURE;                                                  \
+    }                                                                      \
   }
 
 #define RWDS(a, b, tol, msg)                                                  \
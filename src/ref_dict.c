@@ -23,6 +23,24 @@
 
 #include "ref_malloc.h"
 
+/* first index with a key not less than key, keys are sorted */
+static REF_INT ref_dict_bisect(REF_DICT ref_dict, REF_INT key) {
+  REF_INT lo, hi, mid;
+  lo = 0;
+  hi = ref_dict_n(ref_dict);
+  /* keys are often stored in increasing order, append */
+  if (0 < hi && ref_dict->key[hi - 1] < key) return hi;
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (ref_dict->key[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
 REF_STATUS ref_dict_create(REF_DICT *ref_dict_ptr) {
   REF_DICT ref_dict;
 
@@ -99,22 +117,17 @@ REF_STATUS ref_dict_store(REF_DICT ref_dict, REF_INT key, REF_INT value) {
   if (0 < ref_dict_naux(ref_dict)) return REF_INVALID;
 
   if (ref_dict_max(ref_dict) == ref_dict_n(ref_dict)) {
-    ref_dict_max(ref_dict) += 1000;
+    ref_dict_max(ref_dict) *= 2;
 
     ref_realloc(ref_dict->key, ref_dict_max(ref_dict), REF_INT);
     ref_realloc(ref_dict->value, ref_dict_max(ref_dict), REF_INT);
   }
 
-  insert_point = 0;
-  for (i = ref_dict_n(ref_dict) - 1; i >= 0; i--) {
-    if (ref_dict->key[i] == key) {
-      ref_dict->value[i] = value;
-      return REF_SUCCESS;
-    }
-    if (ref_dict->key[i] < key) {
-      insert_point = i + 1;
-      break;
-    }
+  insert_point = ref_dict_bisect(ref_dict, key);
+  if (insert_point < ref_dict_n(ref_dict) &&
+      key == ref_dict->key[insert_point]) {
+    ref_dict->value[insert_point] = value;
+    return REF_SUCCESS;
   }
   /* shift to open up insert_point */
   for (i = ref_dict_n(ref_dict); i > insert_point; i--)
@@ -137,7 +150,7 @@ REF_STATUS ref_dict_store_with_aux(REF_DICT ref_dict, REF_INT key,
   if (0 == ref_dict_naux(ref_dict)) return REF_INVALID;
 
   if (ref_dict_max(ref_dict) == ref_dict_n(ref_dict)) {
-    ref_dict_max(ref_dict) += 100;
+    ref_dict_max(ref_dict) *= 2;
 
     ref_realloc(ref_dict->key, ref_dict_max(ref_dict), REF_INT);
     ref_realloc(ref_dict->value, ref_dict_max(ref_dict), REF_INT);
@@ -145,16 +158,11 @@ REF_STATUS ref_dict_store_with_aux(REF_DICT ref_dict, REF_INT key,
                 REF_DBL);
   }
 
-  insert_point = 0;
-  for (i = ref_dict_n(ref_dict) - 1; i >= 0; i--) {
-    if (ref_dict->key[i] == key) {
-      ref_dict->value[i] = value;
-      return REF_SUCCESS;
-    }
-    if (ref_dict->key[i] < key) {
-      insert_point = i + 1;
-      break;
-    }
+  insert_point = ref_dict_bisect(ref_dict, key);
+  if (insert_point < ref_dict_n(ref_dict) &&
+      key == ref_dict->key[insert_point]) {
+    ref_dict->value[insert_point] = value;
+    return REF_SUCCESS;
   }
   /* shift to open up insert_point */
   for (i = ref_dict_n(ref_dict); i > insert_point; i--) {
@@ -186,11 +194,11 @@ REF_STATUS ref_dict_location(REF_DICT ref_dict, REF_INT key,
 
   *location = REF_EMPTY;
 
-  for (i = 0; i < ref_dict_n(ref_dict); i++)
-    if (key == ref_dict->key[i]) {
-      *location = i;
-      return REF_SUCCESS;
-    }
+  i = ref_dict_bisect(ref_dict, key);
+  if (i < ref_dict_n(ref_dict) && key == ref_dict->key[i]) {
+    *location = i;
+    return REF_SUCCESS;
+  }
 
   return REF_NOT_FOUND;
 }
@@ -231,14 +239,8 @@ REF_STATUS ref_dict_value(REF_DICT ref_dict, REF_INT key, REF_INT *value) {
 }
 
 REF_BOOL ref_dict_has_key(REF_DICT ref_dict, REF_INT key) {
-  REF_INT i;
-
-  for (i = 0; i < ref_dict_n(ref_dict); i++)
-    if (key == ref_dict->key[i]) {
-      return REF_TRUE;
-    }
-
-  return REF_FALSE;
+  REF_INT location;
+  return (REF_SUCCESS == ref_dict_location(ref_dict, key, &location));
 }
 
 REF_BOOL ref_dict_has_value(REF_DICT ref_dict, REF_INT value) {
@@ -220,5 +220,35 @@ int main(void) {
     RSS(ref_dict_free(ref_dict), "free");
   }
 
+  { /* scrambled store iterates sorted, finds all, removes */
+    REF_INT i, n = 1000, key, value, key_index, last;
+    RSS(ref_dict_create(&ref_dict), "create");
+    for (i = 0; i < n; i++) {
+      key = (i * 389) % n; /* 389 is prime, visits every key once */
+      RSS(ref_dict_store(ref_dict, 3 * key, key), "store");
+      RSS(ref_dict_store(ref_dict, 3 * key, key), "store twice");
+    }
+    REIS(n, ref_dict_n(ref_dict), "count");
+    last = REF_EMPTY;
+    each_ref_dict_key_value(ref_dict, key_index, key, value) {
+      RAS(last < key, "not sorted");
+      REIS(3 * value, key, "value");
+      last = key;
+    }
+    for (key = 0; key < n; key++) {
+      RSS(ref_dict_location(ref_dict, 3 * key, &key_index), "loc");
+      REIS(3 * key, ref_dict_key(ref_dict, key_index), "key index");
+      RAS(!ref_dict_has_key(ref_dict, 3 * key + 1), "extra");
+    }
+    for (key = 0; key < n; key += 2) {
+      RSS(ref_dict_remove(ref_dict, 3 * key), "remove");
+    }
+    REIS(n / 2, ref_dict_n(ref_dict), "half");
+    for (key = 0; key < n; key++) {
+      REIS(key % 2, ref_dict_has_key(ref_dict, 3 * key), "has");
+    }
+    RSS(ref_dict_free(ref_dict), "free");
+  }
+
   return 0;
 }
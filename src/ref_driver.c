@@ -41,6 +41,7 @@
 #include "ref_part.h"
 
 #include "ref_adapt.h"
+#include "ref_census.h"
 #include "ref_gather.h"
 
 #include "ref_collapse.h"
@@ -78,6 +79,19 @@ static void echo_argv(int argc, char *argv[]) {
   printf("\n\n");
 }
 
+/* replace the census and report volume, quality and ratio from it */
+static REF_STATUS ref_driver_census(REF_GRID ref_grid,
+                                    REF_CENSUS *ref_census) {
+  if (NULL != (void *)(*ref_census))
+    RSS(ref_census_free(*ref_census), "free census");
+  RSS(ref_census_create(ref_census, ref_grid), "census");
+  RSS(ref_validation_cell_volume_census(ref_grid, *ref_census), "vol");
+  RSS(ref_histogram_quality_census(ref_grid, *ref_census), "gram");
+  RSS(ref_histogram_ratio_census(ref_grid, *ref_census), "gram");
+  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "census");
+  return REF_SUCCESS;
+}
+
 int main(int argc, char *argv[]) {
   REF_MPI ref_mpi;
   REF_GRID ref_grid = NULL;
@@ -89,23 +103,28 @@ int main(int argc, char *argv[]) {
   REF_BOOL curvature_metric = REF_TRUE;
   REF_BOOL curvature_constraint = REF_FALSE;
   REF_BOOL debug_verbose = REF_FALSE;
+  REF_BOOL collective_gather = REF_FALSE;
+  REF_INT pack_order = REF_GRID_PACK_COMPACT;
   char output_project[1004];
   char output_filename[1024];
-  REF_INT ngeom;
+  char profile_filename[1024];
+  REF_GLOB ngeom;
   REF_BOOL all_done;
+  REF_CENSUS ref_census = NULL;
 
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "make mpi");
   ref_mpi_stopwatch_start(ref_mpi);
 
   output_project[0] = '\0';
+  profile_filename[0] = '\0';
 
   if (ref_mpi_once(ref_mpi)) {
     printf("version %s, on or after 1.8.20\n", VERSION);
     echo_argv(argc, argv);
   }
 
-  while ((opt = getopt(argc, argv, "i:m:g:r:o:x:s:ltd")) != -1) {
+  while ((opt = getopt(argc, argv, "i:m:g:r:o:x:s:p:f:ltdc")) != -1) {
     switch (opt) {
       case 'i':
         if (ref_mpi_para(ref_mpi)) {
@@ -135,6 +154,23 @@ int main(int argc, char *argv[]) {
       case 's':
         passes = atoi(optarg);
         break;
+      case 'p':
+        if (0 == strcmp(optarg, "rcm")) {
+          pack_order = REF_GRID_PACK_RCM;
+        } else if (0 == strcmp(optarg, "hilbert")) {
+          pack_order = REF_GRID_PACK_HILBERT;
+        } else if (0 == strcmp(optarg, "compact")) {
+          pack_order = REF_GRID_PACK_COMPACT;
+        } else {
+          printf("unknown pack order -p %s\n", optarg);
+          printf("       [-p {compact,rcm,hilbert}] node order of pack\n");
+          return REF_INVALID;
+        }
+        break;
+      case 'f':
+        snprintf(profile_filename, 1024, "%s", optarg);
+        ref_mpi_timing(ref_mpi) = REF_TRUE;
+        break;
       case 'l':
         sanitize_metric = REF_TRUE;
         break;
@@ -145,6 +181,9 @@ int main(int argc, char *argv[]) {
         debug_verbose = REF_TRUE;
         ref_mpi->debug = REF_TRUE;
         break;
+      case 'c':
+        collective_gather = REF_TRUE;
+        break;
       case '?':
       default:
         printf("parse error -%c\n", optopt);
@@ -158,18 +197,24 @@ int main(int argc, char *argv[]) {
         printf("       [-s number_of_adaptation_sweeps] default is 15\n");
         printf("       [-o output_project]\n");
         printf("       [-x export_grid.ext]\n");
+        printf("       [-p {compact,rcm,hilbert}] node order of pack\n");
+        printf("       [-f profile.csv] per region timing report\n");
         printf("       [-l] limit metric change\n");
         printf("       [-t] tecplot movie\n");
         printf("       [-d] debug verbose\n");
+        printf("       [-c] collective MPI-IO gather\n");
         return 1;
     }
   }
 
   RNS(ref_grid, "input grid required");
   ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "read inputs");
+  ref_gather_collective(ref_grid_gather(ref_grid)) = collective_gather;
+  ref_grid_pack_order(ref_grid) = pack_order;
 
   ref_grid_adapt(ref_grid, watch_param) = REF_TRUE;
   ref_grid_adapt(ref_grid, instrument) = REF_TRUE; /* timing datails */
+  ref_grid_adapt(ref_grid, watch_topo) = debug_verbose;
   ref_grid_adapt(ref_grid, collapse_per_pass) = 5; /* timing datails */
 
   RSS(ref_gather_ngeom(ref_grid_node(ref_grid), ref_grid_geom(ref_grid),
@@ -199,56 +244,69 @@ int main(int argc, char *argv[]) {
                                          tecplot_movie),
       "show time");
 
-  RSS(ref_validation_cell_volume(ref_grid), "vol");
-  RSS(ref_histogram_quality(ref_grid), "gram");
-  RSS(ref_histogram_ratio(ref_grid), "gram");
+  RSS(ref_driver_census(ref_grid, &ref_census), "census");
 
   if (curvature_constraint) {
     if (ref_mpi_once(ref_mpi)) printf("constrain curvature\n");
     RSS(ref_metric_constrain_curvature(ref_grid), "crv const");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "crv const");
     RSS(ref_validation_cell_volume(ref_grid), "vol");
+    RSS(ref_census_free(ref_census), "stale census");
+    ref_census = NULL;
   }
   if (sanitize_metric) {
     if (ref_mpi_once(ref_mpi)) printf("sanitizing metric\n");
     RSS(ref_metric_sanitize(ref_grid), "sant metric");
-    RSS(ref_validation_cell_volume(ref_grid), "vol");
-    RSS(ref_histogram_quality(ref_grid), "gram");
-    RSS(ref_histogram_ratio(ref_grid), "gram");
+    RSS(ref_driver_census(ref_grid, &ref_census), "census");
   }
 
   for (pass = 0; pass < passes; pass++) {
     if (ref_mpi_once(ref_mpi))
       printf("\n pass %d of %d with %d ranks\n", pass + 1, passes,
              ref_mpi_n(ref_grid_mpi(ref_grid)));
-    RSS(ref_adapt_parameter(ref_grid, &all_done), "param");
+    if (NULL == ref_census)
+      RSS(ref_census_create(&ref_census, ref_grid), "census");
+    RSS(ref_adapt_parameter_census(ref_grid, ref_census, &all_done), "param");
     if (all_done) break;
     RSS(ref_adapt_pass(ref_grid), "pass");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "pass");
     if (curvature_metric) {
+      RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "curvature"), "timer");
       RSS(ref_metric_interpolated_curvature(ref_grid), "interp curve");
+      RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "curvature"), "timer");
       ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "curvature");
     }
     if (NULL != background_grid) {
+      RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "interp"), "timer");
       RSS(ref_metric_interpolate(ref_grid, background_grid), "interp");
+      RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "interp"), "timer");
       ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "interp");
     }
     if (curvature_constraint) {
+      RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "crv const"), "timer");
       RSS(ref_metric_constrain_curvature(ref_grid), "crv const");
+      RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "crv const"), "timer");
       ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "crv const");
     }
     if (sanitize_metric) {
+      RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "sanitize"), "timer");
       RSS(ref_metric_sanitize(ref_grid), "sant metric");
+      RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "sanitize"), "timer");
       ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "sant");
     }
-    RSS(ref_validation_cell_volume(ref_grid), "vol");
-    RSS(ref_histogram_quality(ref_grid), "gram");
-    RSS(ref_histogram_ratio(ref_grid), "gram");
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "balance"), "timer");
     RSS(ref_migrate_to_balance(ref_grid), "balance");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "balance"), "timer");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "balance");
+    RSS(ref_mpi_timer_start(ref_grid_mpi(ref_grid), "pack"), "timer");
     RSS(ref_grid_pack(ref_grid), "pack");
+    RSS(ref_mpi_timer_stop(ref_grid_mpi(ref_grid), "pack"), "timer");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "pack");
+    /* taken after balance, so the next pass parameters can reuse it */
+    RSS(ref_driver_census(ref_grid, &ref_census), "census");
   }
+  if (NULL != (void *)ref_census)
+    RSS(ref_census_free(ref_census), "free census");
 
   RSS(ref_geom_verify_param(ref_grid), "final params");
   ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "verify final params");
@@ -297,6 +355,10 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (strcmp(profile_filename, "") != 0) {
+    RSS(ref_mpi_timer_report(ref_mpi, profile_filename), "timer report");
+  }
+
   if (NULL != background_grid) RSS(ref_grid_free(background_grid), "free");
   if (NULL != ref_grid) RSS(ref_grid_free(ref_grid), "free");
 
@@ -24,6 +24,28 @@
 #include "ref_malloc.h"
 #include "ref_mpi.h"
 
+static REF_STATUS ref_edge_grow(REF_EDGE ref_edge) {
+  REF_INT orig, chunk, edge;
+
+  orig = ref_edge_max(ref_edge);
+  /* geometric growth for efficiency */
+  chunk = MAX(5000, (REF_INT)(1.5 * (REF_DBL)orig));
+  ref_edge_max(ref_edge) = orig + chunk;
+
+  ref_realloc(ref_edge->e2n, 2 * ref_edge_max(ref_edge), REF_INT);
+  for (edge = orig; edge < ref_edge_max(ref_edge); edge++) {
+    ref_edge_e2n(ref_edge, 0, edge) = REF_EMPTY;
+    ref_edge_e2n(ref_edge, 1, edge) = REF_EMPTY;
+  }
+  if (NULL != (void *)ref_edge->count) {
+    ref_realloc(ref_edge->count, ref_edge_max(ref_edge), REF_INT);
+    for (edge = orig; edge < ref_edge_max(ref_edge); edge++)
+      ref_edge_count(ref_edge, edge) = 0;
+  }
+
+  return REF_SUCCESS;
+}
+
 static REF_STATUS ref_edge_uniq(REF_EDGE ref_edge, REF_INT node0,
                                 REF_INT node1) {
   REF_INT edge;
@@ -31,27 +53,21 @@ static REF_STATUS ref_edge_uniq(REF_EDGE ref_edge, REF_INT node0,
   /* do nothing if we already have it */
   RXS(ref_edge_with(ref_edge, node0, node1, &edge), REF_NOT_FOUND,
       "find existing");
-  if (REF_EMPTY != edge) return REF_SUCCESS;
+  if (REF_EMPTY != edge) {
+    if (NULL != (void *)ref_edge->count) ref_edge_count(ref_edge, edge)++;
+    return REF_SUCCESS;
+  }
 
   /* incemental reallocation */
   if (ref_edge_n(ref_edge) >= ref_edge_max(ref_edge)) {
-    REF_INT orig, chunk;
-    orig = ref_edge_max(ref_edge);
-    /* geometric growth for efficiency */
-    chunk = MAX(5000, (REF_INT)(1.5 * (REF_DBL)orig));
-    ref_edge_max(ref_edge) = orig + chunk;
-
-    ref_realloc(ref_edge->e2n, 2 * ref_edge_max(ref_edge), REF_INT);
-    for (edge = orig; edge < ref_edge_max(ref_edge); edge++) {
-      ref_edge_e2n(ref_edge, 0, edge) = REF_EMPTY;
-      ref_edge_e2n(ref_edge, 1, edge) = REF_EMPTY;
-    }
+    RSS(ref_edge_grow(ref_edge), "grow");
   }
 
   edge = ref_edge_n(ref_edge);
   ref_edge_n(ref_edge)++;
   ref_edge_e2n(ref_edge, 0, edge) = node0;
   ref_edge_e2n(ref_edge, 1, edge) = node1;
+  if (NULL != (void *)ref_edge->count) ref_edge_count(ref_edge, edge) = 1;
 
   RSS(ref_adj_add(ref_edge_adj(ref_edge), ref_edge_e2n(ref_edge, 0, edge),
                   edge),
@@ -94,6 +110,11 @@ static REF_STATUS ref_edge_builder_uniq(REF_EDGE ref_edge, REF_GRID ref_grid) {
 REF_STATUS ref_edge_create(REF_EDGE *ref_edge_ptr, REF_GRID ref_grid) {
   REF_EDGE ref_edge;
 
+  if (NULL != (void *)ref_grid_edge(ref_grid)) {
+    RSS(ref_edge_deep_copy(ref_edge_ptr, ref_grid_edge(ref_grid)), "copy");
+    return REF_SUCCESS;
+  }
+
   ref_malloc(*ref_edge_ptr, 1, REF_EDGE_STRUCT);
 
   ref_edge = *ref_edge_ptr;
@@ -101,6 +122,29 @@ REF_STATUS ref_edge_create(REF_EDGE *ref_edge_ptr, REF_GRID ref_grid) {
   ref_edge_n(ref_edge) = 0;
   ref_edge_max(ref_edge) = 0;
   ref_edge->e2n = (REF_INT *)NULL;
+  ref_edge->count = (REF_INT *)NULL;
+
+  RSS(ref_adj_create(&(ref_edge_adj(ref_edge))), "create adj");
+
+  ref_edge_node(ref_edge) = ref_grid_node(ref_grid);
+
+  RSS(ref_edge_builder_uniq(ref_edge, ref_grid), "build edges");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_edge_create_counted(REF_EDGE *ref_edge_ptr, REF_GRID ref_grid) {
+  REF_EDGE ref_edge;
+
+  ref_malloc(*ref_edge_ptr, 1, REF_EDGE_STRUCT);
+
+  ref_edge = *ref_edge_ptr;
+
+  ref_edge_n(ref_edge) = 0;
+  ref_edge_max(ref_edge) = MAX(100, 8 * ref_node_n(ref_grid_node(ref_grid)));
+  ref_malloc_init(ref_edge->e2n, 2 * ref_edge_max(ref_edge), REF_INT,
+                  REF_EMPTY);
+  ref_malloc_init(ref_edge->count, ref_edge_max(ref_edge), REF_INT, 0);
 
   RSS(ref_adj_create(&(ref_edge_adj(ref_edge))), "create adj");
 
@@ -115,6 +159,7 @@ REF_STATUS ref_edge_free(REF_EDGE ref_edge) {
   if (NULL == (void *)ref_edge) return REF_NULL;
 
   RSS(ref_adj_free(ref_edge_adj(ref_edge)), "free adj");
+  ref_free(ref_edge->count);
   ref_free(ref_edge->e2n);
 
   ref_free(ref_edge);
@@ -122,6 +167,73 @@ REF_STATUS ref_edge_free(REF_EDGE ref_edge) {
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_edge_deep_copy(REF_EDGE *ref_edge_ptr, REF_EDGE original) {
+  REF_EDGE ref_edge;
+  REF_INT i;
+
+  ref_malloc(*ref_edge_ptr, 1, REF_EDGE_STRUCT);
+
+  ref_edge = *ref_edge_ptr;
+
+  ref_edge_n(ref_edge) = ref_edge_n(original);
+  ref_edge_max(ref_edge) = ref_edge_max(original);
+  ref_malloc(ref_edge->e2n, 2 * ref_edge_max(ref_edge), REF_INT);
+  for (i = 0; i < 2 * ref_edge_max(ref_edge); i++)
+    ref_edge->e2n[i] = original->e2n[i];
+  ref_edge->count = (REF_INT *)NULL;
+
+  RSS(ref_adj_deep_copy(&(ref_edge_adj(ref_edge)), ref_edge_adj(original)),
+      "copy adj");
+
+  ref_edge_node(ref_edge) = ref_edge_node(original);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_edge_add_cell_edge(REF_EDGE ref_edge, REF_INT node0,
+                                  REF_INT node1) {
+  RNS(ref_edge->count, "edges are not counted");
+  RSS(ref_edge_uniq(ref_edge, node0, node1), "add uniq");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_edge_remove_cell_edge(REF_EDGE ref_edge, REF_INT node0,
+                                     REF_INT node1) {
+  REF_INT edge, last, i;
+
+  RNS(ref_edge->count, "edges are not counted");
+  RSS(ref_edge_with(ref_edge, node0, node1, &edge), "missing edge");
+  ref_edge_count(ref_edge, edge)--;
+  if (0 < ref_edge_count(ref_edge, edge)) return REF_SUCCESS;
+
+  for (i = 0; i < 2; i++)
+    RSS(ref_adj_remove(ref_edge_adj(ref_edge), ref_edge_e2n(ref_edge, i, edge),
+                       edge),
+        "adj rm");
+
+  /* fill the hole with the last edge to stay compact */
+  last = ref_edge_n(ref_edge) - 1;
+  if (edge != last) {
+    for (i = 0; i < 2; i++) {
+      RSS(ref_adj_remove(ref_edge_adj(ref_edge),
+                         ref_edge_e2n(ref_edge, i, last), last),
+          "adj rm last");
+      ref_edge_e2n(ref_edge, i, edge) = ref_edge_e2n(ref_edge, i, last);
+      RSS(ref_adj_add(ref_edge_adj(ref_edge), ref_edge_e2n(ref_edge, i, edge),
+                      edge),
+          "adj add moved");
+    }
+    ref_edge_count(ref_edge, edge) = ref_edge_count(ref_edge, last);
+  }
+  ref_edge_e2n(ref_edge, 0, last) = REF_EMPTY;
+  ref_edge_e2n(ref_edge, 1, last) = REF_EMPTY;
+  ref_edge_count(ref_edge, last) = 0;
+  ref_edge_n(ref_edge)--;
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_edge_with(REF_EDGE ref_edge, REF_INT node0, REF_INT node1,
                          REF_INT *edge) {
   REF_INT item, ref;
@@ -141,6 +253,17 @@ REF_STATUS ref_edge_with(REF_EDGE ref_edge, REF_INT node0, REF_INT node1,
   return REF_NOT_FOUND;
 }
 
+REF_STATUS ref_edge_append(REF_EDGE ref_edge, REF_INT node0, REF_INT node1,
+                           REF_INT *edge) {
+  RXS(ref_edge_with(ref_edge, node0, node1, edge), REF_NOT_FOUND, "find");
+  if (REF_EMPTY != *edge) return REF_SUCCESS;
+
+  RSS(ref_edge_uniq(ref_edge, node0, node1), "add");
+  *edge = ref_edge_n(ref_edge) - 1;
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_edge_part(REF_EDGE ref_edge, REF_INT edge, REF_INT *part) {
   REF_NODE ref_node = ref_edge_node(ref_edge);
 
@@ -154,16 +277,33 @@ REF_STATUS ref_edge_part(REF_EDGE ref_edge, REF_INT edge, REF_INT *part) {
   return REF_SUCCESS;
 }
 
+/* widened to REF_GLOB so one exchange serves both widths */
 REF_STATUS ref_edge_ghost_int(REF_EDGE ref_edge, REF_MPI ref_mpi,
                               REF_INT *data) {
+  REF_GLOB *wide;
+  REF_INT i;
+
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+
+  ref_malloc(wide, ref_edge_n(ref_edge), REF_GLOB);
+  for (i = 0; i < ref_edge_n(ref_edge); i++) wide[i] = (REF_GLOB)data[i];
+  RSS(ref_edge_ghost_glob(ref_edge, ref_mpi, wide), "ghost glob");
+  for (i = 0; i < ref_edge_n(ref_edge); i++) data[i] = (REF_INT)wide[i];
+  ref_free(wide);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_edge_ghost_glob(REF_EDGE ref_edge, REF_MPI ref_mpi,
+                               REF_GLOB *data) {
   REF_NODE ref_node = ref_edge_node(ref_edge);
   REF_INT *a_size, *b_size;
   REF_INT a_total, b_total;
   REF_INT edge;
   REF_INT part;
   REF_INT *a_next, *a_edge;
-  REF_INT *a_nodes, *b_nodes;
-  REF_INT *a_data, *b_data;
+  REF_GLOB *a_nodes, *b_nodes;
+  REF_GLOB *a_data, *b_data;
 
   REF_INT node0, node1;
   REF_INT request;
@@ -183,14 +323,14 @@ REF_STATUS ref_edge_ghost_int(REF_EDGE ref_edge, REF_MPI ref_mpi,
 
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-  ref_malloc(a_nodes, 2 * a_total, REF_INT);
-  ref_malloc(a_data, a_total, REF_INT);
+  ref_malloc(a_nodes, 2 * a_total, REF_GLOB);
+  ref_malloc(a_data, a_total, REF_GLOB);
   ref_malloc(a_edge, a_total, REF_INT);
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-  ref_malloc(b_nodes, 2 * b_total, REF_INT);
-  ref_malloc(b_data, b_total, REF_INT);
+  ref_malloc(b_nodes, 2 * b_total, REF_GLOB);
+  ref_malloc(b_data, b_total, REF_GLOB);
 
   ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
   a_next[0] = 0;
@@ -210,7 +350,7 @@ REF_STATUS ref_edge_ghost_int(REF_EDGE ref_edge, REF_MPI ref_mpi,
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_nodes, a_size, b_nodes, b_size, 2,
-                        REF_INT_TYPE),
+                        REF_GLOB_TYPE),
       "alltoallv requested nodes");
 
   for (request = 0; request < b_total; request++) {
@@ -221,7 +361,7 @@ REF_STATUS ref_edge_ghost_int(REF_EDGE ref_edge, REF_MPI ref_mpi,
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, b_data, b_size, a_data, a_size, 1,
-                        REF_INT_TYPE),
+                        REF_GLOB_TYPE),
       "alltoallv return data");
 
   for (request = 0; request < a_total; request++) {
@@ -252,7 +392,7 @@ REF_STATUS ref_edge_ghost_dbl(REF_EDGE ref_edge, REF_MPI ref_mpi, REF_DBL *data,
   REF_INT edge;
   REF_INT part;
   REF_INT *a_next, *a_edge;
-  REF_INT *a_nodes, *b_nodes;
+  REF_GLOB *a_nodes, *b_nodes;
   REF_DBL *a_data, *b_data;
 
   REF_INT node0, node1;
@@ -274,13 +414,13 @@ REF_STATUS ref_edge_ghost_dbl(REF_EDGE ref_edge, REF_MPI ref_mpi, REF_DBL *data,
 
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-  ref_malloc(a_nodes, 2 * a_total, REF_INT);
+  ref_malloc(a_nodes, 2 * a_total, REF_GLOB);
   ref_malloc(a_data, dim * a_total, REF_DBL);
   ref_malloc(a_edge, a_total, REF_INT);
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-  ref_malloc(b_nodes, 2 * b_total, REF_INT);
+  ref_malloc(b_nodes, 2 * b_total, REF_GLOB);
   ref_malloc(b_data, dim * b_total, REF_DBL);
 
   ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
@@ -301,7 +441,7 @@ REF_STATUS ref_edge_ghost_dbl(REF_EDGE ref_edge, REF_MPI ref_mpi, REF_DBL *data,
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_nodes, a_size, b_nodes, b_size, 2,
-                        REF_INT_TYPE),
+                        REF_GLOB_TYPE),
       "alltoallv requested nodes");
 
   for (request = 0; request < b_total; request++) {
@@ -34,18 +34,31 @@ BEGIN_C_DECLORATION
 struct REF_EDGE_STRUCT {
   REF_INT n, max;
   REF_INT *e2n;
+  REF_INT *count;
   REF_ADJ adj;
   REF_NODE node;
 };
 
+/* copies the grid's counted edges when it tracks them */
 REF_STATUS ref_edge_create(REF_EDGE *ref_edge, REF_GRID ref_grid);
 REF_STATUS ref_edge_free(REF_EDGE ref_edge);
+REF_STATUS ref_edge_deep_copy(REF_EDGE *ref_edge, REF_EDGE original);
+
+/* edges with the number of cell edges that use them,
+ * kept current by ref_cell_add and ref_cell_remove */
+REF_STATUS ref_edge_create_counted(REF_EDGE *ref_edge, REF_GRID ref_grid);
+REF_STATUS ref_edge_add_cell_edge(REF_EDGE ref_edge, REF_INT node0,
+                                  REF_INT node1);
+REF_STATUS ref_edge_remove_cell_edge(REF_EDGE ref_edge, REF_INT node0,
+                                     REF_INT node1);
 
 #define ref_edge_n(ref_edge) ((ref_edge)->n)
 #define ref_edge_max(ref_edge) ((ref_edge)->max)
 
 #define ref_edge_e2n(ref_edge, node, edge) ((ref_edge)->e2n[node + 2 * edge])
 
+#define ref_edge_count(ref_edge, edge) ((ref_edge)->count[(edge)])
+
 #define ref_edge_adj(ref_edge) ((ref_edge)->adj)
 #define ref_edge_node(ref_edge) ((ref_edge)->node)
 
@@ -57,11 +70,16 @@ REF_STATUS ref_edge_free(REF_EDGE ref_edge);
 
 REF_STATUS ref_edge_with(REF_EDGE ref_edge, REF_INT node0, REF_INT node1,
                          REF_INT *edge);
+/* index of the edge, appended when missing */
+REF_STATUS ref_edge_append(REF_EDGE ref_edge, REF_INT node0, REF_INT node1,
+                           REF_INT *edge);
 
 REF_STATUS ref_edge_part(REF_EDGE ref_edge, REF_INT edge, REF_INT *part);
 
 REF_STATUS ref_edge_ghost_int(REF_EDGE ref_edge, REF_MPI ref_mpi,
                               REF_INT *data);
+REF_STATUS ref_edge_ghost_glob(REF_EDGE ref_edge, REF_MPI ref_mpi,
+                               REF_GLOB *data);
 REF_STATUS ref_edge_ghost_dbl(REF_EDGE ref_edge, REF_MPI ref_mpi, REF_DBL *data,
                               REF_INT dim);
 
@@ -32,10 +32,53 @@
 #include "ref_sort.h"
 
 #include "ref_fixture.h"
+#include "ref_malloc.h"
 #include "ref_mpi.h"
 
 #include "ref_import.h"
 
+#include "ref_adapt.h"
+#include "ref_metric.h"
+
+static REF_STATUS ref_edge_test_tracked(REF_GRID ref_grid) {
+  REF_EDGE tracked = ref_grid_edge(ref_grid);
+  REF_EDGE fresh;
+  REF_CELL ref_cell;
+  REF_INT group, cell, cell_edge, edge, other;
+  REF_INT *count;
+
+  RNS(tracked, "edges not tracked");
+  ref_grid_edge(ref_grid) = NULL;
+  RSS(ref_edge_create(&fresh, ref_grid), "fresh");
+  ref_grid_edge(ref_grid) = tracked;
+  REIS(ref_edge_n(fresh), ref_edge_n(tracked), "edge count");
+
+  ref_malloc_init(count, ref_edge_n(tracked), REF_INT, 0);
+  each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+    each_ref_cell_valid_cell(ref_cell, cell) {
+      each_ref_cell_cell_edge(ref_cell, cell_edge) {
+        RSS(ref_edge_with(tracked, ref_cell_e2n(ref_cell, 0, cell_edge, cell),
+                          ref_cell_e2n(ref_cell, 1, cell_edge, cell), &edge),
+            "tracked missing edge");
+        count[edge]++;
+      }
+    }
+  }
+  each_ref_edge(fresh, edge) {
+    RSS(ref_edge_with(tracked, ref_edge_e2n(fresh, 0, edge),
+                      ref_edge_e2n(fresh, 1, edge), &other),
+        "fresh edge not tracked");
+  }
+  each_ref_edge(tracked, edge) {
+    REIS(count[edge], ref_edge_count(tracked, edge), "use count");
+  }
+  ref_free(count);
+
+  RSS(ref_edge_free(fresh), "free");
+
+  return REF_SUCCESS;
+}
+
 int main(int argc, char *argv[]) {
   REF_MPI ref_mpi;
   RSS(ref_mpi_start(argc, argv), "start");
@@ -44,17 +87,76 @@ int main(int argc, char *argv[]) {
   if (2 == argc) {
     REF_GRID ref_grid;
     REF_EDGE ref_edge;
+    REF_INT edge, node;
+    REF_DBL *ratio;
     ref_mpi_stopwatch_start(ref_mpi);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, argv[1]), "examine header");
     ref_mpi_stopwatch_stop(ref_mpi, "import");
     RSS(ref_edge_create(&ref_edge, ref_grid), "create");
     ref_mpi_stopwatch_stop(ref_mpi, "create");
+    /* vary the metric so the log mean path is exercised */
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      ref_node_metric(ref_grid_node(ref_grid), 0, node) =
+          1.0 + (REF_DBL)(node % 10);
+    }
+    ref_malloc(ratio, ref_edge_n(ref_edge), REF_DBL);
+    for (edge = 0; edge < ref_edge_n(ref_edge); edge++)
+      RSS(ref_node_ratio(ref_grid_node(ref_grid),
+                         ref_edge_e2n(ref_edge, 0, edge),
+                         ref_edge_e2n(ref_edge, 1, edge), &(ratio[edge])),
+          "ratio");
+    ref_mpi_stopwatch_stop(ref_mpi, "ratio");
+    RSS(ref_node_ratio_many(ref_grid_node(ref_grid), ref_edge_n(ref_edge),
+                            &ref_edge_e2n(ref_edge, 0, 0), ratio),
+        "ratio many");
+    ref_mpi_stopwatch_stop(ref_mpi, "ratio many");
+    ref_free(ratio);
     RSS(ref_edge_free(ref_edge), "free");
     RSS(ref_grid_free(ref_grid), "free");
     RSS(ref_mpi_free(ref_mpi), "free");
     return 0;
   }
 
+  { /* tracked edges follow cell add, remove, and replace */
+    REF_GRID ref_grid;
+    REF_CELL ref_cell;
+    REF_INT nodes[REF_CELL_MAX_SIZE_PER], cell, node, orig;
+
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+    ref_cell = ref_grid_tet(ref_grid);
+    RSS(ref_grid_track_edges(ref_grid), "track");
+    RSS(ref_edge_test_tracked(ref_grid), "initial");
+
+    RSS(ref_cell_nodes(ref_cell, 0, nodes), "nodes");
+    RSS(ref_cell_remove(ref_cell, 0), "remove");
+    RSS(ref_edge_test_tracked(ref_grid), "remove");
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add");
+    RSS(ref_edge_test_tracked(ref_grid), "add");
+
+    RSS(ref_node_add(ref_grid_node(ref_grid), 1000, &node), "new node");
+    orig = nodes[0];
+    nodes[0] = node;
+    RSS(ref_cell_replace_whole(ref_cell, cell, nodes), "replace whole");
+    RSS(ref_edge_test_tracked(ref_grid), "replace whole");
+    RSS(ref_cell_replace_node(ref_cell, node, orig), "replace node");
+    RSS(ref_edge_test_tracked(ref_grid), "replace node");
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* tracked edges follow an adapt pass */
+    REF_GRID ref_grid;
+
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+    RSS(ref_metric_olympic_node(ref_grid_node(ref_grid), 0.05), "olympic");
+    RSS(ref_adapt_pass(ref_grid), "pass");
+    RSS(ref_edge_test_tracked(ref_grid), "after pass");
+    RSS(ref_grid_pack(ref_grid), "pack");
+    RSS(ref_edge_test_tracked(ref_grid), "after pack");
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   { /* make edges shared by two elements */
     REF_EDGE ref_edge;
     REF_GRID ref_grid;
@@ -102,6 +204,28 @@ int main(int argc, char *argv[]) {
     RSS(ref_grid_free(ref_grid), "free");
   }
 
+  if (!ref_mpi_para(ref_mpi)) { /* append missing edge */
+    REF_EDGE ref_edge;
+    REF_GRID ref_grid;
+    REF_INT edge, n;
+
+    RSS(ref_fixture_pri_grid(&ref_grid, ref_mpi), "pri");
+    RSS(ref_edge_create(&ref_edge, ref_grid), "create");
+    n = ref_edge_n(ref_edge);
+
+    RSS(ref_edge_append(ref_edge, 0, 1, &edge), "existing");
+    REIS(0, edge, "existing index");
+    REIS(n, ref_edge_n(ref_edge), "existing not added");
+    RSS(ref_edge_append(ref_edge, 0, 4, &edge), "missing");
+    REIS(n, edge, "appended index");
+    REIS(n + 1, ref_edge_n(ref_edge), "appended");
+    RSS(ref_edge_with(ref_edge, 4, 0, &edge), "find appended");
+    REIS(n, edge, "found appended");
+
+    RSS(ref_edge_free(ref_edge), "edge");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   { /* ref_edge_ghost */
     REF_EDGE ref_edge;
     REF_GRID ref_grid;
@@ -44,6 +44,9 @@ REF_STATUS ref_elast_create(REF_ELAST *ref_elast_ptr, REF_GRID ref_grid) {
   ref_malloc_init(ref_elast->a,
                   3 * 3 * ref_comprow_nnz(ref_elast_comprow(ref_elast)),
                   REF_DBL, 0.0);
+  ref_malloc_init(ref_elast->diag_inv,
+                  3 * 3 * ref_comprow_max(ref_elast_comprow(ref_elast)),
+                  REF_DBL, 0.0);
 
   ref_malloc_init(ref_elast->displacement,
                   3 * ref_comprow_max(ref_elast_comprow(ref_elast)), REF_DBL,
@@ -59,6 +62,7 @@ REF_STATUS ref_elast_free(REF_ELAST ref_elast) {
 
   ref_free(ref_elast->bc);
   ref_free(ref_elast->displacement);
+  ref_free(ref_elast->diag_inv);
   ref_free(ref_elast->a);
   ref_comprow_free(ref_elast->ref_comprow);
 
@@ -501,6 +505,14 @@ REF_STATUS ref_elast_assemble(REF_ELAST ref_elast) {
     }
   }
 
+  /* factor the diagonal blocks once for every sweep or iteration */
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(ref_comprow_entry(ref_comprow, node, node, &entry), "diag");
+    RSS(ref_matrix_inv_gen(3, &(ref_elast->a[9 * entry]),
+                           &(ref_elast->diag_inv[9 * node])),
+        "inv diag");
+  }
+
   /* to set ghost node bc's */
   RSS(ref_node_ghost_int(ref_node, ref_elast->bc), "ghost bcs");
   RSS(ref_node_ghost_dbl(ref_node, ref_elast->displacement, 3), "ghost disp");
@@ -513,34 +525,35 @@ REF_STATUS ref_elast_relax(REF_ELAST ref_elast, REF_DBL *l2norm) {
   REF_GRID ref_grid = ref_elast_grid(ref_elast);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
-  double ab[12];
-  int entry, row, col, i, j;
+  double b[3], *inv;
+  int entry, row, col, i;
 
   *l2norm = 0.0;
   each_ref_node_valid_node(ref_node, row) {
     if (ref_node_owned(ref_node, row) && 0 == ref_elast->bc[row]) {
-      ab[9] = ab[10] = ab[11] = 0.0;
+      b[0] = b[1] = b[2] = 0.0;
       each_ref_comprow_row_entry(ref_comprow, row, entry) {
         col = ref_comprow->col[entry];
         if (row != col) {
           for (i = 0; i < 3; i++) {
-            ab[9 + i] -= (ref_elast->a[i + 0 * 3 + 9 * entry] *
-                              ref_elast->displacement[0 + 3 * col] +
-                          ref_elast->a[i + 1 * 3 + 9 * entry] *
-                              ref_elast->displacement[1 + 3 * col] +
-                          ref_elast->a[i + 2 * 3 + 9 * entry] *
-                              ref_elast->displacement[2 + 3 * col]);
+            b[i] -= (ref_elast->a[i + 0 * 3 + 9 * entry] *
+                         ref_elast->displacement[0 + 3 * col] +
+                     ref_elast->a[i + 1 * 3 + 9 * entry] *
+                         ref_elast->displacement[1 + 3 * col] +
+                     ref_elast->a[i + 2 * 3 + 9 * entry] *
+                         ref_elast->displacement[2 + 3 * col]);
           }
         }
       }
-      RSS(ref_comprow_entry(ref_comprow, row, row, &entry), "diag");
-      for (i = 0; i < 3; i++)
-        for (j = 0; j < 3; j++)
-          ab[i + 3 * j] = ref_elast->a[i + j * 3 + 9 * entry];
-      RSS(ref_matrix_solve_ab(3, 4, ab), "solve");
-      for (i = 0; i < 3; i++)
-        *l2norm += pow(ref_elast->displacement[i + 3 * row] - ab[9 + i], 2);
-      for (i = 0; i < 3; i++) ref_elast->displacement[i + 3 * row] = ab[9 + i];
+      inv = &(ref_elast->diag_inv[9 * row]);
+      for (i = 0; i < 3; i++) {
+        *l2norm += pow(ref_elast->displacement[i + 3 * row] -
+                           (inv[i + 0] * b[0] + inv[i + 3] * b[1] +
+                            inv[i + 6] * b[2]),
+                       2);
+        ref_elast->displacement[i + 3 * row] =
+            inv[i + 0] * b[0] + inv[i + 3] * b[1] + inv[i + 6] * b[2];
+      }
     }
   }
   RSS(ref_node_ghost_dbl(ref_node, ref_elast->displacement, 3), "ghost disp");
@@ -551,3 +564,175 @@ REF_STATUS ref_elast_relax(REF_ELAST ref_elast, REF_DBL *l2norm) {
 
   return REF_SUCCESS;
 }
+
+#define ref_elast_free_row(ref_elast, ref_node, row)                   \
+  (ref_node_valid(ref_node, row) && ref_node_owned(ref_node, row) && \
+   0 == (ref_elast)->bc[(row)])
+
+/* y = A v on the free rows and zero elsewhere, updates ghosts of v */
+static REF_STATUS ref_elast_multiply(REF_ELAST ref_elast, REF_DBL *v,
+                                     REF_DBL *y) {
+  REF_COMPROW ref_comprow = ref_elast_comprow(ref_elast);
+  REF_NODE ref_node = ref_grid_node(ref_elast_grid(ref_elast));
+  REF_INT row, entry, col, i;
+
+  RSS(ref_node_ghost_dbl(ref_node, v, 3), "ghost v");
+#ifdef _OPENMP
+#pragma omp parallel for private(entry, col, i)
+#endif
+  for (row = 0; row < ref_node_max(ref_node); row++) {
+    for (i = 0; i < 3; i++) y[i + 3 * row] = 0.0;
+    if (!ref_elast_free_row(ref_elast, ref_node, row)) continue;
+    each_ref_comprow_row_entry(ref_comprow, row, entry) {
+      col = ref_comprow->col[entry];
+      for (i = 0; i < 3; i++)
+        y[i + 3 * row] += ref_elast->a[i + 0 * 3 + 9 * entry] * v[0 + 3 * col] +
+                          ref_elast->a[i + 1 * 3 + 9 * entry] * v[1 + 3 * col] +
+                          ref_elast->a[i + 2 * 3 + 9 * entry] * v[2 + 3 * col];
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+/* z = D^-1 r with the cached inverse diagonal blocks */
+static REF_STATUS ref_elast_precondition(REF_ELAST ref_elast, REF_DBL *r,
+                                         REF_DBL *z) {
+  REF_NODE ref_node = ref_grid_node(ref_elast_grid(ref_elast));
+  REF_DBL *inv;
+  REF_INT row, i;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(inv, i)
+#endif
+  for (row = 0; row < ref_node_max(ref_node); row++) {
+    for (i = 0; i < 3; i++) z[i + 3 * row] = 0.0;
+    if (!ref_elast_free_row(ref_elast, ref_node, row)) continue;
+    inv = &(ref_elast->diag_inv[9 * row]);
+    for (i = 0; i < 3; i++)
+      z[i + 3 * row] = inv[i + 0] * r[0 + 3 * row] +
+                       inv[i + 3] * r[1 + 3 * row] +
+                       inv[i + 6] * r[2 + 3 * row];
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_elast_dot(REF_ELAST ref_elast, REF_DBL *a, REF_DBL *b,
+                                REF_DBL *dot) {
+  REF_NODE ref_node = ref_grid_node(ref_elast_grid(ref_elast));
+  REF_MPI ref_mpi = ref_grid_mpi(ref_elast_grid(ref_elast));
+  REF_DBL sum = 0.0;
+  REF_INT row;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : sum)
+#endif
+  for (row = 0; row < ref_node_max(ref_node); row++) {
+    if (!ref_elast_free_row(ref_elast, ref_node, row)) continue;
+    sum += a[0 + 3 * row] * b[0 + 3 * row] + a[1 + 3 * row] * b[1 + 3 * row] +
+           a[2 + 3 * row] * b[2 + 3 * row];
+  }
+  RSS(ref_mpi_allsum(ref_mpi, &sum, 1, REF_DBL_TYPE), "sum dot");
+  *dot = sum;
+
+  return REF_SUCCESS;
+}
+
+#define REF_ELAST_RESTART (30)
+
+REF_STATUS ref_elast_solve(REF_ELAST ref_elast, REF_DBL tol, REF_INT max_iter,
+                           REF_DBL *l2norm) {
+  REF_NODE ref_node = ref_grid_node(ref_elast_grid(ref_elast));
+  REF_INT m = REF_ELAST_RESTART;
+  REF_INT n = 3 * ref_node_max(ref_node);
+  REF_DBL *x = ref_elast->displacement;
+  REF_DBL *v, *w, *z;
+  REF_DBL h[(REF_ELAST_RESTART + 1) * REF_ELAST_RESTART];
+  REF_DBL g[REF_ELAST_RESTART + 1], y[REF_ELAST_RESTART];
+  REF_DBL cs[REF_ELAST_RESTART], sn[REF_ELAST_RESTART];
+  REF_DBL beta, initial, residual, temp;
+  REF_INT iter, i, j, k, nkrylov;
+
+  ref_malloc_init(v, n * (m + 1), REF_DBL, 0.0);
+  ref_malloc_init(w, n, REF_DBL, 0.0);
+  ref_malloc_init(z, n, REF_DBL, 0.0);
+
+  initial = -1.0;
+  residual = 0.0;
+  iter = 0;
+  while (REF_TRUE) {
+    /* the right hand side is zero on the free rows, r = -A x */
+    RSS(ref_elast_multiply(ref_elast, x, w), "A x");
+    for (i = 0; i < n; i++) w[i] = -w[i];
+    RSS(ref_elast_dot(ref_elast, w, w, &beta), "beta");
+    beta = sqrt(beta);
+    if (initial < 0.0) initial = beta;
+    residual = beta;
+    if (beta <= tol * initial || 0.0 == beta || iter >= max_iter) break;
+
+    for (i = 0; i < n; i++) v[i] = w[i] / beta;
+    for (j = 0; j <= m; j++) g[j] = 0.0;
+    g[0] = beta;
+
+    nkrylov = 0;
+    for (j = 0; j < m && iter < max_iter; j++) {
+      RSS(ref_elast_precondition(ref_elast, &(v[n * j]), z), "M^-1 v");
+      RSS(ref_elast_multiply(ref_elast, z, w), "A M^-1 v");
+      /* modified Gram-Schmidt */
+      for (k = 0; k <= j; k++) {
+        RSS(ref_elast_dot(ref_elast, w, &(v[n * k]), &(h[k + (m + 1) * j])),
+            "h");
+        for (i = 0; i < n; i++) w[i] -= h[k + (m + 1) * j] * v[i + n * k];
+      }
+      RSS(ref_elast_dot(ref_elast, w, w, &temp), "norm w");
+      h[j + 1 + (m + 1) * j] = sqrt(temp);
+      if (0.0 < h[j + 1 + (m + 1) * j])
+        for (i = 0; i < n; i++)
+          v[i + n * (j + 1)] = w[i] / h[j + 1 + (m + 1) * j];
+
+      /* reduce the hessenberg column with givens rotations */
+      for (k = 0; k < j; k++) {
+        temp = cs[k] * h[k + (m + 1) * j] + sn[k] * h[k + 1 + (m + 1) * j];
+        h[k + 1 + (m + 1) * j] =
+            -sn[k] * h[k + (m + 1) * j] + cs[k] * h[k + 1 + (m + 1) * j];
+        h[k + (m + 1) * j] = temp;
+      }
+      temp = sqrt(h[j + (m + 1) * j] * h[j + (m + 1) * j] +
+                  h[j + 1 + (m + 1) * j] * h[j + 1 + (m + 1) * j]);
+      RAS(0.0 < temp, "GMRES breakdown");
+      cs[j] = h[j + (m + 1) * j] / temp;
+      sn[j] = h[j + 1 + (m + 1) * j] / temp;
+      h[j + (m + 1) * j] = temp;
+      h[j + 1 + (m + 1) * j] = 0.0;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+
+      iter++;
+      nkrylov = j + 1;
+      residual = ABS(g[j + 1]);
+      if (residual <= tol * initial) break;
+    }
+
+    /* back substitute and correct x by M^-1 V y */
+    for (k = nkrylov - 1; k >= 0; k--) {
+      y[k] = g[k];
+      for (j = k + 1; j < nkrylov; j++) y[k] -= h[k + (m + 1) * j] * y[j];
+      y[k] /= h[k + (m + 1) * k];
+    }
+    for (i = 0; i < n; i++) w[i] = 0.0;
+    for (k = 0; k < nkrylov; k++)
+      for (i = 0; i < n; i++) w[i] += y[k] * v[i + n * k];
+    RSS(ref_elast_precondition(ref_elast, w, z), "M^-1 V y");
+    for (i = 0; i < n; i++) x[i] += z[i];
+    RSS(ref_node_ghost_dbl(ref_node, x, 3), "ghost disp");
+  }
+
+  ref_free(z);
+  ref_free(w);
+  ref_free(v);
+
+  *l2norm = residual / sqrt((REF_DBL)ref_node_n_global(ref_node));
+
+  return REF_SUCCESS;
+}
@@ -35,6 +35,7 @@ struct REF_ELAST_STRUCT {
   REF_GRID ref_grid;
   REF_COMPROW ref_comprow;
   REF_DBL *a;
+  REF_DBL *diag_inv;
   REF_DBL *displacement;
   REF_INT *bc;
 };
@@ -52,6 +53,11 @@ REF_STATUS ref_elast_assemble(REF_ELAST ref_elast);
 
 REF_STATUS ref_elast_relax(REF_ELAST ref_elast, REF_DBL *l2norm);
 
+/* restarted GMRES preconditioned by the inverse diagonal blocks,
+ * stops when the residual drops by tol or after max_iter iterations */
+REF_STATUS ref_elast_solve(REF_ELAST ref_elast, REF_DBL tol, REF_INT max_iter,
+                           REF_DBL *l2norm);
+
 END_C_DECLORATION
 
 #endif /* REF_ELAST_H */
@@ -30,7 +30,7 @@
   ref_node_xyz(ref_node, 0, local[(node)]) = (x);                            \
   ref_node_xyz(ref_node, 1, local[(node)]) = (y);                            \
   ref_node_xyz(ref_node, 2, local[(node)]) = (z);                            \
-  ref_node_part(ref_node, local[(node)]) = ref_part_implicit(                \
+  ref_node_part(ref_node, local[(node)]) = (REF_INT)ref_part_implicit(       \
       nnodesg, ref_mpi_n(ref_mpi), ref_node_global(ref_node, local[(node)]));
 
 REF_STATUS ref_fixture_tet_grid(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi) {
@@ -1117,3 +1117,20 @@ REF_STATUS ref_fixture_twod_brick_grid(REF_GRID *ref_grid_ptr,
 
   return REF_SUCCESS;
 }
+
+REF_STATUS ref_fixture_same_file(const char *filename0, const char *filename1) {
+  FILE *file0, *file1;
+  int char0, char1;
+  file0 = fopen(filename0, "r");
+  RNS(file0, "unable to open file0");
+  file1 = fopen(filename1, "r");
+  RNS(file1, "unable to open file1");
+  do {
+    char0 = fgetc(file0);
+    char1 = fgetc(file1);
+    REIS(char0, char1, "files differ");
+  } while (EOF != char0);
+  fclose(file1);
+  fclose(file0);
+  return REF_SUCCESS;
+}
@@ -39,6 +39,9 @@ REF_STATUS ref_fixture_hex_grid(REF_GRID *ref_grid, REF_MPI ref_mpi);
 REF_STATUS ref_fixture_tet_brick_grid(REF_GRID *ref_grid, REF_MPI ref_mpi);
 REF_STATUS ref_fixture_twod_brick_grid(REF_GRID *ref_grid, REF_MPI ref_mpi);
 
+/* byte for byte comparison of two files written by a test */
+REF_STATUS ref_fixture_same_file(const char *filename0, const char *filename1);
+
 END_C_DECLORATION
 
 #endif /* REF_FIXTURE_H */
@@ -35,20 +35,154 @@
 #include "ref_gather.h"
 #include "ref_histogram.h"
 
+#define REF_FORTRAN_MAX_HANDLE (8)
+
+/* grids are held in handle slots, calls act on the selected slot,
+ * the node compaction for read back is kept until the grid changes */
 static REF_MPI ref_mpi = NULL;
-static REF_GRID ref_grid = NULL;
+static REF_INT ref_fortran_current = 0;
+static REF_GRID ref_fortran_grids[REF_FORTRAN_MAX_HANDLE];
+static REF_INT *ref_fortran_o2n[REF_FORTRAN_MAX_HANDLE];
+static REF_INT *ref_fortran_n2o[REF_FORTRAN_MAX_HANDLE];
+static REF_BOOL ref_fortran_packed[REF_FORTRAN_MAX_HANDLE];
 
 REF_BOOL ref_fortran_allow_screen_output = REF_TRUE;
 
+/* calls that change nodes or cells drop the compaction and packing */
+static REF_STATUS ref_fortran_changed(void) {
+  ref_free(ref_fortran_n2o[ref_fortran_current]);
+  ref_free(ref_fortran_o2n[ref_fortran_current]);
+  ref_fortran_n2o[ref_fortran_current] = NULL;
+  ref_fortran_o2n[ref_fortran_current] = NULL;
+  ref_fortran_packed[ref_fortran_current] = REF_FALSE;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_fortran_compact(REF_INT **o2n, REF_INT **n2o) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  RNS(ref_grid, "no grid for selected handle");
+  if (NULL == ref_fortran_o2n[ref_fortran_current])
+    RSS(ref_node_compact(ref_grid_node(ref_grid),
+                         &(ref_fortran_o2n[ref_fortran_current]),
+                         &(ref_fortran_n2o[ref_fortran_current])),
+        "compact");
+  *o2n = ref_fortran_o2n[ref_fortran_current];
+  *n2o = ref_fortran_n2o[ref_fortran_current];
+  return REF_SUCCESS;
+}
+
+/* owned nodes first and no holes, so views need no compaction */
+static REF_STATUS ref_fortran_pack(void) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_INT order;
+  RNS(ref_grid, "no grid for selected handle");
+  if (ref_fortran_packed[ref_fortran_current]) return REF_SUCCESS;
+  RSS(ref_fortran_changed(), "renumbered");
+  order = ref_grid_pack_order(ref_grid);
+  ref_grid_pack_order(ref_grid) = REF_GRID_PACK_COMPACT;
+  RSS(ref_grid_pack(ref_grid), "pack");
+  ref_grid_pack_order(ref_grid) = order;
+  ref_fortran_packed[ref_fortran_current] = REF_TRUE;
+  return REF_SUCCESS;
+}
+
+REF_STATUS REF_FORT_(ref_fortran_handle, REF_FORTRAN_HANDLE)(REF_INT *handle) {
+  RAS(0 <= *handle && *handle < REF_FORTRAN_MAX_HANDLE, "handle out of range");
+  ref_fortran_current = *handle;
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_fortran_adopt_node(REF_INT nnodes, REF_GLOB nnodesg,
+                                  REF_GLOB *global, REF_INT *part,
+                                  REF_DBL *real) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  RAS(NULL == ref_grid, "handle in use");
+  if (NULL == ref_mpi) RSS(ref_mpi_create(&ref_mpi), "create mpi");
+  RSS(ref_grid_create(&ref_grid, ref_mpi), "create grid");
+  ref_fortran_grids[ref_fortran_current] = ref_grid;
+  RSS(ref_fortran_changed(), "new grid");
+  RSS(ref_node_initialize_n_global(ref_grid_node(ref_grid), nnodesg),
+      "init nnodesg");
+  RSS(ref_node_adopt(ref_grid_node(ref_grid), nnodes, global, part, real),
+      "adopt nodes");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_fortran_adopt_cell(REF_INT node_per_cell, REF_INT ncell,
+                                  REF_INT *c2n) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_CELL ref_cell;
+  RNS(ref_grid, "no grid for selected handle");
+  RSS(ref_fortran_changed(), "changed");
+  RSS(ref_grid_cell_with(ref_grid, node_per_cell, &ref_cell), "get cell");
+  RSS(ref_cell_adopt(ref_cell, ncell, c2n), "adopt cells");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_fortran_adopt_face(REF_INT node_per_face, REF_INT nface,
+                                  REF_INT *f2n) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_CELL ref_cell;
+  RNS(ref_grid, "no grid for selected handle");
+  RSS(ref_fortran_changed(), "changed");
+  RSS(ref_grid_face_with(ref_grid, node_per_face, &ref_cell), "get face");
+  RSS(ref_cell_adopt(ref_cell, nface, f2n), "adopt faces");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_fortran_view_node(REF_INT *nnodes0, REF_INT *nnodes,
+                                 REF_GLOB **global, REF_INT **part,
+                                 REF_DBL **real) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_NODE ref_node;
+  REF_INT node;
+  RSS(ref_fortran_pack(), "pack");
+  ref_node = ref_grid_node(ref_grid);
+  *nnodes = ref_node_n(ref_node);
+  *nnodes0 = 0;
+  for (node = 0; node < ref_node_n(ref_node); node++)
+    if (ref_node_owned(ref_node, node)) (*nnodes0)++;
+  *global = ref_node->global;
+  *part = ref_node->part;
+  *real = ref_node->real;
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_fortran_view_cell(REF_INT node_per_cell, REF_INT *ncell,
+                                 REF_INT **c2n) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_CELL ref_cell;
+  RSS(ref_fortran_pack(), "pack");
+  RSS(ref_grid_cell_with(ref_grid, node_per_cell, &ref_cell), "get cell");
+  *ncell = ref_cell_n(ref_cell);
+  *c2n = ref_cell->c2n;
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_fortran_view_face(REF_INT node_per_face, REF_INT *nface,
+                                 REF_INT **f2n) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_CELL ref_cell;
+  RSS(ref_fortran_pack(), "pack");
+  RSS(ref_grid_face_with(ref_grid, node_per_face, &ref_cell), "get face");
+  *nface = ref_cell_n(ref_cell);
+  *f2n = ref_cell->c2n;
+  return REF_SUCCESS;
+}
+
 REF_STATUS REF_FORT_(ref_fortran_init,
                      REF_FORTRAN_INIT)(REF_INT *nnodes, REF_INT *nnodesg,
                                        REF_INT *l2g, REF_INT *part,
                                        REF_INT *partition, REF_DBL *x,
                                        REF_DBL *y, REF_DBL *z) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node;
   REF_INT node, pos;
-  RSS(ref_mpi_create(&ref_mpi), "create mpi");
+  RAS(NULL == ref_grid, "handle in use");
+  if (NULL == ref_mpi) RSS(ref_mpi_create(&ref_mpi), "create mpi");
   RSS(ref_grid_create(&ref_grid, ref_mpi), "create grid");
+  ref_fortran_grids[ref_fortran_current] = ref_grid;
+  RSS(ref_fortran_changed(), "new grid");
   ref_node = ref_grid_node(ref_grid);
 
   ref_mpi_stopwatch_start(ref_grid_mpi(ref_grid));
@@ -72,10 +206,12 @@ REF_STATUS REF_FORT_(ref_fortran_init,
 REF_STATUS REF_FORT_(ref_fortran_import_cell,
                      REF_FORTRAN_IMPORT_CELL)(REF_INT *node_per_cell,
                                               REF_INT *ncell, REF_INT *c2n) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_CELL ref_cell;
   REF_INT cell, node, new_cell;
 
+  RSS(ref_fortran_changed(), "changed");
   RSS(ref_grid_cell_with(ref_grid, *node_per_cell, &ref_cell), "get cell");
 
   for (cell = 0; cell < (*ncell); cell++) {
@@ -91,12 +227,14 @@ REF_STATUS REF_FORT_(ref_fortran_import_face,
                      REF_FORTRAN_IMPORT_FACE)(REF_INT *face_index,
                                               REF_INT *node_per_face,
                                               REF_INT *nface, REF_INT *f2n) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT *nodes;
   REF_CELL ref_cell;
   REF_INT face, node, new_face;
   REF_BOOL has_a_local_node;
 
+  RSS(ref_fortran_changed(), "changed");
   RSS(ref_grid_face_with(ref_grid, *node_per_face, &ref_cell), "get face");
 
   nodes = (REF_INT *)malloc(((*node_per_face) + 1) * sizeof(REF_INT));
@@ -118,6 +256,7 @@ REF_STATUS REF_FORT_(ref_fortran_import_face,
 }
 
 REF_STATUS REF_FORT_(ref_fortran_viz, REF_FORTRAN_VIZ)(void) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   char filename[1024];
   sprintf(filename, "ref_viz%04d.vtk", ref_mpi_rank(ref_grid_mpi(ref_grid)));
   RSS(ref_export_vtk(ref_grid, filename), "export vtk");
@@ -127,8 +266,9 @@ REF_STATUS REF_FORT_(ref_fortran_viz, REF_FORTRAN_VIZ)(void) {
 }
 
 REF_STATUS REF_FORT_(ref_fortran_adapt, REF_FORTRAN_ADAPT)(void) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_INT passes, i;
-  REF_INT ntet, npri;
+  REF_GLOB ntet, npri;
 
   RSS(ref_gather_ncell(ref_grid_node(ref_grid), ref_grid_tet(ref_grid), &ntet),
       "ntet");
@@ -163,6 +303,8 @@ REF_STATUS REF_FORT_(ref_fortran_adapt, REF_FORTRAN_ADAPT)(void) {
   RSS(ref_validation_cell_volume(ref_grid), "vol");
   RSS(ref_histogram_ratio(ref_grid), "gram");
 
+  RSS(ref_fortran_changed(), "changed");
+
   passes = 20;
   for (i = 0; i < passes; i++) {
     RSS(ref_adapt_pass(ref_grid), "pass");
@@ -172,7 +314,7 @@ REF_STATUS REF_FORT_(ref_fortran_adapt, REF_FORTRAN_ADAPT)(void) {
     RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync g");
     if (500000 > ref_node_n_global(ref_grid_node(ref_grid))) {
       if (ref_grid_once(ref_grid))
-        printf("use single parition under 0.5M nodes %d\n",
+        printf("use single parition under 0.5M nodes " REF_GLOB_FMT "\n",
                ref_node_n_global(ref_grid_node(ref_grid)));
       RSS(ref_migrate_to_single_image(ref_grid), "balance");
     } else {
@@ -186,6 +328,7 @@ REF_STATUS REF_FORT_(ref_fortran_adapt, REF_FORTRAN_ADAPT)(void) {
 
 REF_STATUS REF_FORT_(ref_fortran_import_metric,
                      REF_FORTRAN_IMPORT_METRIC)(REF_INT *nnodes, REF_DBL *m) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_INT node, i;
   REF_NODE ref_node = ref_grid_node(ref_grid);
 
@@ -199,6 +342,7 @@ REF_STATUS REF_FORT_(ref_fortran_import_metric,
 REF_STATUS REF_FORT_(ref_fortran_import_ratio,
                      REF_FORTRAN_IMPORT_RATIO)(REF_INT *nnodes,
                                                REF_DBL *ratio) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_SUBDIV ref_subdiv;
 
   REIS(*nnodes, ref_node_n(ref_grid_node(ref_grid)), "nnode mismatch");
@@ -206,6 +350,7 @@ REF_STATUS REF_FORT_(ref_fortran_import_ratio,
   if (ref_fortran_allow_screen_output)
     RSS(ref_validation_cell_volume(ref_grid), "vol");
 
+  RSS(ref_fortran_changed(), "changed");
   RSS(ref_subdiv_create(&ref_subdiv, ref_grid), "create");
   RSS(ref_subdiv_mark_prism_by_ratio(ref_subdiv, ratio), "mark ratio");
   RSS(ref_subdiv_split(ref_subdiv), "split");
@@ -220,13 +365,16 @@ REF_STATUS REF_FORT_(ref_fortran_import_ratio,
 REF_STATUS REF_FORT_(ref_fortran_size_node,
                      REF_FORTRAN_SIZE_NODE)(REF_INT *nnodes0, REF_INT *nnodes,
                                             REF_INT *nnodesg) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT node;
 
   RSS(ref_node_synchronize_globals(ref_node), "sync glob");
 
+  /* the fortran interface is default integer width */
+  RAS(ref_node_n_global(ref_node) <= REF_INT_MAX, "nnodesg exceeds integer");
   *nnodes = ref_node_n(ref_node);
-  *nnodesg = ref_node_n_global(ref_node);
+  *nnodesg = (REF_INT)ref_node_n_global(ref_node);
 
   *nnodes0 = 0;
 
@@ -240,21 +388,19 @@ REF_STATUS REF_FORT_(ref_fortran_size_node,
 REF_STATUS REF_FORT_(ref_fortran_node,
                      REF_FORTRAN_NODE)(REF_INT *nnodes, REF_INT *l2g,
                                        REF_DBL *x, REF_DBL *y, REF_DBL *z) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT *o2n, *n2o, node;
 
-  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+  RSS(ref_fortran_compact(&o2n, &n2o), "compact");
 
   for (node = 0; node < ref_node_n(ref_node); node++) {
-    l2g[node] = ref_node_global(ref_node, n2o[node]) + 1;
+    l2g[node] = (REF_INT)ref_node_global(ref_node, n2o[node]) + 1;
     x[node] = ref_node_xyz(ref_node, 0, n2o[node]);
     y[node] = ref_node_xyz(ref_node, 1, n2o[node]);
     z[node] = ref_node_xyz(ref_node, 2, n2o[node]);
   }
 
-  ref_free(n2o);
-  ref_free(o2n);
-
   REIS(*nnodes, ref_node_n(ref_node), "nnode mismatch");
 
   return REF_SUCCESS;
@@ -263,6 +409,7 @@ REF_STATUS REF_FORT_(ref_fortran_node,
 REF_STATUS REF_FORT_(ref_fortran_size_cell,
                      REF_FORTRAN_SIZE_CELL)(REF_INT *node_per_cell,
                                             REF_INT *ncell) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_CELL ref_cell;
 
   RSS(ref_grid_cell_with(ref_grid, *node_per_cell, &ref_cell), "get cell");
@@ -274,13 +421,13 @@ REF_STATUS REF_FORT_(ref_fortran_size_cell,
 REF_STATUS REF_FORT_(ref_fortran_cell, REF_FORTRAN_CELL)(REF_INT *node_per_cell,
                                                          REF_INT *ncell,
                                                          REF_INT *c2n) {
-  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_CELL ref_cell;
   REF_INT cell, i, node;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT *o2n, *n2o;
 
-  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+  RSS(ref_fortran_compact(&o2n, &n2o), "compact");
 
   RSS(ref_grid_cell_with(ref_grid, *node_per_cell, &ref_cell), "get cell");
 
@@ -291,9 +438,6 @@ REF_STATUS REF_FORT_(ref_fortran_cell, REF_FORTRAN_CELL)(REF_INT *node_per_cell,
     i++;
   }
 
-  ref_free(n2o);
-  ref_free(o2n);
-
   REIS(*ncell, i, "ncell mismatch");
 
   return REF_SUCCESS;
@@ -303,6 +447,7 @@ REF_STATUS REF_FORT_(ref_fortran_size_face,
                      REF_FORTRAN_SIZE_FACE)(REF_INT *ibound,
                                             REF_INT *node_per_face,
                                             REF_INT *nface) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_CELL ref_cell;
   REF_INT cell;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
@@ -318,13 +463,13 @@ REF_STATUS REF_FORT_(ref_fortran_size_face,
 REF_STATUS REF_FORT_(ref_fortran_face,
                      REF_FORTRAN_FACE)(REF_INT *ibound, REF_INT *node_per_face,
                                        REF_INT *nface, REF_INT *f2n) {
-  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_CELL ref_cell;
   REF_INT cell, i, node;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT *o2n, *n2o;
 
-  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+  RSS(ref_fortran_compact(&o2n, &n2o), "compact");
 
   RSS(ref_grid_face_with(ref_grid, *node_per_face, &ref_cell), "get face");
 
@@ -337,15 +482,13 @@ REF_STATUS REF_FORT_(ref_fortran_face,
     i++;
   }
 
-  ref_free(n2o);
-  ref_free(o2n);
-
   REIS(*nface, i, "nface mismatch");
 
   return REF_SUCCESS;
 }
 
 REF_STATUS REF_FORT_(ref_fortran_naux, REF_FORTRAN_NAUX)(REF_INT *naux) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node = ref_grid_node(ref_grid);
   ref_node_naux(ref_node) = *naux;
   RSS(ref_node_resize_aux(ref_node), "size aux");
@@ -355,6 +498,7 @@ REF_STATUS REF_FORT_(ref_fortran_naux, REF_FORTRAN_NAUX)(REF_INT *naux) {
 REF_STATUS REF_FORT_(ref_fortran_import_aux,
                      REF_FORTRAN_IMPORT_AUX)(REF_INT *ldim, REF_INT *nnodes,
                                              REF_INT *offset, REF_DBL *aux) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT node, i;
   for (node = 0; node < (*nnodes); node++)
@@ -366,31 +510,38 @@ REF_STATUS REF_FORT_(ref_fortran_import_aux,
 REF_STATUS REF_FORT_(ref_fortran_aux,
                      REF_FORTRAN_AUX)(REF_INT *ldim, REF_INT *nnodes,
                                       REF_INT *offset, REF_DBL *aux) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT node, i;
   REF_INT *o2n, *n2o;
 
   SUPRESS_UNUSED_COMPILER_WARNING(nnodes);
 
-  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+  RSS(ref_fortran_compact(&o2n, &n2o), "compact");
 
   for (node = 0; node < ref_node_n(ref_node); node++)
     for (i = 0; i < (*ldim); i++)
       aux[i + (*ldim) * node] =
           ref_node_aux(ref_node, i + (*offset), n2o[node]);
 
-  ref_free(n2o);
-  ref_free(o2n);
-
   REIS(*nnodes, ref_node_n(ref_node), "nnode mismatch");
 
   return REF_SUCCESS;
 }
 
 REF_STATUS REF_FORT_(ref_fortran_free, REF_FORTRAN_FREE)(void) {
+  REF_GRID ref_grid = ref_fortran_grids[ref_fortran_current];
+  REF_INT handle;
+  REF_BOOL in_use;
+  RSS(ref_fortran_changed(), "changed");
   RSS(ref_grid_free(ref_grid), "free grid");
-  ref_grid = NULL;
-  RSS(ref_mpi_free(ref_mpi), "free mpi");
-  ref_mpi = NULL;
+  ref_fortran_grids[ref_fortran_current] = NULL;
+  in_use = REF_FALSE;
+  for (handle = 0; handle < REF_FORTRAN_MAX_HANDLE; handle++)
+    in_use = in_use || (NULL != ref_fortran_grids[handle]);
+  if (!in_use && NULL != ref_mpi) {
+    RSS(ref_mpi_free(ref_mpi), "free mpi");
+    ref_mpi = NULL;
+  }
   return REF_SUCCESS;
 }
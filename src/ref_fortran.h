@@ -25,6 +25,8 @@
 #include "config.h"
 #endif
 
+#include "ref_grid.h"
+
 BEGIN_C_DECLORATION
 
 /* Define to a macro mangling the given C identifier (in lower and upper
@@ -35,6 +37,31 @@ BEGIN_C_DECLORATION
 
 extern REF_BOOL ref_fortran_allow_screen_output;
 
+/* selects the grid slot (0 to 7) that the calls below act on */
+REF_STATUS REF_FORT_(ref_fortran_handle, REF_FORTRAN_HANDLE)(REF_INT *handle);
+
+/* C callers hand malloc'd, zero based arrays to an empty slot without
+ * copies or sorting. The slot owns and grows them, ref_fortran_free
+ * frees them. Nodes carry REF_NODE_REAL_PER reals (x,y,z,m[6]) and
+ * faces carry their id after the nodes. */
+REF_STATUS ref_fortran_adopt_node(REF_INT nnodes, REF_GLOB nnodesg,
+                                  REF_GLOB *global, REF_INT *part,
+                                  REF_DBL *real);
+REF_STATUS ref_fortran_adopt_cell(REF_INT node_per_cell, REF_INT ncell,
+                                  REF_INT *c2n);
+REF_STATUS ref_fortran_adopt_face(REF_INT node_per_face, REF_INT nface,
+                                  REF_INT *f2n);
+
+/* read only views of the slot storage in the same layouts, owned nodes
+ * first, valid until the next call that changes the grid */
+REF_STATUS ref_fortran_view_node(REF_INT *nnodes0, REF_INT *nnodes,
+                                 REF_GLOB **global, REF_INT **part,
+                                 REF_DBL **real);
+REF_STATUS ref_fortran_view_cell(REF_INT node_per_cell, REF_INT *ncell,
+                                 REF_INT **c2n);
+REF_STATUS ref_fortran_view_face(REF_INT node_per_face, REF_INT *nface,
+                                 REF_INT **f2n);
+
 REF_STATUS REF_FORT_(ref_fortran_init,
                      REF_FORTRAN_INIT)(REF_INT *nnodes, REF_INT *nnodesg,
                                        REF_INT *l2g, REF_INT *part,
@@ -26,6 +26,7 @@
 #include "ref_adj.h"
 #include "ref_cell.h"
 #include "ref_export.h"
+#include "ref_fixture.h"
 #include "ref_grid.h"
 #include "ref_list.h"
 #include "ref_math.h"
@@ -241,6 +242,94 @@ int main(int argc, char *argv[]) {
   free(x);
   free(l2g);
 
+  { /* second handle adopts arrays while the first is kept */
+    REF_GLOB *global, *view_global;
+    REF_INT *view_part, *view_c2n;
+    REF_DBL *real, *view_real;
+    REF_INT handle, i;
+
+    handle = 1;
+    RSS(REF_FORT_(ref_fortran_handle, REF_FORTRAN_HANDLE)(&handle), "select");
+
+    nnodes = 4;
+    global = (REF_GLOB *)malloc(sizeof(REF_GLOB) * nnodes);
+    part = (REF_INT *)malloc(sizeof(REF_INT) * nnodes);
+    real = (REF_DBL *)calloc((size_t)(REF_NODE_REAL_PER * nnodes),
+                             sizeof(REF_DBL));
+    for (node = 0; node < nnodes; node++) {
+      global[node] = (node + 3) % nnodes;
+      part[node] = 0;
+    }
+    part[0] = 1; /* ghost listed first */
+    real[0 + REF_NODE_REAL_PER * 2] = 1.0;
+    real[1 + REF_NODE_REAL_PER * 3] = 1.0;
+    real[2 + REF_NODE_REAL_PER * 0] = 1.0;
+    node_per_cell = 4;
+    ncell = 1;
+    c2n = (REF_INT *)malloc(sizeof(REF_INT) * node_per_cell * ncell);
+    for (node = 0; node < node_per_cell; node++) c2n[node] = node;
+    node_per_face = 3;
+    nface = 1;
+    f2n = (REF_INT *)malloc(sizeof(REF_INT) * (node_per_face + 1) * nface);
+    f2n[0] = 1;
+    f2n[1] = 2;
+    f2n[2] = 3;
+    f2n[3] = 7;
+
+    RSS(ref_fortran_adopt_node(nnodes, 4, global, part, real), "adopt node");
+    RSS(ref_fortran_adopt_cell(node_per_cell, ncell, c2n), "adopt cell");
+    RSS(ref_fortran_adopt_face(node_per_face, nface, f2n), "adopt face");
+
+    RSS(REF_FORT_(ref_fortran_size_node, REF_FORTRAN_SIZE_NODE)(
+            &nnodes0, &nnodes, &nnodesg),
+        "size_node");
+    REIS(3, nnodes0, "owned");
+    REIS(4, nnodes, "n");
+    l2g = (REF_INT *)malloc(sizeof(REF_INT) * nnodes);
+    x = (REF_DBL *)malloc(sizeof(REF_DBL) * nnodes);
+    y = (REF_DBL *)malloc(sizeof(REF_DBL) * nnodes);
+    z = (REF_DBL *)malloc(sizeof(REF_DBL) * nnodes);
+    RSS(REF_FORT_(ref_fortran_node, REF_FORTRAN_NODE)(&nnodes, l2g, x, y, z),
+        "get node");
+    REIS(4, l2g[3], "ghost read back last");
+
+    /* packing renumbers nodes, so the kept compaction must be dropped */
+    RSS(ref_fortran_view_node(&nnodes0, &nnodes, &view_global, &view_part,
+                              &view_real),
+        "view node");
+    REIS(3, nnodes0, "owned");
+    RAS(real == view_real, "view should be the adopted storage");
+    REIS(1, view_part[3], "ghost last");
+    RSS(REF_FORT_(ref_fortran_node, REF_FORTRAN_NODE)(&nnodes, l2g, x, y, z),
+        "get node");
+    for (i = 0; i < nnodes; i++) {
+      RES(view_global[i] + 1, (REF_GLOB)l2g[i], "stale compaction");
+      RWDS(view_real[0 + REF_NODE_REAL_PER * i], x[i], -1.0, "x");
+    }
+
+    RSS(ref_fortran_view_cell(node_per_cell, &ncell, &view_c2n), "view cell");
+    REIS(1, ncell, "ncell");
+    RAS(c2n == view_c2n, "view should be the adopted storage");
+    REIS(3, view_c2n[0], "renumbered ghost");
+    RSS(ref_fortran_view_face(node_per_face, &nface, &view_c2n), "view face");
+    REIS(1, nface, "nface");
+    REIS(7, view_c2n[node_per_face], "face id");
+
+    free(z);
+    free(y);
+    free(x);
+    free(l2g);
+    RSS(REF_FORT_(ref_fortran_free, REF_FORTRAN_FREE)(), "free adopted");
+
+    handle = 0;
+    RSS(REF_FORT_(ref_fortran_handle, REF_FORTRAN_HANDLE)(&handle), "select");
+    nnodes = REF_EMPTY;
+    RSS(REF_FORT_(ref_fortran_size_node, REF_FORTRAN_SIZE_NODE)(
+            &nnodes0, &nnodes, &nnodesg),
+        "size_node");
+    REIS(4, nnodes, "first handle should be intact");
+  }
+
   RSS(REF_FORT_(ref_fortran_free, REF_FORTRAN_FREE)(), "free");
 
   RSS(ref_mpi_stop(), "stop");
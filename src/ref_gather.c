@@ -41,6 +41,8 @@ REF_STATUS ref_gather_create(REF_GATHER *ref_gather_ptr) {
   ref_gather->grid_file = (FILE *)NULL;
   ref_gather->hist_file = (FILE *)NULL;
   ref_gather->time = 0.0;
+  ref_gather->collective = REF_FALSE;
+  ref_gather->min_meshb_version = 2;
 
   return REF_SUCCESS;
 }
@@ -82,17 +84,19 @@ static REF_STATUS ref_gather_ncell_below_quality(REF_NODE ref_node,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
-                                           REF_INT *l2c, REF_DBL *scalar,
+static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_GLOB nnode,
+                                           REF_GLOB *l2c, REF_DBL *scalar,
                                            FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
-  REF_INT nnode_written, first, n, i;
-  REF_INT global, local;
+  REF_GLOB nnode_written, first, global;
+  REF_INT n, i;
+  REF_INT local;
   REF_STATUS status;
   REF_INT dim = 6;
-  REF_INT *sorted_local, *sorted_cellnode, *pack, total_cellnode, position;
+  REF_INT *sorted_local, *pack, total_cellnode, position;
+  REF_GLOB *sorted_cellnode;
 
   total_cellnode = 0;
   for (i = 0; i < ref_node_max(ref_node); i++) {
@@ -102,7 +106,7 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
   }
 
   ref_malloc(sorted_local, total_cellnode, REF_INT);
-  ref_malloc(sorted_cellnode, total_cellnode, REF_INT);
+  ref_malloc(sorted_cellnode, total_cellnode, REF_GLOB);
   ref_malloc(pack, total_cellnode, REF_INT);
 
   total_cellnode = 0;
@@ -113,14 +117,15 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
       total_cellnode++;
     }
   }
-  RSS(ref_sort_heap_int(total_cellnode, sorted_cellnode, sorted_local), "sort");
+  RSS(ref_sort_heap_glob(total_cellnode, sorted_cellnode, sorted_local),
+      "sort");
   for (i = 0; i < total_cellnode; i++) {
     sorted_local[i] = pack[sorted_local[i]];
     sorted_cellnode[i] = l2c[sorted_local[i]];
   }
   ref_free(pack);
 
-  chunk = nnode / ref_mpi_n(ref_mpi) + 1;
+  chunk = (REF_INT)(nnode / ref_mpi_n(ref_mpi) + 1);
   chunk = MAX(chunk, 100000);
 
   ref_malloc(local_xyzm, dim * chunk, REF_DBL);
@@ -129,7 +134,7 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
   nnode_written = 0;
   while (nnode_written < nnode) {
     first = nnode_written;
-    n = MIN(chunk, nnode - nnode_written);
+    n = (REF_INT)MIN(chunk, nnode - nnode_written);
 
     nnode_written += n;
 
@@ -137,8 +142,8 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
 
     for (i = 0; i < n; i++) {
       global = first + i;
-      status =
-          ref_sort_search(total_cellnode, sorted_cellnode, global, &position);
+      status = ref_sort_search_glob(total_cellnode, sorted_cellnode, global,
+                                    &position);
       RXS(status, REF_NOT_FOUND, "node local failed");
       if (REF_SUCCESS == status) {
         local = sorted_local[position];
@@ -165,8 +170,8 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
     for (i = 0; i < n; i++)
       if ((ABS(local_xyzm[5 + dim * i] - 1.0) > 0.1) &&
           (ABS(local_xyzm[5 + dim * i] - 0.0) > 0.1)) {
-        printf("%s: %d: %s: before sum %d %f\n", __FILE__, __LINE__, __func__,
-               first + i, local_xyzm[5 + dim * i]);
+        printf("%s: %d: %s: before sum " REF_GLOB_FMT " %f\n", __FILE__,
+               __LINE__, __func__, first + i, local_xyzm[5 + dim * i]);
       }
 
     RSS(ref_mpi_sum(ref_mpi, local_xyzm, xyzm, dim * n, REF_DBL_TYPE), "sum");
@@ -174,8 +179,8 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
     if (ref_mpi_once(ref_mpi))
       for (i = 0; i < n; i++) {
         if (ABS(xyzm[5 + dim * i] - 1.0) > 0.1) {
-          printf("%s: %d: %s: after sum %d %f\n", __FILE__, __LINE__, __func__,
-                 first + i, xyzm[5 + dim * i]);
+          printf("%s: %d: %s: after sum " REF_GLOB_FMT " %f\n", __FILE__,
+                 __LINE__, __func__, first + i, xyzm[5 + dim * i]);
         }
         if (NULL == scalar) {
           fprintf(file, "%.15e %.15e %.15e %.0f %.0f\n", xyzm[0 + dim * i],
@@ -198,15 +203,16 @@ static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node, REF_INT nnode,
 }
 
 static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node, REF_CELL ref_cell,
-                                      REF_INT ncell_expected, REF_INT *l2c,
+                                      REF_GLOB ncell_expected, REF_GLOB *l2c,
                                       FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT cell, node;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT node_per = ref_cell_node_per(ref_cell);
-  REF_INT *c2n, ncell;
+  REF_GLOB *c2n;
+  REF_INT ncell;
   REF_INT proc, part;
-  REF_INT ncell_actual;
+  REF_GLOB ncell_actual;
 
   ncell_actual = 0;
 
@@ -215,9 +221,7 @@ static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node, REF_CELL ref_cell,
       RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
       if (ref_mpi_rank(ref_mpi) == part) {
         for (node = 0; node < node_per; node++) {
-          nodes[node] = l2c[nodes[node]];
-          nodes[node]++;
-          fprintf(file, " %d", nodes[node]);
+          fprintf(file, " " REF_GLOB_FMT, l2c[nodes[node]] + 1);
         }
         ncell_actual++;
         fprintf(file, "\n");
@@ -228,13 +232,13 @@ static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node, REF_CELL ref_cell,
   if (ref_mpi_once(ref_mpi)) {
     each_ref_mpi_worker(ref_mpi, proc) {
       RSS(ref_mpi_recv(ref_mpi, &ncell, 1, REF_INT_TYPE, proc), "recv ncell");
-      ref_malloc(c2n, ncell * node_per, REF_INT);
-      RSS(ref_mpi_recv(ref_mpi, c2n, ncell * node_per, REF_INT_TYPE, proc),
+      ref_malloc(c2n, ncell * node_per, REF_GLOB);
+      RSS(ref_mpi_recv(ref_mpi, c2n, ncell * node_per, REF_GLOB_TYPE, proc),
           "recv c2n");
       for (cell = 0; cell < ncell; cell++) {
         for (node = 0; node < node_per; node++) {
           c2n[node + node_per * cell]++;
-          fprintf(file, " %d", c2n[node + node_per * cell]);
+          fprintf(file, " " REF_GLOB_FMT, c2n[node + node_per * cell]);
         }
         ncell_actual++;
         fprintf(file, "\n");
@@ -248,7 +252,7 @@ static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node, REF_CELL ref_cell,
       if (ref_mpi_rank(ref_mpi) == part) ncell++;
     }
     RSS(ref_mpi_send(ref_mpi, &ncell, 1, REF_INT_TYPE, 0), "send ncell");
-    ref_malloc(c2n, ncell * node_per, REF_INT);
+    ref_malloc(c2n, ncell * node_per, REF_GLOB);
     ncell = 0;
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
@@ -258,7 +262,7 @@ static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node, REF_CELL ref_cell,
         ncell++;
       }
     }
-    RSS(ref_mpi_send(ref_mpi, c2n, ncell * node_per, REF_INT_TYPE, 0),
+    RSS(ref_mpi_send(ref_mpi, c2n, ncell * node_per, REF_GLOB_TYPE, 0),
         "send c2n");
 
     ref_free(c2n);
@@ -280,7 +284,7 @@ static REF_STATUS ref_gather_cell_quality_tec(REF_NODE ref_node,
   REF_INT node_per = ref_cell_node_per(ref_cell);
   REF_INT size_per = ref_cell_size_per(ref_cell);
   REF_INT ncell;
-  REF_INT *c2n;
+  REF_GLOB *c2n;
   REF_INT proc;
   REF_DBL quality;
 
@@ -290,9 +294,8 @@ static REF_STATUS ref_gather_cell_quality_tec(REF_NODE ref_node,
       if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, nodes[0]) &&
           quality < min_quality) {
         for (node = 0; node < node_per; node++) {
-          nodes[node] = ref_node_global(ref_node, nodes[node]);
-          nodes[node]++;
-          fprintf(file, " %d", nodes[node]);
+          fprintf(file, " " REF_GLOB_FMT,
+                  ref_node_global(ref_node, nodes[node]) + 1);
         }
         fprintf(file, "\n");
       }
@@ -303,13 +306,13 @@ static REF_STATUS ref_gather_cell_quality_tec(REF_NODE ref_node,
     each_ref_mpi_worker(ref_mpi, proc) {
       RSS(ref_mpi_recv(ref_mpi, &ncell, 1, REF_INT_TYPE, proc), "recv ncell");
       if (ncell > 0) {
-        ref_malloc(c2n, ncell * size_per, REF_INT);
-        RSS(ref_mpi_recv(ref_mpi, c2n, ncell * size_per, REF_INT_TYPE, proc),
+        ref_malloc(c2n, ncell * size_per, REF_GLOB);
+        RSS(ref_mpi_recv(ref_mpi, c2n, ncell * size_per, REF_GLOB_TYPE, proc),
             "recv c2n");
         for (cell = 0; cell < ncell; cell++) {
           for (node = 0; node < node_per; node++) {
             c2n[node + size_per * cell]++;
-            fprintf(file, " %d", c2n[node + size_per * cell]);
+            fprintf(file, " " REF_GLOB_FMT, c2n[node + size_per * cell]);
           }
           fprintf(file, "\n");
         }
@@ -326,7 +329,7 @@ static REF_STATUS ref_gather_cell_quality_tec(REF_NODE ref_node,
     }
     RSS(ref_mpi_send(ref_mpi, &ncell, 1, REF_INT_TYPE, 0), "send ncell");
     if (ncell > 0) {
-      ref_malloc(c2n, ncell * size_per, REF_INT);
+      ref_malloc(c2n, ncell * size_per, REF_GLOB);
       ncell = 0;
       each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
         RSS(ref_node_tet_quality(ref_node, nodes, &quality), "qual");
@@ -340,7 +343,7 @@ static REF_STATUS ref_gather_cell_quality_tec(REF_NODE ref_node,
           ncell++;
         }
       }
-      RSS(ref_mpi_send(ref_mpi, c2n, ncell * size_per, REF_INT_TYPE, 0),
+      RSS(ref_mpi_send(ref_mpi, c2n, ncell * size_per, REF_GLOB_TYPE, 0),
           "send c2n");
       ref_free(c2n);
     }
@@ -390,7 +393,7 @@ REF_STATUS ref_gather_tec_movie_frame(REF_GRID ref_grid,
   REF_CELL ref_cell = ref_grid_tri(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
   REF_INT cell, cell_node, nodes[REF_CELL_MAX_SIZE_PER];
-  REF_INT nnode, ncell, *l2c;
+  REF_GLOB nnode, ncell, *l2c;
   REF_DBL *norm_dev, dot;
 
   if (!(ref_gather->recording)) return REF_SUCCESS;
@@ -425,13 +428,13 @@ REF_STATUS ref_gather_tec_movie_frame(REF_GRID ref_grid,
     }
     if (NULL == zone_title) {
       fprintf(ref_gather->grid_file,
-              "zone t=\"part\", nodes=%d, elements=%d, datapacking=%s, "
-              "zonetype=%s, solutiontime=%f\n",
+              "zone t=\"part\", nodes=" REF_GLOB_FMT ", elements=" REF_GLOB_FMT
+              ", datapacking=%s, zonetype=%s, solutiontime=%f\n",
               nnode, ncell, "point", "fetriangle", ref_gather->time);
     } else {
       fprintf(ref_gather->grid_file,
-              "zone t=\"%s\", nodes=%d, elements=%d, datapacking=%s, "
-              "zonetype=%s, solutiontime=%f\n",
+              "zone t=\"%s\", nodes=" REF_GLOB_FMT ", elements=" REF_GLOB_FMT
+              ", datapacking=%s, zonetype=%s, solutiontime=%f\n",
               zone_title, nnode, ncell, "point", "fetriangle",
               ref_gather->time);
     }
@@ -457,14 +460,16 @@ REF_STATUS ref_gather_tec_movie_frame(REF_GRID ref_grid,
     if (ref_grid_once(ref_grid)) {
       if (NULL == zone_title) {
         fprintf(ref_gather->grid_file,
-                "zone t=\"qpart\", nodes=%d, elements=%d, datapacking=%s, "
-                "zonetype=%s, solutiontime=%f\n",
+                "zone t=\"qpart\", nodes=" REF_GLOB_FMT
+                ", elements=%d, datapacking=%s, zonetype=%s, "
+                "solutiontime=%f\n",
                 nnode, MAX(1, ntet), "point", "fetetrahedron",
                 ref_gather->time);
       } else {
         fprintf(ref_gather->grid_file,
-                "zone t=\"q%s\", nodes=%d, elements=%d, datapacking=%s, "
-                "zonetype=%s, solutiontime=%f\n",
+                "zone t=\"q%s\", nodes=" REF_GLOB_FMT
+                ", elements=%d, datapacking=%s, zonetype=%s, "
+                "solutiontime=%f\n",
                 zone_title, nnode, MAX(1, ntet), "point", "fetetrahedron",
                 ref_gather->time);
       }
@@ -495,7 +500,7 @@ REF_STATUS ref_gather_tec_part(REF_GRID ref_grid, const char *filename) {
   FILE *file;
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tri(ref_grid);
-  REF_INT nnode, ncell, *l2c;
+  REF_GLOB nnode, ncell, *l2c;
 
   RSS(ref_node_synchronize_globals(ref_node), "sync");
 
@@ -509,10 +514,10 @@ REF_STATUS ref_gather_tec_part(REF_GRID ref_grid, const char *filename) {
 
     fprintf(file, "title=\"tecplot refine partion file\"\n");
     fprintf(file, "variables = \"x\" \"y\" \"z\" \"p\" \"a\"\n");
-    fprintf(
-        file,
-        "zone t=\"part\", nodes=%d, elements=%d, datapacking=%s, zonetype=%s\n",
-        nnode, ncell, "point", "fetriangle");
+    fprintf(file,
+            "zone t=\"part\", nodes=" REF_GLOB_FMT ", elements=" REF_GLOB_FMT
+            ", datapacking=%s, zonetype=%s\n",
+            nnode, ncell, "point", "fetriangle");
   }
 
   RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, NULL, file), "nodes");
@@ -525,18 +530,54 @@ REF_STATUS ref_gather_tec_part(REF_GRID ref_grid, const char *filename) {
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_gather_node(REF_NODE ref_node, REF_BOOL swap_endian,
-                                  REF_BOOL has_id, FILE *file) {
+/* meshb version 4 widens integers to 8 bytes, ugrid writes as version 2 */
+static REF_STATUS ref_gather_int(FILE *file, REF_INT version,
+                                 REF_BOOL swap_endian, REF_GLOB value) {
+  int int_value;
+  long long_value;
+
+  if (4 == version) {
+    RAS(!swap_endian, "swap endian 64-bit integers not implemented");
+    long_value = (long)value;
+    REIS(1, fwrite(&long_value, sizeof(long), 1, file), "long");
+  } else {
+    RAS(value <= REF_INT_MAX, "exceeds int, requires meshb version 4");
+    int_value = (int)value;
+    if (swap_endian) SWAP_INT(int_value);
+    REIS(1, fwrite(&int_value, sizeof(int), 1, file), "int");
+  }
+
+  return REF_SUCCESS;
+}
+
+/* meshb version 2 has int positions, versions 3 and 4 have long positions */
+static REF_STATUS ref_gather_pos(FILE *file, REF_INT version, long position) {
+  int int_position;
+
+  if (2 == version) {
+    RAS(position <= REF_INT_MAX, "meshb version 2 limited to 2GB");
+    int_position = (int)position;
+    REIS(1, fwrite(&int_position, sizeof(int), 1, file), "int pos");
+  } else {
+    REIS(1, fwrite(&position, sizeof(long), 1, file), "long pos");
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_gather_node(REF_NODE ref_node, REF_INT version,
+                                  REF_BOOL swap_endian, REF_BOOL has_id,
+                                  FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
   REF_DBL swapped_dbl;
-  REF_INT nnode_written, first, n, i;
-  REF_INT global, local;
-  REF_INT id = REF_EXPORT_MESHB_VERTEX_ID;
+  REF_INT n, i;
+  REF_GLOB nnode_written, first, global;
+  REF_INT local;
   REF_STATUS status;
 
-  chunk = ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1;
+  chunk = (REF_INT)(ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1);
 
   ref_malloc(local_xyzm, 4 * chunk, REF_DBL);
   ref_malloc(xyzm, 4 * chunk, REF_DBL);
@@ -544,7 +585,7 @@ static REF_STATUS ref_gather_node(REF_NODE ref_node, REF_BOOL swap_endian,
   nnode_written = 0;
   while (nnode_written < ref_node_n_global(ref_node)) {
     first = nnode_written;
-    n = MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
+    n = (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
 
     nnode_written += n;
 
@@ -573,7 +614,8 @@ static REF_STATUS ref_gather_node(REF_NODE ref_node, REF_BOOL swap_endian,
     if (ref_mpi_once(ref_mpi))
       for (i = 0; i < n; i++) {
         if (ABS(xyzm[3 + 4 * i] - 1.0) > 0.1) {
-          printf("error gather node %d %f\n", first + i, xyzm[3 + 4 * i]);
+          printf("error gather node " REF_GLOB_FMT " %f\n", first + i,
+                 xyzm[3 + 4 * i]);
         }
         swapped_dbl = xyzm[0 + 4 * i];
         if (swap_endian) SWAP_DBL(swapped_dbl);
@@ -584,7 +626,10 @@ static REF_STATUS ref_gather_node(REF_NODE ref_node, REF_BOOL swap_endian,
         swapped_dbl = xyzm[2 + 4 * i];
         if (swap_endian) SWAP_DBL(swapped_dbl);
         REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "z");
-        if (has_id) REIS(1, fwrite(&id, sizeof(REF_INT), 1, file), "id");
+        if (has_id)
+          RSS(ref_gather_int(file, version, swap_endian,
+                             REF_EXPORT_MESHB_VERTEX_ID),
+              "id");
       }
   }
 
@@ -598,11 +643,12 @@ static REF_STATUS ref_gather_node_metric(REF_NODE ref_node, FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
-  REF_INT nnode_written, first, n, i, im;
-  REF_INT global, local;
+  REF_INT n, i, im;
+  REF_GLOB nnode_written, first, global;
+  REF_INT local;
   REF_STATUS status;
 
-  chunk = ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1;
+  chunk = (REF_INT)(ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1);
 
   ref_malloc(local_xyzm, 7 * chunk, REF_DBL);
   ref_malloc(xyzm, 7 * chunk, REF_DBL);
@@ -610,7 +656,7 @@ static REF_STATUS ref_gather_node_metric(REF_NODE ref_node, FILE *file) {
   nnode_written = 0;
   while (nnode_written < ref_node_n_global(ref_node)) {
     first = nnode_written;
-    n = MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
+    n = (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
 
     nnode_written += n;
 
@@ -635,7 +681,8 @@ static REF_STATUS ref_gather_node_metric(REF_NODE ref_node, FILE *file) {
     if (ref_mpi_once(ref_mpi))
       for (i = 0; i < n; i++) {
         if (ABS(xyzm[6 + 7 * i] - 1.0) > 0.1) {
-          printf("error gather node %d %f\n", first + i, xyzm[6 + 7 * i]);
+          printf("error gather node " REF_GLOB_FMT " %f\n", first + i,
+                 xyzm[6 + 7 * i]);
         }
         fprintf(file, "%.15e %.15e %.15e %.15e %.15e %.15e \n", xyzm[0 + 7 * i],
                 xyzm[1 + 7 * i], xyzm[2 + 7 * i], xyzm[3 + 7 * i],
@@ -653,11 +700,12 @@ static REF_STATUS ref_gather_node_metric_solb(REF_NODE ref_node, FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
-  REF_INT nnode_written, first, n, i, im;
-  REF_INT global, local;
+  REF_INT n, i, im;
+  REF_GLOB nnode_written, first, global;
+  REF_INT local;
   REF_STATUS status;
-  int next_position, keyword_code;
-  int code, version, dim;
+  long next_position = 0;
+  int keyword_code, code, version, dim;
 
   if (ref_mpi_once(ref_mpi)) {
     code = 1;
@@ -667,7 +715,7 @@ static REF_STATUS ref_gather_node_metric_solb(REF_NODE ref_node, FILE *file) {
     next_position = 4 + 4 + 4 + ftell(file);
     keyword_code = 3;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
     dim = 3;
     REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
   }
@@ -677,16 +725,16 @@ static REF_STATUS ref_gather_node_metric_solb(REF_NODE ref_node, FILE *file) {
         4 + 4 + 4 + 4 + 4 + ref_node_n_global(ref_node) * (6 * 8) + ftell(file);
     keyword_code = 62;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
-    REIS(1, fwrite(&(ref_node_n_global(ref_node)), sizeof(int), 1, file),
-         "nnode");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
+    RSS(ref_gather_int(file, version, REF_FALSE, ref_node_n_global(ref_node)),
+        "nnode");
     keyword_code = 1; /* one solution at node */
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "n solutions");
     keyword_code = 3; /* solution type 3, metric */
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "metric solution");
   }
 
-  chunk = ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1;
+  chunk = (REF_INT)(ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1);
 
   ref_malloc(local_xyzm, 7 * chunk, REF_DBL);
   ref_malloc(xyzm, 7 * chunk, REF_DBL);
@@ -694,7 +742,7 @@ static REF_STATUS ref_gather_node_metric_solb(REF_NODE ref_node, FILE *file) {
   nnode_written = 0;
   while (nnode_written < ref_node_n_global(ref_node)) {
     first = nnode_written;
-    n = MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
+    n = (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
 
     nnode_written += n;
 
@@ -719,7 +767,8 @@ static REF_STATUS ref_gather_node_metric_solb(REF_NODE ref_node, FILE *file) {
     if (ref_mpi_once(ref_mpi))
       for (i = 0; i < n; i++) {
         if (ABS(xyzm[6 + 7 * i] - 1.0) > 0.1) {
-          printf("error gather node %d %f\n", first + i, xyzm[6 + 7 * i]);
+          printf("error gather node " REF_GLOB_FMT " %f\n", first + i,
+                 xyzm[6 + 7 * i]);
         }
         REIS(1, fwrite(&(xyzm[0 + 7 * i]), sizeof(REF_DBL), 1, file), "m11");
         REIS(1, fwrite(&(xyzm[1 + 7 * i]), sizeof(REF_DBL), 1, file), "m12");
@@ -741,7 +790,7 @@ static REF_STATUS ref_gather_node_metric_solb(REF_NODE ref_node, FILE *file) {
     keyword_code = 54;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "end kw");
     next_position = 0;
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
   }
 
   return REF_SUCCESS;
@@ -752,11 +801,12 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
-  REF_INT nnode_written, first, n, i, im;
-  REF_INT global, local;
+  REF_INT n, i, im;
+  REF_GLOB nnode_written, first, global;
+  REF_INT local;
   REF_STATUS status;
-  int next_position, keyword_code;
-  int code, version, dim;
+  long next_position = 0;
+  int keyword_code, code, version, dim;
 
   if (ref_mpi_once(ref_mpi)) {
     code = 1;
@@ -766,7 +816,7 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
     next_position = 4 + 4 + 4 + ftell(file);
     keyword_code = 3;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
     dim = 3;
     REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
   }
@@ -776,9 +826,9 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
                     ref_node_n_global(ref_node) * (ldim * 8) + ftell(file);
     keyword_code = 62;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
-    REIS(1, fwrite(&(ref_node_n_global(ref_node)), sizeof(int), 1, file),
-         "nnode");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
+    RSS(ref_gather_int(file, version, REF_FALSE, ref_node_n_global(ref_node)),
+        "nnode");
     keyword_code = ldim; /* one solution at node */
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "n solutions");
     keyword_code = 1; /* solution type 1, scalar */
@@ -787,7 +837,7 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
     }
   }
 
-  chunk = ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1;
+  chunk = (REF_INT)(ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1);
 
   ref_malloc(local_xyzm, (ldim + 1) * chunk, REF_DBL);
   ref_malloc(xyzm, (ldim + 1) * chunk, REF_DBL);
@@ -795,7 +845,7 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
   nnode_written = 0;
   while (nnode_written < ref_node_n_global(ref_node)) {
     first = nnode_written;
-    n = MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
+    n = (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_written);
 
     nnode_written += n;
 
@@ -822,7 +872,7 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
     if (ref_mpi_once(ref_mpi))
       for (i = 0; i < n; i++) {
         if (ABS(xyzm[ldim + (ldim + 1) * i] - 1.0) > 0.1) {
-          printf("error gather node %d %f\n", first + i,
+          printf("error gather node " REF_GLOB_FMT " %f\n", first + i,
                  xyzm[ldim + (ldim + 1) * i]);
         }
         for (im = 0; im < ldim; im++) {
@@ -843,13 +893,14 @@ static REF_STATUS ref_gather_node_scalar_solb(REF_NODE ref_node, REF_INT ldim,
     keyword_code = 54;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "end kw");
     next_position = 0;
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
   }
 
   return REF_SUCCESS;
 }
 
 static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
+                                  REF_INT version,
                                   REF_BOOL faceid_insted_of_c2n,
                                   REF_BOOL always_id, REF_BOOL swap_endian,
                                   REF_BOOL select_faceid, REF_INT faceid,
@@ -860,7 +911,7 @@ static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
   REF_INT node_per = ref_cell_node_per(ref_cell);
   REF_INT size_per = ref_cell_size_per(ref_cell);
   REF_INT ncell;
-  REF_INT *c2n;
+  REF_GLOB *c2n;
   REF_INT proc;
 
   if (ref_mpi_once(ref_mpi)) {
@@ -868,27 +919,22 @@ static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
       if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, nodes[0]) &&
           (!select_faceid || nodes[ref_cell_node_per(ref_cell)] == faceid)) {
         if (faceid_insted_of_c2n) {
-          node = node_per;
-          if (swap_endian) SWAP_INT(nodes[node]);
-          REIS(1, fwrite(&(nodes[node]), sizeof(REF_INT), 1, file), "cel node");
+          RSS(ref_gather_int(file, version, swap_endian, nodes[node_per]),
+              "cel node");
         } else {
           for (node = 0; node < node_per; node++) {
-            nodes[node] = ref_node_global(ref_node, nodes[node]);
-            nodes[node]++;
-            if (swap_endian) SWAP_INT(nodes[node]);
-            REIS(1, fwrite(&(nodes[node]), sizeof(REF_INT), 1, file),
-                 "cel node");
+            RSS(ref_gather_int(file, version, swap_endian,
+                               ref_node_global(ref_node, nodes[node]) + 1),
+                "cel node");
           }
           if (always_id) {
             if (ref_cell_last_node_is_an_id(ref_cell)) {
-              node = node_per;
-              if (swap_endian) SWAP_INT(nodes[node]);
-              REIS(1, fwrite(&(nodes[node]), sizeof(REF_INT), 1, file),
-                   "cel node");
+              RSS(ref_gather_int(file, version, swap_endian, nodes[node_per]),
+                  "cel node");
             } else {
-              node = REF_EXPORT_MESHB_3D_ID;
-              if (swap_endian) SWAP_INT(node);
-              REIS(1, fwrite(&(node), sizeof(REF_INT), 1, file), "cel node");
+              RSS(ref_gather_int(file, version, swap_endian,
+                                 REF_EXPORT_MESHB_3D_ID),
+                  "cel node");
             }
           }
         }
@@ -900,38 +946,29 @@ static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
     each_ref_mpi_worker(ref_mpi, proc) {
       RSS(ref_mpi_recv(ref_mpi, &ncell, 1, REF_INT_TYPE, proc), "recv ncell");
       if (ncell > 0) {
-        ref_malloc(c2n, ncell * size_per, REF_INT);
-        RSS(ref_mpi_recv(ref_mpi, c2n, ncell * size_per, REF_INT_TYPE, proc),
+        ref_malloc(c2n, ncell * size_per, REF_GLOB);
+        RSS(ref_mpi_recv(ref_mpi, c2n, ncell * size_per, REF_GLOB_TYPE, proc),
             "recv c2n");
         for (cell = 0; cell < ncell; cell++)
           if (faceid_insted_of_c2n) {
-            node = node_per;
-            if (swap_endian) SWAP_INT(c2n[node + size_per * cell]);
-            REIS(1,
-                 fwrite(&(c2n[node + size_per * cell]), sizeof(REF_INT), 1,
-                        file),
-                 "cell");
+            RSS(ref_gather_int(file, version, swap_endian,
+                               c2n[node_per + size_per * cell]),
+                "cell");
           } else {
             for (node = 0; node < node_per; node++) {
-              c2n[node + size_per * cell]++;
-              if (swap_endian) SWAP_INT(c2n[node + size_per * cell]);
-              REIS(1,
-                   fwrite(&(c2n[node + size_per * cell]), sizeof(REF_INT), 1,
-                          file),
-                   "cell");
+              RSS(ref_gather_int(file, version, swap_endian,
+                                 c2n[node + size_per * cell] + 1),
+                  "cell");
             }
             if (always_id) {
               if (ref_cell_last_node_is_an_id(ref_cell)) {
-                node = node_per;
-                if (swap_endian) SWAP_INT(c2n[node + size_per * cell]);
-                REIS(1,
-                     fwrite(&(c2n[node + size_per * cell]), sizeof(REF_INT), 1,
-                            file),
-                     "cel node");
+                RSS(ref_gather_int(file, version, swap_endian,
+                                   c2n[node_per + size_per * cell]),
+                    "cel node");
               } else {
-                node = REF_EXPORT_MESHB_3D_ID;
-                if (swap_endian) SWAP_INT(node);
-                REIS(1, fwrite(&(node), sizeof(REF_INT), 1, file), "cel node");
+                RSS(ref_gather_int(file, version, swap_endian,
+                                   REF_EXPORT_MESHB_3D_ID),
+                    "cel node");
               }
             }
           }
@@ -947,7 +984,7 @@ static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
     }
     RSS(ref_mpi_send(ref_mpi, &ncell, 1, REF_INT_TYPE, 0), "send ncell");
     if (ncell > 0) {
-      ref_malloc(c2n, ncell * size_per, REF_INT);
+      ref_malloc(c2n, ncell * size_per, REF_GLOB);
       ncell = 0;
       each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
         if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, nodes[0]) &&
@@ -960,7 +997,7 @@ static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
           ncell++;
         }
       }
-      RSS(ref_mpi_send(ref_mpi, c2n, ncell * size_per, REF_INT_TYPE, 0),
+      RSS(ref_mpi_send(ref_mpi, c2n, ncell * size_per, REF_GLOB_TYPE, 0),
           "send c2n");
       ref_free(c2n);
     }
@@ -970,11 +1007,11 @@ static REF_STATUS ref_gather_cell(REF_NODE ref_node, REF_CELL ref_cell,
 }
 
 static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
-                                  REF_INT type, FILE *file) {
+                                  REF_INT version, REF_INT type, FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT geom, node, id, i;
+  REF_INT geom, i;
   REF_INT ngeom;
-  REF_INT *node_id;
+  REF_GLOB *node_id;
   REF_DBL *param;
   REF_INT proc;
   double filler = 0.0;
@@ -984,10 +1021,12 @@ static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
       if (ref_mpi_rank(ref_mpi) !=
           ref_node_part(ref_node, ref_geom_node(ref_geom, geom)))
         continue;
-      node = ref_node_global(ref_node, ref_geom_node(ref_geom, geom)) + 1;
-      id = ref_geom_id(ref_geom, geom);
-      REIS(1, fwrite(&(node), sizeof(int), 1, file), "node");
-      REIS(1, fwrite(&(id), sizeof(int), 1, file), "id");
+      RSS(ref_gather_int(
+              file, version, REF_FALSE,
+              ref_node_global(ref_node, ref_geom_node(ref_geom, geom)) + 1),
+          "node");
+      RSS(ref_gather_int(file, version, REF_FALSE, ref_geom_id(ref_geom, geom)),
+          "id");
       for (i = 0; i < type; i++)
         REIS(1,
              fwrite(&(ref_geom_param(ref_geom, i, geom)), sizeof(double), 1,
@@ -1001,17 +1040,18 @@ static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
     each_ref_mpi_worker(ref_mpi, proc) {
       RSS(ref_mpi_recv(ref_mpi, &ngeom, 1, REF_INT_TYPE, proc), "recv ngeom");
       if (ngeom > 0) {
-        ref_malloc(node_id, 2 * ngeom, REF_INT);
+        ref_malloc(node_id, 2 * ngeom, REF_GLOB);
         ref_malloc(param, 2 * ngeom, REF_DBL);
-        RSS(ref_mpi_recv(ref_mpi, node_id, 2 * ngeom, REF_INT_TYPE, proc),
+        RSS(ref_mpi_recv(ref_mpi, node_id, 2 * ngeom, REF_GLOB_TYPE, proc),
             "recv node_id");
         RSS(ref_mpi_recv(ref_mpi, param, 2 * ngeom, REF_DBL_TYPE, proc),
             "recv param");
         for (geom = 0; geom < ngeom; geom++) {
-          node = node_id[0 + 2 * geom] + 1;
-          id = node_id[1 + 2 * geom];
-          REIS(1, fwrite(&(node), sizeof(int), 1, file), "node");
-          REIS(1, fwrite(&(id), sizeof(int), 1, file), "id");
+          RSS(ref_gather_int(file, version, REF_FALSE,
+                             node_id[0 + 2 * geom] + 1),
+              "node");
+          RSS(ref_gather_int(file, version, REF_FALSE, node_id[1 + 2 * geom]),
+              "id");
           for (i = 0; i < type; i++)
             REIS(1, fwrite(&(param[i + 2 * geom]), sizeof(double), 1, file),
                  "id");
@@ -1032,7 +1072,7 @@ static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
     }
     RSS(ref_mpi_send(ref_mpi, &ngeom, 1, REF_INT_TYPE, 0), "send ngeom");
     if (ngeom > 0) {
-      ref_malloc(node_id, 2 * ngeom, REF_INT);
+      ref_malloc(node_id, 2 * ngeom, REF_GLOB);
       ref_malloc_init(param, 2 * ngeom, REF_DBL, 0.0); /* prevent uninit */
       ngeom = 0;
       each_ref_geom_of(ref_geom, type, geom) {
@@ -1046,7 +1086,7 @@ static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
           param[i + 2 * ngeom] = ref_geom_param(ref_geom, i, geom);
         ngeom++;
       }
-      RSS(ref_mpi_send(ref_mpi, node_id, 2 * ngeom, REF_INT_TYPE, 0),
+      RSS(ref_mpi_send(ref_mpi, node_id, 2 * ngeom, REF_GLOB_TYPE, 0),
           "send node_id");
       RSS(ref_mpi_send(ref_mpi, param, 2 * ngeom, REF_DBL_TYPE, 0),
           "send param");
@@ -1058,14 +1098,273 @@ static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_gather_int_collective(REF_MPI ref_mpi, void *file,
+                                            long *offset, REF_INT n,
+                                            REF_INT *ints) {
+  REF_INT nrecord = 0;
+  if (ref_mpi_once(ref_mpi)) nrecord = n;
+  RSS(ref_mpi_fwrite_at_all(ref_mpi, file, *offset, ints, sizeof(REF_INT),
+                            nrecord),
+      "write ints");
+  (*offset) += (long)n * (long)sizeof(REF_INT);
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_gather_prefix(REF_MPI ref_mpi, REF_INT nlocal,
+                                    REF_INT *before, REF_INT *total) {
+  REF_INT *counts, part;
+
+  ref_malloc(counts, ref_mpi_n(ref_mpi), REF_INT);
+  RSS(ref_mpi_allgather(ref_mpi, &nlocal, counts, REF_INT_TYPE), "counts");
+  *before = 0;
+  *total = 0;
+  each_ref_mpi_part(ref_mpi, part) {
+    if (part < ref_mpi_rank(ref_mpi)) (*before) += counts[part];
+    (*total) += counts[part];
+  }
+  ref_free(counts);
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_gather_node_collective(REF_NODE ref_node,
+                                             REF_BOOL swap_endian,
+                                             REF_BOOL has_id, void *file,
+                                             long *offset) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_INT chunk, n, nowned, node, i, nrecv;
+  REF_GLOB first;
+  REF_INT record_size;
+  REF_INT *dest;
+  REF_GLOB *send_global, *recv_global;
+  REF_DBL *send_xyz, *recv_xyz, swapped_dbl;
+  REF_BYTE *record;
+  REF_INT id = REF_EXPORT_MESHB_VERTEX_ID;
+
+  /* rank part holds a contiguous block of globals, like ref_gather_node */
+  chunk = (REF_INT)(ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1);
+  first = MIN((REF_GLOB)chunk * (REF_GLOB)ref_mpi_rank(ref_mpi),
+              ref_node_n_global(ref_node));
+  n = (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - first);
+
+  nowned = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) nowned++;
+  }
+  ref_malloc(dest, nowned, REF_INT);
+  ref_malloc(send_global, nowned, REF_GLOB);
+  ref_malloc(send_xyz, 3 * nowned, REF_DBL);
+  nowned = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) {
+      send_global[nowned] = ref_node_global(ref_node, node);
+      dest[nowned] = (REF_INT)(send_global[nowned] / chunk);
+      for (i = 0; i < 3; i++)
+        send_xyz[i + 3 * nowned] = ref_node_xyz(ref_node, i, node);
+      nowned++;
+    }
+  }
+
+  RSS(ref_mpi_blindsend(ref_mpi, dest, (void *)send_global, 1, nowned,
+                        (void **)(&recv_global), &nrecv, REF_GLOB_TYPE),
+      "send globals");
+  RSS(ref_mpi_blindsend(ref_mpi, dest, (void *)send_xyz, 3, nowned,
+                        (void **)(&recv_xyz), &nrecv, REF_DBL_TYPE),
+      "send xyz");
+  REIS(n, nrecv, "each global should be owned once");
+
+  record_size = 3 * (REF_INT)sizeof(REF_DBL);
+  if (has_id) record_size += (REF_INT)sizeof(REF_INT);
+  ref_malloc(record, (long)record_size * (long)n, REF_BYTE);
+  for (i = 0; i < nrecv; i++) {
+    node = (REF_INT)(recv_global[i] - first);
+    RAS(0 <= node && node < n, "global outside of block");
+    swapped_dbl = recv_xyz[0 + 3 * i];
+    if (swap_endian) SWAP_DBL(swapped_dbl);
+    memcpy(&(record[record_size * node]), &swapped_dbl, sizeof(REF_DBL));
+    swapped_dbl = recv_xyz[1 + 3 * i];
+    if (swap_endian) SWAP_DBL(swapped_dbl);
+    memcpy(&(record[record_size * node + 8]), &swapped_dbl, sizeof(REF_DBL));
+    swapped_dbl = recv_xyz[2 + 3 * i];
+    if (swap_endian) SWAP_DBL(swapped_dbl);
+    memcpy(&(record[record_size * node + 16]), &swapped_dbl, sizeof(REF_DBL));
+    if (has_id)
+      memcpy(&(record[record_size * node + 24]), &id, sizeof(REF_INT));
+  }
+
+  RSS(ref_mpi_fwrite_at_all(ref_mpi, file,
+                            *offset + (long)record_size * (long)first, record,
+                            record_size, n),
+      "write nodes");
+  (*offset) += (long)record_size * (long)ref_node_n_global(ref_node);
+
+  ref_free(record);
+  ref_free(recv_xyz);
+  ref_free(recv_global);
+  ref_free(send_xyz);
+  ref_free(send_global);
+  ref_free(dest);
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_gather_cell_collective(
+    REF_NODE ref_node, REF_CELL ref_cell, REF_BOOL faceid_insted_of_c2n,
+    REF_BOOL always_id, REF_BOOL swap_endian, REF_BOOL select_faceid,
+    REF_INT faceid, void *file, long *offset) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_INT cell, node, nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT node_per = ref_cell_node_per(ref_cell);
+  REF_INT ncell, before, total, ints_per;
+  REF_INT *c2n;
+
+  ncell = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, nodes[0]) &&
+        (!select_faceid || nodes[node_per] == faceid))
+      ncell++;
+  }
+  RSS(ref_gather_prefix(ref_mpi, ncell, &before, &total), "prefix");
+  if (0 == total) return REF_SUCCESS;
+
+  if (faceid_insted_of_c2n) {
+    ints_per = 1;
+  } else {
+    ints_per = node_per + (always_id ? 1 : 0);
+  }
+
+  ref_malloc(c2n, ints_per * ncell, REF_INT);
+  ncell = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, nodes[0]) &&
+        (!select_faceid || nodes[node_per] == faceid)) {
+      if (faceid_insted_of_c2n) {
+        c2n[ints_per * ncell] = nodes[node_per];
+      } else {
+        for (node = 0; node < node_per; node++)
+          c2n[node + ints_per * ncell] =
+              (REF_INT)(ref_node_global(ref_node, nodes[node]) + 1);
+        if (always_id) {
+          if (ref_cell_last_node_is_an_id(ref_cell)) {
+            c2n[node_per + ints_per * ncell] = nodes[node_per];
+          } else {
+            c2n[node_per + ints_per * ncell] = REF_EXPORT_MESHB_3D_ID;
+          }
+        }
+      }
+      ncell++;
+    }
+  }
+  if (swap_endian)
+    for (node = 0; node < ints_per * ncell; node++) SWAP_INT(c2n[node]);
+
+  RSS(ref_mpi_fwrite_at_all(
+          ref_mpi, file,
+          *offset + (long)before * (long)ints_per * (long)sizeof(REF_INT), c2n,
+          ints_per * (REF_INT)sizeof(REF_INT), ncell),
+      "write c2n");
+  (*offset) += (long)total * (long)ints_per * (long)sizeof(REF_INT);
+
+  ref_free(c2n);
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_gather_geom_collective(REF_NODE ref_node,
+                                             REF_GEOM ref_geom, REF_INT type,
+                                             void *file, long *offset) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_INT geom, node, i, ngeom, before, total, record_size;
+  REF_BYTE *record;
+  REF_DBL param, filler = 0.0;
+
+  ngeom = 0;
+  each_ref_geom_of(ref_geom, type, geom) {
+    if (ref_node_owned(ref_node, ref_geom_node(ref_geom, geom))) ngeom++;
+  }
+  RSS(ref_gather_prefix(ref_mpi, ngeom, &before, &total), "prefix");
+  if (0 == total) return REF_SUCCESS;
+
+  record_size = 2 * (REF_INT)sizeof(REF_INT) + type * (REF_INT)sizeof(REF_DBL);
+  if (0 < type) record_size += (REF_INT)sizeof(REF_DBL);
+
+  ref_malloc(record, (long)record_size * (long)ngeom, REF_BYTE);
+  ngeom = 0;
+  each_ref_geom_of(ref_geom, type, geom) {
+    if (!ref_node_owned(ref_node, ref_geom_node(ref_geom, geom))) continue;
+    node = (REF_INT)(ref_node_global(ref_node, ref_geom_node(ref_geom, geom)) +
+                     1);
+    memcpy(&(record[record_size * ngeom]), &node, sizeof(REF_INT));
+    memcpy(&(record[record_size * ngeom + 4]), &(ref_geom_id(ref_geom, geom)),
+           sizeof(REF_INT));
+    for (i = 0; i < type; i++) {
+      param = ref_geom_param(ref_geom, i, geom);
+      memcpy(&(record[record_size * ngeom + 8 + 8 * i]), &param,
+             sizeof(REF_DBL));
+    }
+    if (0 < type)
+      memcpy(&(record[record_size * ngeom + 8 + 8 * type]), &filler,
+             sizeof(REF_DBL));
+    ngeom++;
+  }
+
+  RSS(ref_mpi_fwrite_at_all(ref_mpi, file,
+                            *offset + (long)record_size * (long)before, record,
+                            record_size, ngeom),
+      "write geom");
+  (*offset) += (long)record_size * (long)total;
+
+  ref_free(record);
+
+  return REF_SUCCESS;
+}
+
+/* version 2 when it fits, 3 for long positions, 4 for long integers,
+ * never below min_version */
+static REF_STATUS ref_gather_meshb_version(REF_NODE ref_node, REF_CELL *cells,
+                                          REF_GLOB *ncell, REF_GLOB *ngeom,
+                                          REF_INT cad_data_size,
+                                          REF_INT min_version,
+                                          REF_INT *version) {
+  REF_INT i, type;
+  long bytes;
+
+  bytes = 4 + 4 + 4 + 4 + 4;
+  bytes += 4 + 4 + 4 + (long)ref_node_n_global(ref_node) * (3 * 8 + 4);
+  *version = (ref_node_n_global(ref_node) > REF_INT_MAX ? 4 : 2);
+  for (i = 0; i < 3; i++) {
+    if (0 == ncell[i]) continue;
+    if (ncell[i] > REF_INT_MAX) *version = 4;
+    bytes += 4 + 4 + 4 +
+             (long)ncell[i] * (4 * (ref_cell_node_per(cells[i]) + 1));
+  }
+  for (type = 0; type < 3; type++) {
+    if (0 == ngeom[type]) continue;
+    if (ngeom[type] > REF_INT_MAX) *version = 4;
+    bytes += 4 + 4 + 4 + (long)ngeom[type] * (4 * 2 + 8 * type) +
+             (0 < type ? 8 * (long)ngeom[type] : 0);
+  }
+  if (0 < cad_data_size) bytes += 4 + 4 + 4 + cad_data_size;
+  bytes += 4 + 4;
+  if (2 == *version && bytes > REF_INT_MAX) *version = 3;
+  if (*version < min_version) *version = min_version;
+
+  return REF_SUCCESS;
+}
+
 static REF_STATUS ref_gather_meshb(REF_GRID ref_grid, const char *filename) {
   REF_BOOL verbose = REF_FALSE;
   FILE *file;
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT code, version, dim;
-  int next_position, keyword_code;
-  REF_INT ncell, node_per;
-  REF_INT ngeom, type;
+  int keyword_code;
+  long next_position = 0;
+  long header_size, int_size;
+  REF_INT i, node_per;
+  REF_INT type;
+  REF_GLOB ncell[3], ngeom[3];
+  REF_INT cell_keyword[3] = {5, 6, 8};
+  REF_CELL cells[3];
   REF_CELL ref_cell;
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
   REF_BOOL faceid_insted_of_c2n = REF_FALSE;
@@ -1077,6 +1376,23 @@ static REF_STATUS ref_gather_meshb(REF_GRID ref_grid, const char *filename) {
   RAS(!ref_grid_twod(ref_grid), "only 3D");
 
   RSS(ref_node_synchronize_globals(ref_node), "sync");
+
+  cells[0] = ref_grid_edg(ref_grid);
+  cells[1] = ref_grid_tri(ref_grid);
+  cells[2] = ref_grid_tet(ref_grid);
+  for (i = 0; i < 3; i++)
+    RSS(ref_gather_ncell(ref_node, cells[i], &(ncell[i])), "ncell");
+  each_ref_type(ref_geom, type) {
+    RSS(ref_gather_ngeom(ref_node, ref_geom, type, &(ngeom[type])), "ngeom");
+  }
+  RSS(ref_gather_meshb_version(
+          ref_node, cells, ncell, ngeom, ref_geom_cad_data_size(ref_geom),
+          ref_gather_min_meshb_version(ref_grid_gather(ref_grid)), &version),
+      "version");
+  RAS(2 <= version && version <= 4, "meshb version 2, 3, or 4");
+  int_size = (4 == version ? 8 : 4);
+  header_size = 4 + (2 == version ? 4 : 8) + int_size;
+
   file = NULL;
   if (ref_grid_once(ref_grid)) {
     file = fopen(filename, "w");
@@ -1085,130 +1401,84 @@ static REF_STATUS ref_gather_meshb(REF_GRID ref_grid, const char *filename) {
 
     code = 1;
     REIS(1, fwrite(&code, sizeof(int), 1, file), "code");
-    version = 2;
     REIS(1, fwrite(&version, sizeof(int), 1, file), "version");
-    next_position = 4 + 4 + 4 + ftell(file);
+    next_position = header_size - int_size + 4 + ftell(file);
     keyword_code = 3;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
     dim = 3;
     REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
   }
 
   if (ref_grid_once(ref_grid)) {
-    next_position =
-        4 + 4 + 4 + ref_node_n_global(ref_node) * (3 * 8 + 4) + ftell(file);
+    next_position = header_size +
+                    ref_node_n_global(ref_node) * (3 * 8 + int_size) +
+                    ftell(file);
     keyword_code = 4;
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
-    REIS(1, fwrite(&(ref_node_n_global(ref_node)), sizeof(int), 1, file),
-         "nnode");
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
+    RSS(ref_gather_int(file, version, REF_FALSE, ref_node_n_global(ref_node)),
+        "nnode");
     if (verbose)
-      printf("vertex kw %d next %d n %d\n", keyword_code, next_position,
-             ref_node_n_global(ref_node));
+      printf("vertex kw %d next %ld n " REF_GLOB_FMT "\n", keyword_code,
+             next_position, ref_node_n_global(ref_node));
   }
-  RSS(ref_gather_node(ref_node, swap_endian, always_id, file), "nodes");
+  RSS(ref_gather_node(ref_node, version, swap_endian, always_id, file),
+      "nodes");
   if (ref_grid_once(ref_grid))
     REIS(next_position, ftell(file), "vertex inconsistent");
 
-  ref_cell = ref_grid_edg(ref_grid);
-  keyword_code = 5;
-  RSS(ref_gather_ncell(ref_node, ref_cell, &ncell), "ntet");
-  if (verbose)
-    printf("%d: edge ncell %d\n", ref_mpi_rank(ref_grid_mpi(ref_grid)), ncell);
-  if (ncell > 0) {
-    if (ref_grid_once(ref_grid)) {
-      node_per = ref_cell_node_per(ref_cell);
-      next_position = 4 + 4 + 4 + ncell * (4 * (node_per + 1)) + ftell(file);
-      REIS(1, fwrite(&keyword_code, sizeof(int), 1, file),
-           "vertex version code");
-      REIS(1, fwrite(&next_position, sizeof(next_position), 1, file),
-           "next pos");
-      REIS(1, fwrite(&(ncell), sizeof(int), 1, file), "nnode");
-      if (verbose)
-        printf("elem kw %d next %d n %d\n", keyword_code, next_position, ncell);
-    }
-    RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, select_faceid, faceid, file),
-        "nodes");
-    if (ref_grid_once(ref_grid))
-      REIS(next_position, ftell(file), "cell inconsistent");
-  }
-
-  ref_cell = ref_grid_tri(ref_grid);
-  keyword_code = 6;
-  RSS(ref_gather_ncell(ref_node, ref_cell, &ncell), "ntet");
-  if (ncell > 0) {
+  for (i = 0; i < 3; i++) {
+    ref_cell = cells[i];
+    if (0 == ncell[i]) continue;
     if (ref_grid_once(ref_grid)) {
       node_per = ref_cell_node_per(ref_cell);
-      next_position = 4 + 4 + 4 + ncell * (4 * (node_per + 1)) + ftell(file);
+      keyword_code = cell_keyword[i];
+      next_position =
+          header_size + ncell[i] * (int_size * (node_per + 1)) + ftell(file);
       REIS(1, fwrite(&keyword_code, sizeof(int), 1, file),
            "vertex version code");
-      REIS(1, fwrite(&next_position, sizeof(next_position), 1, file),
-           "next pos");
-      REIS(1, fwrite(&(ncell), sizeof(int), 1, file), "nnode");
+      RSS(ref_gather_pos(file, version, next_position), "next pos");
+      RSS(ref_gather_int(file, version, REF_FALSE, ncell[i]), "ncell");
       if (verbose)
-        printf("elem kw %d next %d n %d\n", keyword_code, next_position, ncell);
+        printf("elem kw %d next %ld n " REF_GLOB_FMT "\n", keyword_code,
+               next_position, ncell[i]);
     }
-    RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, select_faceid, faceid, file),
+    RSS(ref_gather_cell(ref_node, ref_cell, version, faceid_insted_of_c2n,
+                        always_id, swap_endian, select_faceid, faceid, file),
         "nodes");
     if (ref_grid_once(ref_grid))
       REIS(next_position, ftell(file), "cell inconsistent");
   }
 
-  ref_cell = ref_grid_tet(ref_grid);
-  keyword_code = 8;
-  RSS(ref_gather_ncell(ref_node, ref_cell, &ncell), "ntet");
-  if (ncell > 0) {
+  each_ref_type(ref_geom, type) {
+    if (0 == ngeom[type]) continue;
     if (ref_grid_once(ref_grid)) {
-      node_per = ref_cell_node_per(ref_cell);
-      next_position = 4 + 4 + 4 + ncell * (4 * (node_per + 1)) + ftell(file);
+      keyword_code = 40 + type; /* GmfVerticesOnGeometricVertices */
+      next_position = header_size + ngeom[type] * (int_size * 2 + 8 * type) +
+                      (0 < type ? 8 * ngeom[type] : 0) + ftell(file);
       REIS(1, fwrite(&keyword_code, sizeof(int), 1, file),
            "vertex version code");
-      REIS(1, fwrite(&next_position, sizeof(next_position), 1, file),
-           "next pos");
-      REIS(1, fwrite(&(ncell), sizeof(int), 1, file), "nnode");
+      RSS(ref_gather_pos(file, version, next_position), "next pos");
+      RSS(ref_gather_int(file, version, REF_FALSE, ngeom[type]), "ngeom");
       if (verbose)
-        printf("elem kw %d next %d n %d\n", keyword_code, next_position, ncell);
+        printf("geom type %d kw %d next %ld n " REF_GLOB_FMT "\n", type,
+               keyword_code, next_position, ngeom[type]);
     }
-    RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, select_faceid, faceid, file),
-        "nodes");
+    RSS(ref_gather_geom(ref_node, ref_geom, version, type, file), "nodes");
     if (ref_grid_once(ref_grid))
       REIS(next_position, ftell(file), "cell inconsistent");
   }
 
-  each_ref_type(ref_geom, type) {
-    keyword_code = 40 + type; /* GmfVerticesOnGeometricVertices */
-    RSS(ref_gather_ngeom(ref_node, ref_geom, type, &ngeom), "ngeom");
-    if (ngeom > 0) {
-      if (ref_grid_once(ref_grid)) {
-        node_per = ref_cell_node_per(ref_cell);
-        next_position = 4 + 4 + 4 + ngeom * (4 * 2 + 8 * type) +
-                        (0 < type ? 8 * ngeom : 0) + ftell(file);
-        REIS(1, fwrite(&keyword_code, sizeof(int), 1, file),
-             "vertex version code");
-        REIS(1, fwrite(&next_position, sizeof(next_position), 1, file),
-             "next pos");
-        REIS(1, fwrite(&(ngeom), sizeof(int), 1, file), "nnode");
-        if (verbose)
-          printf("geom type %d kw %d next %d n %d\n", type, keyword_code,
-                 next_position, ngeom);
-      }
-      RSS(ref_gather_geom(ref_node, ref_geom, type, file), "nodes");
-      if (ref_grid_once(ref_grid))
-        REIS(next_position, ftell(file), "cell inconsistent");
-    }
-  }
-
   if (ref_grid_once(ref_grid) && 0 < ref_geom_cad_data_size(ref_geom)) {
     keyword_code = 126; /* GmfByteFlow */
-    next_position = 4 + 4 + 4 + ref_geom_cad_data_size(ref_geom) + ftell(file);
+    next_position =
+        header_size + ref_geom_cad_data_size(ref_geom) + ftell(file);
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword");
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next");
-    REIS(1, fwrite(&(ref_geom_cad_data_size(ref_geom)), sizeof(int), 1, file),
-         "n");
+    RSS(ref_gather_pos(file, version, next_position), "next");
+    RSS(ref_gather_int(file, version, REF_FALSE,
+                       ref_geom_cad_data_size(ref_geom)),
+        "n");
     REIS(ref_geom_cad_data_size(ref_geom),
          fwrite(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
                 ref_geom_cad_data_size(ref_geom), file),
@@ -1220,8 +1490,8 @@ static REF_STATUS ref_gather_meshb(REF_GRID ref_grid, const char *filename) {
     keyword_code = 54;           /* GmfEnd 101-47 */
     REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
     next_position = 0;
-    REIS(1, fwrite(&next_position, sizeof(next_position), 1, file), "next pos");
-    if (verbose) printf("end kw %d next %d\n", keyword_code, next_position);
+    RSS(ref_gather_pos(file, version, next_position), "next pos");
+    if (verbose) printf("end kw %d next %ld\n", keyword_code, next_position);
     if (verbose) printf("close %s\n", filename);
     fclose(file);
   }
@@ -1229,14 +1499,117 @@ static REF_STATUS ref_gather_meshb(REF_GRID ref_grid, const char *filename) {
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_gather_meshb_collective(REF_GRID ref_grid,
+                                              const char *filename) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_GEOM ref_geom = ref_grid_geom(ref_grid);
+  REF_CELL ref_cell;
+  void *file;
+  long offset, next_position;
+  REF_INT header[5];
+  REF_GLOB ncell, ngeom;
+  REF_INT type, nrecord, i;
+  REF_INT keyword_code[3] = {5, 6, 8};
+  REF_CELL cells[3];
+  REF_BOOL always_id = REF_TRUE;
+
+  RAS(!ref_grid_twod(ref_grid), "only 3D");
+  RAS(2 == ref_gather_min_meshb_version(ref_grid_gather(ref_grid)),
+      "collective meshb only writes version 2");
+
+  RSS(ref_node_synchronize_globals(ref_node), "sync");
+  RSS(ref_mpi_fopen_write(ref_mpi, filename, &file), "open");
+
+  offset = 0;
+  header[0] = 1; /* code */
+  header[1] = 2; /* version, int positions */
+  header[2] = 3; /* dim keyword */
+  header[3] = 20;
+  header[4] = 3;
+  RSS(ref_gather_int_collective(ref_mpi, file, &offset, 5, header), "dim");
+
+  next_position = offset + 12 + (long)ref_node_n_global(ref_node) * (3 * 8 + 4);
+  RAS(next_position <= REF_INT_MAX, "meshb version 2 limited to 2GB");
+  header[0] = 4;
+  header[1] = (REF_INT)next_position;
+  header[2] = (REF_INT)ref_node_n_global(ref_node);
+  RSS(ref_gather_int_collective(ref_mpi, file, &offset, 3, header), "vertex");
+  RSS(ref_gather_node_collective(ref_node, REF_FALSE, always_id, file,
+                                 &offset),
+      "nodes");
+  REIS(next_position, offset, "vertex inconsistent");
+
+  cells[0] = ref_grid_edg(ref_grid);
+  cells[1] = ref_grid_tri(ref_grid);
+  cells[2] = ref_grid_tet(ref_grid);
+  for (i = 0; i < 3; i++) {
+    ref_cell = cells[i];
+    RSS(ref_gather_ncell(ref_node, ref_cell, &ncell), "ncell");
+    if (0 == ncell) continue;
+    next_position =
+        offset + 12 + (long)ncell * (4 * (ref_cell_node_per(ref_cell) + 1));
+    RAS(next_position <= REF_INT_MAX, "meshb version 2 limited to 2GB");
+    header[0] = keyword_code[i];
+    header[1] = (REF_INT)next_position;
+    header[2] = (REF_INT)ncell;
+    RSS(ref_gather_int_collective(ref_mpi, file, &offset, 3, header), "cell");
+    RSS(ref_gather_cell_collective(ref_node, ref_cell, REF_FALSE, always_id,
+                                   REF_FALSE, REF_FALSE, REF_EMPTY, file,
+                                   &offset),
+        "cells");
+    REIS(next_position, offset, "cell inconsistent");
+  }
+
+  each_ref_type(ref_geom, type) {
+    RSS(ref_gather_ngeom(ref_node, ref_geom, type, &ngeom), "ngeom");
+    if (0 == ngeom) continue;
+    next_position = offset + 12 + (long)ngeom * (4 * 2 + 8 * type) +
+                    (0 < type ? 8 * (long)ngeom : 0);
+    RAS(next_position <= REF_INT_MAX, "meshb version 2 limited to 2GB");
+    header[0] = 40 + type; /* GmfVerticesOnGeometricVertices */
+    header[1] = (REF_INT)next_position;
+    header[2] = (REF_INT)ngeom;
+    RSS(ref_gather_int_collective(ref_mpi, file, &offset, 3, header), "geom");
+    RSS(ref_gather_geom_collective(ref_node, ref_geom, type, file, &offset),
+        "geom");
+    REIS(next_position, offset, "geom inconsistent");
+  }
+
+  if (0 < ref_geom_cad_data_size(ref_geom)) {
+    next_position = offset + 12 + ref_geom_cad_data_size(ref_geom);
+    RAS(next_position <= REF_INT_MAX, "meshb version 2 limited to 2GB");
+    header[0] = 126; /* GmfByteFlow */
+    header[1] = (REF_INT)next_position;
+    header[2] = ref_geom_cad_data_size(ref_geom);
+    RSS(ref_gather_int_collective(ref_mpi, file, &offset, 3, header), "cad");
+    nrecord = 0;
+    if (ref_mpi_once(ref_mpi)) nrecord = ref_geom_cad_data_size(ref_geom);
+    RSS(ref_mpi_fwrite_at_all(ref_mpi, file, offset,
+                              ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
+                              nrecord),
+        "cad data");
+    offset = next_position;
+  }
+
+  header[0] = 54; /* GmfEnd 101-47 */
+  header[1] = 0;
+  RSS(ref_gather_int_collective(ref_mpi, file, &offset, 2, header), "end");
+
+  RSS(ref_mpi_fclose(ref_mpi, file), "close");
+
+  return REF_SUCCESS;
+}
+
 static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid, const char *filename,
                                        REF_BOOL swap_endian) {
   FILE *file;
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_INT nnode, ntri, nqua, ntet, npyr, npri, nhex;
+  REF_GLOB nnode, ntri, nqua, ntet, npyr, npri, nhex;
   REF_CELL ref_cell;
   REF_INT group;
   REF_INT faceid, min_faceid, max_faceid;
+  REF_INT version = 2; /* ugrid integers are 32-bit */
   REF_BOOL always_id = REF_FALSE;
   REF_BOOL faceid_insted_of_c2n, select_faceid;
 
@@ -1258,58 +1631,53 @@ static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid, const char *filename,
     if (NULL == (void *)file) printf("unable to open %s\n", filename);
     RNS(file, "unable to open file");
 
-    if (swap_endian) {
-      SWAP_INT(nnode);
-      SWAP_INT(ntri);
-      SWAP_INT(nqua);
-      SWAP_INT(ntet);
-      SWAP_INT(npyr);
-      SWAP_INT(npri);
-      SWAP_INT(nhex);
-    }
-
-    REIS(1, fwrite(&nnode, sizeof(REF_INT), 1, file), "nnode");
+    RSS(ref_gather_int(file, version, swap_endian, nnode), "nnode");
 
-    REIS(1, fwrite(&ntri, sizeof(REF_INT), 1, file), "ntri");
-    REIS(1, fwrite(&nqua, sizeof(REF_INT), 1, file), "nqua");
+    RSS(ref_gather_int(file, version, swap_endian, ntri), "ntri");
+    RSS(ref_gather_int(file, version, swap_endian, nqua), "nqua");
 
-    REIS(1, fwrite(&ntet, sizeof(REF_INT), 1, file), "ntet");
-    REIS(1, fwrite(&npyr, sizeof(REF_INT), 1, file), "npyr");
-    REIS(1, fwrite(&npri, sizeof(REF_INT), 1, file), "npri");
-    REIS(1, fwrite(&nhex, sizeof(REF_INT), 1, file), "nhex");
+    RSS(ref_gather_int(file, version, swap_endian, ntet), "ntet");
+    RSS(ref_gather_int(file, version, swap_endian, npyr), "npyr");
+    RSS(ref_gather_int(file, version, swap_endian, npri), "npri");
+    RSS(ref_gather_int(file, version, swap_endian, nhex), "nhex");
   }
 
-  RSS(ref_gather_node(ref_node, swap_endian, always_id, file), "nodes");
+  RSS(ref_gather_node(ref_node, version, swap_endian, always_id, file),
+      "nodes");
 
   RSS(ref_geom_faceid_range(ref_grid, &min_faceid, &max_faceid), "range");
 
   faceid_insted_of_c2n = REF_FALSE;
   select_faceid = REF_TRUE;
   for (faceid = min_faceid; faceid <= max_faceid; faceid++)
-    RSS(ref_gather_cell(ref_node, ref_grid_tri(ref_grid), faceid_insted_of_c2n,
-                        always_id, swap_endian, select_faceid, faceid, file),
+    RSS(ref_gather_cell(ref_node, ref_grid_tri(ref_grid), version,
+                        faceid_insted_of_c2n, always_id, swap_endian,
+                        select_faceid, faceid, file),
         "tri c2n");
   for (faceid = min_faceid; faceid <= max_faceid; faceid++)
-    RSS(ref_gather_cell(ref_node, ref_grid_qua(ref_grid), faceid_insted_of_c2n,
-                        always_id, swap_endian, select_faceid, faceid, file),
+    RSS(ref_gather_cell(ref_node, ref_grid_qua(ref_grid), version,
+                        faceid_insted_of_c2n, always_id, swap_endian,
+                        select_faceid, faceid, file),
         "qua c2n");
 
   faceid_insted_of_c2n = REF_TRUE;
   for (faceid = min_faceid; faceid <= max_faceid; faceid++)
-    RSS(ref_gather_cell(ref_node, ref_grid_tri(ref_grid), faceid_insted_of_c2n,
-                        always_id, swap_endian, select_faceid, faceid, file),
+    RSS(ref_gather_cell(ref_node, ref_grid_tri(ref_grid), version,
+                        faceid_insted_of_c2n, always_id, swap_endian,
+                        select_faceid, faceid, file),
         "tri faceid");
   for (faceid = min_faceid; faceid <= max_faceid; faceid++)
-    RSS(ref_gather_cell(ref_node, ref_grid_qua(ref_grid), faceid_insted_of_c2n,
-                        always_id, swap_endian, select_faceid, faceid, file),
+    RSS(ref_gather_cell(ref_node, ref_grid_qua(ref_grid), version,
+                        faceid_insted_of_c2n, always_id, swap_endian,
+                        select_faceid, faceid, file),
         "qua faceid");
 
   faceid_insted_of_c2n = REF_FALSE;
   select_faceid = REF_FALSE;
   faceid = REF_EMPTY;
   each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
-    RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, select_faceid, faceid, file),
+    RSS(ref_gather_cell(ref_node, ref_cell, version, faceid_insted_of_c2n,
+                        always_id, swap_endian, select_faceid, faceid, file),
         "cell c2n");
   }
 
@@ -1318,11 +1686,109 @@ static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid, const char *filename,
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_gather_bin_ugrid_collective(REF_GRID ref_grid,
+                                                  const char *filename,
+                                                  REF_BOOL swap_endian) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  void *file;
+  long offset;
+  REF_GLOB count[7];
+  REF_INT header[7], i;
+  REF_INT group;
+  REF_INT faceid, min_faceid, max_faceid;
+  REF_BOOL always_id = REF_FALSE;
+  REF_BOOL faceid_insted_of_c2n, select_faceid;
+
+  RSS(ref_node_synchronize_globals(ref_node), "sync");
+
+  count[0] = ref_node_n_global(ref_node);
+  RSS(ref_gather_ncell(ref_node, ref_grid_tri(ref_grid), &(count[1])), "ntri");
+  RSS(ref_gather_ncell(ref_node, ref_grid_qua(ref_grid), &(count[2])), "nqua");
+  RSS(ref_gather_ncell(ref_node, ref_grid_tet(ref_grid), &(count[3])), "ntet");
+  RSS(ref_gather_ncell(ref_node, ref_grid_pyr(ref_grid), &(count[4])), "npyr");
+  RSS(ref_gather_ncell(ref_node, ref_grid_pri(ref_grid), &(count[5])), "npri");
+  RSS(ref_gather_ncell(ref_node, ref_grid_hex(ref_grid), &(count[6])), "nhex");
+  for (i = 0; i < 7; i++) {
+    RAS(count[i] <= REF_INT_MAX, "ugrid integers are 32-bit");
+    header[i] = (REF_INT)count[i];
+    if (swap_endian) SWAP_INT(header[i]);
+  }
+
+  RSS(ref_mpi_fopen_write(ref_mpi, filename, &file), "open");
+  offset = 0;
+  RSS(ref_gather_int_collective(ref_mpi, file, &offset, 7, header), "header");
+
+  RSS(ref_gather_node_collective(ref_node, swap_endian, always_id, file,
+                                 &offset),
+      "nodes");
+
+  RSS(ref_geom_faceid_range(ref_grid, &min_faceid, &max_faceid), "range");
+
+  faceid_insted_of_c2n = REF_FALSE;
+  select_faceid = REF_TRUE;
+  for (faceid = min_faceid; faceid <= max_faceid; faceid++)
+    RSS(ref_gather_cell_collective(
+            ref_node, ref_grid_tri(ref_grid), faceid_insted_of_c2n, always_id,
+            swap_endian, select_faceid, faceid, file, &offset),
+        "tri c2n");
+  for (faceid = min_faceid; faceid <= max_faceid; faceid++)
+    RSS(ref_gather_cell_collective(
+            ref_node, ref_grid_qua(ref_grid), faceid_insted_of_c2n, always_id,
+            swap_endian, select_faceid, faceid, file, &offset),
+        "qua c2n");
+
+  faceid_insted_of_c2n = REF_TRUE;
+  for (faceid = min_faceid; faceid <= max_faceid; faceid++)
+    RSS(ref_gather_cell_collective(
+            ref_node, ref_grid_tri(ref_grid), faceid_insted_of_c2n, always_id,
+            swap_endian, select_faceid, faceid, file, &offset),
+        "tri faceid");
+  for (faceid = min_faceid; faceid <= max_faceid; faceid++)
+    RSS(ref_gather_cell_collective(
+            ref_node, ref_grid_qua(ref_grid), faceid_insted_of_c2n, always_id,
+            swap_endian, select_faceid, faceid, file, &offset),
+        "qua faceid");
+
+  faceid_insted_of_c2n = REF_FALSE;
+  select_faceid = REF_FALSE;
+  faceid = REF_EMPTY;
+  each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+    RSS(ref_gather_cell_collective(ref_node, ref_cell, faceid_insted_of_c2n,
+                                   always_id, swap_endian, select_faceid,
+                                   faceid, file, &offset),
+        "cell c2n");
+  }
+
+  RSS(ref_mpi_fclose(ref_mpi, file), "close");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_gather_by_extension(REF_GRID ref_grid, const char *filename) {
   size_t end_of_string;
+  REF_BOOL collective = ref_gather_collective(ref_grid_gather(ref_grid));
 
   end_of_string = strlen(filename);
 
+  if (collective) {
+    if (strcmp(&filename[end_of_string - 10], ".lb8.ugrid") == 0) {
+      RSS(ref_gather_bin_ugrid_collective(ref_grid, filename, REF_FALSE),
+          "lb8_ugrid failed");
+      return REF_SUCCESS;
+    }
+    if (strcmp(&filename[end_of_string - 9], ".b8.ugrid") == 0) {
+      RSS(ref_gather_bin_ugrid_collective(ref_grid, filename, REF_TRUE),
+          "b8_ugrid failed");
+      return REF_SUCCESS;
+    }
+    if (strcmp(&filename[end_of_string - 6], ".meshb") == 0) {
+      RSS(ref_gather_meshb_collective(ref_grid, filename), "meshb failed");
+      return REF_SUCCESS;
+    }
+  }
+
   if (strcmp(&filename[end_of_string - 10], ".lb8.ugrid") == 0) {
     RSS(ref_gather_bin_ugrid(ref_grid, filename, REF_FALSE),
         "lb8_ugrid failed");
@@ -1395,10 +1861,10 @@ REF_STATUS ref_gather_scalar(REF_GRID ref_grid, REF_INT ldim, REF_DBL *scalar,
 }
 
 REF_STATUS ref_gather_ncell(REF_NODE ref_node, REF_CELL ref_cell,
-                            REF_INT *ncell) {
+                            REF_GLOB *ncell) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT cell, nodes[REF_CELL_MAX_SIZE_PER];
-  REF_INT ncell_local;
+  REF_GLOB ncell_local;
 
   ncell_local = 0;
   each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
@@ -1407,17 +1873,17 @@ REF_STATUS ref_gather_ncell(REF_NODE ref_node, REF_CELL ref_cell,
     }
   }
 
-  RSS(ref_mpi_sum(ref_mpi, &ncell_local, ncell, 1, REF_INT_TYPE), "sum");
-  RSS(ref_mpi_bcast(ref_mpi, ncell, 1, REF_INT_TYPE), "bcast");
+  RSS(ref_mpi_sum(ref_mpi, &ncell_local, ncell, 1, REF_GLOB_TYPE), "sum");
+  RSS(ref_mpi_bcast(ref_mpi, ncell, 1, REF_GLOB_TYPE), "bcast");
 
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_gather_ngeom(REF_NODE ref_node, REF_GEOM ref_geom, REF_INT type,
-                            REF_INT *ngeom) {
+                            REF_GLOB *ngeom) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT geom, node;
-  REF_INT ngeom_local;
+  REF_GLOB ngeom_local;
 
   ngeom_local = 0;
   each_ref_geom_of(ref_geom, type, geom) {
@@ -1425,8 +1891,8 @@ REF_STATUS ref_gather_ngeom(REF_NODE ref_node, REF_GEOM ref_geom, REF_INT type,
     if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, node)) ngeom_local++;
   }
 
-  RSS(ref_mpi_sum(ref_mpi, &ngeom_local, ngeom, 1, REF_INT_TYPE), "sum");
-  RSS(ref_mpi_bcast(ref_mpi, ngeom, 1, REF_INT_TYPE), "bcast");
+  RSS(ref_mpi_sum(ref_mpi, &ngeom_local, ngeom, 1, REF_GLOB_TYPE), "sum");
+  RSS(ref_mpi_bcast(ref_mpi, ngeom, 1, REF_GLOB_TYPE), "bcast");
 
   return REF_SUCCESS;
 }
@@ -39,8 +39,14 @@ struct REF_GATHER_STRUCT {
   FILE *grid_file;
   FILE *hist_file;
   REF_DBL time;
+  REF_BOOL collective;
+  REF_INT min_meshb_version;
 };
 
+#define ref_gather_collective(ref_gather) ((ref_gather)->collective)
+#define ref_gather_min_meshb_version(ref_gather) \
+  ((ref_gather)->min_meshb_version)
+
 REF_STATUS ref_gather_create(REF_GATHER *ref_gather);
 REF_STATUS ref_gather_free(REF_GATHER ref_gather);
 
@@ -61,9 +67,9 @@ REF_STATUS ref_gather_scalar(REF_GRID ref_grid, REF_INT ldim, REF_DBL *scalar,
                              const char *filename);
 
 REF_STATUS ref_gather_ncell(REF_NODE ref_node, REF_CELL ref_cell,
-                            REF_INT *ncell);
+                            REF_GLOB *ncell);
 REF_STATUS ref_gather_ngeom(REF_NODE ref_node, REF_GEOM ref_geom, REF_INT type,
-                            REF_INT *ngeom);
+                            REF_GLOB *ngeom);
 
 END_C_DECLORATION
 
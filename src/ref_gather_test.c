@@ -104,6 +104,104 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (1 == argc) { /* forced meshb version 3 and 4 round trip */
+    REF_GRID export_grid, import_grid;
+    REF_GEOM ref_geom;
+    REF_INT node, version;
+    REF_GLOB ntri;
+    REF_DBL param[2] = {0.5, 0.25};
+    REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
+    char file[] = "ref_gather_test.meshb";
+
+    RSS(ref_fixture_tet_grid(&export_grid, ref_mpi), "set up tet");
+    ref_geom = ref_grid_geom(export_grid);
+    each_ref_node_valid_node(ref_grid_node(export_grid), node) {
+      RSS(ref_geom_add(ref_geom, node, REF_GEOM_FACE, 1, param), "face");
+    }
+    RSS(ref_gather_ncell(ref_grid_node(export_grid), ref_grid_tri(export_grid),
+                         &ntri),
+        "ntri");
+    for (version = 3; version <= 4; version++) {
+      ref_gather_min_meshb_version(ref_grid_gather(export_grid)) = version;
+      RSS(ref_gather_by_extension(export_grid, file), "gather");
+      if (ref_mpi_once(ref_mpi)) {
+        REF_INT file_version;
+        RSS(ref_import_meshb_header(file, &file_version, key_pos), "head");
+        REIS(version, file_version, "meshb version");
+        RSS(ref_import_by_extension(&import_grid, ref_mpi, file), "import");
+        REIS(4, ref_node_n(ref_grid_node(import_grid)), "nodes");
+        REIS(1, ref_cell_n(ref_grid_tet(import_grid)), "tets");
+        REIS(ntri, ref_cell_n(ref_grid_tri(import_grid)), "tris");
+        REIS(4, ref_geom_n(ref_grid_geom(import_grid)), "geom");
+        RWDS(1.0, ref_node_xyz(ref_grid_node(import_grid), 0, 1), -1,
+             "node 1 x");
+        RWDS(0.25, ref_geom_param(ref_grid_geom(import_grid), 1, 0), -1,
+             "face v");
+        RSS(ref_grid_free(import_grid), "free");
+        REIS(0, remove(file), "test clean up");
+      }
+    }
+    RSS(ref_grid_free(export_grid), "free");
+  }
+
+  if (1 == argc) { /* collective ugrid matches rank 0 gather */
+    REF_GRID ref_grid;
+    char *files[] = {"ref_gather_test.lb8.ugrid", "ref_gather_test.b8.ugrid"};
+    char *collective_files[] = {"ref_gather_test_collective.lb8.ugrid",
+                                "ref_gather_test_collective.b8.ugrid"};
+    REF_INT i;
+
+    RSS(ref_fixture_pri_stack_grid(&ref_grid, ref_mpi), "set up pri");
+
+    for (i = 0; i < 2; i++) {
+      ref_gather_collective(ref_grid_gather(ref_grid)) = REF_FALSE;
+      RSS(ref_gather_by_extension(ref_grid, files[i]), "gather");
+      ref_gather_collective(ref_grid_gather(ref_grid)) = REF_TRUE;
+      RSS(ref_gather_by_extension(ref_grid, collective_files[i]), "gather");
+      if (ref_mpi_once(ref_mpi)) {
+        RSS(ref_fixture_same_file(files[i], collective_files[i]), "same");
+        REIS(0, remove(files[i]), "test clean up");
+        REIS(0, remove(collective_files[i]), "test clean up");
+      }
+    }
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  if (1 == argc) { /* collective meshb with geom and cad matches gather */
+    REF_GRID ref_grid;
+    REF_GEOM ref_geom;
+    REF_INT node;
+    REF_DBL param[2] = {0.5, 0.25};
+    char file[] = "ref_gather_test.meshb";
+    char collective_file[] = "ref_gather_test_collective.meshb";
+
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "set up tet");
+    ref_geom = ref_grid_geom(ref_grid);
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      RSS(ref_geom_add(ref_geom, node, REF_GEOM_FACE, 1, param), "face");
+      if (0 == ref_node_global(ref_grid_node(ref_grid), node))
+        RSS(ref_geom_add(ref_geom, node, REF_GEOM_NODE, 2, param), "node");
+    }
+    ref_geom_cad_data_size(ref_geom) = 3;
+    ref_malloc(ref_geom_cad_data(ref_geom), ref_geom_cad_data_size(ref_geom),
+               REF_BYTE);
+    ref_geom_cad_data(ref_geom)[0] = 5;
+    ref_geom_cad_data(ref_geom)[1] = 4;
+    ref_geom_cad_data(ref_geom)[2] = 3;
+
+    RSS(ref_gather_by_extension(ref_grid, file), "gather");
+    ref_gather_collective(ref_grid_gather(ref_grid)) = REF_TRUE;
+    RSS(ref_gather_by_extension(ref_grid, collective_file), "gather");
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_same_file(file, collective_file), "same");
+      REIS(0, remove(file), "test clean up");
+      REIS(0, remove(collective_file), "test clean up");
+    }
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   if (1 < argc) {
     REF_GRID import_grid;
 
@@ -123,6 +221,17 @@ int main(int argc, char *argv[]) {
         "gather");
     ref_mpi_stopwatch_stop(ref_grid_mpi(import_grid), "b8.ugrid");
 
+    ref_gather_collective(ref_grid_gather(import_grid)) = REF_TRUE;
+    ref_mpi_stopwatch_start(ref_grid_mpi(import_grid));
+    RSS(ref_gather_by_extension(import_grid, "ref_gather_test.meshb"),
+        "gather");
+    ref_mpi_stopwatch_stop(ref_grid_mpi(import_grid), "collective meshb");
+
+    ref_mpi_stopwatch_start(ref_grid_mpi(import_grid));
+    RSS(ref_gather_by_extension(import_grid, "ref_gather_test.b8.ugrid"),
+        "gather");
+    ref_mpi_stopwatch_stop(ref_grid_mpi(import_grid), "collective b8.ugrid");
+
     RSS(ref_grid_free(import_grid), "free");
   }
 
@@ -54,6 +54,8 @@ REF_STATUS ref_geom_initialize(REF_GEOM ref_geom) {
   }
   ref_geom_id(ref_geom, ref_geom_max(ref_geom) - 1) = REF_EMPTY;
   ref_geom_blank(ref_geom) = 0;
+  /* wholesale change, the next sparse check starts over */
+  RSS(ref_geom_untrack_dirty(ref_geom), "untrack");
   if (NULL != (void *)(ref_geom->ref_adj))
     RSS(ref_adj_free(ref_geom->ref_adj), "free to prevent leak");
   RSS(ref_adj_create(&(ref_geom->ref_adj)), "create ref_adj for ref_geom");
@@ -76,6 +78,7 @@ REF_STATUS ref_geom_create(REF_GEOM *ref_geom_ptr) {
              REF_INT);
   ref_malloc(ref_geom->param, 2 * ref_geom_max(ref_geom), REF_DBL);
   ref_geom->ref_adj = (REF_ADJ)NULL;
+  ref_geom_dirty(ref_geom) = (REF_LIST)NULL;
   RSS(ref_geom_initialize(ref_geom), "init geom list");
 
   ref_geom->uv_area_sign = NULL;
@@ -102,11 +105,20 @@ REF_STATUS ref_geom_create(REF_GEOM *ref_geom_ptr) {
   ref_geom->cad_data_size = 0;
   ref_geom->cad_data = (REF_BYTE *)NULL;
 
+  ref_geom->cache_key = (REF_INT *)NULL;
+  ref_geom->cache_param = (REF_DBL *)NULL;
+  ref_geom->cache_value = (REF_DBL *)NULL;
+  ref_geom_cache_hit(ref_geom) = 0;
+  ref_geom_cache_miss(ref_geom) = 0;
+
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_geom_free(REF_GEOM ref_geom) {
   if (NULL == (void *)ref_geom) return REF_NULL;
+  ref_free(ref_geom->cache_value);
+  ref_free(ref_geom->cache_param);
+  ref_free(ref_geom->cache_key);
   ref_free(ref_geom->cad_data);
 #ifdef HAVE_EGADS
   if (NULL != ref_geom->faces) EG_free((ego *)(ref_geom->faces));
@@ -117,6 +129,7 @@ REF_STATUS ref_geom_free(REF_GEOM ref_geom) {
     REIS(EGADS_SUCCESS, EG_close((ego)(ref_geom->context)), "EG close");
 #endif
   RSS(ref_adj_free(ref_geom->ref_adj), "adj free");
+  RSS(ref_geom_untrack_dirty(ref_geom), "untrack");
   ref_free(ref_geom->uv_area_sign);
   ref_free(ref_geom->param);
   ref_free(ref_geom->descr);
@@ -153,6 +166,7 @@ REF_STATUS ref_geom_deep_copy(REF_GEOM *ref_geom_ptr, REF_GEOM original) {
 
   RSS(ref_adj_deep_copy(&(ref_geom->ref_adj), original->ref_adj),
       "deep copy ref_adj for ref_geom");
+  ref_geom_dirty(ref_geom) = (REF_LIST)NULL;
 
   ref_geom->nnode = REF_EMPTY;
   ref_geom->nedge = REF_EMPTY;
@@ -166,6 +180,12 @@ REF_STATUS ref_geom_deep_copy(REF_GEOM *ref_geom_ptr, REF_GEOM original) {
   ref_geom->cad_data_size = 0;
   ref_geom->cad_data = (REF_BYTE *)NULL;
 
+  ref_geom->cache_key = (REF_INT *)NULL;
+  ref_geom->cache_param = (REF_DBL *)NULL;
+  ref_geom->cache_value = (REF_DBL *)NULL;
+  ref_geom_cache_hit(ref_geom) = 0;
+  ref_geom_cache_miss(ref_geom) = 0;
+
   return REF_SUCCESS;
 }
 
@@ -198,6 +218,8 @@ REF_STATUS ref_geom_pack(REF_GEOM ref_geom, REF_INT *o2n) {
     RSS(ref_adj_add(ref_geom->ref_adj, ref_geom_node(ref_geom, geom), geom),
         "register geom");
   }
+  if (NULL != (void *)ref_geom_dirty(ref_geom))
+    RSS(ref_list_apply_o2n(ref_geom_dirty(ref_geom), o2n), "dirty");
 
   return REF_SUCCESS;
 }
@@ -1051,6 +1073,8 @@ REF_STATUS ref_geom_add(REF_GEOM ref_geom, REF_INT node, REF_INT type,
   if (type > 1) ref_geom_param(ref_geom, 1, geom) = param[1];
 
   RSS(ref_adj_add(ref_geom->ref_adj, node, geom), "register geom");
+  if (NULL != (void *)ref_geom_dirty(ref_geom))
+    RSS(ref_list_push(ref_geom_dirty(ref_geom), node), "dirty");
 
   ref_geom_n(ref_geom)++;
 
@@ -1062,6 +1086,8 @@ REF_STATUS ref_geom_remove_all(REF_GEOM ref_geom, REF_INT node) {
   REF_INT item, geom;
 
   item = ref_adj_first(ref_adj, node);
+  if (ref_adj_valid(item) && NULL != (void *)ref_geom_dirty(ref_geom))
+    RSS(ref_list_push(ref_geom_dirty(ref_geom), node), "dirty");
   while (ref_adj_valid(item)) {
     geom = ref_adj_item_ref(ref_adj, item);
     RSS(ref_adj_remove(ref_adj, node, geom), "unregister geom");
@@ -1721,6 +1747,89 @@ REF_STATUS ref_geom_constrain(REF_GRID ref_grid, REF_INT node) {
 
   return REF_SUCCESS;
 }
+
+REF_STATUS ref_geom_cache_reset(REF_GEOM ref_geom) {
+  ref_free(ref_geom->cache_value);
+  ref_free(ref_geom->cache_param);
+  ref_free(ref_geom->cache_key);
+  ref_geom->cache_key = (REF_INT *)NULL;
+  ref_geom->cache_param = (REF_DBL *)NULL;
+  ref_geom->cache_value = (REF_DBL *)NULL;
+  return REF_SUCCESS;
+}
+
+/* params past the entity dimension are ignored, direct mapped slot */
+static void ref_geom_cache_key(REF_INT type, REF_INT id, REF_DBL *params,
+                               REF_INT kind, REF_DBL *key_params,
+                               REF_INT *slot) {
+  unsigned int hash, word[2];
+  REF_INT i;
+  key_params[0] = 0.0;
+  key_params[1] = 0.0;
+  for (i = 0; i < type && i < 2; i++) key_params[i] = params[i];
+  hash = 2166136261u;
+  hash = (hash ^ (unsigned int)type) * 16777619u;
+  hash = (hash ^ (unsigned int)id) * 16777619u;
+  hash = (hash ^ (unsigned int)kind) * 16777619u;
+  for (i = 0; i < 2; i++) {
+    memcpy(word, &(key_params[i]), sizeof(REF_DBL));
+    hash = (hash ^ word[0]) * 16777619u;
+    hash = (hash ^ word[1]) * 16777619u;
+  }
+  *slot = (REF_INT)(hash % (unsigned int)REF_GEOM_CACHE_SIZE);
+}
+
+REF_STATUS ref_geom_cache_find(REF_GEOM ref_geom, REF_INT type, REF_INT id,
+                               REF_DBL *params, REF_INT kind, REF_DBL *values,
+                               REF_BOOL *found) {
+  REF_DBL key_params[2];
+  REF_INT slot, i;
+
+  *found = REF_FALSE;
+  ref_geom_cache_key(type, id, params, kind, key_params, &slot);
+  if (NULL != ref_geom->cache_key &&
+      type == ref_geom->cache_key[0 + 3 * slot] &&
+      id == ref_geom->cache_key[1 + 3 * slot] &&
+      kind == ref_geom->cache_key[2 + 3 * slot] &&
+      key_params[0] == ref_geom->cache_param[0 + 2 * slot] &&
+      key_params[1] == ref_geom->cache_param[1 + 2 * slot]) {
+    for (i = 0; i < REF_GEOM_CACHE_VALUES; i++)
+      values[i] = ref_geom->cache_value[i + REF_GEOM_CACHE_VALUES * slot];
+    *found = REF_TRUE;
+    ref_geom_cache_hit(ref_geom)++;
+  } else {
+    ref_geom_cache_miss(ref_geom)++;
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_geom_cache_store(REF_GEOM ref_geom, REF_INT type, REF_INT id,
+                                REF_DBL *params, REF_INT kind,
+                                REF_DBL *values) {
+  REF_DBL key_params[2];
+  REF_INT slot, i;
+
+  if (NULL == ref_geom->cache_key) {
+    ref_malloc_init(ref_geom->cache_key, 3 * REF_GEOM_CACHE_SIZE, REF_INT,
+                    REF_EMPTY);
+    ref_malloc(ref_geom->cache_param, 2 * REF_GEOM_CACHE_SIZE, REF_DBL);
+    ref_malloc(ref_geom->cache_value,
+               REF_GEOM_CACHE_VALUES * REF_GEOM_CACHE_SIZE, REF_DBL);
+  }
+
+  ref_geom_cache_key(type, id, params, kind, key_params, &slot);
+  ref_geom->cache_key[0 + 3 * slot] = type;
+  ref_geom->cache_key[1 + 3 * slot] = id;
+  ref_geom->cache_key[2 + 3 * slot] = kind;
+  ref_geom->cache_param[0 + 2 * slot] = key_params[0];
+  ref_geom->cache_param[1 + 2 * slot] = key_params[1];
+  for (i = 0; i < REF_GEOM_CACHE_VALUES; i++)
+    ref_geom->cache_value[i + REF_GEOM_CACHE_VALUES * slot] = values[i];
+
+  return REF_SUCCESS;
+}
+
 /*
   [x_t,y_t,z_t] edge
   [x_tt,y_tt,z_tt]
@@ -1747,7 +1856,7 @@ REF_STATUS ref_geom_eval(REF_GEOM ref_geom, REF_INT geom, REF_DBL *xyz,
 REF_STATUS ref_geom_eval_at(REF_GEOM ref_geom, REF_INT type, REF_INT id,
                             REF_DBL *params, REF_DBL *xyz, REF_DBL *dxyz_dtuv) {
 #ifdef HAVE_EGADS
-  double eval[18];
+  double eval[REF_GEOM_CACHE_VALUES];
   REF_INT i;
   ego *nodes, *edges, *faces;
   ego object;
@@ -1786,6 +1895,25 @@ REF_STATUS ref_geom_eval_at(REF_GEOM ref_geom, REF_INT type, REF_INT id,
       RSS(REF_IMPLEMENT, "unknown geom");
   }
 
+  {
+    REF_BOOL found;
+    RSS(ref_geom_cache_find(ref_geom, type, id, params, REF_GEOM_CACHE_EVAL,
+                            eval, &found),
+        "cache find");
+    if (found) {
+      xyz[0] = eval[0];
+      xyz[1] = eval[1];
+      xyz[2] = eval[2];
+      if (NULL != dxyz_dtuv) {
+        for (i = 0; i < 6; i++) dxyz_dtuv[i] = eval[3 + i];
+        if (REF_GEOM_FACE == type)
+          for (i = 0; i < 9; i++) dxyz_dtuv[6 + i] = eval[9 + i];
+      }
+      return REF_SUCCESS;
+    }
+  }
+
+  for (i = 0; i < REF_GEOM_CACHE_VALUES; i++) eval[i] = 0.0;
   status = EG_evaluate(object, params, eval);
   if (EGADS_SUCCESS != status) {
     ego ref, *pchldrn;
@@ -1801,6 +1929,9 @@ REF_STATUS ref_geom_eval_at(REF_GEOM ref_geom, REF_INT type, REF_INT id,
     printf("trange %f %f\n", trange[0], trange[1]);
     REIS(EGADS_SUCCESS, status, "eval");
   }
+  RSS(ref_geom_cache_store(ref_geom, type, id, params, REF_GEOM_CACHE_EVAL,
+                           eval),
+      "cache store");
   xyz[0] = eval[0];
   xyz[1] = eval[1];
   xyz[2] = eval[2];
@@ -1939,12 +2070,14 @@ REF_STATUS ref_geom_inverse_eval(REF_GEOM ref_geom, REF_INT type, REF_INT id,
 REF_STATUS ref_geom_face_curvature(REF_GEOM ref_geom, REF_INT geom, REF_DBL *kr,
                                    REF_DBL *r, REF_DBL *ks, REF_DBL *s) {
 #ifdef HAVE_EGADS
-  double curvature[8];
+  double curvature[REF_GEOM_CACHE_VALUES];
   ego *faces;
   ego object;
   int egads_status;
   int faceid;
   double uv[2];
+  REF_INT i;
+  REF_BOOL found;
   RNS(ref_geom->faces, "faces not loaded");
   faceid = ref_geom_id(ref_geom, geom);
   faces = (ego *)(ref_geom->faces);
@@ -1953,7 +2086,22 @@ REF_STATUS ref_geom_face_curvature(REF_GEOM ref_geom, REF_INT geom, REF_DBL *kr,
 
   uv[0] = ref_geom_param(ref_geom, 0, geom);
   uv[1] = ref_geom_param(ref_geom, 1, geom);
-  egads_status = EG_curvature(object, uv, curvature);
+  /* degen faces are shifted off the param, only cache the direct query */
+  found = REF_FALSE;
+  if (0 == ref_geom_degen(ref_geom, geom))
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_FACE, faceid, uv,
+                            REF_GEOM_CACHE_CURVATURE, curvature, &found),
+        "cache find");
+  if (found) {
+    egads_status = EGADS_SUCCESS;
+  } else {
+    for (i = 0; i < REF_GEOM_CACHE_VALUES; i++) curvature[i] = 0.0;
+    egads_status = EG_curvature(object, uv, curvature);
+    if (EGADS_SUCCESS == egads_status && 0 == ref_geom_degen(ref_geom, geom))
+      RSS(ref_geom_cache_store(ref_geom, REF_GEOM_FACE, faceid, uv,
+                               REF_GEOM_CACHE_CURVATURE, curvature),
+          "cache store");
+  }
   if (0 != ref_geom_degen(ref_geom, geom) || EGADS_DEGEN == egads_status) {
     REF_DBL xyz[3], dxyz_duv[15], du, dv;
     ego ref, *pchldrn;
@@ -2184,149 +2332,229 @@ REF_STATUS ref_geom_verify_param(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_geom_verify_topo(REF_GRID ref_grid) {
+static REF_STATUS ref_geom_verify_topo_node(REF_GRID ref_grid, REF_INT node) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
-  REF_CELL ref_cell;
-  REF_INT node;
   REF_INT item, geom;
   REF_BOOL geom_node, geom_edge, geom_face;
   REF_BOOL no_face, no_edge;
   REF_BOOL found_one;
   REF_BOOL found_too_many;
-  REF_INT cell, ncell, cell_list[2];
 
-  for (node = 0; node < ref_node_max(ref_node); node++) {
-    if (ref_node_valid(ref_node, node)) {
-      RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_NODE, &geom_node), "node");
-      RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_EDGE, &geom_edge), "edge");
-      RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_FACE, &geom_face), "face");
-      no_face = ref_cell_node_empty(ref_grid_tri(ref_grid), node) &&
-                ref_cell_node_empty(ref_grid_qua(ref_grid), node);
-      no_edge = ref_cell_node_empty(ref_grid_edg(ref_grid), node);
-      if (geom_node) {
-        if (no_edge && ref_node_owned(ref_node, node)) {
-          THROW("geom node missing edge");
-        }
-        if (no_face && ref_node_owned(ref_node, node)) {
-          THROW("geom node missing tri or qua");
-        }
+  if (ref_node_valid(ref_node, node)) {
+    RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_NODE, &geom_node), "node");
+    RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_EDGE, &geom_edge), "edge");
+    RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_FACE, &geom_face), "face");
+    no_face = ref_cell_node_empty(ref_grid_tri(ref_grid), node) &&
+              ref_cell_node_empty(ref_grid_qua(ref_grid), node);
+    no_edge = ref_cell_node_empty(ref_grid_edg(ref_grid), node);
+    if (geom_node) {
+      if (no_edge && ref_node_owned(ref_node, node)) {
+        THROW("geom node missing edge");
       }
-      if (geom_edge) {
-        if (no_edge && ref_node_owned(ref_node, node)) {
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("geom edge missing edge");
-        }
-        if (no_face && ref_node_owned(ref_node, node)) {
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("geom edge missing tri or qua");
-        }
+      if (no_face && ref_node_owned(ref_node, node)) {
+        THROW("geom node missing tri or qua");
       }
-      if (geom_face) {
-        if (no_face && ref_node_owned(ref_node, node)) {
-          printf("no face for geom\n");
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("geom face missing tri or qua");
-        }
+    }
+    if (geom_edge) {
+      if (no_edge && ref_node_owned(ref_node, node)) {
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("geom edge missing edge");
       }
-      if (!no_edge) {
-        if (!geom_edge) {
-          printf("no geom for edge\n");
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("geom edge missing for edg");
-        }
+      if (no_face && ref_node_owned(ref_node, node)) {
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("geom edge missing tri or qua");
       }
-      if (!no_face) {
-        if (!geom_face) {
-          printf("no geom for face\n");
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("geom face missing tri or qua");
-        }
+    }
+    if (geom_face) {
+      if (no_face && ref_node_owned(ref_node, node)) {
+        printf("no face for geom\n");
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("geom face missing tri or qua");
       }
-      if (geom_edge && !geom_node) {
-        found_one = REF_FALSE;
-        found_too_many = REF_FALSE;
-        each_ref_geom_having_node(ref_geom, node, item, geom) {
-          if (REF_GEOM_EDGE == ref_geom_type(ref_geom, geom)) {
-            if (found_one) found_too_many = REF_TRUE;
-            found_one = REF_TRUE;
-          }
-        }
-        if (!found_one || found_too_many) {
-          if (!found_one) printf("none found\n");
-          if (found_too_many) printf("found too many\n");
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("multiple geom edge away from geom node");
-        }
+    }
+    if (!no_edge) {
+      if (!geom_edge) {
+        printf("no geom for edge\n");
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("geom edge missing for edg");
       }
-      if (geom_face && !geom_edge) {
-        found_one = REF_FALSE;
-        found_too_many = REF_FALSE;
-        each_ref_adj_node_item_with_ref(ref_geom_adj(ref_geom), node, item,
-                                        geom) {
-          if (REF_GEOM_FACE == ref_geom_type(ref_geom, geom)) {
-            if (found_one) found_too_many = REF_TRUE;
-            found_one = REF_TRUE;
-          }
+    }
+    if (!no_face) {
+      if (!geom_face) {
+        printf("no geom for face\n");
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("geom face missing tri or qua");
+      }
+    }
+    if (geom_edge && !geom_node) {
+      found_one = REF_FALSE;
+      found_too_many = REF_FALSE;
+      each_ref_geom_having_node(ref_geom, node, item, geom) {
+        if (REF_GEOM_EDGE == ref_geom_type(ref_geom, geom)) {
+          if (found_one) found_too_many = REF_TRUE;
+          found_one = REF_TRUE;
         }
-        if (!found_one || found_too_many) {
-          if (!found_one) printf("none found\n");
-          if (found_too_many) printf("found too many\n");
-          RSS(ref_node_location(ref_node, node), "loc");
-          RSS(ref_geom_tattle(ref_geom, node), "tatt");
-          RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
-              "geom tec");
-          THROW("multiple geom face away from geom edge");
+      }
+      if (!found_one || found_too_many) {
+        if (!found_one) printf("none found\n");
+        if (found_too_many) printf("found too many\n");
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("multiple geom edge away from geom node");
+      }
+    }
+    if (geom_face && !geom_edge) {
+      found_one = REF_FALSE;
+      found_too_many = REF_FALSE;
+      each_ref_adj_node_item_with_ref(ref_geom_adj(ref_geom), node, item,
+                                      geom) {
+        if (REF_GEOM_FACE == ref_geom_type(ref_geom, geom)) {
+          if (found_one) found_too_many = REF_TRUE;
+          found_one = REF_TRUE;
         }
       }
-    } else {
-      if (!ref_adj_empty(ref_geom_adj(ref_geom), node))
-        THROW("invalid node has geom");
+      if (!found_one || found_too_many) {
+        if (!found_one) printf("none found\n");
+        if (found_too_many) printf("found too many\n");
+        RSS(ref_node_location(ref_node, node), "loc");
+        RSS(ref_geom_tattle(ref_geom, node), "tatt");
+        RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"),
+            "geom tec");
+        THROW("multiple geom face away from geom edge");
+      }
     }
+  } else {
+    if (!ref_adj_empty(ref_geom_adj(ref_geom), node))
+      THROW("invalid node has geom");
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_geom_verify_topo_edg(REF_GRID ref_grid, REF_INT cell) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_GEOM ref_geom = ref_grid_geom(ref_grid);
+  REF_CELL ref_cell = ref_grid_edg(ref_grid);
+  REF_INT ncell, cell_list[2];
+
+  RSS(ref_cell_list_with2(ref_cell, ref_cell_c2n(ref_cell, 0, cell),
+                          ref_cell_c2n(ref_cell, 1, cell), 2, &ncell,
+                          cell_list),
+      "edge list for edge");
+  if (2 == ncell) {
+    printf("error: two edg found with same nodes\n");
+    printf("edg %d n %d %d id %d\n", cell_list[0],
+           ref_cell_c2n(ref_cell, 0, cell_list[0]),
+           ref_cell_c2n(ref_cell, 1, cell_list[0]),
+           ref_cell_c2n(ref_cell, 2, cell_list[0]));
+    printf("edg %d n %d %d id %d\n", cell_list[1],
+           ref_cell_c2n(ref_cell, 0, cell_list[1]),
+           ref_cell_c2n(ref_cell, 1, cell_list[1]),
+           ref_cell_c2n(ref_cell, 2, cell_list[1]));
+    RSS(ref_node_location(ref_node, ref_cell_c2n(ref_cell, 0, cell)), "loc");
+    RSS(ref_node_location(ref_node, ref_cell_c2n(ref_cell, 1, cell)), "loc");
+    RSS(ref_geom_tattle(ref_geom, ref_cell_c2n(ref_cell, 0, cell)), "tatt");
+    RSS(ref_geom_tattle(ref_geom, ref_cell_c2n(ref_cell, 1, cell)), "tatt");
+    RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"), "geom tec");
+  }
+  REIS(1, ncell, "expect only one edge cell for two nodes");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_geom_verify_topo(REF_GRID ref_grid) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_edg(ref_grid);
+  REF_INT node, cell;
+
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    RSS(ref_geom_verify_topo_node(ref_grid, node), "node topo");
   }
 
-  ref_cell = ref_grid_edg(ref_grid);
   each_ref_cell_valid_cell(ref_cell, cell) {
-    RSS(ref_cell_list_with2(ref_cell, ref_cell_c2n(ref_cell, 0, cell),
-                            ref_cell_c2n(ref_cell, 1, cell), 2, &ncell,
-                            cell_list),
-        "edge list for edge");
-    if (2 == ncell) {
-      printf("error: two edg found with same nodes\n");
-      printf("edg %d n %d %d id %d\n", cell_list[0],
-             ref_cell_c2n(ref_cell, 0, cell_list[0]),
-             ref_cell_c2n(ref_cell, 1, cell_list[0]),
-             ref_cell_c2n(ref_cell, 2, cell_list[0]));
-      printf("edg %d n %d %d id %d\n", cell_list[1],
-             ref_cell_c2n(ref_cell, 0, cell_list[1]),
-             ref_cell_c2n(ref_cell, 1, cell_list[1]),
-             ref_cell_c2n(ref_cell, 2, cell_list[1]));
-      RSS(ref_node_location(ref_node, ref_cell_c2n(ref_cell, 0, cell)), "loc");
-      RSS(ref_node_location(ref_node, ref_cell_c2n(ref_cell, 1, cell)), "loc");
-      RSS(ref_geom_tattle(ref_geom, ref_cell_c2n(ref_cell, 0, cell)), "tatt");
-      RSS(ref_geom_tattle(ref_geom, ref_cell_c2n(ref_cell, 1, cell)), "tatt");
-      RSS(ref_geom_tec_para_shard(ref_grid, "ref_geom_topo_error"), "geom tec");
+    RSS(ref_geom_verify_topo_edg(ref_grid, cell), "edg topo");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_geom_track_dirty(REF_GEOM ref_geom) {
+  if (NULL != (void *)ref_geom_dirty(ref_geom)) return REF_SUCCESS;
+  RSS(ref_list_create(&(ref_geom_dirty(ref_geom))), "create dirty");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_geom_untrack_dirty(REF_GEOM ref_geom) {
+  if (NULL == (void *)ref_geom_dirty(ref_geom)) return REF_SUCCESS;
+  RSS(ref_list_free(ref_geom_dirty(ref_geom)), "free dirty");
+  ref_geom_dirty(ref_geom) = (REF_LIST)NULL;
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_geom_verify_topo_dirty(REF_GRID ref_grid) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_GEOM ref_geom = ref_grid_geom(ref_grid);
+  REF_CELL edg = ref_grid_edg(ref_grid);
+  REF_CELL tri = ref_grid_tri(ref_grid);
+  REF_CELL qua = ref_grid_qua(ref_grid);
+  REF_LIST lists[4];
+  REF_INT i, item, node, cell;
+
+  lists[0] = ref_cell_dirty(edg);
+  lists[1] = ref_cell_dirty(tri);
+  lists[2] = ref_cell_dirty(qua);
+  lists[3] = ref_geom_dirty(ref_geom);
+  if (NULL == (void *)lists[0] || NULL == (void *)lists[1] ||
+      NULL == (void *)lists[2] || NULL == (void *)lists[3]) {
+    RSS(ref_cell_track_dirty(edg), "track edg");
+    RSS(ref_cell_track_dirty(tri), "track tri");
+    RSS(ref_cell_track_dirty(qua), "track qua");
+    RSS(ref_geom_track_dirty(ref_geom), "track geom");
+    RSS(ref_list_erase(ref_cell_dirty(edg)), "erase edg");
+    RSS(ref_list_erase(ref_cell_dirty(tri)), "erase tri");
+    RSS(ref_list_erase(ref_cell_dirty(qua)), "erase qua");
+    RSS(ref_list_erase(ref_geom_dirty(ref_geom)), "erase geom");
+    RSS(ref_geom_verify_topo(ref_grid), "full check to start");
+    return REF_SUCCESS;
+  }
+
+  /* gather into the geom list, sorted so each node is checked once */
+  for (i = 0; i < 3; i++) {
+    each_ref_list_item(lists[i], item) {
+      RSS(ref_list_push(lists[3], ref_list_value(lists[i], item)), "push");
     }
-    REIS(1, ncell, "expect only one edge cell for two nodes");
+    RSS(ref_list_erase(lists[i]), "erase");
   }
+  RSS(ref_list_sort(lists[3]), "sort dirty");
+
+  each_ref_list_item(lists[3], i) {
+    node = ref_list_value(lists[3], i);
+    if (i > 0 && node == ref_list_value(lists[3], i - 1)) continue;
+    if (node < 0 || ref_node_max(ref_node) <= node) continue;
+    RSS(ref_geom_verify_topo_node(ref_grid, node), "node topo");
+    each_ref_cell_having_node(edg, node, item, cell) {
+      RSS(ref_geom_verify_topo_edg(ref_grid, cell), "edg topo");
+    }
+  }
+  RSS(ref_list_erase(lists[3]), "erase");
 
   return REF_SUCCESS;
 }
@@ -2340,7 +2568,8 @@ REF_STATUS ref_geom_tetgen_volume(REF_GRID ref_grid) {
   char *ele_name = "ref_geom_test.1.ele";
   char command[1024];
   FILE *file;
-  REF_INT nnode, ndim, attr, mark, global;
+  REF_INT nnode, ndim, attr, mark;
+  REF_GLOB global;
   REF_INT ntet, node_per;
   REF_INT node, nnode_surface, item, new_node;
   REF_DBL xyz[3], dist;
@@ -2448,7 +2677,8 @@ static REF_STATUS ref_import_ugrid_tets(REF_GRID ref_grid,
   FILE *file;
   REF_INT nnode, ntri, nqua, ntet, npyr, npri, nhex;
   REF_DBL xyz[3];
-  REF_INT new_node, orig_nnode, node, tri, global;
+  REF_INT new_node, orig_nnode, node, tri;
+  REF_GLOB global;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT qua;
   REF_INT face_id;
@@ -2610,6 +2840,7 @@ REF_STATUS ref_geom_egads_load(REF_GEOM ref_geom, const char *filename) {
        "EG topo body type");
   REIS(SOLIDBODY, mtype, "expected SOLIDBODY");
   ref_geom->solid = (void *)solid;
+  RSS(ref_geom_cache_reset(ref_geom), "new model invalidates cache");
 
   REIS(EGADS_SUCCESS, EG_getBodyTopos(solid, NULL, NODE, &nnode, &nodes),
        "EG node topo");
@@ -3374,11 +3605,12 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT *a_nnode, *b_nnode;
   REF_INT a_nnode_total, b_nnode_total;
-  REF_INT *a_global, *b_global;
+  REF_GLOB *a_global, *b_global;
   REF_INT *a_part, *b_part;
   REF_INT *a_ngeom, *b_ngeom;
   REF_INT a_ngeom_total, b_ngeom_total;
   REF_INT *a_descr, *b_descr;
+  REF_GLOB *a_node, *b_node;
   REF_DBL *a_param, *b_param;
   REF_INT part, node, degree;
   REF_INT *a_next, *b_next;
@@ -3404,12 +3636,12 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
 
   a_nnode_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_nnode_total += a_nnode[part];
-  ref_malloc(a_global, a_nnode_total, REF_INT);
+  ref_malloc(a_global, a_nnode_total, REF_GLOB);
   ref_malloc(a_part, a_nnode_total, REF_INT);
 
   b_nnode_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_nnode_total += b_nnode[part];
-  ref_malloc(b_global, b_nnode_total, REF_INT);
+  ref_malloc(b_global, b_nnode_total, REF_GLOB);
   ref_malloc(b_part, b_nnode_total, REF_INT);
 
   a_next[0] = 0;
@@ -3427,7 +3659,7 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_global, a_nnode, b_global, b_nnode, 1,
-                        REF_INT_TYPE),
+                        REF_GLOB_TYPE),
       "alltoallv global");
   RSS(ref_mpi_alltoallv(ref_mpi, a_part, a_nnode, b_part, b_nnode, 1,
                         REF_INT_TYPE),
@@ -3448,11 +3680,13 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
   a_ngeom_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_ngeom_total += a_ngeom[part];
   ref_malloc(a_descr, REF_GEOM_DESCR_SIZE * a_ngeom_total, REF_INT);
+  ref_malloc(a_node, a_ngeom_total, REF_GLOB);
   ref_malloc(a_param, 2 * a_ngeom_total, REF_DBL);
 
   b_ngeom_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_ngeom_total += b_ngeom[part];
   ref_malloc(b_descr, REF_GEOM_DESCR_SIZE * b_ngeom_total, REF_INT);
+  ref_malloc(b_node, b_ngeom_total, REF_GLOB);
   ref_malloc(b_param, 2 * b_ngeom_total, REF_DBL);
 
   b_next[0] = 0;
@@ -3468,7 +3702,7 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
         b_descr[i + REF_GEOM_DESCR_SIZE * b_next[part]] =
             ref_geom_descr(ref_geom, i, geom);
       }
-      b_descr[REF_GEOM_DESCR_NODE + REF_GEOM_DESCR_SIZE * b_next[part]] =
+      b_node[b_next[part]] =
           ref_node_global(ref_node, ref_geom_node(ref_geom, geom));
       b_param[0 + 2 * b_next[part]] = ref_geom_param(ref_geom, 0, geom);
       b_param[1 + 2 * b_next[part]] = ref_geom_param(ref_geom, 1, geom);
@@ -3479,13 +3713,15 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
   RSS(ref_mpi_alltoallv(ref_mpi, b_descr, b_ngeom, a_descr, a_ngeom,
                         REF_GEOM_DESCR_SIZE, REF_INT_TYPE),
       "alltoallv descr");
+  RSS(ref_mpi_alltoallv(ref_mpi, b_node, b_ngeom, a_node, a_ngeom, 1,
+                        REF_GLOB_TYPE),
+      "alltoallv node");
   RSS(ref_mpi_alltoallv(ref_mpi, b_param, b_ngeom, a_param, a_ngeom, 2,
                         REF_DBL_TYPE),
       "alltoallv param");
 
   for (geom = 0; geom < a_ngeom_total; geom++) {
-    node = a_descr[REF_GEOM_DESCR_NODE + REF_GEOM_DESCR_SIZE * geom];
-    RSS(ref_node_local(ref_node, node, &local), "g2l");
+    RSS(ref_node_local(ref_node, a_node[geom], &local), "g2l");
     a_descr[REF_GEOM_DESCR_NODE + REF_GEOM_DESCR_SIZE * geom] = local;
     RSS(ref_geom_add_with_descr(ref_geom,
                                 &(a_descr[REF_GEOM_DESCR_SIZE * geom]),
@@ -3494,8 +3730,10 @@ REF_STATUS ref_geom_ghost(REF_GEOM ref_geom, REF_NODE ref_node) {
   }
 
   free(b_param);
+  free(b_node);
   free(b_descr);
   free(a_param);
+  free(a_node);
   free(a_descr);
   free(b_part);
   free(b_global);
@@ -50,10 +50,16 @@ typedef enum REF_GEOM_SURFACES {
 #define REF_GEOM_DESCR_DEGEN (3)
 #define REF_GEOM_DESCR_NODE (4)
 
+#define REF_GEOM_CACHE_SIZE (4096)
+#define REF_GEOM_CACHE_EVAL (0)
+#define REF_GEOM_CACHE_CURVATURE (1)
+#define REF_GEOM_CACHE_VALUES (18)
+
 END_C_DECLORATION
 
 #include "ref_adj.h"
 #include "ref_grid.h"
+#include "ref_list.h"
 
 BEGIN_C_DECLORATION
 
@@ -73,6 +79,11 @@ struct REF_GEOM_STRUCT {
   void *nodes;
   REF_INT cad_data_size;
   REF_BYTE *cad_data;
+  REF_INT *cache_key;
+  REF_DBL *cache_param;
+  REF_DBL *cache_value;
+  REF_INT cache_hit, cache_miss;
+  REF_LIST dirty;
 };
 
 #define ref_geom_n(ref_geom) ((ref_geom)->n)
@@ -82,6 +93,12 @@ struct REF_GEOM_STRUCT {
 #define ref_geom_cad_data(ref_geom) ((ref_geom)->cad_data)
 #define ref_geom_cad_data_size(ref_geom) ((ref_geom)->cad_data_size)
 
+/* nodes gaining or losing geom since the last erase, or NULL */
+#define ref_geom_dirty(ref_geom) ((ref_geom)->dirty)
+
+#define ref_geom_cache_hit(ref_geom) ((ref_geom)->cache_hit)
+#define ref_geom_cache_miss(ref_geom) ((ref_geom)->cache_miss)
+
 #define ref_geom_model_loaded(ref_geom) (NULL != (void *)((ref_geom)->solid))
 
 #define ref_geom_descr(ref_geom, attribute, geom) \
@@ -193,6 +210,15 @@ REF_STATUS ref_geom_tri_uv_bounding_box2(REF_GRID ref_grid, REF_INT node0,
 
 REF_STATUS ref_geom_constrain(REF_GRID ref_grid, REF_INT node);
 
+/* CAD evaluations keyed by (type, id, param), a moved param misses */
+REF_STATUS ref_geom_cache_reset(REF_GEOM ref_geom);
+REF_STATUS ref_geom_cache_find(REF_GEOM ref_geom, REF_INT type, REF_INT id,
+                               REF_DBL *params, REF_INT kind, REF_DBL *values,
+                               REF_BOOL *found);
+REF_STATUS ref_geom_cache_store(REF_GEOM ref_geom, REF_INT type, REF_INT id,
+                                REF_DBL *params, REF_INT kind,
+                                REF_DBL *values);
+
 REF_STATUS ref_geom_eval(REF_GEOM ref_geom, REF_INT geom, REF_DBL *xyz,
                          REF_DBL *dxyz_dtuv);
 REF_STATUS ref_geom_eval_at(REF_GEOM ref_geom, REF_INT type, REF_INT id,
@@ -212,6 +238,11 @@ REF_STATUS ref_geom_tri_norm_deviation(REF_GRID ref_grid, REF_INT *nodes,
 
 REF_STATUS ref_geom_verify_param(REF_GRID ref_grid);
 REF_STATUS ref_geom_verify_topo(REF_GRID ref_grid);
+/* checks the nodes touched since the last call, full check to start */
+REF_STATUS ref_geom_verify_topo_dirty(REF_GRID ref_grid);
+
+REF_STATUS ref_geom_track_dirty(REF_GEOM ref_geom);
+REF_STATUS ref_geom_untrack_dirty(REF_GEOM ref_geom);
 
 REF_STATUS ref_geom_egads_export(const char *filename);
 
@@ -212,6 +212,95 @@ int main(int argc, char *argv[]) {
     RSS(ref_geom_free(ref_geom), "cleanup");
   }
 
+  { /* cache hit, moved param and other kind miss */
+    REF_GEOM ref_geom;
+    REF_DBL params[2], values[REF_GEOM_CACHE_VALUES];
+    REF_DBL stored[REF_GEOM_CACHE_VALUES];
+    REF_INT i;
+    REF_BOOL found;
+    RSS(ref_geom_create(&ref_geom), "create");
+    for (i = 0; i < REF_GEOM_CACHE_VALUES; i++) stored[i] = (REF_DBL)i;
+    params[0] = 0.25;
+    params[1] = 0.5;
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_FACE, 3, params,
+                            REF_GEOM_CACHE_EVAL, values, &found),
+        "find empty");
+    RAS(!found, "empty cache hit");
+    RSS(ref_geom_cache_store(ref_geom, REF_GEOM_FACE, 3, params,
+                             REF_GEOM_CACHE_EVAL, stored),
+        "store");
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_FACE, 3, params,
+                            REF_GEOM_CACHE_EVAL, values, &found),
+        "find");
+    RAS(found, "stored miss");
+    for (i = 0; i < REF_GEOM_CACHE_VALUES; i++)
+      RWDS(stored[i], values[i], -1, "value");
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_FACE, 3, params,
+                            REF_GEOM_CACHE_CURVATURE, values, &found),
+        "find curvature");
+    RAS(!found, "other kind hit");
+    params[1] = 0.5000001;
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_FACE, 3, params,
+                            REF_GEOM_CACHE_EVAL, values, &found),
+        "find moved");
+    RAS(!found, "moved param hit");
+    REIS(1, ref_geom_cache_hit(ref_geom), "hits");
+    REIS(3, ref_geom_cache_miss(ref_geom), "misses");
+    RSS(ref_geom_cache_store(ref_geom, REF_GEOM_EDGE, 3, params,
+                             REF_GEOM_CACHE_EVAL, stored),
+        "store edge");
+    params[1] = 7.0;
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_EDGE, 3, params,
+                            REF_GEOM_CACHE_EVAL, values, &found),
+        "find edge");
+    RAS(found, "edge ignores second param");
+    RSS(ref_geom_cache_reset(ref_geom), "reset");
+    RSS(ref_geom_cache_find(ref_geom, REF_GEOM_EDGE, 3, params,
+                            REF_GEOM_CACHE_EVAL, values, &found),
+        "find reset");
+    RAS(!found, "reset hit");
+    RSS(ref_geom_free(ref_geom), "free");
+  }
+
+  { /* verify topo of touched nodes */
+    REF_GRID ref_grid;
+    REF_GEOM ref_geom;
+    REF_INT node, cell, nodes[REF_CELL_MAX_SIZE_PER];
+    REF_DBL params[2];
+    RSS(ref_grid_create(&ref_grid, ref_mpi), "create");
+    ref_geom = ref_grid_geom(ref_grid);
+    for (cell = 0; cell < 3; cell++)
+      RSS(ref_node_add(ref_grid_node(ref_grid), cell, &node), "add node");
+
+    nodes[0] = 0;
+    nodes[1] = 1;
+    nodes[2] = 2;
+    nodes[3] = 20;
+    RSS(ref_cell_add(ref_grid_tri(ref_grid), nodes, &cell), "add tri");
+    nodes[0] = 0;
+    nodes[1] = 1;
+    nodes[2] = 5;
+    RSS(ref_cell_add(ref_grid_edg(ref_grid), nodes, &cell), "add edg");
+    params[0] = 0.0;
+    params[1] = 0.0;
+    for (node = 0; node < 3; node++)
+      RSS(ref_geom_add(ref_geom, node, REF_GEOM_FACE, 20, params), "face");
+    for (node = 0; node < 2; node++)
+      RSS(ref_geom_add(ref_geom, node, REF_GEOM_EDGE, 5, params), "edge");
+
+    RAS(NULL == (void *)ref_geom_dirty(ref_geom), "not tracked yet");
+    RSS(ref_geom_verify_topo_dirty(ref_grid), "first check is full");
+    RAS(NULL != (void *)ref_geom_dirty(ref_geom), "tracked");
+    RSS(ref_geom_verify_topo_dirty(ref_grid), "nothing touched");
+
+    RSS(ref_geom_add(ref_geom, 2, REF_GEOM_NODE, 1, params), "node");
+    REIS(1, ref_list_n(ref_geom_dirty(ref_geom)), "touched");
+    REIS(REF_FAILURE, ref_geom_verify_topo_dirty(ref_grid),
+         "geom node without edg found");
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   { /* add geom node */
     REF_GEOM ref_geom;
     REF_INT node, type, id;
@@ -20,10 +20,12 @@
 #include <stdlib.h>
 
 #include "ref_adj.h"
+#include "ref_edge.h"
 #include "ref_grid.h"
 
 #include "ref_malloc.h"
 #include "ref_matrix.h"
+#include "ref_sort.h"
 
 REF_STATUS ref_grid_create(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi) {
   REF_GRID ref_grid;
@@ -53,8 +55,10 @@ REF_STATUS ref_grid_create(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi) {
   RSS(ref_adapt_create(&(ref_grid->adapt)), "adapt create");
 
   ref_grid_background(ref_grid) = NULL;
+  ref_grid_edge(ref_grid) = NULL;
 
   ref_grid_twod(ref_grid) = REF_FALSE;
+  ref_grid_pack_order(ref_grid) = REF_GRID_PACK_COMPACT;
 
   return REF_SUCCESS;
 }
@@ -95,8 +99,160 @@ REF_STATUS ref_grid_deep_copy(REF_GRID *ref_grid_ptr, REF_GRID original) {
       "adapt deep copy");
 
   ref_grid_background(ref_grid) = NULL;
+  ref_grid_edge(ref_grid) = NULL;
 
   ref_grid_twod(ref_grid) = ref_grid_twod(original);
+  ref_grid_pack_order(ref_grid) = ref_grid_pack_order(original);
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_grid_rcm_order(REF_GRID ref_grid, REF_INT *order) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_EDGE ref_edge;
+  REF_INT *degree, *seed, *visited, *nbor, *nbor_degree, *sorted;
+  REF_INT node, other, item, edge, i, n, head, tail, nnbor, max_degree;
+
+  RSS(ref_edge_create(&ref_edge, ref_grid), "edges");
+
+  ref_malloc_init(degree, ref_node_max(ref_node), REF_INT, 0);
+  ref_malloc_init(visited, ref_node_max(ref_node), REF_INT, REF_FALSE);
+  ref_malloc(seed, ref_node_n(ref_node), REF_INT);
+  ref_malloc(sorted, ref_node_n(ref_node), REF_INT);
+
+  n = 0;
+  max_degree = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(ref_adj_degree(ref_edge_adj(ref_edge), node, &(degree[node])), "deg");
+    max_degree = MAX(max_degree, degree[node]);
+    order[n] = node;
+    seed[n] = degree[node];
+    n++;
+  }
+  REIS(n, ref_node_n(ref_node), "node miscount");
+  RSS(ref_sort_heap_int(n, seed, sorted), "sort seed degree");
+  for (i = 0; i < n; i++) seed[i] = order[sorted[i]];
+
+  ref_malloc(nbor, max_degree, REF_INT);
+  ref_malloc(nbor_degree, max_degree, REF_INT);
+
+  /* breadth first from the lowest degree unvisited node of each component */
+  head = 0;
+  tail = 0;
+  for (i = 0; i < n; i++) {
+    if (visited[seed[i]]) continue;
+    visited[seed[i]] = REF_TRUE;
+    order[tail] = seed[i];
+    tail++;
+    while (head < tail) {
+      node = order[head];
+      head++;
+      nnbor = 0;
+      each_edge_having_node(ref_edge, node, item, edge) {
+        other = ref_edge_e2n(ref_edge, 0, edge);
+        if (node == other) other = ref_edge_e2n(ref_edge, 1, edge);
+        if (visited[other]) continue;
+        visited[other] = REF_TRUE;
+        nbor[nnbor] = other;
+        nbor_degree[nnbor] = degree[other];
+        nnbor++;
+      }
+      RSS(ref_sort_heap_int(nnbor, nbor_degree, sorted), "sort nbor degree");
+      for (item = 0; item < nnbor; item++) {
+        order[tail] = nbor[sorted[item]];
+        tail++;
+      }
+    }
+  }
+  REIS(n, tail, "unvisited nodes");
+
+  for (i = 0; i < n / 2; i++) {
+    node = order[i];
+    order[i] = order[n - 1 - i];
+    order[n - 1 - i] = node;
+  }
+
+  ref_free(nbor_degree);
+  ref_free(nbor);
+  ref_free(sorted);
+  ref_free(seed);
+  ref_free(visited);
+  ref_free(degree);
+
+  RSS(ref_edge_free(ref_edge), "free edges");
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_grid_hilbert_order(REF_GRID ref_grid, REF_INT *order) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL *xyz;
+  REF_INT *nodes;
+  REF_INT node, i, n;
+
+  ref_malloc(xyz, 3 * ref_node_n(ref_node), REF_DBL);
+  ref_malloc(nodes, ref_node_n(ref_node), REF_INT);
+
+  n = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < 3; i++) xyz[i + 3 * n] = ref_node_xyz(ref_node, i, node);
+    nodes[n] = node;
+    n++;
+  }
+  REIS(n, ref_node_n(ref_node), "node miscount");
+  RSS(ref_sort_hilbert_dbl(n, xyz, order), "hilbert");
+  for (i = 0; i < n; i++) order[i] = nodes[order[i]];
+
+  ref_free(nodes);
+  ref_free(xyz);
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_grid_order(REF_GRID ref_grid, REF_INT **o2n_ptr,
+                                 REF_INT **n2o_ptr) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_INT *o2n, *n2o, *order;
+  REF_INT i, node, nnode;
+
+  ref_malloc(order, ref_node_n(ref_node), REF_INT);
+  switch (ref_grid_pack_order(ref_grid)) {
+    case REF_GRID_PACK_RCM:
+      RSS(ref_grid_rcm_order(ref_grid, order), "rcm");
+      break;
+    case REF_GRID_PACK_HILBERT:
+      RSS(ref_grid_hilbert_order(ref_grid, order), "hilbert");
+      break;
+    default:
+      ref_free(order);
+      RSS(REF_IMPLEMENT, "unknown pack order");
+  }
+
+  ref_malloc_init(*o2n_ptr, ref_node_max(ref_node), REF_INT, REF_EMPTY);
+  o2n = *o2n_ptr;
+  ref_malloc(*n2o_ptr, ref_node_n(ref_node), REF_INT);
+  n2o = *n2o_ptr;
+
+  /* owned nodes first, like ref_node_compact */
+  nnode = 0;
+  for (i = 0; i < ref_node_n(ref_node); i++) {
+    node = order[i];
+    if (ref_mpi_rank(ref_mpi) != ref_node_part(ref_node, node)) continue;
+    o2n[node] = nnode;
+    nnode++;
+  }
+  for (i = 0; i < ref_node_n(ref_node); i++) {
+    node = order[i];
+    if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, node)) continue;
+    o2n[node] = nnode;
+    nnode++;
+  }
+  REIS(nnode, ref_node_n(ref_node), "nnode miscount");
+
+  each_ref_node_valid_node(ref_node, node) n2o[o2n[node]] = node;
+
+  ref_free(order);
 
   return REF_SUCCESS;
 }
@@ -105,28 +261,73 @@ REF_STATUS ref_grid_pack(REF_GRID ref_grid) {
   REF_INT group;
   REF_INT *o2n, *n2o;
   REF_CELL ref_cell;
+  REF_BOOL track_edges = (NULL != (void *)ref_grid_edge(ref_grid));
 
-  RSS(ref_node_compact(ref_grid_node(ref_grid), &o2n, &n2o), "compact");
+  RSS(ref_grid_untrack_edges(ref_grid), "untrack");
 
-  RSS(ref_node_pack(ref_grid_node(ref_grid), o2n, n2o), "pack node");
-  each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
-    RSS(ref_cell_pack(ref_cell, o2n), "pack cell");
+  if (REF_GRID_PACK_COMPACT == ref_grid_pack_order(ref_grid)) {
+    RSS(ref_node_compact(ref_grid_node(ref_grid), &o2n, &n2o), "compact");
+    RSS(ref_node_pack(ref_grid_node(ref_grid), o2n, n2o), "pack node");
+    each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+      RSS(ref_cell_pack(ref_cell, o2n), "pack cell");
+    }
+    RSS(ref_cell_pack(ref_grid_edg(ref_grid), o2n), "pack edg");
+    RSS(ref_cell_pack(ref_grid_tri(ref_grid), o2n), "pack tri");
+    RSS(ref_cell_pack(ref_grid_qua(ref_grid), o2n), "pack qua");
+  } else {
+    RSS(ref_grid_order(ref_grid, &o2n, &n2o), "order");
+    RSS(ref_node_pack(ref_grid_node(ref_grid), o2n, n2o), "pack node");
+    each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+      RSS(ref_cell_pack_by_node(ref_cell, o2n), "pack cell");
+    }
+    RSS(ref_cell_pack_by_node(ref_grid_edg(ref_grid), o2n), "pack edg");
+    RSS(ref_cell_pack_by_node(ref_grid_tri(ref_grid), o2n), "pack tri");
+    RSS(ref_cell_pack_by_node(ref_grid_qua(ref_grid), o2n), "pack qua");
   }
-  RSS(ref_cell_pack(ref_grid_edg(ref_grid), o2n), "pack edg");
-  RSS(ref_cell_pack(ref_grid_tri(ref_grid), o2n), "pack tri");
-  RSS(ref_cell_pack(ref_grid_qua(ref_grid), o2n), "pack qua");
 
   RSS(ref_geom_pack(ref_grid_geom(ref_grid), o2n), "pack geom");
 
   ref_free(n2o);
   ref_free(o2n);
 
+  if (track_edges) RSS(ref_grid_track_edges(ref_grid), "track");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_grid_track_edges(REF_GRID ref_grid) {
+  REF_INT group;
+  REF_CELL ref_cell;
+
+  if (NULL != (void *)ref_grid_edge(ref_grid)) return REF_SUCCESS;
+
+  RSS(ref_edge_create_counted(&ref_grid_edge(ref_grid), ref_grid), "edges");
+  each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+    ref_cell_edge(ref_cell) = ref_grid_edge(ref_grid);
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_grid_untrack_edges(REF_GRID ref_grid) {
+  REF_INT group;
+  REF_CELL ref_cell;
+
+  if (NULL == (void *)ref_grid_edge(ref_grid)) return REF_SUCCESS;
+
+  each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+    ref_cell_edge(ref_cell) = NULL;
+  }
+  RSS(ref_edge_free(ref_grid_edge(ref_grid)), "free edges");
+  ref_grid_edge(ref_grid) = NULL;
+
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_grid_free(REF_GRID ref_grid) {
   if (NULL == (void *)ref_grid) return REF_NULL;
 
+  RSS(ref_grid_untrack_edges(ref_grid), "untrack edges");
   RSS(ref_adapt_free(ref_grid->adapt), "adapt free");
   RSS(ref_gather_free(ref_grid_gather(ref_grid)), "gather free");
   RSS(ref_geom_free(ref_grid_geom(ref_grid)), "geom free");
@@ -161,6 +362,7 @@ REF_STATUS ref_grid_inspect(REF_GRID ref_grid) {
   printf(" %p adapt\n", (void *)(ref_grid->adapt));
   printf(" %p background\n", (void *)(ref_grid->background));
   printf(" %d twod\n", (ref_grid->twod));
+  printf(" %d pack order\n", (ref_grid->pack_order));
 
   return REF_SUCCESS;
 }
@@ -342,19 +544,20 @@ REF_STATUS ref_grid_edge_tag_nodes(REF_GRID ref_grid, REF_INT edge_tag,
 }
 
 REF_STATUS ref_grid_cell_nodes(REF_GRID ref_grid, REF_CELL ref_cell,
-                               REF_INT *nnode_global, REF_INT *ncell_global,
-                               REF_INT **l2c) {
+                               REF_GLOB *nnode_global, REF_GLOB *ncell_global,
+                               REF_GLOB **l2c) {
   REF_NODE ref_node;
   REF_MPI ref_mpi;
   REF_INT cell, node, part;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT nnode, ncell;
-  REF_INT proc, offset, *counts;
+  REF_INT proc, *counts;
+  REF_GLOB offset;
 
   ref_node = ref_grid_node(ref_grid);
   ref_mpi = ref_node_mpi(ref_node);
 
-  ref_malloc_init(*l2c, ref_node_max(ref_node), REF_INT, REF_EMPTY);
+  ref_malloc_init(*l2c, ref_node_max(ref_node), REF_GLOB, REF_EMPTY);
 
   (*nnode_global) = 0;
   (*ncell_global) = 0;
@@ -375,7 +578,7 @@ REF_STATUS ref_grid_cell_nodes(REF_GRID ref_grid, REF_CELL ref_cell,
     }
   }
   (*ncell_global) = ncell;
-  RSS(ref_mpi_allsum(ref_mpi, ncell_global, 1, REF_INT_TYPE), "allsum");
+  RSS(ref_mpi_allsum(ref_mpi, ncell_global, 1, REF_GLOB_TYPE), "allsum");
 
   ref_malloc(counts, ref_mpi_n(ref_mpi), REF_INT);
   RSS(ref_mpi_allgather(ref_mpi, &nnode, counts, REF_INT_TYPE), "gather size");
@@ -392,7 +595,7 @@ REF_STATUS ref_grid_cell_nodes(REF_GRID ref_grid, REF_CELL ref_cell,
     }
   }
 
-  RSS(ref_node_ghost_int(ref_node, (*l2c)), "xfer");
+  RSS(ref_node_ghost_glob(ref_node, (*l2c)), "xfer");
 
   return REF_SUCCESS;
 }
@@ -50,16 +50,26 @@ struct REF_GRID_STRUCT {
   REF_ADAPT adapt;
 
   REF_GRID background;
+  REF_EDGE edge;
 
   REF_BOOL twod;
+  REF_INT pack_order;
 };
 
+#define REF_GRID_PACK_COMPACT (0)
+#define REF_GRID_PACK_RCM (1)
+#define REF_GRID_PACK_HILBERT (2)
+
 REF_STATUS ref_grid_create(REF_GRID *ref_grid, REF_MPI ref_mpi);
 REF_STATUS ref_grid_free(REF_GRID ref_grid);
 
 REF_STATUS ref_grid_deep_copy(REF_GRID *ref_grid, REF_GRID original);
 REF_STATUS ref_grid_pack(REF_GRID ref_grid);
 
+/* keep counted volume edges current through cell add and remove */
+REF_STATUS ref_grid_track_edges(REF_GRID ref_grid);
+REF_STATUS ref_grid_untrack_edges(REF_GRID ref_grid);
+
 #define ref_grid_mpi(ref_grid) ((ref_grid)->mpi)
 #define ref_grid_once(ref_grid) ref_mpi_once(ref_grid_mpi(ref_grid))
 
@@ -79,8 +89,10 @@ REF_STATUS ref_grid_pack(REF_GRID ref_grid);
 #define ref_grid_gather(ref_grid) ((ref_grid)->gather)
 #define ref_grid_adapt(ref_grid, param) (((ref_grid)->adapt)->param)
 #define ref_grid_background(ref_grid) ((ref_grid)->background)
+#define ref_grid_edge(ref_grid) ((ref_grid)->edge)
 
 #define ref_grid_twod(ref_grid) ((ref_grid)->twod)
+#define ref_grid_pack_order(ref_grid) ((ref_grid)->pack_order)
 
 #define each_ref_grid_ref_cell(ref_grid, group, ref_cell)                     \
   for ((group) = 0, (ref_cell) = ref_grid_cell(ref_grid, group); (group) < 4; \
@@ -111,7 +123,8 @@ REF_STATUS ref_grid_edge_tag_nodes(REF_GRID ref_grid, REF_INT edge_tag,
                                    REF_INT *nnode, REF_INT *nedge,
                                    REF_INT **g2l, REF_INT **l2g);
 REF_STATUS ref_grid_cell_nodes(REF_GRID ref_grid, REF_CELL ref_cell,
-                               REF_INT *nnode, REF_INT *ncell, REF_INT **l2c);
+                               REF_GLOB *nnode, REF_GLOB *ncell,
+                               REF_GLOB **l2c);
 
 REF_STATUS ref_grid_inward_boundary_orientation(REF_GRID ref_grid);
 
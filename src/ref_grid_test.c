@@ -39,8 +39,55 @@
 
 #include "ref_malloc.h"
 
-int main(void) {
+#include "ref_adapt.h"
+#include "ref_migrate.h"
+#include "ref_part.h"
+#include "ref_validation.h"
+
+int main(int argc, char *argv[]) {
   REF_MPI ref_mpi;
+
+  if (3 == argc) {
+    REF_GRID ref_grid;
+    REF_INT pack_order, pass;
+    REF_BOOL all_done;
+    const char *names[] = {"compact", "rcm", "hilbert"};
+    char message[64];
+    RSS(ref_mpi_start(argc, argv), "start");
+    RSS(ref_mpi_create(&ref_mpi), "create");
+    for (pack_order = REF_GRID_PACK_COMPACT;
+         pack_order <= REF_GRID_PACK_HILBERT; pack_order++) {
+      ref_mpi_stopwatch_start(ref_mpi);
+      RSS(ref_part_by_extension(&ref_grid, ref_mpi, argv[1]), "part grid");
+      RSS(ref_migrate_to_balance(ref_grid), "balance");
+      RSS(ref_part_metric(ref_grid_node(ref_grid), argv[2]), "part metric");
+      /* scramble the ordering with a few passes before reordering */
+      for (pass = 0; pass < 2; pass++) {
+        RSS(ref_adapt_parameter(ref_grid, &all_done), "param");
+        RSS(ref_adapt_pass(ref_grid), "pass");
+        RSS(ref_grid_pack(ref_grid), "pack");
+      }
+      ref_mpi_stopwatch_stop(ref_mpi, "setup");
+      ref_grid_pack_order(ref_grid) = pack_order;
+      RSS(ref_grid_pack(ref_grid), "pack");
+      sprintf(message, "%s reorder", names[pack_order]);
+      ref_mpi_stopwatch_stop(ref_mpi, message);
+      for (pass = 0; pass < 3; pass++) {
+        RSS(ref_adapt_parameter(ref_grid, &all_done), "param");
+        RSS(ref_adapt_pass(ref_grid), "pass");
+        sprintf(message, "%s adapt pass", names[pack_order]);
+        ref_mpi_stopwatch_stop(ref_mpi, message);
+        RSS(ref_grid_pack(ref_grid), "pack");
+        sprintf(message, "%s pack", names[pack_order]);
+        ref_mpi_stopwatch_stop(ref_mpi, message);
+      }
+      RSS(ref_grid_free(ref_grid), "free");
+    }
+    RSS(ref_mpi_free(ref_mpi), "free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   RSS(ref_mpi_create(&ref_mpi), "create");
 
   { /* init */
@@ -347,6 +394,66 @@ int main(void) {
     RSS(ref_grid_free(ref_grid), "cleanup");
   }
 
+  { /* pack with node reordering keeps the grid */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_CELL ref_cell;
+    REF_INT pack_order, nnode, ntet, ntri, cell, node, first, last;
+    REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+    REF_DBL sum[3], vol, total;
+    for (pack_order = REF_GRID_PACK_COMPACT;
+         pack_order <= REF_GRID_PACK_HILBERT; pack_order++) {
+      RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "fix");
+      ref_node = ref_grid_node(ref_grid);
+      nnode = ref_node_n(ref_node);
+      ntet = ref_cell_n(ref_grid_tet(ref_grid));
+      ntri = ref_cell_n(ref_grid_tri(ref_grid));
+      sum[0] = sum[1] = sum[2] = 0.0;
+      each_ref_node_valid_node(ref_node, node) {
+        sum[0] += ref_node_xyz(ref_node, 0, node);
+        sum[1] += ref_node_xyz(ref_node, 1, node);
+        sum[2] += ref_node_xyz(ref_node, 2, node);
+      }
+
+      ref_grid_pack_order(ref_grid) = pack_order;
+      RSS(ref_grid_pack(ref_grid), "pack");
+
+      REIS(nnode, ref_node_n(ref_node), "nodes");
+      REIS(ntet, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+      REIS(ntri, ref_cell_n(ref_grid_tri(ref_grid)), "tris");
+      each_ref_node_valid_node(ref_node, node) {
+        sum[0] -= ref_node_xyz(ref_node, 0, node);
+        sum[1] -= ref_node_xyz(ref_node, 1, node);
+        sum[2] -= ref_node_xyz(ref_node, 2, node);
+      }
+      RWDS(0.0, sum[0], -1, "x moved");
+      RWDS(0.0, sum[1], -1, "y moved");
+      RWDS(0.0, sum[2], -1, "z moved");
+
+      total = 0.0;
+      ref_cell = ref_grid_tet(ref_grid);
+      each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+        RSS(ref_node_tet_vol(ref_node, nodes, &vol), "vol");
+        RAS(0.0 < vol, "inverted tet");
+        total += vol;
+      }
+      RWDS(1.0, total, -1, "brick volume");
+      RSS(ref_validation_cell_node(ref_grid), "cell node");
+      RSS(ref_validation_boundary_face(ref_grid), "boundary face");
+
+      if (REF_GRID_PACK_COMPACT != pack_order) {
+        last = 0;
+        each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+          first = MIN(MIN(nodes[0], nodes[1]), MIN(nodes[2], nodes[3]));
+          RAS(last <= first, "tets not ordered by first node");
+          last = first;
+        }
+      }
+
+      RSS(ref_grid_free(ref_grid), "cleanup");
+    }
+  }
+
   RSS(ref_mpi_free(ref_mpi), "free");
   return 0;
 }
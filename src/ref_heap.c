@@ -0,0 +1,156 @@
+
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_heap.h"
+#include "ref_malloc.h"
+
+REF_STATUS ref_heap_create(REF_HEAP *ref_heap_ptr, REF_BOOL max_first) {
+  REF_HEAP ref_heap;
+  REF_INT i;
+
+  ref_malloc(*ref_heap_ptr, 1, REF_HEAP_STRUCT);
+
+  ref_heap = (*ref_heap_ptr);
+
+  ref_heap_max_first(ref_heap) = max_first;
+  ref_heap_n(ref_heap) = 0;
+  ref_heap->max = 100;
+  ref_malloc(ref_heap->id, ref_heap->max, REF_INT);
+  ref_malloc(ref_heap->key, ref_heap->max, REF_DBL);
+  ref_heap->nid = 100;
+  ref_malloc(ref_heap->slot, ref_heap->nid, REF_INT);
+  for (i = 0; i < ref_heap->nid; i++) ref_heap->slot[i] = REF_EMPTY;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_heap_free(REF_HEAP ref_heap) {
+  if (NULL == (void *)ref_heap) return REF_NULL;
+  ref_free(ref_heap->slot);
+  ref_free(ref_heap->key);
+  ref_free(ref_heap->id);
+  ref_free(ref_heap);
+  return REF_SUCCESS;
+}
+
+/* true when key0 belongs above key1 */
+#define ref_heap_above(ref_heap, key0, key1) \
+  ((ref_heap)->max_first ? (key0) > (key1) : (key0) < (key1))
+
+static REF_STATUS ref_heap_place(REF_HEAP ref_heap, REF_INT slot, REF_INT id,
+                                 REF_DBL key) {
+  ref_heap->id[slot] = id;
+  ref_heap->key[slot] = key;
+  ref_heap->slot[id] = slot;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_heap_sift(REF_HEAP ref_heap, REF_INT slot) {
+  REF_INT id = ref_heap->id[slot];
+  REF_DBL key = ref_heap->key[slot];
+  REF_INT parent, child;
+
+  while (slot > 0) {
+    parent = (slot - 1) / 2;
+    if (!ref_heap_above(ref_heap, key, ref_heap->key[parent])) break;
+    RSS(ref_heap_place(ref_heap, slot, ref_heap->id[parent],
+                       ref_heap->key[parent]),
+        "up");
+    slot = parent;
+  }
+
+  while (2 * slot + 1 < ref_heap_n(ref_heap)) {
+    child = 2 * slot + 1;
+    if (child + 1 < ref_heap_n(ref_heap) &&
+        ref_heap_above(ref_heap, ref_heap->key[child + 1],
+                       ref_heap->key[child]))
+      child++;
+    if (!ref_heap_above(ref_heap, ref_heap->key[child], key)) break;
+    RSS(ref_heap_place(ref_heap, slot, ref_heap->id[child],
+                       ref_heap->key[child]),
+        "down");
+    slot = child;
+  }
+
+  RSS(ref_heap_place(ref_heap, slot, id, key), "settle");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_heap_push(REF_HEAP ref_heap, REF_INT id, REF_DBL key) {
+  REF_INT slot, orig, i;
+
+  RAS(id >= 0, "negative id");
+
+  if (ref_heap_has(ref_heap, id)) {
+    slot = ref_heap->slot[id];
+    ref_heap->key[slot] = key;
+    RSS(ref_heap_sift(ref_heap, slot), "sift rekey");
+    return REF_SUCCESS;
+  }
+
+  if (id >= ref_heap->nid) {
+    orig = ref_heap->nid;
+    ref_heap->nid = MAX(id + 1, orig + orig / 2);
+    ref_realloc(ref_heap->slot, ref_heap->nid, REF_INT);
+    for (i = orig; i < ref_heap->nid; i++) ref_heap->slot[i] = REF_EMPTY;
+  }
+  if (ref_heap_n(ref_heap) == ref_heap->max) {
+    ref_heap->max += MAX(100, ref_heap->max / 2);
+    ref_realloc(ref_heap->id, ref_heap->max, REF_INT);
+    ref_realloc(ref_heap->key, ref_heap->max, REF_DBL);
+  }
+
+  slot = ref_heap_n(ref_heap);
+  ref_heap_n(ref_heap)++;
+  RSS(ref_heap_place(ref_heap, slot, id, key), "append");
+  RSS(ref_heap_sift(ref_heap, slot), "sift new");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_heap_pop(REF_HEAP ref_heap, REF_INT *id, REF_DBL *key) {
+  *id = REF_EMPTY;
+  if (0 == ref_heap_n(ref_heap)) return REF_NOT_FOUND;
+
+  *id = ref_heap->id[0];
+  *key = ref_heap->key[0];
+  RSS(ref_heap_remove(ref_heap, *id), "remove top");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_heap_remove(REF_HEAP ref_heap, REF_INT id) {
+  REF_INT slot, last;
+
+  if (!ref_heap_has(ref_heap, id)) return REF_NOT_FOUND;
+
+  slot = ref_heap->slot[id];
+  ref_heap->slot[id] = REF_EMPTY;
+  ref_heap_n(ref_heap)--;
+  last = ref_heap_n(ref_heap);
+  if (slot == last) return REF_SUCCESS;
+
+  RSS(ref_heap_place(ref_heap, slot, ref_heap->id[last], ref_heap->key[last]),
+      "fill hole");
+  RSS(ref_heap_sift(ref_heap, slot), "sift fill");
+
+  return REF_SUCCESS;
+}
@@ -0,0 +1,57 @@
+
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef REF_HEAP_H
+#define REF_HEAP_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_HEAP_STRUCT REF_HEAP_STRUCT;
+typedef REF_HEAP_STRUCT *REF_HEAP;
+END_C_DECLORATION
+
+BEGIN_C_DECLORATION
+
+/* binary heap of integer ids with keys that can be changed in place */
+struct REF_HEAP_STRUCT {
+  REF_BOOL max_first;
+  REF_INT n, max;
+  REF_INT *id;
+  REF_DBL *key;
+  REF_INT nid;
+  REF_INT *slot;
+};
+
+REF_STATUS ref_heap_create(REF_HEAP *ref_heap, REF_BOOL max_first);
+REF_STATUS ref_heap_free(REF_HEAP ref_heap);
+
+#define ref_heap_n(ref_heap) ((ref_heap)->n)
+#define ref_heap_max_first(ref_heap) ((ref_heap)->max_first)
+
+#define ref_heap_has(ref_heap, id_arg)             \
+  ((id_arg) >= 0 && (id_arg) < (ref_heap)->nid && \
+   REF_EMPTY != (ref_heap)->slot[(id_arg)])
+
+/* insert id or move it to its new key */
+REF_STATUS ref_heap_push(REF_HEAP ref_heap, REF_INT id, REF_DBL key);
+REF_STATUS ref_heap_pop(REF_HEAP ref_heap, REF_INT *id, REF_DBL *key);
+REF_STATUS ref_heap_remove(REF_HEAP ref_heap, REF_INT id);
+
+END_C_DECLORATION
+
+#endif /* REF_HEAP_H */
@@ -0,0 +1,116 @@
+
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ref_heap.h"
+#include "ref_mpi.h"
+
+int main(int argc, char *argv[]) {
+  REF_HEAP ref_heap;
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  {
+    REIS(REF_NULL, ref_heap_free(NULL), "dont free NULL");
+    RSS(ref_heap_create(&ref_heap, REF_TRUE), "create");
+    REIS(0, ref_heap_n(ref_heap), "init zero");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* pop empty */
+    REF_INT id;
+    REF_DBL key;
+    RSS(ref_heap_create(&ref_heap, REF_TRUE), "create");
+    REIS(REF_NOT_FOUND, ref_heap_pop(ref_heap, &id, &key), "empty");
+    REIS(REF_EMPTY, id, "empty id");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* max first */
+    REF_INT id;
+    REF_DBL key;
+    RSS(ref_heap_create(&ref_heap, REF_TRUE), "create");
+    RSS(ref_heap_push(ref_heap, 3, 1.0), "push");
+    RSS(ref_heap_push(ref_heap, 7, 3.0), "push");
+    RSS(ref_heap_push(ref_heap, 5, 2.0), "push");
+    REIS(3, ref_heap_n(ref_heap), "three");
+    RAS(ref_heap_has(ref_heap, 7), "has 7");
+    RAS(!ref_heap_has(ref_heap, 4), "not 4");
+    RAS(!ref_heap_has(ref_heap, 1000), "not 1000");
+    RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+    REIS(7, id, "largest");
+    RWDS(3.0, key, -1.0, "key");
+    RAS(!ref_heap_has(ref_heap, 7), "popped 7");
+    RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+    REIS(5, id, "middle");
+    RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+    REIS(3, id, "smallest");
+    REIS(0, ref_heap_n(ref_heap), "empty");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* min first with rekey and remove */
+    REF_INT id;
+    REF_DBL key;
+    RSS(ref_heap_create(&ref_heap, REF_FALSE), "create");
+    RSS(ref_heap_push(ref_heap, 0, 1.0), "push");
+    RSS(ref_heap_push(ref_heap, 1, 2.0), "push");
+    RSS(ref_heap_push(ref_heap, 2, 3.0), "push");
+    RSS(ref_heap_push(ref_heap, 3, 4.0), "push");
+    RSS(ref_heap_push(ref_heap, 2, 0.5), "rekey up");
+    RSS(ref_heap_push(ref_heap, 0, 5.0), "rekey down");
+    REIS(4, ref_heap_n(ref_heap), "rekey keeps n");
+    RSS(ref_heap_remove(ref_heap, 1), "remove");
+    REIS(REF_NOT_FOUND, ref_heap_remove(ref_heap, 1), "remove again");
+    RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+    REIS(2, id, "rekeyed up");
+    RWDS(0.5, key, -1.0, "key");
+    RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+    REIS(3, id, "untouched");
+    RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+    REIS(0, id, "rekeyed down");
+    REIS(0, ref_heap_n(ref_heap), "empty");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* grow with scrambled keys and pop in order */
+    REF_INT i, n = 1000, id;
+    REF_DBL key, last;
+    RSS(ref_heap_create(&ref_heap, REF_TRUE), "create");
+    for (i = 0; i < n; i++)
+      RSS(ref_heap_push(ref_heap, 3 * i, (REF_DBL)((7919 * i) % n)), "push");
+    for (i = 0; i < n; i += 2) RSS(ref_heap_remove(ref_heap, 3 * i), "rm");
+    REIS(n / 2, ref_heap_n(ref_heap), "half");
+    last = (REF_DBL)n;
+    while (0 < ref_heap_n(ref_heap)) {
+      RSS(ref_heap_pop(ref_heap, &id, &key), "pop");
+      RAS(key <= last, "out of order");
+      RAS(1 == (id / 3) % 2, "removed id popped");
+      last = key;
+    }
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
@@ -20,7 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "ref_edge.h"
+#include "ref_census.h"
 #include "ref_histogram.h"
 #include "ref_malloc.h"
 #include "ref_mpi.h"
@@ -365,92 +365,65 @@ REF_STATUS ref_histogram_print_stat(REF_HISTOGRAM ref_histogram) {
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_histogram_add_census_ratio(REF_HISTOGRAM ref_histogram,
+                                          REF_CENSUS ref_census,
+                                          REF_MPI ref_mpi) {
+  REF_INT i;
+
+  for (i = 0; i < ref_census_nratio(ref_census); i++)
+    RSS(ref_histogram_add(ref_histogram, ref_census_ratio(ref_census, i)),
+        "add");
+  RSS(ref_histogram_gather(ref_histogram, ref_mpi), "gather");
+
+  for (i = 0; i < ref_census_nratio(ref_census); i++)
+    RSS(ref_histogram_add_stat(ref_histogram, ref_census_ratio(ref_census, i)),
+        "add");
+  RSS(ref_histogram_gather_stat(ref_histogram, ref_mpi), "gather");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_histogram_add_census_quality(REF_HISTOGRAM ref_histogram,
+                                            REF_CENSUS ref_census,
+                                            REF_MPI ref_mpi) {
+  REF_INT i;
+
+  for (i = 0; i < ref_census_nquality(ref_census); i++)
+    RSS(ref_histogram_add(ref_histogram, ref_census_quality(ref_census, i)),
+        "add");
+  RSS(ref_histogram_gather(ref_histogram, ref_mpi), "gather");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_histogram_add_ratio(REF_HISTOGRAM ref_histogram,
                                    REF_GRID ref_grid) {
-  REF_EDGE ref_edge;
-  REF_INT edge, part;
-  REF_DBL ratio;
-  REF_BOOL active;
-
-  RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
-
-  for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
-    RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
-    RSS(ref_node_edge_twod(ref_grid_node(ref_grid),
-                           ref_edge_e2n(ref_edge, 0, edge),
-                           ref_edge_e2n(ref_edge, 1, edge), &active),
-        "twod edge");
-    active = (active || !ref_grid_twod(ref_grid));
-    if (part == ref_mpi_rank(ref_grid_mpi(ref_grid)) && active) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
-      RSS(ref_histogram_add(ref_histogram, ratio), "add");
-    }
-  }
+  REF_CENSUS ref_census;
 
-  RSS(ref_histogram_gather(ref_histogram, ref_grid_mpi(ref_grid)), "gather");
-
-  for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
-    RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
-    RSS(ref_node_edge_twod(ref_grid_node(ref_grid),
-                           ref_edge_e2n(ref_edge, 0, edge),
-                           ref_edge_e2n(ref_edge, 1, edge), &active),
-        "twod edge");
-    active = (active || !ref_grid_twod(ref_grid));
-    if (part == ref_mpi_rank(ref_grid_mpi(ref_grid)) && active) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
-      RSS(ref_histogram_add_stat(ref_histogram, ratio), "add");
-    }
-  }
-  RSS(ref_histogram_gather_stat(ref_histogram, ref_grid_mpi(ref_grid)),
-      "gather");
-
-  RSS(ref_edge_free(ref_edge), "free edge");
+  RSS(ref_census_create(&ref_census, ref_grid), "census");
+  RSS(ref_histogram_add_census_ratio(ref_histogram, ref_census,
+                                     ref_grid_mpi(ref_grid)),
+      "add ratio");
+  RSS(ref_census_free(ref_census), "free census");
 
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_histogram_add_quality(REF_HISTOGRAM ref_histogram,
                                      REF_GRID ref_grid) {
-  REF_CELL ref_cell;
-  REF_INT cell;
-  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-  REF_DBL quality;
-  REF_BOOL active_twod;
-
-  if (ref_grid_twod(ref_grid)) {
-    ref_cell = ref_grid_tri(ref_grid);
-  } else {
-    ref_cell = ref_grid_tet(ref_grid);
-  }
-  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-    if (ref_node_part(ref_grid_node(ref_grid), nodes[0]) ==
-        ref_mpi_rank(ref_grid_mpi(ref_grid))) {
-      if (ref_grid_twod(ref_grid)) {
-        RSS(ref_node_node_twod(ref_grid_node(ref_grid), nodes[0], &active_twod),
-            "active twod tri");
-        if (!active_twod) continue;
-        RSS(ref_node_tri_quality(ref_grid_node(ref_grid), nodes, &quality),
-            "qual");
-      } else {
-        RSS(ref_node_tet_quality(ref_grid_node(ref_grid), nodes, &quality),
-            "qual");
-      }
-      if (quality > 0.0) RSS(ref_histogram_add(ref_histogram, quality), "add");
-    }
-  }
+  REF_CENSUS ref_census;
 
-  RSS(ref_histogram_gather(ref_histogram, ref_grid_mpi(ref_grid)), "gather");
+  RSS(ref_census_create(&ref_census, ref_grid), "census");
+  RSS(ref_histogram_add_census_quality(ref_histogram, ref_census,
+                                       ref_grid_mpi(ref_grid)),
+      "add quality");
+  RSS(ref_census_free(ref_census), "free census");
 
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_histogram_ratio(REF_GRID ref_grid) {
+REF_STATUS ref_histogram_ratio_census(REF_GRID ref_grid,
+                                      REF_CENSUS ref_census) {
   REF_HISTOGRAM ref_histogram;
 
   RSS(ref_histogram_create(&ref_histogram), "create");
@@ -458,7 +431,9 @@ REF_STATUS ref_histogram_ratio(REF_GRID ref_grid) {
   if (REF_FALSE)
     RSS(ref_histogram_debug(ref_histogram, "ref_histogram.len"), "dbug");
 
-  RSS(ref_histogram_add_ratio(ref_histogram, ref_grid), "add ratio");
+  RSS(ref_histogram_add_census_ratio(ref_histogram, ref_census,
+                                     ref_grid_mpi(ref_grid)),
+      "add ratio");
 
   if (ref_grid_once(ref_grid))
     RSS(ref_histogram_print(ref_histogram, ref_grid, "edge ratio"), "print");
@@ -469,12 +444,15 @@ REF_STATUS ref_histogram_ratio(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_histogram_quality(REF_GRID ref_grid) {
+REF_STATUS ref_histogram_quality_census(REF_GRID ref_grid,
+                                        REF_CENSUS ref_census) {
   REF_HISTOGRAM ref_histogram;
 
   RSS(ref_histogram_create(&ref_histogram), "create");
 
-  RSS(ref_histogram_add_quality(ref_histogram, ref_grid), "add quality");
+  RSS(ref_histogram_add_census_quality(ref_histogram, ref_census,
+                                       ref_grid_mpi(ref_grid)),
+      "add quality");
 
   if (ref_grid_once(ref_grid))
     RSS(ref_histogram_print(ref_histogram, ref_grid, "quality"), "print");
@@ -483,6 +461,26 @@ REF_STATUS ref_histogram_quality(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_histogram_ratio(REF_GRID ref_grid) {
+  REF_CENSUS ref_census;
+
+  RSS(ref_census_create(&ref_census, ref_grid), "census");
+  RSS(ref_histogram_ratio_census(ref_grid, ref_census), "ratio");
+  RSS(ref_census_free(ref_census), "free census");
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_histogram_quality(REF_GRID ref_grid) {
+  REF_CENSUS ref_census;
+
+  RSS(ref_census_create(&ref_census, ref_grid), "census");
+  RSS(ref_histogram_quality_census(ref_grid, ref_census), "quality");
+  RSS(ref_census_free(ref_census), "free census");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_histogram_ratio_tec(REF_GRID ref_grid) {
   REF_HISTOGRAM ref_histogram;
 
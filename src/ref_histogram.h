@@ -27,6 +27,7 @@ typedef REF_HISTOGRAM_STRUCT *REF_HISTOGRAM;
 END_C_DECLORATION
 
 #include <stdio.h>
+#include "ref_census.h"
 #include "ref_grid.h"
 #include "ref_mpi.h"
 
@@ -87,10 +88,21 @@ REF_STATUS ref_histogram_gather_stat(REF_HISTOGRAM ref_histogram,
                                      REF_MPI ref_mpi);
 REF_STATUS ref_histogram_print_stat(REF_HISTOGRAM ref_histogram);
 
+REF_STATUS ref_histogram_add_census_ratio(REF_HISTOGRAM ref_histogram,
+                                          REF_CENSUS ref_census,
+                                          REF_MPI ref_mpi);
+REF_STATUS ref_histogram_add_census_quality(REF_HISTOGRAM ref_histogram,
+                                            REF_CENSUS ref_census,
+                                            REF_MPI ref_mpi);
 REF_STATUS ref_histogram_add_ratio(REF_HISTOGRAM ref_histogram,
                                    REF_GRID ref_grid);
 REF_STATUS ref_histogram_add_quality(REF_HISTOGRAM ref_histogram,
                                      REF_GRID ref_grid);
+/* print from a census already taken of the grid */
+REF_STATUS ref_histogram_ratio_census(REF_GRID ref_grid,
+                                      REF_CENSUS ref_census);
+REF_STATUS ref_histogram_quality_census(REF_GRID ref_grid,
+                                        REF_CENSUS ref_census);
 REF_STATUS ref_histogram_ratio(REF_GRID ref_grid);
 REF_STATUS ref_histogram_quality(REF_GRID ref_grid);
 
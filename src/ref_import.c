@@ -920,7 +920,7 @@ static REF_STATUS meshb_pos(FILE *file, REF_INT version, REF_FILEPOS *pos) {
   int temp_int;
   long temp_long;
 
-  if (3 == version) {
+  if (3 <= version) {
     REIS(1, fread(&temp_long, sizeof(temp_long), 1, file), "read long");
     *pos = temp_long;
   } else {
@@ -930,6 +930,55 @@ static REF_STATUS meshb_pos(FILE *file, REF_INT version, REF_FILEPOS *pos) {
 
   return REF_SUCCESS;
 }
+
+REF_STATUS ref_import_meshb_ints(FILE *file, REF_INT version, REF_INT n,
+                                 REF_GLOB *ints) {
+  int temp_int, *int_buffer;
+  long temp_long, *long_buffer;
+  REF_INT i;
+
+  if (1 == n) {
+    if (4 == version) {
+      REIS(1, fread(&temp_long, sizeof(temp_long), 1, file), "read long");
+      RAS(temp_long <= REF_GLOB_MAX, "exceeds REF_GLOB, configure glob64");
+      ints[0] = (REF_GLOB)temp_long;
+    } else {
+      REIS(1, fread(&temp_int, sizeof(temp_int), 1, file), "read int");
+      ints[0] = temp_int;
+    }
+    return REF_SUCCESS;
+  }
+
+  if (n <= 0) return REF_SUCCESS;
+
+  if (4 == version) {
+    ref_malloc(long_buffer, n, long);
+    RES((size_t)n, fread(long_buffer, sizeof(long), (size_t)n, file), "longs");
+    for (i = 0; i < n; i++) {
+      RAS(long_buffer[i] <= REF_GLOB_MAX, "exceeds REF_GLOB, configure glob64");
+      ints[i] = (REF_GLOB)long_buffer[i];
+    }
+    ref_free(long_buffer);
+  } else {
+    ref_malloc(int_buffer, n, int);
+    RES((size_t)n, fread(int_buffer, sizeof(int), (size_t)n, file), "ints");
+    for (i = 0; i < n; i++) ints[i] = int_buffer[i];
+    ref_free(int_buffer);
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS meshb_int(FILE *file, REF_INT version, REF_INT *value) {
+  REF_GLOB temp_glob;
+
+  RSS(ref_import_meshb_ints(file, version, 1, &temp_glob), "read");
+  RAS(temp_glob <= REF_INT_MAX, "exceeds int, use ref_part for this meshb");
+  *value = (REF_INT)temp_glob;
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_import_meshb_header(const char *filename, REF_INT *version,
                                    REF_FILEPOS *key_pos) {
   FILE *file;
@@ -948,7 +997,7 @@ REF_STATUS ref_import_meshb_header(const char *filename, REF_INT *version,
   REIS(1, fread((unsigned char *)&int_code, 4, 1, file), "code");
   REIS(1, int_code, "code");
   REIS(1, fread((unsigned char *)&int_version, 4, 1, file), "version");
-  if (int_version < 1 || 3 < int_version) {
+  if (int_version < 1 || 4 < int_version) {
     printf("version %d not supported\n", int_version);
     THROW("version");
   }
@@ -1052,7 +1101,7 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   RAS(available, "meshb missing vertex");
-  REIS(1, fread((unsigned char *)&nnode, 4, 1, file), "nnode");
+  RSS(meshb_int(file, version, &nnode), "nnode");
   if (verbose) printf("nnode %d\n", nnode);
 
   for (node = 0; node < nnode; node++) {
@@ -1071,7 +1120,7 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
       RSS(meshb_real(file, version, &(ref_node_xyz(ref_node, 2, new_node))),
           "z");
     }
-    REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+    RSS(meshb_int(file, version, &(id)), "id");
     /* ref_node_location(ref_node, node ); */
   }
   REIS(next_position, ftello(file), "end location");
@@ -1093,13 +1142,13 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   if (available) {
-    REIS(1, fread((unsigned char *)&nedge, 4, 1, file), "nedge");
+    RSS(meshb_int(file, version, &nedge), "nedge");
     if (verbose) printf("nedge %d\n", nedge);
 
     for (edge = 0; edge < nedge; edge++) {
-      REIS(1, fread(&(n0), sizeof(n0), 1, file), "n0");
-      REIS(1, fread(&(n1), sizeof(n1), 1, file), "n1");
-      REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+      RSS(meshb_int(file, version, &(n0)), "n0");
+      RSS(meshb_int(file, version, &(n1)), "n1");
+      RSS(meshb_int(file, version, &(id)), "id");
       n0--;
       n1--;
       if (2 == dim) {
@@ -1148,17 +1197,17 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   if (available) {
-    REIS(1, fread((unsigned char *)&ntri, 4, 1, file), "ntri");
+    RSS(meshb_int(file, version, &ntri), "ntri");
     if (verbose) printf("ntri %d\n", ntri);
     if (2 == dim)
       printf("y=1 symmetry faceid is %d, y=0 symmetry faceid is %d\n", faceid1,
              faceid2);
 
     for (tri = 0; tri < ntri; tri++) {
-      REIS(1, fread(&(n0), sizeof(n0), 1, file), "n0");
-      REIS(1, fread(&(n1), sizeof(n1), 1, file), "n1");
-      REIS(1, fread(&(n2), sizeof(n2), 1, file), "n2");
-      REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+      RSS(meshb_int(file, version, &(n0)), "n0");
+      RSS(meshb_int(file, version, &(n1)), "n1");
+      RSS(meshb_int(file, version, &(n2)), "n2");
+      RSS(meshb_int(file, version, &(id)), "id");
       n0--;
       n1--;
       n2--;
@@ -1199,15 +1248,15 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   if (3 == dim && available) {
-    REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "ncell");
+    RSS(meshb_int(file, version, &ncell), "ncell");
     if (verbose) printf("nquad %d\n", ncell);
 
     for (cell = 0; cell < ncell; cell++) {
-      REIS(1, fread(&(n0), sizeof(n0), 1, file), "qua n0");
-      REIS(1, fread(&(n1), sizeof(n1), 1, file), "qua n1");
-      REIS(1, fread(&(n2), sizeof(n2), 1, file), "qua n2");
-      REIS(1, fread(&(n3), sizeof(n3), 1, file), "qua n3");
-      REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+      RSS(meshb_int(file, version, &(n0)), "qua n0");
+      RSS(meshb_int(file, version, &(n1)), "qua n1");
+      RSS(meshb_int(file, version, &(n2)), "qua n2");
+      RSS(meshb_int(file, version, &(n3)), "qua n3");
+      RSS(meshb_int(file, version, &(id)), "id");
       n0--;
       n1--;
       n2--;
@@ -1226,15 +1275,15 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   if (3 == dim && available) {
-    REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "ncell");
+    RSS(meshb_int(file, version, &ncell), "ncell");
     if (verbose) printf("ntet %d\n", ncell);
 
     for (cell = 0; cell < ncell; cell++) {
-      REIS(1, fread(&(n0), sizeof(n0), 1, file), "tet n0");
-      REIS(1, fread(&(n1), sizeof(n1), 1, file), "tet n1");
-      REIS(1, fread(&(n2), sizeof(n2), 1, file), "tet n2");
-      REIS(1, fread(&(n3), sizeof(n3), 1, file), "tet n3");
-      REIS(1, fread(&(id), sizeof(id), 1, file), "tet id");
+      RSS(meshb_int(file, version, &(n0)), "tet n0");
+      RSS(meshb_int(file, version, &(n1)), "tet n1");
+      RSS(meshb_int(file, version, &(n2)), "tet n2");
+      RSS(meshb_int(file, version, &(n3)), "tet n3");
+      RSS(meshb_int(file, version, &(id)), "tet id");
       n0--;
       n1--;
       n2--;
@@ -1252,16 +1301,16 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   if (3 == dim && available) {
-    REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "ncell");
+    RSS(meshb_int(file, version, &ncell), "ncell");
     if (verbose) printf("npyramid %d\n", ncell);
 
     for (cell = 0; cell < ncell; cell++) {
-      REIS(1, fread(&(n0), sizeof(n0), 1, file), "pyr n0");
-      REIS(1, fread(&(n1), sizeof(n1), 1, file), "pyr n1");
-      REIS(1, fread(&(n2), sizeof(n2), 1, file), "pyr n2");
-      REIS(1, fread(&(n3), sizeof(n3), 1, file), "pyr n3");
-      REIS(1, fread(&(n4), sizeof(n4), 1, file), "pyr n4");
-      REIS(1, fread(&(id), sizeof(id), 1, file), "pyr id");
+      RSS(meshb_int(file, version, &(n0)), "pyr n0");
+      RSS(meshb_int(file, version, &(n1)), "pyr n1");
+      RSS(meshb_int(file, version, &(n2)), "pyr n2");
+      RSS(meshb_int(file, version, &(n3)), "pyr n3");
+      RSS(meshb_int(file, version, &(n4)), "pyr n4");
+      RSS(meshb_int(file, version, &(id)), "pyr id");
       n0--;
       n1--;
       n2--;
@@ -1283,17 +1332,17 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &next_position),
       "jump");
   if (3 == dim && available) {
-    REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "ncell");
+    RSS(meshb_int(file, version, &ncell), "ncell");
     if (verbose) printf("nprism %d\n", ncell);
 
     for (cell = 0; cell < ncell; cell++) {
-      REIS(1, fread(&(n0), sizeof(n0), 1, file), "pri n0");
-      REIS(1, fread(&(n1), sizeof(n1), 1, file), "pri n1");
-      REIS(1, fread(&(n2), sizeof(n2), 1, file), "pri n2");
-      REIS(1, fread(&(n3), sizeof(n3), 1, file), "pri n3");
-      REIS(1, fread(&(n4), sizeof(n4), 1, file), "pri n4");
-      REIS(1, fread(&(n5), sizeof(n5), 1, file), "pri n5");
-      REIS(1, fread(&(id), sizeof(id), 1, file), "pri id");
+      RSS(meshb_int(file, version, &(n0)), "pri n0");
+      RSS(meshb_int(file, version, &(n1)), "pri n1");
+      RSS(meshb_int(file, version, &(n2)), "pri n2");
+      RSS(meshb_int(file, version, &(n3)), "pri n3");
+      RSS(meshb_int(file, version, &(n4)), "pri n4");
+      RSS(meshb_int(file, version, &(n5)), "pri n5");
+      RSS(meshb_int(file, version, &(id)), "pri id");
       n0--;
       n1--;
       n2--;
@@ -1319,13 +1368,13 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                               &next_position),
         "jump");
     if (available) {
-      REIS(1, fread((unsigned char *)&ngeom, 4, 1, file), "ngeom");
+      RSS(meshb_int(file, version, &ngeom), "ngeom");
       if (verbose) printf("type %d ngeom %d\n", type, ngeom);
 
       for (geom = 0; geom < ngeom; geom++) {
         double filler;
-        REIS(1, fread(&(node), sizeof(node), 1, file), "node");
-        REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+        RSS(meshb_int(file, version, &(node)), "node");
+        RSS(meshb_int(file, version, &(id)), "id");
         for (i = 0; i < type; i++)
           REIS(1, fread(&(param[i]), sizeof(double), 1, file), "param");
         if (0 < type)
@@ -1342,9 +1391,8 @@ static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                             &available, &next_position),
       "jump");
   if (available) {
-    REIS(1,
-         fread((unsigned char *)&ref_geom_cad_data_size(ref_geom), 4, 1, file),
-         "cad data size");
+    RSS(meshb_int(file, version, &ref_geom_cad_data_size(ref_geom)),
+        "cad data size");
     if (verbose)
       printf("cad_data %d bytes\n", ref_geom_cad_data_size(ref_geom));
     /* safe non-NULL free, if already allocated, to prevent memory leaks */
@@ -39,6 +39,9 @@ REF_STATUS ref_import_meshb_jump(FILE *file, REF_INT version,
                                  REF_FILEPOS *key_pos, REF_INT keyword,
                                  REF_BOOL *available,
                                  REF_FILEPOS *next_position);
+/* meshb integers are 4 bytes, 8 bytes for version 4 */
+REF_STATUS ref_import_meshb_ints(FILE *file, REF_INT version, REF_INT n,
+                                 REF_GLOB *ints);
 
 END_C_DECLORATION
 
@@ -51,6 +51,32 @@ int main(int argc, char *argv[]) {
 
   RSS(ref_mpi_create(&ref_mpi), "create");
 
+  { /* meshb ints are 4 bytes, 8 bytes for version 4 */
+    FILE *file;
+    char filename[] = "ref_import_test.ints";
+    int four_bytes[3] = {7, -1, 2147483647};
+    long eight_bytes[3] = {7, -1, 2147483647};
+    REF_GLOB ints[3];
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    REIS(3, fwrite(four_bytes, sizeof(int), 3, file), "four");
+    REIS(3, fwrite(eight_bytes, sizeof(long), 3, file), "eight");
+    REIS(0, fclose(file), "close");
+    file = fopen(filename, "r");
+    RNS(file, "unable to open file");
+    RSS(ref_import_meshb_ints(file, 2, 1, ints), "one v2");
+    REIS(7, ints[0], "one v2");
+    RSS(ref_import_meshb_ints(file, 3, 2, ints), "two v3");
+    REIS(-1, ints[0], "two v3");
+    REIS(2147483647, ints[1], "two v3");
+    RSS(ref_import_meshb_ints(file, 4, 3, ints), "three v4");
+    REIS(7, ints[0], "three v4");
+    REIS(-1, ints[1], "three v4");
+    REIS(2147483647, ints[2], "three v4");
+    REIS(0, fclose(file), "close");
+    REIS(0, remove(filename), "test clean up");
+  }
+
   { /* export import twod .msh brick */
     REF_GRID export_grid, import_grid;
     char file[] = "ref_import_test.msh";
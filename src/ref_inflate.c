@@ -73,7 +73,8 @@ REF_STATUS ref_inflate_face(REF_GRID ref_grid, REF_DICT faceids,
   REF_INT ntri, tris[2], nquad, quads[2];
   REF_INT tri_node;
   REF_INT *o2n;
-  REF_INT global, new_node;
+  REF_INT new_node;
+  REF_GLOB global;
   REF_INT new_cell;
   REF_DBL min_dot;
 
@@ -276,7 +277,8 @@ REF_STATUS ref_inflate_radially(REF_GRID ref_grid, REF_DICT faceids,
   REF_INT ntri, tris[2], nquad, quads[2];
   REF_INT tri_node;
   REF_INT *o2n;
-  REF_INT global, new_node;
+  REF_INT new_node;
+  REF_GLOB global;
   REF_INT new_cell;
   REF_DBL min_dot;
   REF_DBL phi_rad, alpha_weighting, xshift;
@@ -27,6 +27,7 @@
 #include "ref_malloc.h"
 
 #define MAX_NODE_LIST (200)
+#define REF_INTERP_TREE_BATCH (1024)
 
 #define ref_interp_mpi(ref_interp) ((ref_interp)->ref_mpi)
 
@@ -109,8 +110,8 @@ REF_STATUS ref_interp_exhaustive_enclosing_tet(REF_GRID ref_grid, REF_DBL *xyz,
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_interp_enclosing_tet_in_list(REF_GRID ref_grid,
-                                            REF_LIST ref_list, REF_DBL *xyz,
+REF_STATUS ref_interp_enclosing_tet_in_list(REF_GRID ref_grid, REF_INT n,
+                                            REF_INT *list, REF_DBL *xyz,
                                             REF_INT *cell, REF_DBL *bary) {
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
@@ -121,8 +122,8 @@ REF_STATUS ref_interp_enclosing_tet_in_list(REF_GRID ref_grid,
 
   best_candidate = REF_EMPTY;
   best_bary = -999.0;
-  each_ref_list_item(ref_list, item) {
-    candidate = ref_list_value(ref_list, item);
+  for (item = 0; item < n; item++) {
+    candidate = list[item];
     RSS(ref_cell_nodes(ref_cell, candidate, nodes), "cell");
     RXS(ref_node_bary4(ref_node, nodes, xyz, current_bary), REF_DIV_ZERO,
         "bary");
@@ -198,8 +199,8 @@ static REF_STATUS ref_update_agent_seed(REF_INTERP ref_interp, REF_INT id,
     /* if it is off proc */
     if (!ref_node_owned(ref_node, node0) && !ref_node_owned(ref_node, node1) &&
         !ref_node_owned(ref_node, node2)) {
-      /* pick at pseudo random */
-      node = face_nodes[rand() % 3];
+      /* pick at pseudo random, reproducible when walked by threads */
+      node = face_nodes[(id + ref_agent_step(ref_agents, id)) % 3];
       ref_agent_part(ref_agents, id) = ref_node_part(ref_node, node);
       ref_agent_seed(ref_agents, id) = ref_node_global(ref_node, node);
       ref_agent_mode(ref_agents, id) = REF_AGENT_HOP_PART;
@@ -240,8 +241,9 @@ REF_STATUS ref_interp_walk_agent(REF_INTERP ref_interp, REF_INT id) {
       return REF_SUCCESS;
     }
 
-    RSB(ref_cell_nodes(ref_cell, ref_agent_seed(ref_agents, id), nodes), "cell",
-        { ref_agents_tattle(ref_agents, id, "cell_nodes in walk"); });
+    RSB(ref_cell_nodes(ref_cell, (REF_INT)ref_agent_seed(ref_agents, id),
+                       nodes),
+        "cell", { ref_agents_tattle(ref_agents, id, "cell_nodes in walk"); });
     /* when REF_DIV_ZERO, min bary is preserved */
     RXS(ref_node_bary4(ref_node, nodes, ref_agent_xyz_ptr(ref_agents, id),
                        bary),
@@ -370,6 +372,7 @@ REF_STATUS ref_interp_process_agents(REF_INTERP ref_interp) {
   REF_INT i, id, node;
   REF_INT n_agents;
   REF_INT sweep = 0;
+  REF_INT nwalker, *walker, item, nfail;
 
   n_agents = ref_agents_n(ref_agents);
   RSS(ref_mpi_allsum(ref_mpi, &n_agents, 1, REF_INT_TYPE), "sum");
@@ -380,12 +383,27 @@ REF_STATUS ref_interp_process_agents(REF_INTERP ref_interp) {
     if (ref_interp->instrument) ref_agents_population(ref_agents, "agent pop");
     sweep++;
 
+    /* a walk only reads the from grid and writes its own agent,
+     * so the batch of local walkers is independent */
+    ref_malloc(walker, ref_agents_max(ref_agents), REF_INT);
+    nwalker = 0;
     each_active_ref_agent(
         ref_agents,
         id) if (REF_AGENT_WALKING == ref_agent_mode(ref_agents, id) &&
                 ref_agent_part(ref_agents, id) == ref_mpi_rank(ref_mpi)) {
-      RSS(ref_interp_walk_agent(ref_interp, id), "walking");
+      walker[nwalker] = id;
+      nwalker++;
     }
+    nfail = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nfail)
+#endif
+    for (item = 0; item < nwalker; item++) {
+      if (REF_SUCCESS != ref_interp_walk_agent(ref_interp, walker[item]))
+        nfail++;
+    }
+    ref_free(walker);
+    REIS(0, nfail, "walking");
 
     RSS(ref_agents_migrate(ref_agents), "send it");
 
@@ -421,7 +439,7 @@ REF_STATUS ref_interp_process_agents(REF_INTERP ref_interp) {
         id) if ((REF_AGENT_AT_BOUNDARY == ref_agent_mode(ref_agents, id) ||
                  REF_AGENT_TERMINATED == ref_agent_mode(ref_agents, id)) &&
                 ref_agent_home(ref_agents, id) == ref_mpi_rank(ref_mpi)) {
-      node = ref_agent_node(ref_agents, id);
+      node = (REF_INT)ref_agent_node(ref_agents, id);
       RAS(ref_node_valid(to_node, node), "not vaild");
       RAS(ref_node_owned(to_node, node), "ghost, not owned");
       REIS(REF_EMPTY, ref_interp->cell[node], "already found?");
@@ -438,13 +456,13 @@ REF_STATUS ref_interp_process_agents(REF_INTERP ref_interp) {
         ref_agents,
         id) if (REF_AGENT_ENCLOSING == ref_agent_mode(ref_agents, id) &&
                 ref_agent_home(ref_agents, id) == ref_mpi_rank(ref_mpi)) {
-      node = ref_agent_node(ref_agents, id);
+      node = (REF_INT)ref_agent_node(ref_agents, id);
       RAS(ref_node_valid(to_node, node), "not vaild");
       RAS(ref_node_owned(to_node, node), "ghost, not owned");
       REIS(REF_EMPTY, ref_interp->cell[node], "already found?");
       RAS(ref_interp->agent_hired[node], "should have an agent");
 
-      ref_interp->cell[node] = ref_agent_seed(ref_agents, id);
+      ref_interp->cell[node] = (REF_INT)ref_agent_seed(ref_agents, id);
       ref_interp->part[node] = ref_agent_part(ref_agents, id);
       for (i = 0; i < 4; i++)
         ref_interp->bary[i + 4 * node] = ref_agent_bary(ref_agents, i, id);
@@ -665,6 +683,12 @@ REF_STATUS ref_interp_bounding_sphere(REF_NODE ref_node, REF_INT *nodes,
   return REF_SUCCESS;
 }
 
+static REF_BOOL ref_interp_box_holds(REF_DBL *box, REF_DBL *xyz) {
+  return (box[0] <= xyz[0] && xyz[0] <= box[3] && box[1] <= xyz[1] &&
+          xyz[1] <= box[4] && box[2] <= xyz[2] && xyz[2] <= box[5]);
+}
+
+/* query points only travel to parts whose bounding box could hold them */
 REF_STATUS ref_interp_tree(REF_INTERP ref_interp) {
   REF_GRID from_grid = ref_interp_from_grid(ref_interp);
   REF_GRID to_grid = ref_interp_to_grid(ref_interp);
@@ -678,152 +702,166 @@ REF_STATUS ref_interp_tree(REF_INTERP ref_interp) {
   REF_DBL bary[4];
   REF_LIST ref_list;
   REF_DBL fuzz = 1.0e-12;
-  REF_INT *best_node, *best_cell, *from_proc;
-  REF_DBL *best_bary;
-  REF_INT ntarget;
-  REF_DBL *local_xyz, *global_xyz;
-  REF_INT *local_node, *global_node;
-  REF_INT *source, total_node;
-  REF_INT nsend, nrecv;
-  REF_INT *send_proc, *my_proc, *recv_proc;
-  REF_INT *send_cell, *recv_cell;
-  REF_INT *send_node, *recv_node;
-  REF_DBL *send_bary, *recv_bary;
-  REF_INT i, item;
+  REF_DBL box[6], *all_box;
+  REF_INT nbox, *box_source;
+  REF_INT nsend, nrecv, nreturn, nfound;
+  REF_INT *send_proc, *send_node, *recv_node;
+  REF_DBL *send_xyz, *recv_xyz;
+  REF_INT *return_proc, *return_node, *return_cell, *my_proc;
+  REF_DBL *return_bary;
+  REF_INT *found_node, *found_cell, *found_proc;
+  REF_DBL *found_bary, *best_score, score;
+  REF_INT part, i, item, batch, n, *first;
 
   RSS(ref_list_create(&ref_list), "create list");
   RSS(ref_search_create(&ref_search, ref_cell_n(from_tet)), "mk sr");
+  for (i = 0; i < 3; i++) {
+    box[i] = 1.0e100;
+    box[i + 3] = -1.0e100;
+  }
   each_ref_cell_valid_cell_with_nodes(from_tet, cell, nodes) {
     RSS(ref_interp_bounding_sphere(from_node, nodes, center, &radius), "b");
     RSS(ref_search_insert(ref_search, cell, center, 2.0 * radius), "ins");
+    for (i = 0; i < 3; i++) {
+      box[i] = MIN(box[i], center[i] - 2.0 * radius - fuzz);
+      box[i + 3] = MAX(box[i + 3], center[i] + 2.0 * radius + fuzz);
+    }
   }
+  RSS(ref_mpi_allconcat(ref_mpi, 6, 1, (void *)box, &nbox, &box_source,
+                        (void **)&all_box, REF_DBL_TYPE),
+      "cat boxes");
+  REIS(ref_mpi_n(ref_mpi), nbox, "one box per part");
 
-  ntarget = 0;
+  nsend = 0;
   each_ref_node_valid_node(to_node, node) {
     if (!ref_node_owned(to_node, node) || REF_EMPTY != ref_interp->cell[node])
       continue;
-    ntarget++;
+    for (part = 0; part < nbox; part++) {
+      if (ref_interp_box_holds(&(all_box[6 * part]),
+                               ref_node_xyz_ptr(to_node, node)))
+        nsend++;
+    }
   }
-  ref_malloc(local_node, ntarget, REF_INT);
-  ref_malloc(local_xyz, 3 * ntarget, REF_DBL);
-  ntarget = 0;
+  ref_malloc(send_proc, nsend, REF_INT);
+  ref_malloc(send_node, nsend, REF_INT);
+  ref_malloc(send_xyz, 3 * nsend, REF_DBL);
+  nsend = 0;
   each_ref_node_valid_node(to_node, node) {
     if (!ref_node_owned(to_node, node) || REF_EMPTY != ref_interp->cell[node])
       continue;
-    local_node[ntarget] = node;
-    local_xyz[0 + 3 * ntarget] = ref_node_xyz(to_node, 0, node);
-    local_xyz[1 + 3 * ntarget] = ref_node_xyz(to_node, 1, node);
-    local_xyz[2 + 3 * ntarget] = ref_node_xyz(to_node, 2, node);
-    ntarget++;
+    for (part = 0; part < nbox; part++) {
+      if (!ref_interp_box_holds(&(all_box[6 * part]),
+                                ref_node_xyz_ptr(to_node, node)))
+        continue;
+      send_proc[nsend] = part;
+      send_node[nsend] = node;
+      for (i = 0; i < 3; i++)
+        send_xyz[i + 3 * nsend] = ref_node_xyz(to_node, i, node);
+      nsend++;
+    }
   }
-  RSS(ref_mpi_allconcat(ref_mpi, 3, ntarget, (void *)local_xyz, &total_node,
-                        &source, (void **)&global_xyz, REF_DBL_TYPE),
-      "cat");
-  ref_free(source);
-  RSS(ref_mpi_allconcat(ref_mpi, 1, ntarget, (void *)local_node, &total_node,
-                        &source, (void **)&global_node, REF_INT_TYPE),
-      "cat");
+  ref_free(box_source);
+  ref_free(all_box);
 
-  ref_malloc(best_bary, total_node, REF_DBL);
-  ref_malloc(best_node, total_node, REF_INT);
-  ref_malloc(best_cell, total_node, REF_INT);
-  ref_malloc(from_proc, total_node, REF_INT);
-  for (node = 0; node < total_node; node++) {
-    best_node[node] = global_node[node];
-    best_cell[node] = REF_EMPTY;
-    best_bary[node] = 1.0e20; /* negative for min, until use max*/
-    RSS(ref_search_touching(ref_search, ref_list, &(global_xyz[3 * node]),
-                            fuzz),
+  ref_malloc_init(my_proc, nsend, REF_INT, ref_mpi_rank(ref_mpi));
+  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_node, 1, nsend,
+                        (void **)(&recv_node), &nrecv, REF_INT_TYPE),
+      "blind send node");
+  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_xyz, 3, nsend,
+                        (void **)(&recv_xyz), &nrecv, REF_DBL_TYPE),
+      "blind send xyz");
+  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)my_proc, 1, nsend,
+                        (void **)(&return_proc), &nrecv, REF_INT_TYPE),
+      "blind send proc");
+  ref_free(my_proc);
+  ref_free(send_xyz);
+  ref_free(send_node);
+  ref_free(send_proc);
+
+  /* score and bary of the best local tet, negative min bary for min */
+  ref_malloc(return_node, nrecv, REF_INT);
+  ref_malloc(return_cell, nrecv, REF_INT);
+  ref_malloc(return_bary, 5 * nrecv, REF_DBL);
+  /* batches of queries bound the length of the candidate list */
+  ref_malloc(first, REF_INTERP_TREE_BATCH + 1, REF_INT);
+  nreturn = 0;
+  for (batch = 0; batch < nrecv; batch += REF_INTERP_TREE_BATCH) {
+    n = MIN(REF_INTERP_TREE_BATCH, nrecv - batch);
+    RSS(ref_search_touching_many(ref_search, ref_list, n,
+                                 &(recv_xyz[3 * batch]), fuzz, first),
         "tch");
-    if (ref_list_n(ref_list) > 0) {
-      RSS(ref_interp_enclosing_tet_in_list(from_grid, ref_list,
-                                           &(global_xyz[3 * node]),
-                                           &(best_cell[node]), bary),
+    (ref_interp->tree_cells) += ref_list_n(ref_list);
+    for (item = batch; item < batch + n; item++) {
+      i = item - batch;
+      if (first[i + 1] == first[i]) continue;
+      RSS(ref_interp_enclosing_tet_in_list(
+              from_grid, first[i + 1] - first[i],
+              &(ref_list_value(ref_list, first[i])), &(recv_xyz[3 * item]),
+              &cell, bary),
           "best in list");
-      /* negative for min, until use max*/
-      best_bary[node] = -MIN(MIN(bary[0], bary[1]), MIN(bary[2], bary[3]));
-    } else {
-      best_cell[node] = REF_EMPTY;
+      RSS(ref_cell_nodes(from_tet, cell, nodes), "cell");
+      return_proc[nreturn] = return_proc[item];
+      return_node[nreturn] = recv_node[item];
+      return_cell[nreturn] = cell;
+      return_bary[0 + 5 * nreturn] =
+          -MIN(MIN(bary[0], bary[1]), MIN(bary[2], bary[3]));
+      RSS(ref_node_bary4(from_node, nodes, &(recv_xyz[3 * item]),
+                         &(return_bary[1 + 5 * nreturn])),
+          "bary");
+      nreturn++;
     }
-    (ref_interp->tree_cells) += ref_list_n(ref_list);
     RSS(ref_list_erase(ref_list), "reset list");
   }
+  ref_free(first);
+  ref_free(recv_xyz);
+  ref_free(recv_node);
 
-  /* negative for min, until use max*/
-  RSS(ref_mpi_allminwho(ref_mpi, best_bary, from_proc, total_node), "who");
-
-  nsend = 0;
-  for (node = 0; node < total_node; node++)
-    if (ref_mpi_rank(ref_mpi) == from_proc[node]) nsend++;
-
-  ref_malloc(send_bary, 4 * nsend, REF_DBL);
-  ref_malloc(send_cell, nsend, REF_INT);
-  ref_malloc(send_node, nsend, REF_INT);
-  ref_malloc(send_proc, nsend, REF_INT);
-  ref_malloc_init(my_proc, nsend, REF_INT, ref_mpi_rank(ref_mpi));
-  nsend = 0;
-  for (node = 0; node < total_node; node++)
-    if (ref_mpi_rank(ref_mpi) == from_proc[node]) {
-      send_proc[nsend] = source[node];
-      send_node[nsend] = best_node[node];
-      send_cell[nsend] = best_cell[node];
-      RSS(ref_cell_nodes(from_tet, best_cell[node], nodes), "cell");
-      RSS(ref_node_bary4(from_node, nodes, &(global_xyz[3 * node]),
-                         &(send_bary[4 * nsend])),
-          "bary");
-      nsend++;
-    }
-
-  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_node, 1, nsend,
-                        (void **)(&recv_node), &nrecv, REF_INT_TYPE),
+  ref_malloc_init(my_proc, nreturn, REF_INT, ref_mpi_rank(ref_mpi));
+  RSS(ref_mpi_blindsend(ref_mpi, return_proc, (void *)return_node, 1, nreturn,
+                        (void **)(&found_node), &nfound, REF_INT_TYPE),
       "blind send node");
-  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_cell, 1, nsend,
-                        (void **)(&recv_cell), &nrecv, REF_INT_TYPE),
+  RSS(ref_mpi_blindsend(ref_mpi, return_proc, (void *)return_cell, 1, nreturn,
+                        (void **)(&found_cell), &nfound, REF_INT_TYPE),
       "blind send cell");
-  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)my_proc, 1, nsend,
-                        (void **)(&recv_proc), &nrecv, REF_INT_TYPE),
+  RSS(ref_mpi_blindsend(ref_mpi, return_proc, (void *)my_proc, 1, nreturn,
+                        (void **)(&found_proc), &nfound, REF_INT_TYPE),
       "blind send proc");
-  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_bary, 4, nsend,
-                        (void **)(&recv_bary), &nrecv, REF_DBL_TYPE),
+  RSS(ref_mpi_blindsend(ref_mpi, return_proc, (void *)return_bary, 5, nreturn,
+                        (void **)(&found_bary), &nfound, REF_DBL_TYPE),
       "blind send bary");
-
-  for (item = 0; item < nrecv; item++) {
-    (ref_interp->n_tree)++;
-    node = recv_node[item];
-    REIS(REF_EMPTY, ref_interp->cell[node], "tree already found?");
+  ref_free(my_proc);
+  ref_free(return_bary);
+  ref_free(return_cell);
+  ref_free(return_node);
+  ref_free(return_proc);
+
+  /* lowest score wins, ties to the lowest part like allminwho */
+  ref_malloc_init(best_score, ref_node_max(to_node), REF_DBL, 1.0e100);
+  for (item = 0; item < nfound; item++) {
+    node = found_node[item];
+    score = found_bary[0 + 5 * item];
+    if (score > best_score[node]) continue;
+    if (score == best_score[node] && found_proc[item] > ref_interp->part[node])
+      continue;
+    best_score[node] = score;
+    if (REF_EMPTY == ref_interp->cell[node]) (ref_interp->n_tree)++;
     if (ref_interp->agent_hired[node]) { /* need to dequeue */
       RSS(ref_agents_delete(ref_interp->ref_agents, node), "deq");
       ref_interp->agent_hired[node] = REF_FALSE;
     }
-    ref_interp->cell[node] = recv_cell[item];
-    ref_interp->part[node] = recv_proc[item];
+    ref_interp->cell[node] = found_cell[item];
+    ref_interp->part[node] = found_proc[item];
     for (i = 0; i < 4; i++)
-      ref_interp->bary[i + 4 * node] = recv_bary[i + 4 * item];
+      ref_interp->bary[i + 4 * node] = found_bary[1 + i + 5 * item];
   }
+  ref_free(best_score);
 
   RSS(ref_mpi_allsum(ref_mpi, &(ref_interp->n_tree), 1, REF_INT_TYPE), "as");
 
-  ref_free(recv_node);
-  ref_free(recv_cell);
-  ref_free(recv_proc);
-  ref_free(recv_bary);
-
-  ref_free(send_bary);
-  ref_free(my_proc);
-  ref_free(send_cell);
-  ref_free(send_node);
-  ref_free(send_proc);
-
-  ref_free(from_proc);
-  ref_free(best_cell);
-  ref_free(best_node);
-  ref_free(best_bary);
-
-  ref_free(source);
-  ref_free(global_node);
-  ref_free(global_xyz);
-  ref_free(local_xyz);
-  ref_free(local_node);
+  ref_free(found_bary);
+  ref_free(found_proc);
+  ref_free(found_cell);
+  ref_free(found_node);
 
   RSS(ref_search_free(ref_search), "free list");
   RSS(ref_list_free(ref_list), "free list");
@@ -839,6 +877,13 @@ REF_STATUS ref_interp_tree(REF_INTERP ref_interp) {
 
 REF_STATUS ref_interp_locate(REF_INTERP ref_interp) {
   REF_MPI ref_mpi = ref_interp_mpi(ref_interp);
+  REF_GRID from_grid = ref_interp_from_grid(ref_interp);
+  REF_GRID to_grid = ref_interp_to_grid(ref_interp);
+
+  /* neither grid changes while locating, walk packed adjacency */
+  RSS(ref_cell_freeze(ref_grid_tet(from_grid)), "freeze from tet");
+  RSS(ref_cell_freeze(ref_grid_tri(from_grid)), "freeze from tri");
+  RSS(ref_cell_freeze(ref_grid_tet(to_grid)), "freeze to tet");
 
   if (ref_interp->instrument)
     RSS(ref_mpi_stopwatch_start(ref_mpi), "locate clock");
@@ -855,6 +900,10 @@ REF_STATUS ref_interp_locate(REF_INTERP ref_interp) {
   if (ref_interp->instrument)
     RSS(ref_mpi_stopwatch_stop(ref_mpi, "tree"), "locate clock");
 
+  RSS(ref_cell_thaw(ref_grid_tet(to_grid)), "thaw to tet");
+  RSS(ref_cell_thaw(ref_grid_tri(from_grid)), "thaw from tri");
+  RSS(ref_cell_thaw(ref_grid_tet(from_grid)), "thaw from tet");
+
   return REF_SUCCESS;
 }
 
@@ -67,6 +67,9 @@ REF_STATUS ref_interp_free(REF_INTERP ref_interp);
 
 REF_STATUS ref_interp_locate(REF_INTERP ref_interp);
 
+REF_STATUS ref_interp_bounding_sphere(REF_NODE ref_node, REF_INT *nodes,
+                                      REF_DBL *center, REF_DBL *radius);
+
 REF_STATUS ref_interp_scalar(REF_INTERP ref_interp, REF_INT leading_dim,
                              REF_DBL *from_scalar, REF_DBL *to_scalar);
 
@@ -226,8 +226,9 @@ int main(int argc, char *argv[]) {
     RSS(ref_part_by_extension(&new_grid, ref_mpi, argv[4]),
         "part candidate grid in position 4");
     if (ref_mpi_once(ref_mpi)) {
-      printf("%d leading dim from %d nodes to %d nodes\n", ldim,
-             ref_node_n_global(ref_grid_node(old_grid)),
+      printf("%d leading dim from " REF_GLOB_FMT " nodes to " REF_GLOB_FMT
+             " nodes\n",
+             ldim, ref_node_n_global(ref_grid_node(old_grid)),
              ref_node_n_global(ref_grid_node(new_grid)));
     }
     RSS(ref_interp_create(&ref_interp, old_grid, new_grid), "make interp");
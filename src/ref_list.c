@@ -143,6 +143,20 @@ REF_STATUS ref_list_apply_offset(REF_LIST ref_list, REF_INT equal_and_above,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_list_apply_o2n(REF_LIST ref_list, REF_INT *o2n) {
+  REF_INT i, n;
+
+  n = 0;
+  for (i = 0; i < ref_list_n(ref_list); i++) {
+    if (REF_EMPTY == o2n[ref_list->value[i]]) continue;
+    ref_list->value[n] = o2n[ref_list->value[i]];
+    n++;
+  }
+  ref_list_n(ref_list) = n;
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_list_sort(REF_LIST ref_list) {
   REF_INT *order;
   REF_INT i;
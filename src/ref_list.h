@@ -57,6 +57,9 @@ REF_STATUS ref_list_delete(REF_LIST ref_list, REF_INT value);
 REF_STATUS ref_list_apply_offset(REF_LIST ref_list, REF_INT equal_and_above,
                                  REF_INT offset);
 
+/* renumber values with o2n, values mapped to REF_EMPTY are dropped */
+REF_STATUS ref_list_apply_o2n(REF_LIST ref_list, REF_INT *o2n);
+
 REF_STATUS ref_list_sort(REF_LIST ref_list);
 
 REF_STATUS ref_list_erase(REF_LIST ref_list);
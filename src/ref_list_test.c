@@ -96,6 +96,24 @@ int main(int argc, char *argv[]) {
     RSS(ref_list_free(ref_list), "free");
   }
 
+  { /* apply o2n drops removed */
+    REF_INT last;
+    REF_INT o2n[4] = {REF_EMPTY, 0, 3, 1};
+    RSS(ref_list_create(&ref_list), "create");
+    RSS(ref_list_push(ref_list, 0), "store");
+    RSS(ref_list_push(ref_list, 2), "store");
+    RSS(ref_list_push(ref_list, 3), "store");
+    RSS(ref_list_apply_o2n(ref_list, o2n), "o2n");
+    REIS(2, ref_list_n(ref_list), "removed not dropped");
+
+    RSS(ref_list_pop(ref_list, &last), "rm");
+    REIS(1, last, "renumber");
+    RSS(ref_list_pop(ref_list, &last), "rm");
+    REIS(3, last, "renumber");
+
+    RSS(ref_list_free(ref_list), "free");
+  }
+
   { /* sort */
     REF_INT last;
     RSS(ref_list_create(&ref_list), "create");
@@ -466,15 +466,75 @@ REF_STATUS ref_metric_interpolate(REF_GRID to_grid, REF_GRID from_grid) {
   return REF_SUCCESS;
 }
 
+/* edges of each node in increasing edge order, skipping inactive edges */
+static REF_STATUS ref_metric_node_edges(REF_EDGE ref_edge, REF_BOOL *active,
+                                        REF_INT **start, REF_INT **edges) {
+  REF_INT nnode = ref_node_max(ref_edge_node(ref_edge));
+  REF_INT edge, node, i;
+
+  ref_malloc_init(*start, nnode + 1, REF_INT, 0);
+  each_ref_edge(ref_edge, edge) {
+    if (NULL != active && !active[edge]) continue;
+    for (i = 0; i < 2; i++) (*start)[ref_edge_e2n(ref_edge, i, edge) + 1]++;
+  }
+  for (node = 0; node < nnode; node++) (*start)[node + 1] += (*start)[node];
+  ref_malloc(*edges, (*start)[nnode], REF_INT);
+  each_ref_edge(ref_edge, edge) {
+    if (NULL != active && !active[edge]) continue;
+    for (i = 0; i < 2; i++) {
+      node = ref_edge_e2n(ref_edge, i, edge);
+      (*edges)[(*start)[node]] = edge;
+      (*start)[node]++;
+    }
+  }
+  for (node = nnode; node > 0; node--) (*start)[node] = (*start)[node - 1];
+  (*start)[0] = 0;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_metric_gradation_node(REF_DBL *metric,
+                                            REF_DBL *metric_orig,
+                                            REF_NODE ref_node,
+                                            REF_EDGE ref_edge, REF_INT node,
+                                            REF_INT *start, REF_INT *edges,
+                                            REF_DBL log_r) {
+  REF_DBL ratio, enlarge;
+  REF_DBL direction[3];
+  REF_DBL limit_metric[6], limited[6];
+  REF_INT i, item, node0, node1, other;
+
+  for (item = start[node]; item < start[node + 1]; item++) {
+    node0 = ref_edge_e2n(ref_edge, 0, edges[item]);
+    node1 = ref_edge_e2n(ref_edge, 1, edges[item]);
+    other = (node == node0 ? node1 : node0);
+    direction[0] =
+        (ref_node_xyz(ref_node, 0, node1) - ref_node_xyz(ref_node, 0, node0));
+    direction[1] =
+        (ref_node_xyz(ref_node, 1, node1) - ref_node_xyz(ref_node, 1, node0));
+    direction[2] =
+        (ref_node_xyz(ref_node, 2, node1) - ref_node_xyz(ref_node, 2, node0));
+
+    ratio = ref_matrix_sqrt_vt_m_v(&(metric_orig[6 * other]), direction);
+    enlarge = pow(1.0 + ratio * log_r, -2.0);
+    for (i = 0; i < 6; i++)
+      limit_metric[i] = metric_orig[i + 6 * other] * enlarge;
+    RSS(ref_matrix_intersect(&(metric_orig[6 * node]), limit_metric, limited),
+        "limit m with enlarged other");
+    RSS(ref_matrix_intersect(&(metric[6 * node]), limited, &(metric[6 * node])),
+        "update m");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_metric_gradation(REF_DBL *metric, REF_GRID ref_grid, REF_DBL r) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_EDGE ref_edge;
   REF_DBL *metric_orig;
-  REF_DBL ratio, enlarge, log_r;
-  REF_DBL direction[3];
-  REF_DBL limit_metric[6], limited[6];
-  REF_INT node, i;
-  REF_INT edge, node0, node1;
+  REF_DBL log_r;
+  REF_INT node, i, nfail;
+  REF_INT *start, *edges;
 
   log_r = log(r);
 
@@ -488,36 +548,22 @@ REF_STATUS ref_metric_gradation(REF_DBL *metric, REF_GRID ref_grid, REF_DBL r) {
 
   /* F. Alauzet doi:10.1016/j.finel.2009.06.028 equation (9) */
 
-  each_ref_edge(ref_edge, edge) {
-    node0 = ref_edge_e2n(ref_edge, 0, edge);
-    node1 = ref_edge_e2n(ref_edge, 1, edge);
-    direction[0] =
-        (ref_node_xyz(ref_node, 0, node1) - ref_node_xyz(ref_node, 0, node0));
-    direction[1] =
-        (ref_node_xyz(ref_node, 1, node1) - ref_node_xyz(ref_node, 1, node0));
-    direction[2] =
-        (ref_node_xyz(ref_node, 2, node1) - ref_node_xyz(ref_node, 2, node0));
-
-    ratio = ref_matrix_sqrt_vt_m_v(&(metric_orig[6 * node1]), direction);
-    enlarge = pow(1.0 + ratio * log_r, -2.0);
-    for (i = 0; i < 6; i++)
-      limit_metric[i] = metric_orig[i + 6 * node1] * enlarge;
-    RSS(ref_matrix_intersect(&(metric_orig[6 * node0]), limit_metric, limited),
-        "limit m0 with enlarged m1");
-    RSS(ref_matrix_intersect(&(metric[6 * node0]), limited,
-                             &(metric[6 * node0])),
-        "update m0");
-
-    ratio = ref_matrix_sqrt_vt_m_v(&(metric_orig[6 * node0]), direction);
-    enlarge = pow(1.0 + ratio * log_r, -2.0);
-    for (i = 0; i < 6; i++)
-      limit_metric[i] = metric_orig[i + 6 * node0] * enlarge;
-    RSS(ref_matrix_intersect(&(metric_orig[6 * node1]), limit_metric, limited),
-        "limit m1 with enlarged m0");
-    RSS(ref_matrix_intersect(&(metric[6 * node1]), limited,
-                             &(metric[6 * node1])),
-        "update m1");
+  /* each node applies its own half of its edges in edge order, so nodes
+   * are independent and the result matches a serial sweep over edges */
+  RSS(ref_metric_node_edges(ref_edge, NULL, &start, &edges), "node edges");
+  nfail = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nfail)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    if (REF_SUCCESS != ref_metric_gradation_node(metric, metric_orig, ref_node,
+                                                 ref_edge, node, start, edges,
+                                                 log_r))
+      nfail++;
   }
+  REIS(0, nfail, "gradation node");
+  ref_free(edges);
+  ref_free(start);
 
   ref_free(metric_orig);
 
@@ -528,18 +574,42 @@ REF_STATUS ref_metric_gradation(REF_DBL *metric, REF_GRID ref_grid, REF_DBL r) {
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_metric_surface_gradation_node(
+    REF_DBL *metric, REF_DBL *metric_orig, REF_DBL *metric_limit,
+    REF_EDGE ref_edge, REF_INT node, REF_INT *start, REF_INT *edges,
+    REF_DBL *edge_lr) {
+  REF_DBL lr;
+  REF_DBL l[6], m[6];
+  REF_INT i, item, other;
+
+  for (item = start[node]; item < start[node + 1]; item++) {
+    other = ref_edge_e2n(ref_edge, 0, edges[item]);
+    if (node == other) other = ref_edge_e2n(ref_edge, 1, edges[item]);
+    lr = edge_lr[edges[item]];
+    for (i = 0; i < 6; i++)
+      l[i] = metric_limit[i + 6 * other] * (1.0 / lr / lr);
+    RSS(ref_matrix_intersect(&(metric_orig[6 * node]), l, m), "m");
+    RSS(ref_matrix_intersect(m, &(metric[6 * node]), &(metric[6 * node])),
+        "m");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_metric_surface_gradation(REF_DBL *metric, REF_GRID ref_grid,
                                         REF_DBL r) {
   REF_CELL ref_cell = ref_grid_tri(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_EDGE ref_edge;
   REF_DBL *metric_orig;
   REF_DBL *metric_limit;
-  REF_DBL ratio, lr;
-  REF_DBL l0[6], l1[6];
-  REF_DBL m0[6], m1[6];
+  REF_DBL *edge_lr;
+  REF_DBL ratio;
   REF_INT node, i;
   REF_INT edge, node0, node1;
-  REF_BOOL have_side;
+  REF_BOOL *have_side;
+  REF_INT nfail;
+  REF_INT *start, *edges;
 
   RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
 
@@ -554,24 +624,37 @@ REF_STATUS ref_metric_surface_gradation(REF_DBL *metric, REF_GRID ref_grid,
       metric_limit[i + 6 * node] = metric[i + 6 * node] * (1.0 / r / r);
   }
 
+  ref_malloc(have_side, ref_edge_n(ref_edge), REF_BOOL);
+  ref_malloc(edge_lr, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_cell_freeze(ref_cell), "freeze");
   each_ref_edge(ref_edge, edge) {
     node0 = ref_edge_e2n(ref_edge, 0, edge);
     node1 = ref_edge_e2n(ref_edge, 1, edge);
-    RSS(ref_cell_has_side(ref_cell, node0, node1, &have_side), "side");
-    if (!have_side) continue;
-    RSS(ref_node_ratio(ref_grid_node(ref_grid), node0, node1, &ratio), "ratio");
-    lr = pow(r, ratio);
-    for (i = 0; i < 6; i++)
-      l0[i] = metric_limit[i + 6 * node0] * (1.0 / lr / lr);
-    for (i = 0; i < 6; i++)
-      l1[i] = metric_limit[i + 6 * node1] * (1.0 / lr / lr);
-    RSS(ref_matrix_intersect(&(metric_orig[6 * node0]), l1, m0), "m0");
-    RSS(ref_matrix_intersect(&(metric_orig[6 * node1]), l0, m1), "m1");
-    RSS(ref_matrix_intersect(m0, &(metric[6 * node0]), &(metric[6 * node0])),
-        "m0");
-    RSS(ref_matrix_intersect(m1, &(metric[6 * node1]), &(metric[6 * node1])),
-        "m0");
+    RSS(ref_cell_has_side(ref_cell, node0, node1, &(have_side[edge])), "side");
+    if (!have_side[edge]) continue;
+    RSS(ref_node_ratio(ref_node, node0, node1, &ratio), "ratio");
+    edge_lr[edge] = pow(r, ratio);
+  }
+  RSS(ref_cell_thaw(ref_cell), "thaw");
+
+  /* nodes are independent and see their edges in the serial order */
+  RSS(ref_metric_node_edges(ref_edge, have_side, &start, &edges),
+      "node edges");
+  nfail = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nfail)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    if (REF_SUCCESS != ref_metric_surface_gradation_node(
+                           metric, metric_orig, metric_limit, ref_edge, node,
+                           start, edges, edge_lr))
+      nfail++;
   }
+  REIS(0, nfail, "surface gradation node");
+  ref_free(edges);
+  ref_free(start);
+  ref_free(edge_lr);
+  ref_free(have_side);
 
   ref_free(metric_limit);
   ref_free(metric_orig);
@@ -67,6 +67,51 @@
   ../acceptance/2d/linear/two/accept-2d-two-08.metric
 */
 
+static REF_STATUS ref_metric_test_serial_gradation(REF_DBL *metric,
+                                                   REF_GRID ref_grid,
+                                                   REF_DBL r) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_EDGE ref_edge;
+  REF_DBL *metric_orig;
+  REF_DBL ratio, enlarge;
+  REF_DBL direction[3];
+  REF_DBL limit_metric[6], limited[6];
+  REF_INT i, edge, node0, node1;
+
+  RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
+  ref_malloc(metric_orig, 6 * ref_node_max(ref_node), REF_DBL);
+  for (i = 0; i < 6 * ref_node_max(ref_node); i++) metric_orig[i] = metric[i];
+  each_ref_edge(ref_edge, edge) {
+    node0 = ref_edge_e2n(ref_edge, 0, edge);
+    node1 = ref_edge_e2n(ref_edge, 1, edge);
+    for (i = 0; i < 3; i++)
+      direction[i] =
+          ref_node_xyz(ref_node, i, node1) - ref_node_xyz(ref_node, i, node0);
+    ratio = ref_matrix_sqrt_vt_m_v(&(metric_orig[6 * node1]), direction);
+    enlarge = pow(1.0 + ratio * log(r), -2.0);
+    for (i = 0; i < 6; i++)
+      limit_metric[i] = metric_orig[i + 6 * node1] * enlarge;
+    RSS(ref_matrix_intersect(&(metric_orig[6 * node0]), limit_metric, limited),
+        "limit");
+    RSS(ref_matrix_intersect(&(metric[6 * node0]), limited,
+                             &(metric[6 * node0])),
+        "update");
+    ratio = ref_matrix_sqrt_vt_m_v(&(metric_orig[6 * node0]), direction);
+    enlarge = pow(1.0 + ratio * log(r), -2.0);
+    for (i = 0; i < 6; i++)
+      limit_metric[i] = metric_orig[i + 6 * node0] * enlarge;
+    RSS(ref_matrix_intersect(&(metric_orig[6 * node1]), limit_metric, limited),
+        "limit");
+    RSS(ref_matrix_intersect(&(metric[6 * node1]), limited,
+                             &(metric[6 * node1])),
+        "update");
+  }
+  ref_free(metric_orig);
+  RSS(ref_edge_free(ref_edge), "free");
+
+  return REF_SUCCESS;
+}
+
 int main(int argc, char *argv[]) {
   REF_INT fixed_point_pos = REF_EMPTY;
   REF_INT curve_limit_pos = REF_EMPTY;
@@ -868,6 +913,39 @@ int main(int argc, char *argv[]) {
     RSS(ref_grid_free(ref_grid), "free");
   }
 
+  if (!ref_mpi_para(ref_mpi)) { /* node sweep equals edge sweep bitwise */
+    REF_GRID ref_grid;
+    REF_DBL *metric, *serial;
+    REF_INT node, i;
+
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+
+    ref_malloc_init(metric, 6 * ref_node_max(ref_grid_node(ref_grid)),
+                    REF_DBL, 0.0);
+    ref_malloc_init(serial, 6 * ref_node_max(ref_grid_node(ref_grid)),
+                    REF_DBL, 0.0);
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      metric[0 + 6 * node] = 1.0 + 0.1 * (REF_DBL)(node % 7);
+      metric[1 + 6 * node] = 0.01 * (REF_DBL)(node % 3);
+      metric[3 + 6 * node] = 1.0 + 10.0 * (REF_DBL)(node % 5);
+      metric[5 + 6 * node] = 1.0 + 100.0 * (REF_DBL)(node % 11);
+      for (i = 0; i < 6; i++) serial[i + 6 * node] = metric[i + 6 * node];
+    }
+
+    RSS(ref_metric_gradation(metric, ref_grid, 1.5), "grad");
+    RSS(ref_metric_test_serial_gradation(serial, ref_grid, 1.5), "serial");
+
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      for (i = 0; i < 6; i++)
+        RAS(serial[i + 6 * node] == metric[i + 6 * node], "not identical");
+    }
+
+    ref_free(serial);
+    ref_free(metric);
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   if (!ref_mpi_para(ref_mpi)) { /* limit hmin */
     REF_GRID ref_grid;
     REF_DBL *metric;
@@ -66,13 +66,13 @@ REF_STATUS ref_migrate_create(REF_MIGRATE *ref_migrate_ptr, REF_GRID ref_grid) {
 
   ref_migrate_grid(ref_migrate) = ref_grid;
 
-  RSS(ref_adj_create(&(ref_migrate_parent_global(ref_migrate))), "make adj");
+  RSS(ref_adj_create(&(ref_migrate_parent_local(ref_migrate))), "make adj");
   RSS(ref_adj_create(&(ref_migrate_parent_part(ref_migrate))), "make adj");
   RSS(ref_adj_create(&(ref_migrate_conn(ref_migrate))), "make adj");
 
   ref_migrate_max(ref_migrate) = ref_node_max(ref_node);
 
-  ref_malloc_init(ref_migrate->global, ref_migrate_max(ref_migrate), REF_INT,
+  ref_malloc_init(ref_migrate->global, ref_migrate_max(ref_migrate), REF_GLOB,
                   REF_EMPTY);
   ref_malloc(ref_migrate->xyz, 3 * ref_migrate_max(ref_migrate), REF_DBL);
   ref_malloc(ref_migrate->weight, ref_migrate_max(ref_migrate), REF_DBL);
@@ -80,8 +80,7 @@ REF_STATUS ref_migrate_create(REF_MIGRATE *ref_migrate_ptr, REF_GRID ref_grid) {
   each_ref_node_valid_node(ref_node, node) {
     if (ref_mpi_rank(ref_node_mpi(ref_node)) == ref_node_part(ref_node, node)) {
       ref_migrate_global(ref_migrate, node) = ref_node_global(ref_node, node);
-      RSS(ref_adj_add(ref_migrate_parent_global(ref_migrate), node,
-                      ref_node_global(ref_node, node)),
+      RSS(ref_adj_add(ref_migrate_parent_local(ref_migrate), node, node),
           "add");
       RSS(ref_adj_add(ref_migrate_parent_part(ref_migrate), node,
                       ref_node_part(ref_node, node)),
@@ -117,7 +116,7 @@ REF_STATUS ref_migrate_free(REF_MIGRATE ref_migrate) {
 
   RSS(ref_adj_free(ref_migrate_conn(ref_migrate)), "free adj");
   RSS(ref_adj_free(ref_migrate_parent_part(ref_migrate)), "free adj");
-  RSS(ref_adj_free(ref_migrate_parent_global(ref_migrate)), "free adj");
+  RSS(ref_adj_free(ref_migrate_parent_local(ref_migrate)), "free adj");
 
   ref_free(ref_migrate->global);
   ref_free(ref_migrate->xyz);
@@ -129,15 +128,15 @@ REF_STATUS ref_migrate_free(REF_MIGRATE ref_migrate) {
 
 REF_STATUS ref_migrate_inspect(REF_MIGRATE ref_migrate) {
   REF_NODE ref_node = ref_grid_node(ref_migrate_grid(ref_migrate));
-  REF_INT node, item, global, part;
+  REF_INT node, item, local, part;
 
   each_ref_migrate_node(ref_migrate, node) {
-    printf(" %2d : %3d :", ref_mpi_rank(ref_node_mpi(ref_node)),
+    printf(" %2d : " REF_GLOB_FMT " :", ref_mpi_rank(ref_node_mpi(ref_node)),
            ref_node_global(ref_node, node));
-    each_ref_adj_node_item_with_ref(ref_migrate_parent_global(ref_migrate),
-                                    node, item, global) {
+    each_ref_adj_node_item_with_ref(ref_migrate_parent_local(ref_migrate),
+                                    node, item, local) {
       part = ref_adj_item_ref(ref_migrate_parent_part(ref_migrate), item);
-      printf(" %3d+%d", global, part);
+      printf(" " REF_GLOB_FMT "+%d", ref_node_global(ref_node, local), part);
     }
     printf("\n");
   }
@@ -148,7 +147,7 @@ REF_STATUS ref_migrate_2d_agglomeration_keep(REF_MIGRATE ref_migrate,
                                              REF_INT keep, REF_INT lose) {
   REF_NODE ref_node = ref_grid_node(ref_migrate_grid(ref_migrate));
   REF_ADJ conn_adj = ref_migrate_conn(ref_migrate);
-  REF_INT item, global;
+  REF_INT item, local;
   REF_INT from_node;
 
   /* not working for general agglomeration, ghost lose? */
@@ -159,9 +158,9 @@ REF_STATUS ref_migrate_2d_agglomeration_keep(REF_MIGRATE ref_migrate,
   ref_migrate_global(ref_migrate, lose) = REF_EMPTY;
 
   /* skip if the lose node has been agglomerated */
-  each_ref_adj_node_item_with_ref(ref_migrate_parent_global(ref_migrate), keep,
-                                  item, global) {
-    if (global == ref_node_global(ref_node, lose)) {
+  each_ref_adj_node_item_with_ref(ref_migrate_parent_local(ref_migrate), keep,
+                                  item, local) {
+    if (local == lose) {
       return REF_SUCCESS;
     }
   }
@@ -187,9 +186,7 @@ REF_STATUS ref_migrate_2d_agglomeration_keep(REF_MIGRATE ref_migrate,
 
   ref_migrate_xyz(ref_migrate, 1, keep) = 0.5;
   ref_migrate_weight(ref_migrate, keep) = 2.0;
-  RSS(ref_adj_add(ref_migrate_parent_global(ref_migrate), keep,
-                  ref_node_global(ref_node, lose)),
-      "add");
+  RSS(ref_adj_add(ref_migrate_parent_local(ref_migrate), keep, lose), "add");
   RSS(ref_adj_add(ref_migrate_parent_part(ref_migrate), keep,
                   ref_node_part(ref_node, lose)),
       "add");
@@ -197,6 +194,48 @@ REF_STATUS ref_migrate_2d_agglomeration_keep(REF_MIGRATE ref_migrate,
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_migrate_2d_agglomeration(REF_MIGRATE ref_migrate) {
+  REF_GRID ref_grid = ref_migrate_grid(ref_migrate);
+  REF_NODE ref_node = ref_grid_node(ref_migrate_grid(ref_migrate));
+  REF_INT cell;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT keep, lose;
+
+  each_ref_cell_valid_cell_with_nodes(ref_grid_pri(ref_grid), cell, nodes) {
+    if (ref_node_global(ref_node, nodes[0]) <
+        ref_node_global(ref_node, nodes[3])) {
+      keep = nodes[0];
+      lose = nodes[3];
+    } else {
+      keep = nodes[3];
+      lose = nodes[0];
+    }
+    RSS(ref_migrate_2d_agglomeration_keep(ref_migrate, keep, lose), "0-3");
+
+    if (ref_node_global(ref_node, nodes[1]) <
+        ref_node_global(ref_node, nodes[4])) {
+      keep = nodes[1];
+      lose = nodes[4];
+    } else {
+      keep = nodes[4];
+      lose = nodes[1];
+    }
+    RSS(ref_migrate_2d_agglomeration_keep(ref_migrate, keep, lose), "1-4");
+
+    if (ref_node_global(ref_node, nodes[2]) <
+        ref_node_global(ref_node, nodes[5])) {
+      keep = nodes[2];
+      lose = nodes[5];
+    } else {
+      keep = nodes[5];
+      lose = nodes[2];
+    }
+    RSS(ref_migrate_2d_agglomeration_keep(ref_migrate, keep, lose), "2-5");
+  }
+
+  return REF_SUCCESS;
+}
+
 #if defined(HAVE_ZOLTAN) && defined(HAVE_MPI)
 
 static int ref_migrate_local_n(void *void_ref_migrate, int *ierr) {
@@ -229,7 +268,7 @@ static void ref_migrate_local_ids(void *void_ref_migrate, int global_dim,
   n = 0;
   each_ref_migrate_node(ref_migrate, node) {
     local[n] = node;
-    global[n] = ref_migrate_global(ref_migrate, node);
+    global[n] = (ZOLTAN_ID_TYPE)ref_migrate_global(ref_migrate, node);
     obj_wgts[n] = (float)ref_migrate_weight(ref_migrate, node);
     n++;
   }
@@ -315,7 +354,7 @@ static void ref_migrate_edge_list(void *void_ref_migrate, int global_dim,
 
   each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node, item,
                                   ref) {
-    conn_global[degree] = ref_node_global(ref_node, ref);
+    conn_global[degree] = (ZOLTAN_ID_TYPE)ref_node_global(ref_node, ref);
     conn_part[degree] = ref_node_part(ref_node, ref);
     weight[degree] =
         (float)(ref_node_age(ref_node, node) + ref_node_age(ref_node, ref) + 1);
@@ -323,48 +362,6 @@ static void ref_migrate_edge_list(void *void_ref_migrate, int global_dim,
   }
 }
 
-static REF_STATUS ref_migrate_2d_agglomeration(REF_MIGRATE ref_migrate) {
-  REF_GRID ref_grid = ref_migrate_grid(ref_migrate);
-  REF_NODE ref_node = ref_grid_node(ref_migrate_grid(ref_migrate));
-  REF_INT cell;
-  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-  REF_INT keep, lose;
-
-  each_ref_cell_valid_cell_with_nodes(ref_grid_pri(ref_grid), cell, nodes) {
-    if (ref_node_global(ref_node, nodes[0]) <
-        ref_node_global(ref_node, nodes[3])) {
-      keep = nodes[0];
-      lose = nodes[3];
-    } else {
-      keep = nodes[3];
-      lose = nodes[0];
-    }
-    RSS(ref_migrate_2d_agglomeration_keep(ref_migrate, keep, lose), "0-3");
-
-    if (ref_node_global(ref_node, nodes[1]) <
-        ref_node_global(ref_node, nodes[4])) {
-      keep = nodes[1];
-      lose = nodes[4];
-    } else {
-      keep = nodes[4];
-      lose = nodes[1];
-    }
-    RSS(ref_migrate_2d_agglomeration_keep(ref_migrate, keep, lose), "1-4");
-
-    if (ref_node_global(ref_node, nodes[2]) <
-        ref_node_global(ref_node, nodes[5])) {
-      keep = nodes[2];
-      lose = nodes[5];
-    } else {
-      keep = nodes[5];
-      lose = nodes[2];
-    }
-    RSS(ref_migrate_2d_agglomeration_keep(ref_migrate, keep, lose), "2-5");
-  }
-
-  return REF_SUCCESS;
-}
-
 #endif
 
 REF_STATUS ref_migrate_to_balance(REF_GRID ref_grid) {
@@ -391,6 +388,218 @@ REF_STATUS ref_migrate_single_part(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_migrate_node_part(REF_MIGRATE ref_migrate,
+                                        REF_INT *migrate_part) {
+  REF_GRID ref_grid = ref_migrate_grid(ref_migrate);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT node, item, local, parent, part, nsend, nrecv;
+  REF_INT *node_part, *proc;
+  REF_GLOB *send, *recv;
+
+  ref_malloc_init(node_part, ref_node_max(ref_node), REF_INT, REF_EMPTY);
+
+  nsend = 0;
+  each_ref_migrate_node(ref_migrate, node) {
+    each_ref_adj_node_item_with_ref(ref_migrate_parent_local(ref_migrate),
+                                    node, item, parent) {
+      nsend++;
+    }
+  }
+  ref_malloc(proc, nsend, REF_INT);
+  ref_malloc(send, 2 * nsend, REF_GLOB);
+
+  nsend = 0;
+  each_ref_migrate_node(ref_migrate, node) {
+    each_ref_adj_node_item_with_ref(ref_migrate_parent_local(ref_migrate),
+                                    node, item, parent) {
+      part = ref_adj_item_ref(ref_migrate_parent_part(ref_migrate), item);
+      proc[nsend] = part;
+      send[0 + 2 * nsend] = ref_node_global(ref_node, parent);
+      send[1 + 2 * nsend] = migrate_part[node];
+      nsend++;
+    }
+  }
+
+  RSS(ref_mpi_blindsend(ref_mpi, proc, (void *)send, 2, nsend, (void **)&recv,
+                        &nrecv, REF_GLOB_TYPE),
+      "blind send parent parts");
+  for (item = 0; item < nrecv; item++) {
+    RSS(ref_node_local(ref_node, recv[0 + 2 * item], &local), "g2l");
+    node_part[local] = (REF_INT)recv[1 + 2 * item];
+  }
+
+  ref_free(recv);
+  ref_free(send);
+  ref_free(proc);
+
+  RSS(ref_node_ghost_int(ref_node, node_part), "ghost part");
+
+  for (node = 0; node < ref_node_max(ref_node); node++)
+    ref_node_part(ref_node, node) = node_part[node];
+
+  ref_free(node_part);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_migrate_hilbert_part(REF_GRID ref_grid) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MIGRATE ref_migrate;
+  REF_INT node, n, i, lower, upper, mid, nsample, total, nrecv, nback;
+  REF_INT *local, *order, *source, *proc, *send_back, *recv_back;
+  REF_INT *migrate_part;
+  REF_DBL lo[3], hi[3], bbox[6], big = 1.0e200;
+  REF_DBL *xyz, *key, *sample, *all_sample, *splitter, *send, *recv;
+  REF_DBL *weight, before, total_weight, running;
+
+  RSS(ref_node_synchronize_globals(ref_node), "sync global nodes");
+
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+
+  RSS(ref_migrate_create(&ref_migrate, ref_grid), "create migrate");
+
+  if (ref_grid_twod(ref_grid)) {
+    RSS(ref_migrate_2d_agglomeration(ref_migrate), "2d agglom");
+  }
+
+  n = 0;
+  each_ref_migrate_node(ref_migrate, node) n++;
+  ref_malloc(local, n, REF_INT);
+  ref_malloc(xyz, 3 * n, REF_DBL);
+  ref_malloc(key, n, REF_DBL);
+  ref_malloc(order, n, REF_INT);
+
+  for (i = 0; i < 3; i++) {
+    lo[i] = big;
+    hi[i] = -big;
+  }
+  n = 0;
+  each_ref_migrate_node(ref_migrate, node) {
+    local[n] = node;
+    for (i = 0; i < 3; i++) {
+      xyz[i + 3 * n] = ref_migrate_xyz(ref_migrate, i, node);
+      lo[i] = MIN(lo[i], xyz[i + 3 * n]);
+      hi[i] = MAX(hi[i], xyz[i + 3 * n]);
+    }
+    n++;
+  }
+  for (i = 0; i < 3; i++) {
+    RSS(ref_mpi_min(ref_mpi, &(lo[i]), &(bbox[i]), REF_DBL_TYPE), "min");
+    RSS(ref_mpi_max(ref_mpi, &(hi[i]), &(bbox[i + 3]), REF_DBL_TYPE), "max");
+  }
+  RSS(ref_mpi_bcast(ref_mpi, bbox, 6, REF_DBL_TYPE), "bcast bbox");
+  RSS(ref_sort_hilbert_keys(n, xyz, &(bbox[0]), &(bbox[3]), key), "keys");
+  ref_free(xyz);
+
+  /* regular samples of the locally sorted keys choose the splitters */
+  RSS(ref_sort_heap_dbl(n, key, order), "sort local keys");
+  nsample = MIN(n, ref_mpi_n(ref_mpi));
+  ref_malloc(sample, nsample, REF_DBL);
+  for (i = 0; i < nsample; i++) sample[i] = key[order[(i * n) / nsample]];
+  RSS(ref_mpi_allconcat(ref_mpi, 1, nsample, (void *)sample, &total, &source,
+                        (void **)&all_sample, REF_DBL_TYPE),
+      "concat samples");
+  ref_free(source);
+  ref_free(sample);
+  ref_free(order);
+  ref_malloc(order, total, REF_INT);
+  RSS(ref_sort_heap_dbl(total, all_sample, order), "sort samples");
+  ref_malloc(splitter, ref_mpi_n(ref_mpi), REF_DBL);
+  for (i = 1; i < ref_mpi_n(ref_mpi); i++)
+    splitter[i - 1] = all_sample[order[(i * total) / ref_mpi_n(ref_mpi)]];
+  ref_free(order);
+  ref_free(all_sample);
+
+  /* send key, weight, origin to the part that owns its key range */
+  ref_malloc(proc, n, REF_INT);
+  ref_malloc(send, 4 * n, REF_DBL);
+  for (node = 0; node < n; node++) {
+    lower = 0;
+    upper = ref_mpi_n(ref_mpi) - 1;
+    while (lower < upper) {
+      mid = (lower + upper) / 2;
+      if (key[node] < splitter[mid]) {
+        upper = mid;
+      } else {
+        lower = mid + 1;
+      }
+    }
+    proc[node] = lower;
+    send[0 + 4 * node] = key[node];
+    send[1 + 4 * node] = ref_migrate_weight(ref_migrate, local[node]);
+    send[2 + 4 * node] = (REF_DBL)ref_mpi_rank(ref_mpi);
+    send[3 + 4 * node] = (REF_DBL)node;
+  }
+  ref_free(splitter);
+  ref_free(key);
+  RSS(ref_mpi_blindsend(ref_mpi, proc, (void *)send, 4, n, (void **)&recv,
+                        &nrecv, REF_DBL_TYPE),
+      "blind send keys");
+  ref_free(send);
+  ref_free(proc);
+
+  /* cut the global curve by accumulated weight */
+  ref_malloc(key, nrecv, REF_DBL);
+  ref_malloc(order, nrecv, REF_INT);
+  ref_malloc(weight, ref_mpi_n(ref_mpi), REF_DBL);
+  running = 0.0;
+  for (i = 0; i < nrecv; i++) {
+    key[i] = recv[0 + 4 * i];
+    running += recv[1 + 4 * i];
+  }
+  RSS(ref_sort_heap_dbl(nrecv, key, order), "sort received keys");
+  RSS(ref_mpi_allgather(ref_mpi, &running, weight, REF_DBL_TYPE),
+      "gather weight");
+  before = 0.0;
+  for (i = 0; i < ref_mpi_rank(ref_mpi); i++) before += weight[i];
+  total_weight = before;
+  for (i = ref_mpi_rank(ref_mpi); i < ref_mpi_n(ref_mpi); i++)
+    total_weight += weight[i];
+  total_weight = MAX(total_weight, 1.0e-300);
+
+  ref_malloc(proc, nrecv, REF_INT);
+  ref_malloc(send_back, 2 * nrecv, REF_INT);
+  running = before;
+  for (i = 0; i < nrecv; i++) {
+    node = order[i];
+    proc[node] = (REF_INT)recv[2 + 4 * node];
+    send_back[0 + 2 * node] = (REF_INT)recv[3 + 4 * node];
+    send_back[1 + 2 * node] =
+        (REF_INT)((REF_DBL)ref_mpi_n(ref_mpi) *
+                  (running + 0.5 * recv[1 + 4 * node]) / total_weight);
+    send_back[1 + 2 * node] =
+        MIN(MAX(send_back[1 + 2 * node], 0), ref_mpi_n(ref_mpi) - 1);
+    running += recv[1 + 4 * node];
+  }
+  ref_free(weight);
+  ref_free(order);
+  ref_free(key);
+  ref_free(recv);
+
+  RSS(ref_mpi_blindsend(ref_mpi, proc, (void *)send_back, 2, nrecv,
+                        (void **)&recv_back, &nback, REF_INT_TYPE),
+      "blind send parts");
+  ref_free(send_back);
+  ref_free(proc);
+  REIS(n, nback, "lost nodes");
+
+  ref_malloc_init(migrate_part, ref_migrate_max(ref_migrate), REF_INT,
+                  REF_EMPTY);
+  for (i = 0; i < nback; i++)
+    migrate_part[local[recv_back[0 + 2 * i]]] = recv_back[1 + 2 * i];
+  ref_free(recv_back);
+  ref_free(local);
+
+  RSS(ref_migrate_node_part(ref_migrate, migrate_part), "node part");
+
+  ref_free(migrate_part);
+  RSS(ref_migrate_free(ref_migrate), "free migrate");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
 #if defined(HAVE_ZOLTAN) && defined(HAVE_MPI)
   {
@@ -410,13 +619,13 @@ REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
 
     float ver;
 
-    REF_INT node, item, local, global, part;
+    REF_INT node, item, local, parent, part;
 
     REF_INT *migrate_part;
     REF_INT *node_part;
 
     REF_INT *a_next;
-    REF_INT *a_parts, *b_parts;
+    REF_GLOB *a_parts, *b_parts;
     REF_INT *a_size, *b_size;
     REF_INT a_total, b_total;
 
@@ -492,14 +701,13 @@ REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
     ref_malloc_init(b_size, ref_mpi_n(ref_mpi), REF_INT, 0);
 
     each_ref_migrate_node(ref_migrate, node) {
-      each_ref_adj_node_item_with_ref(ref_migrate_parent_global(ref_migrate),
-                                      node, item, global) {
+      each_ref_adj_node_item_with_ref(ref_migrate_parent_local(ref_migrate),
+                                      node, item, parent) {
         part = ref_adj_item_ref(ref_migrate_parent_part(ref_migrate), item);
         if (ref_mpi_rank(ref_mpi) != part) {
           a_size[part]++;
         } else {
-          RSS(ref_node_local(ref_node, global, &local), "g2l");
-          node_part[local] = migrate_part[node];
+          node_part[parent] = migrate_part[node];
         }
       }
     }
@@ -509,11 +717,11 @@ REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
 
     a_total = 0;
     each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-    ref_malloc(a_parts, 2 * a_total, REF_INT);
+    ref_malloc(a_parts, 2 * a_total, REF_GLOB);
 
     b_total = 0;
     each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-    ref_malloc(b_parts, 2 * b_total, REF_INT);
+    ref_malloc(b_parts, 2 * b_total, REF_GLOB);
 
     ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
     a_next[0] = 0;
@@ -522,11 +730,11 @@ REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
     }
 
     each_ref_migrate_node(ref_migrate, node) {
-      each_ref_adj_node_item_with_ref(ref_migrate_parent_global(ref_migrate),
-                                      node, item, global) {
+      each_ref_adj_node_item_with_ref(ref_migrate_parent_local(ref_migrate),
+                                      node, item, parent) {
         part = ref_adj_item_ref(ref_migrate_parent_part(ref_migrate), item);
         if (ref_mpi_rank(ref_mpi) != part) {
-          a_parts[0 + 2 * a_next[part]] = global;
+          a_parts[0 + 2 * a_next[part]] = ref_node_global(ref_node, parent);
           a_parts[1 + 2 * a_next[part]] = migrate_part[node];
           a_next[part]++;
         }
@@ -534,13 +742,12 @@ REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
     }
 
     RSS(ref_mpi_alltoallv(ref_mpi, a_parts, a_size, b_parts, b_size, 2,
-                          REF_INT_TYPE),
+                          REF_GLOB_TYPE),
         "alltoallv parts");
 
     for (node = 0; node < b_total; node++) {
-      global = b_parts[0 + 2 * node];
-      part = b_parts[1 + 2 * node];
-      RSS(ref_node_local(ref_node, global, &local), "g2l");
+      part = (REF_INT)b_parts[1 + 2 * node];
+      RSS(ref_node_local(ref_node, b_parts[0 + 2 * node], &local), "g2l");
       node_part[local] = part;
     }
 
@@ -727,7 +934,7 @@ REF_STATUS ref_migrate_new_part(REF_GRID ref_grid) {
     RSS(ref_migrate_free(ref_migrate), "free migrate");
   }
 #else
-  SUPRESS_UNUSED_COMPILER_WARNING(ref_grid);
+  RSS(ref_migrate_hilbert_part(ref_grid), "hilbert part");
 #endif
 #endif
 
@@ -738,7 +945,7 @@ static REF_STATUS ref_migrate_shufflin_node(REF_NODE ref_node) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT *a_size, *b_size;
   REF_INT a_total, b_total;
-  REF_INT *a_global, *b_global;
+  REF_GLOB *a_global, *b_global;
   REF_INT part, node;
   REF_INT *a_next;
   REF_DBL *a_real, *b_real;
@@ -753,8 +960,9 @@ static REF_STATUS ref_migrate_shufflin_node(REF_NODE ref_node) {
     if (ref_mpi_rank(ref_mpi) != ref_node_part(ref_node, node)) {
       if (ref_node_part(ref_node, node) < 0 ||
           ref_node_part(ref_node, node) >= ref_mpi_n(ref_mpi)) {
-        printf("id %d node %d global %d part %d", ref_mpi_rank(ref_mpi), node,
-               ref_node_global(ref_node, node), ref_node_part(ref_node, node));
+        printf("id %d node %d global " REF_GLOB_FMT " part %d",
+               ref_mpi_rank(ref_mpi), node, ref_node_global(ref_node, node),
+               ref_node_part(ref_node, node));
         THROW("part out of range");
       }
       a_size[ref_node_part(ref_node, node)]++;
@@ -766,7 +974,7 @@ static REF_STATUS ref_migrate_shufflin_node(REF_NODE ref_node) {
 
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-  ref_malloc(a_global, a_total, REF_INT);
+  ref_malloc(a_global, a_total, REF_GLOB);
   ref_malloc(a_real, REF_NODE_REAL_PER * a_total, REF_DBL);
   a_aux = NULL;
   if (ref_node_naux(ref_node) > 0)
@@ -774,7 +982,7 @@ static REF_STATUS ref_migrate_shufflin_node(REF_NODE ref_node) {
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-  ref_malloc(b_global, b_total, REF_INT);
+  ref_malloc(b_global, b_total, REF_GLOB);
   ref_malloc(b_real, REF_NODE_REAL_PER * b_total, REF_DBL);
   b_aux = NULL;
   if (ref_node_naux(ref_node) > 0)
@@ -800,7 +1008,7 @@ static REF_STATUS ref_migrate_shufflin_node(REF_NODE ref_node) {
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_global, a_size, b_global, b_size, 1,
-                        REF_INT_TYPE),
+                        REF_GLOB_TYPE),
       "alltoallv global");
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_real, a_size, b_real, b_size,
@@ -847,7 +1055,7 @@ REF_STATUS ref_migrate_shufflin_cell(REF_NODE ref_node, REF_CELL ref_cell) {
   REF_INT a_total, b_total;
   REF_INT part, node, cell, i;
   REF_INT *a_next;
-  REF_INT *a_c2n, *b_c2n;
+  REF_GLOB *a_c2n, *b_c2n;
   REF_INT *a_parts, *b_parts;
   REF_BOOL need_to_keep;
 
@@ -874,12 +1082,12 @@ REF_STATUS ref_migrate_shufflin_cell(REF_NODE ref_node, REF_CELL ref_cell) {
 
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-  ref_malloc(a_c2n, ref_cell_size_per(ref_cell) * a_total, REF_INT);
+  ref_malloc(a_c2n, ref_cell_size_per(ref_cell) * a_total, REF_GLOB);
   ref_malloc(a_parts, ref_cell_size_per(ref_cell) * a_total, REF_INT);
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-  ref_malloc(b_c2n, ref_cell_size_per(ref_cell) * b_total, REF_INT);
+  ref_malloc(b_c2n, ref_cell_size_per(ref_cell) * b_total, REF_GLOB);
   ref_malloc(b_parts, ref_cell_size_per(ref_cell) * b_total, REF_INT);
 
   ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
@@ -916,7 +1124,7 @@ REF_STATUS ref_migrate_shufflin_cell(REF_NODE ref_node, REF_CELL ref_cell) {
   }
 
   RSS(ref_mpi_alltoallv(ref_mpi, a_c2n, a_size, b_c2n, b_size,
-                        ref_cell_size_per(ref_cell), REF_INT_TYPE),
+                        ref_cell_size_per(ref_cell), REF_GLOB_TYPE),
       "alltoallv c2n");
   RSS(ref_mpi_alltoallv(ref_mpi, a_parts, a_size, b_parts, b_size,
                         ref_cell_size_per(ref_cell), REF_INT_TYPE),
@@ -956,8 +1164,9 @@ REF_STATUS ref_migrate_shufflin_geom(REF_GRID ref_grid) {
   REF_INT part, node;
   REF_INT *a_next;
   REF_INT *a_int, *b_int;
+  REF_GLOB *a_node, *b_node;
   REF_DBL *a_real, *b_real;
-  REF_INT i, global, degree, item, geom;
+  REF_INT i, degree, item, geom;
 
   if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
 
@@ -977,11 +1186,13 @@ REF_STATUS ref_migrate_shufflin_geom(REF_GRID ref_grid) {
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
   ref_malloc(a_int, REF_GEOM_DESCR_SIZE * a_total, REF_INT);
+  ref_malloc(a_node, a_total, REF_GLOB);
   ref_malloc(a_real, 2 * a_total, REF_DBL);
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
   ref_malloc(b_int, REF_GEOM_DESCR_SIZE * b_total, REF_INT);
+  ref_malloc(b_node, b_total, REF_GLOB);
   ref_malloc(b_real, 2 * b_total, REF_DBL);
 
   ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
@@ -998,7 +1209,7 @@ REF_STATUS ref_migrate_shufflin_geom(REF_GRID ref_grid) {
           a_int[i + REF_GEOM_DESCR_SIZE * a_next[part]] =
               ref_geom_descr(ref_geom, i, geom);
         }
-        a_int[REF_GEOM_DESCR_NODE + REF_GEOM_DESCR_SIZE * a_next[part]] =
+        a_node[a_next[part]] =
             ref_node_global(ref_node, ref_geom_node(ref_geom, geom));
         a_real[0 + 2 * a_next[part]] = ref_geom_param(ref_geom, 0, geom);
         a_real[1 + 2 * a_next[part]] = ref_geom_param(ref_geom, 1, geom);
@@ -1010,13 +1221,15 @@ REF_STATUS ref_migrate_shufflin_geom(REF_GRID ref_grid) {
   RSS(ref_mpi_alltoallv(ref_mpi, a_int, a_size, b_int, b_size,
                         REF_GEOM_DESCR_SIZE, REF_INT_TYPE),
       "alltoallv geom int");
+  RSS(ref_mpi_alltoallv(ref_mpi, a_node, a_size, b_node, b_size, 1,
+                        REF_GLOB_TYPE),
+      "alltoallv geom node");
   RSS(ref_mpi_alltoallv(ref_mpi, a_real, a_size, b_real, b_size, 2,
                         REF_DBL_TYPE),
       "alltoallv geom real");
 
   for (geom = 0; geom < b_total; geom++) {
-    global = b_int[REF_GEOM_DESCR_NODE + REF_GEOM_DESCR_SIZE * geom];
-    RSS(ref_node_local(ref_node, global, &node), "g2l");
+    RSS(ref_node_local(ref_node, b_node[geom], &node), "g2l");
     b_int[REF_GEOM_DESCR_NODE + REF_GEOM_DESCR_SIZE * geom] = node;
     RSS(ref_geom_add_with_descr(ref_geom, &(b_int[REF_GEOM_DESCR_SIZE * geom]),
                                 &(b_real[2 * geom])),
@@ -1025,8 +1238,10 @@ REF_STATUS ref_migrate_shufflin_geom(REF_GRID ref_grid) {
 
   free(a_next);
   free(b_real);
+  free(b_node);
   free(b_int);
   free(a_real);
+  free(a_node);
   free(a_int);
   free(b_size);
   free(a_size);
@@ -1067,7 +1282,7 @@ REF_STATUS ref_migrate_shufflin(REF_GRID ref_grid) {
       }
     }
   }
-  RSS(ref_node_rebuild_sorted_global(ref_node), "rebuild");
+  RSS(ref_node_rebuild_index(ref_node), "rebuild");
 
   RSS(ref_node_ghost_real(ref_node), "ghost real");
   RSS(ref_geom_ghost(ref_grid_geom(ref_grid), ref_node), "ghost geom");
@@ -33,11 +33,11 @@ BEGIN_C_DECLORATION
 
 struct REF_MIGRATE_STRUCT {
   REF_GRID grid;
-  REF_ADJ parent_global;
+  REF_ADJ parent_local;
   REF_ADJ parent_part;
   REF_ADJ conn;
   REF_INT max;
-  REF_INT *global;
+  REF_GLOB *global;
   REF_DBL *xyz;
   REF_DBL *weight;
   REF_INT method;
@@ -48,7 +48,7 @@ struct REF_MIGRATE_STRUCT {
 #define ref_migrate_method(ref_migrate) ((ref_migrate)->method)
 
 #define ref_migrate_grid(ref_migrate) ((ref_migrate)->grid)
-#define ref_migrate_parent_global(ref_migrate) ((ref_migrate)->parent_global)
+#define ref_migrate_parent_local(ref_migrate) ((ref_migrate)->parent_local)
 #define ref_migrate_parent_part(ref_migrate) ((ref_migrate)->parent_part)
 #define ref_migrate_conn(ref_migrate) ((ref_migrate)->conn)
 
@@ -80,6 +80,8 @@ REF_STATUS ref_migrate_to_single_image(REF_GRID ref_grid);
 REF_STATUS ref_migrate_single_part(REF_GRID ref_grid);
 
 REF_STATUS ref_migrate_new_part(REF_GRID ref_grid);
+/* native space filling curve partition, used without Zoltan or ParMETIS */
+REF_STATUS ref_migrate_hilbert_part(REF_GRID ref_grid);
 
 REF_STATUS ref_migrate_shufflin(REF_GRID ref_grid);
 REF_STATUS ref_migrate_shufflin_cell(REF_NODE ref_node, REF_CELL ref_cell);
@@ -52,7 +52,7 @@ int main(int argc, char *argv[]) {
     REF_GRID ref_grid;
     REF_MIGRATE ref_migrate;
     REF_INT keep, lose;
-    REF_INT update_global, update_part;
+    REF_INT update_local, update_part;
     REF_ADJ ref_adj;
 
     RSS(ref_fixture_pri_grid(&ref_grid, ref_mpi), "set up grid");
@@ -69,9 +69,9 @@ int main(int argc, char *argv[]) {
     REIS(0, ref_migrate_global(ref_migrate, 0), "mark");
     REIS(REF_EMPTY, ref_migrate_global(ref_migrate, 3), "mark");
 
-    ref_adj = ref_migrate_parent_global(ref_migrate);
-    update_global = ref_adj_item_ref(ref_adj, ref_adj_first(ref_adj, keep));
-    REIS(3, update_global, "glob");
+    ref_adj = ref_migrate_parent_local(ref_migrate);
+    update_local = ref_adj_item_ref(ref_adj, ref_adj_first(ref_adj, keep));
+    REIS(lose, update_local, "parent");
 
     ref_adj = ref_migrate_parent_part(ref_migrate);
     update_part = ref_adj_item_ref(ref_adj, ref_adj_first(ref_adj, keep));
@@ -101,7 +101,7 @@ int main(int argc, char *argv[]) {
     REIS(REF_EMPTY, ref_migrate_global(ref_migrate, 0), "mark");
     REIS(REF_EMPTY, ref_migrate_global(ref_migrate, 3), "mark");
 
-    ref_adj = ref_migrate_parent_global(ref_migrate);
+    ref_adj = ref_migrate_parent_local(ref_migrate);
     RAS(ref_adj_empty(ref_adj, keep), "glob");
 
     ref_adj = ref_migrate_parent_part(ref_migrate);
@@ -160,7 +160,8 @@ int main(int argc, char *argv[]) {
     }
 
     {
-      REF_INT *global, group;
+      REF_GLOB *global;
+      REF_INT group;
       REF_CELL ref_cell;
       each_ref_grid_ref_cell(import_grid, group, ref_cell) {
         RSS(ref_cell_global(ref_cell, ref_grid_node(import_grid), &global),
@@ -176,6 +177,43 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
   }
 
+  if (1 == argc) { /* hilbert part balances tet b8.ugrid */
+    REF_GRID import_grid;
+    REF_NODE ref_node;
+    REF_INT node, owned, total;
+    char grid_file[] = "ref_migrate_test_hilbert.b8.ugrid";
+
+    if (ref_mpi_once(ref_mpi)) {
+      REF_GRID export_grid;
+      RSS(ref_fixture_tet_brick_grid(&export_grid, ref_mpi), "set up tet");
+      RSS(ref_export_b8_ugrid(export_grid, grid_file), "export");
+      RSS(ref_grid_free(export_grid), "free");
+    }
+
+    RSS(ref_part_by_extension(&import_grid, ref_mpi, grid_file), "import");
+    ref_node = ref_grid_node(import_grid);
+    RSS(ref_migrate_hilbert_part(import_grid), "hilbert");
+    each_ref_node_valid_node(ref_node, node) {
+      RAS(0 <= ref_node_part(ref_node, node) &&
+              ref_node_part(ref_node, node) < ref_mpi_n(ref_mpi),
+          "part out of range");
+    }
+    RSS(ref_migrate_shufflin(import_grid), "shufflin");
+
+    owned = 0;
+    each_ref_node_valid_node(ref_node, node) {
+      if (ref_mpi_rank(ref_mpi) == ref_node_part(ref_node, node)) owned++;
+    }
+    total = owned;
+    RSS(ref_mpi_allsum(ref_mpi, &total, 1, REF_INT_TYPE), "sum");
+    REIS(ref_node_n_global(ref_node), total, "lost nodes");
+    RAS(ABS(owned * ref_mpi_n(ref_mpi) - total) <= ref_mpi_n(ref_mpi),
+        "unbalanced");
+
+    RSS(ref_grid_free(import_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
+  }
+
   if (1 < argc) { /* part and migrate argument, world comm */
     REF_GRID import_grid;
 
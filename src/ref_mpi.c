@@ -18,12 +18,17 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
 
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
 #ifdef HAVE_MPI
 #include "mpi.h"
 #endif
@@ -42,6 +47,9 @@
     case REF_DBL_TYPE:                                    \
       (macro_mpi_type) = MPI_DOUBLE;                      \
       break;                                              \
+    case REF_LONG_TYPE:                                   \
+      (macro_mpi_type) = MPI_LONG;                        \
+      break;                                              \
     case REF_BYTE_TYPE:                                   \
       (macro_mpi_type) = MPI_UNSIGNED_CHAR;               \
       break;                                              \
@@ -60,6 +68,35 @@
 
 #endif
 
+/* wall clock, clock() is cpu time */
+static REF_DBL ref_mpi_wall_time(void) {
+#ifdef HAVE_MPI
+  return (REF_DBL)MPI_Wtime();
+#else
+#ifdef HAVE_SYS_TIME_H
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (REF_DBL)now.tv_sec + 1.0e-6 * (REF_DBL)now.tv_usec;
+#else
+  return (REF_DBL)clock() / ((REF_DBL)CLOCKS_PER_SEC);
+#endif
+#endif
+}
+
+static REF_STATUS ref_mpi_timer_initialize(REF_MPI ref_mpi) {
+  ref_mpi->timing = REF_FALSE;
+  ref_mpi->ntimer = 0;
+  ref_mpi->max_timer = 10;
+  ref_mpi->timer_open = REF_EMPTY;
+  ref_malloc(ref_mpi->timer_parent, ref_mpi->max_timer, REF_INT);
+  ref_malloc(ref_mpi->timer_count, ref_mpi->max_timer, REF_INT);
+  ref_malloc(ref_mpi->timer_total, ref_mpi->max_timer, REF_DBL);
+  ref_malloc(ref_mpi->timer_start, ref_mpi->max_timer, REF_DBL);
+  ref_malloc(ref_mpi->timer_name,
+             REF_MPI_TIMER_NAME_LENGTH * ref_mpi->max_timer, char);
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_mpi_create_from_comm(REF_MPI *ref_mpi_ptr, void *comm_ptr) {
   REF_MPI ref_mpi;
 
@@ -71,10 +108,8 @@ REF_STATUS ref_mpi_create_from_comm(REF_MPI *ref_mpi_ptr, void *comm_ptr) {
 
   ref_mpi->comm = NULL;
 
-  ref_mpi->first_time = (REF_DBL)clock() / ((REF_DBL)CLOCKS_PER_SEC);
-  ref_mpi->start_time = ref_mpi->first_time;
-
   ref_mpi->debug = REF_FALSE;
+  RSS(ref_mpi_timer_initialize(ref_mpi), "timer init");
 
 #ifdef HAVE_MPI
   {
@@ -87,12 +122,13 @@ REF_STATUS ref_mpi_create_from_comm(REF_MPI *ref_mpi_ptr, void *comm_ptr) {
       MPI_Comm_rank(ref_mpi_comm(ref_mpi), &(ref_mpi->id));
     }
   }
-  ref_mpi->first_time = (REF_DBL)MPI_Wtime();
-  ref_mpi->start_time = ref_mpi->first_time;
 #else
   SUPRESS_UNUSED_COMPILER_WARNING(comm_ptr);
 #endif
 
+  ref_mpi->first_time = ref_mpi_wall_time();
+  ref_mpi->start_time = ref_mpi->first_time;
+
   return REF_SUCCESS;
 }
 
@@ -135,6 +171,11 @@ REF_STATUS ref_mpi_join_comm(REF_MPI split_mpi) {
 
 REF_STATUS ref_mpi_free(REF_MPI ref_mpi) {
   if (NULL == (void *)ref_mpi) return REF_NULL;
+  ref_free(ref_mpi->timer_name);
+  ref_free(ref_mpi->timer_start);
+  ref_free(ref_mpi->timer_total);
+  ref_free(ref_mpi->timer_count);
+  ref_free(ref_mpi->timer_parent);
   ref_free(ref_mpi->comm);
   ref_free(ref_mpi);
   return REF_SUCCESS;
@@ -153,6 +194,7 @@ REF_STATUS ref_mpi_deep_copy(REF_MPI *ref_mpi_ptr, REF_MPI original) {
   ref_mpi->start_time = original->start_time;
 
   ref_mpi->debug = original->debug;
+  RSS(ref_mpi_timer_initialize(ref_mpi), "timer init");
 
   return REF_SUCCESS;
 }
@@ -179,10 +221,8 @@ REF_STATUS ref_mpi_stop() {
 REF_STATUS ref_mpi_stopwatch_start(REF_MPI ref_mpi) {
 #ifdef HAVE_MPI
   if (ref_mpi_para(ref_mpi)) MPI_Barrier(ref_mpi_comm(ref_mpi));
-  ref_mpi->start_time = (REF_DBL)MPI_Wtime();
-#else
-  ref_mpi->start_time = (REF_DBL)clock() / ((REF_DBL)CLOCKS_PER_SEC);
 #endif
+  ref_mpi->start_time = ref_mpi_wall_time();
 
   return REF_SUCCESS;
 }
@@ -205,11 +245,11 @@ REF_STATUS ref_mpi_stopwatch_stop(REF_MPI ref_mpi, const char *message) {
   }
   RSS(ref_mpi_stopwatch_start(ref_mpi), "restart");
 #else
+  REF_DBL now;
+  now = ref_mpi_wall_time();
   printf("%9.4f: %16.12f (%16.12f) %6.2f%% load balance %s\n",
-         (REF_DBL)clock() / ((REF_DBL)CLOCKS_PER_SEC) - ref_mpi->first_time,
-         (REF_DBL)clock() / ((REF_DBL)CLOCKS_PER_SEC) - ref_mpi->start_time,
-         (REF_DBL)clock() / ((REF_DBL)CLOCKS_PER_SEC) - ref_mpi->start_time,
-         110.0, message);
+         now - ref_mpi->first_time, now - ref_mpi->start_time,
+         now - ref_mpi->start_time, 110.0, message);
   fflush(stdout);
   RSS(ref_mpi_stopwatch_start(ref_mpi), "restart");
 #endif
@@ -217,6 +257,187 @@ REF_STATUS ref_mpi_stopwatch_stop(REF_MPI ref_mpi, const char *message) {
   return REF_SUCCESS;
 }
 
+#define ref_mpi_timer_named(ref_mpi, timer) \
+  (&((ref_mpi)->timer_name[REF_MPI_TIMER_NAME_LENGTH * (timer)]))
+
+REF_STATUS ref_mpi_timer_start(REF_MPI ref_mpi, const char *name) {
+  REF_INT timer;
+
+  if (!ref_mpi_timing(ref_mpi)) return REF_SUCCESS;
+
+  for (timer = 0; timer < ref_mpi->ntimer; timer++) {
+    if (ref_mpi->timer_open == ref_mpi->timer_parent[timer] &&
+        0 == strncmp(ref_mpi_timer_named(ref_mpi, timer), name,
+                     REF_MPI_TIMER_NAME_LENGTH - 1))
+      break;
+  }
+
+  if (timer == ref_mpi->ntimer) {
+    if (ref_mpi->max_timer == ref_mpi->ntimer) {
+      ref_mpi->max_timer *= 2;
+      ref_realloc(ref_mpi->timer_parent, ref_mpi->max_timer, REF_INT);
+      ref_realloc(ref_mpi->timer_count, ref_mpi->max_timer, REF_INT);
+      ref_realloc(ref_mpi->timer_total, ref_mpi->max_timer, REF_DBL);
+      ref_realloc(ref_mpi->timer_start, ref_mpi->max_timer, REF_DBL);
+      ref_realloc(ref_mpi->timer_name,
+                  REF_MPI_TIMER_NAME_LENGTH * ref_mpi->max_timer, char);
+    }
+    ref_mpi->ntimer++;
+    ref_mpi->timer_parent[timer] = ref_mpi->timer_open;
+    ref_mpi->timer_count[timer] = 0;
+    ref_mpi->timer_total[timer] = 0.0;
+    snprintf(ref_mpi_timer_named(ref_mpi, timer), REF_MPI_TIMER_NAME_LENGTH,
+             "%s", name);
+  }
+
+  ref_mpi->timer_open = timer;
+  ref_mpi->timer_start[timer] = ref_mpi_wall_time();
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_mpi_timer_stop(REF_MPI ref_mpi, const char *name) {
+  REF_INT timer;
+
+  if (!ref_mpi_timing(ref_mpi)) return REF_SUCCESS;
+
+  timer = ref_mpi->timer_open;
+  RUS(REF_EMPTY, timer, "no timer open");
+  RAB(0 == strncmp(ref_mpi_timer_named(ref_mpi, timer), name,
+                   REF_MPI_TIMER_NAME_LENGTH - 1),
+      "timer stop does not match open timer",
+      { printf("stop %s with %s open\n", name,
+               ref_mpi_timer_named(ref_mpi, timer)); });
+
+  ref_mpi->timer_total[timer] +=
+      ref_mpi_wall_time() - ref_mpi->timer_start[timer];
+  ref_mpi->timer_count[timer]++;
+  ref_mpi->timer_open = ref_mpi->timer_parent[timer];
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_mpi_timer_total(REF_MPI ref_mpi, const char *name,
+                               REF_DBL *total) {
+  REF_INT timer;
+
+  *total = 0.0;
+  for (timer = 0; timer < ref_mpi->ntimer; timer++) {
+    if (ref_mpi->timer_open == ref_mpi->timer_parent[timer] &&
+        0 == strncmp(ref_mpi_timer_named(ref_mpi, timer), name,
+                     REF_MPI_TIMER_NAME_LENGTH - 1)) {
+      *total = ref_mpi->timer_total[timer];
+      break;
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+static void ref_mpi_timer_path(FILE *file, REF_INT *parent, char *names,
+                               REF_INT timer) {
+  if (REF_EMPTY != parent[timer]) {
+    ref_mpi_timer_path(file, parent, names, parent[timer]);
+    fprintf(file, "/");
+  }
+  fprintf(file, "%s", &(names[REF_MPI_TIMER_NAME_LENGTH * timer]));
+}
+
+REF_STATUS ref_mpi_timer_report(REF_MPI ref_mpi, const char *filename) {
+  FILE *file = NULL;
+  REF_INT ntimer, timer, local, local_parent, depth;
+  REF_INT *parent, *local_timer, *count;
+  REF_DBL *total, *sum, min_total, max_total;
+  REF_INT max_count;
+  char *names;
+
+  if (ref_mpi_once(ref_mpi)) {
+    file = fopen(filename, "w");
+    if (NULL == (void *)file) printf("unable to open %s\n", filename);
+    RNS(file, "unable to open file");
+    fprintf(file, "region,depth,count,min,avg,max,imbalance\n");
+  }
+
+  /* rank 0 regions define the report, matched by path on other ranks */
+  ntimer = ref_mpi->ntimer;
+  RSS(ref_mpi_bcast(ref_mpi, &ntimer, 1, REF_INT_TYPE), "n");
+  if (0 == ntimer) {
+    if (ref_mpi_once(ref_mpi)) fclose(file);
+    return REF_SUCCESS;
+  }
+  ref_malloc(parent, ntimer, REF_INT);
+  ref_malloc(names, REF_MPI_TIMER_NAME_LENGTH * ntimer, char);
+  if (ref_mpi_once(ref_mpi)) {
+    for (timer = 0; timer < ntimer; timer++) {
+      parent[timer] = ref_mpi->timer_parent[timer];
+    }
+    memcpy(names, ref_mpi->timer_name,
+           (size_t)(REF_MPI_TIMER_NAME_LENGTH * ntimer));
+  }
+  RSS(ref_mpi_bcast(ref_mpi, parent, ntimer, REF_INT_TYPE), "parent");
+  RSS(ref_mpi_bcast(ref_mpi, names, REF_MPI_TIMER_NAME_LENGTH * ntimer,
+                    REF_BYTE_TYPE),
+      "names");
+
+  /* parents are created before their children */
+  ref_malloc_init(local_timer, ntimer, REF_INT, REF_EMPTY);
+  ref_malloc_init(count, ntimer, REF_INT, 0);
+  ref_malloc_init(total, ntimer, REF_DBL, 0.0);
+  ref_malloc(sum, ntimer, REF_DBL);
+  for (timer = 0; timer < ntimer; timer++) {
+    local_parent = REF_EMPTY;
+    if (REF_EMPTY != parent[timer]) {
+      local_parent = local_timer[parent[timer]];
+      if (REF_EMPTY == local_parent) continue;
+    }
+    for (local = 0; local < ref_mpi->ntimer; local++) {
+      if (local_parent == ref_mpi->timer_parent[local] &&
+          0 == strncmp(ref_mpi_timer_named(ref_mpi, local),
+                       &(names[REF_MPI_TIMER_NAME_LENGTH * timer]),
+                       REF_MPI_TIMER_NAME_LENGTH - 1)) {
+        local_timer[timer] = local;
+        count[timer] = ref_mpi->timer_count[local];
+        total[timer] = ref_mpi->timer_total[local];
+        break;
+      }
+    }
+  }
+
+  RSS(ref_mpi_sum(ref_mpi, total, sum, ntimer, REF_DBL_TYPE), "sum");
+  for (timer = 0; timer < ntimer; timer++) {
+    RSS(ref_mpi_min(ref_mpi, &(total[timer]), &min_total, REF_DBL_TYPE),
+        "min");
+    RSS(ref_mpi_max(ref_mpi, &(total[timer]), &max_total, REF_DBL_TYPE),
+        "max");
+    RSS(ref_mpi_max(ref_mpi, &(count[timer]), &max_count, REF_INT_TYPE),
+        "count");
+    if (ref_mpi_once(ref_mpi)) {
+      depth = 0;
+      local = timer;
+      while (REF_EMPTY != parent[local]) {
+        depth++;
+        local = parent[local];
+      }
+      sum[timer] /= (REF_DBL)ref_mpi_n(ref_mpi);
+      ref_mpi_timer_path(file, parent, names, timer);
+      fprintf(file, ",%d,%d,%.6e,%.6e,%.6e,%.4f\n", depth, max_count,
+              min_total, sum[timer], max_total,
+              (sum[timer] > 0.0 ? max_total / sum[timer] : 1.0));
+    }
+  }
+
+  ref_free(sum);
+  ref_free(total);
+  ref_free(count);
+  ref_free(local_timer);
+  ref_free(names);
+  ref_free(parent);
+
+  if (ref_mpi_once(ref_mpi)) fclose(file);
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_mpi_bcast(REF_MPI ref_mpi, void *data, REF_INT n,
                          REF_TYPE type) {
 #ifdef HAVE_MPI
@@ -299,6 +520,9 @@ REF_STATUS ref_mpi_alltoall(REF_MPI ref_mpi, void *send, void *recv,
     case REF_INT_TYPE:
       ((REF_INT *)recv)[0] = ((REF_INT *)send)[0];
       break;
+    case REF_LONG_TYPE:
+      ((REF_LONG *)recv)[0] = ((REF_LONG *)send)[0];
+      break;
     case REF_DBL_TYPE:
       ((REF_DBL *)recv)[0] = ((REF_DBL *)send)[0];
       break;
@@ -366,6 +590,75 @@ REF_STATUS ref_mpi_alltoallv(REF_MPI ref_mpi, void *send, REF_INT *send_size,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_mpi_neighbor_alltoallv(REF_MPI ref_mpi, void *send,
+                                      REF_INT *send_size, void *recv,
+                                      REF_INT *recv_size, REF_INT n,
+                                      REF_TYPE type) {
+#ifdef HAVE_MPI
+  MPI_Datatype datatype;
+  MPI_Request *request;
+  size_t bytes;
+  REF_INT part, nrequest, send_disp, recv_disp;
+  REF_INT tag = 7;
+
+  ref_type_mpi_type(type, datatype);
+  switch (type) {
+    case REF_INT_TYPE:
+      bytes = sizeof(REF_INT);
+      break;
+    case REF_LONG_TYPE:
+      bytes = sizeof(REF_LONG);
+      break;
+    case REF_DBL_TYPE:
+      bytes = sizeof(REF_DBL);
+      break;
+    default:
+      bytes = 1;
+  }
+
+  ref_malloc(request, 2 * ref_mpi_n(ref_mpi), MPI_Request);
+  nrequest = 0;
+
+  recv_disp = 0;
+  each_ref_mpi_part(ref_mpi, part) {
+    if (0 < recv_size[part]) {
+      MPI_Irecv((char *)recv + bytes * (size_t)(n * recv_disp),
+                n * recv_size[part], datatype, part, tag,
+                ref_mpi_comm(ref_mpi), &(request[nrequest]));
+      nrequest++;
+    }
+    recv_disp += recv_size[part];
+  }
+
+  send_disp = 0;
+  each_ref_mpi_part(ref_mpi, part) {
+    if (0 < send_size[part]) {
+      MPI_Isend((char *)send + bytes * (size_t)(n * send_disp),
+                n * send_size[part], datatype, part, tag,
+                ref_mpi_comm(ref_mpi), &(request[nrequest]));
+      nrequest++;
+    }
+    send_disp += send_size[part];
+  }
+
+  MPI_Waitall(nrequest, request, MPI_STATUSES_IGNORE);
+
+  ref_free(request);
+
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  SUPRESS_UNUSED_COMPILER_WARNING(send);
+  SUPRESS_UNUSED_COMPILER_WARNING(send_size);
+  SUPRESS_UNUSED_COMPILER_WARNING(recv);
+  SUPRESS_UNUSED_COMPILER_WARNING(recv_size);
+  SUPRESS_UNUSED_COMPILER_WARNING(n);
+  SUPRESS_UNUSED_COMPILER_WARNING(type);
+  return REF_IMPLEMENT;
+#endif
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_mpi_min(REF_MPI ref_mpi, void *input, void *output,
                        REF_TYPE type) {
 #ifdef HAVE_MPI
@@ -376,6 +669,9 @@ REF_STATUS ref_mpi_min(REF_MPI ref_mpi, void *input, void *output,
       case REF_INT_TYPE:
         *(REF_INT *)output = *(REF_INT *)input;
         break;
+      case REF_LONG_TYPE:
+        *(REF_LONG *)output = *(REF_LONG *)input;
+        break;
       case REF_DBL_TYPE:
         *(REF_DBL *)output = *(REF_DBL *)input;
         break;
@@ -394,6 +690,9 @@ REF_STATUS ref_mpi_min(REF_MPI ref_mpi, void *input, void *output,
     case REF_INT_TYPE:
       *(REF_INT *)output = *(REF_INT *)input;
       break;
+    case REF_LONG_TYPE:
+      *(REF_LONG *)output = *(REF_LONG *)input;
+      break;
     case REF_DBL_TYPE:
       *(REF_DBL *)output = *(REF_DBL *)input;
       break;
@@ -434,6 +733,9 @@ REF_STATUS ref_mpi_max(REF_MPI ref_mpi, void *input, void *output,
       case REF_INT_TYPE:
         *(REF_INT *)output = *(REF_INT *)input;
         break;
+      case REF_LONG_TYPE:
+        *(REF_LONG *)output = *(REF_LONG *)input;
+        break;
       case REF_DBL_TYPE:
         *(REF_DBL *)output = *(REF_DBL *)input;
         break;
@@ -452,6 +754,9 @@ REF_STATUS ref_mpi_max(REF_MPI ref_mpi, void *input, void *output,
     case REF_INT_TYPE:
       *(REF_INT *)output = *(REF_INT *)input;
       break;
+    case REF_LONG_TYPE:
+      *(REF_LONG *)output = *(REF_LONG *)input;
+      break;
     case REF_DBL_TYPE:
       *(REF_DBL *)output = *(REF_DBL *)input;
       break;
@@ -476,6 +781,10 @@ REF_STATUS ref_mpi_sum(REF_MPI ref_mpi, void *input, void *output, REF_INT n,
       case REF_INT_TYPE:
         for (i = 0; i < n; i++) ((REF_INT *)output)[i] = ((REF_INT *)input)[i];
         break;
+      case REF_LONG_TYPE:
+        for (i = 0; i < n; i++)
+          ((REF_LONG *)output)[i] = ((REF_LONG *)input)[i];
+        break;
       case REF_DBL_TYPE:
         for (i = 0; i < n; i++) ((REF_DBL *)output)[i] = ((REF_DBL *)input)[i];
         break;
@@ -493,6 +802,9 @@ REF_STATUS ref_mpi_sum(REF_MPI ref_mpi, void *input, void *output, REF_INT n,
     case REF_INT_TYPE:
       for (i = 0; i < n; i++) ((REF_INT *)output)[i] = ((REF_INT *)input)[i];
       break;
+    case REF_LONG_TYPE:
+      for (i = 0; i < n; i++) ((REF_LONG *)output)[i] = ((REF_LONG *)input)[i];
+      break;
     case REF_DBL_TYPE:
       for (i = 0; i < n; i++) ((REF_DBL *)output)[i] = ((REF_DBL *)input)[i];
       break;
@@ -515,6 +827,10 @@ REF_STATUS ref_mpi_allsum(REF_MPI ref_mpi, void *value, REF_INT n,
       ref_malloc(temp, n, REF_INT);
       for (i = 0; i < n; i++) ((REF_INT *)temp)[i] = ((REF_INT *)value)[i];
       break;
+    case REF_LONG_TYPE:
+      ref_malloc(temp, n, REF_LONG);
+      for (i = 0; i < n; i++) ((REF_LONG *)temp)[i] = ((REF_LONG *)value)[i];
+      break;
     case REF_DBL_TYPE:
       ref_malloc(temp, n, REF_DBL);
       for (i = 0; i < n; i++) ((REF_DBL *)temp)[i] = ((REF_DBL *)value)[i];
@@ -528,6 +844,49 @@ REF_STATUS ref_mpi_allsum(REF_MPI ref_mpi, void *value, REF_INT n,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_mpi_allmax(REF_MPI ref_mpi, void *value, REF_INT n,
+                          REF_TYPE type) {
+#ifdef HAVE_MPI
+  MPI_Datatype datatype;
+
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+
+  ref_type_mpi_type(type, datatype);
+  ref_mpi_where_am_i(ref_mpi);
+  MPI_Allreduce(MPI_IN_PLACE, value, n, datatype, MPI_MAX,
+                ref_mpi_comm(ref_mpi));
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  SUPRESS_UNUSED_COMPILER_WARNING(value);
+  SUPRESS_UNUSED_COMPILER_WARNING(n);
+  SUPRESS_UNUSED_COMPILER_WARNING(type);
+#endif
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_mpi_allmaxsum(REF_MPI ref_mpi, REF_DBL *value, REF_INT nmax,
+                             REF_INT nsum) {
+#ifdef HAVE_MPI
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+
+  ref_mpi_where_am_i(ref_mpi);
+  if (0 < nmax)
+    MPI_Allreduce(MPI_IN_PLACE, value, nmax, MPI_DOUBLE, MPI_MAX,
+                  ref_mpi_comm(ref_mpi));
+  if (0 < nsum)
+    MPI_Allreduce(MPI_IN_PLACE, &(value[nmax]), nsum, MPI_DOUBLE, MPI_SUM,
+                  ref_mpi_comm(ref_mpi));
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  SUPRESS_UNUSED_COMPILER_WARNING(value);
+  SUPRESS_UNUSED_COMPILER_WARNING(nmax);
+  SUPRESS_UNUSED_COMPILER_WARNING(nsum);
+#endif
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_mpi_allgather(REF_MPI ref_mpi, void *scalar, void *array,
                              REF_TYPE type) {
 #ifdef HAVE_MPI
@@ -538,6 +897,9 @@ REF_STATUS ref_mpi_allgather(REF_MPI ref_mpi, void *scalar, void *array,
       case REF_INT_TYPE:
         *(REF_INT *)array = *(REF_INT *)scalar;
         break;
+      case REF_LONG_TYPE:
+        *(REF_LONG *)array = *(REF_LONG *)scalar;
+        break;
       case REF_DBL_TYPE:
         *(REF_DBL *)array = *(REF_DBL *)scalar;
         break;
@@ -556,6 +918,9 @@ REF_STATUS ref_mpi_allgather(REF_MPI ref_mpi, void *scalar, void *array,
     case REF_INT_TYPE:
       *(REF_INT *)array = *(REF_INT *)scalar;
       break;
+    case REF_LONG_TYPE:
+      *(REF_LONG *)array = *(REF_LONG *)scalar;
+      break;
     case REF_DBL_TYPE:
       *(REF_DBL *)array = *(REF_DBL *)scalar;
       break;
@@ -585,6 +950,10 @@ REF_STATUS ref_mpi_allgatherv(REF_MPI ref_mpi, void *local_array,
         for (i = 0; i < counts[0]; i++)
           ((REF_INT *)concatenated_array)[i] = ((REF_INT *)local_array)[i];
         break;
+      case REF_LONG_TYPE:
+        for (i = 0; i < counts[0]; i++)
+          ((REF_LONG *)concatenated_array)[i] = ((REF_LONG *)local_array)[i];
+        break;
       case REF_DBL_TYPE:
         for (i = 0; i < counts[0]; i++)
           ((REF_DBL *)concatenated_array)[i] = ((REF_DBL *)local_array)[i];
@@ -614,6 +983,10 @@ REF_STATUS ref_mpi_allgatherv(REF_MPI ref_mpi, void *local_array,
       for (i = 0; i < counts[0]; i++)
         ((REF_INT *)concatenated_array)[i] = ((REF_INT *)local_array)[i];
       break;
+    case REF_LONG_TYPE:
+      for (i = 0; i < counts[0]; i++)
+        ((REF_LONG *)concatenated_array)[i] = ((REF_LONG *)local_array)[i];
+      break;
     case REF_DBL_TYPE:
       for (i = 0; i < counts[0]; i++)
         ((REF_DBL *)concatenated_array)[i] = ((REF_DBL *)local_array)[i];
@@ -655,6 +1028,9 @@ REF_STATUS ref_mpi_allconcat(REF_MPI ref_mpi, REF_INT ldim, REF_INT my_size,
     case REF_INT_TYPE:
       ref_malloc(*((REF_INT **)concatenated), ldim * (*total_size), REF_INT);
       break;
+    case REF_LONG_TYPE:
+      ref_malloc(*((REF_LONG **)concatenated), ldim * (*total_size), REF_LONG);
+      break;
     case REF_DBL_TYPE:
       ref_malloc(*((REF_DBL **)concatenated), ldim * (*total_size), REF_DBL);
       break;
@@ -735,6 +1111,12 @@ REF_STATUS ref_mpi_blindsend(REF_MPI ref_mpi, REF_INT *proc, void *send,
           (*((REF_INT **)recv))[i] = ((REF_INT *)send)[i];
         }
         break;
+      case REF_LONG_TYPE:
+        ref_malloc(*((REF_LONG **)recv), ldim * nsend, REF_LONG);
+        for (i = 0; i < ldim * nsend; i++) {
+          (*((REF_LONG **)recv))[i] = ((REF_LONG *)send)[i];
+        }
+        break;
       case REF_DBL_TYPE:
         ref_malloc(*((REF_DBL **)recv), ldim * nsend, REF_DBL);
         for (i = 0; i < ldim * nsend; i++) {
@@ -780,6 +1162,17 @@ REF_STATUS ref_mpi_blindsend(REF_MPI ref_mpi, REF_INT *proc, void *send,
         a_next[proc[i]]++;
       }
       break;
+    case REF_LONG_TYPE:
+      a_data = malloc(ldim * a_total * sizeof(REF_LONG));
+      RNS(a_data, "malloc failed");
+      ref_malloc(*((REF_LONG **)recv), ldim * b_total, REF_LONG);
+      for (i = 0; i < nsend; i++) {
+        for (l = 0; l < ldim; l++)
+          ((REF_LONG *)a_data)[l + ldim * a_next[proc[i]]] =
+              ((REF_LONG *)send)[l + ldim * i];
+        a_next[proc[i]]++;
+      }
+      break;
     case REF_DBL_TYPE:
       a_data = malloc(ldim * a_total * sizeof(REF_DBL));
       RNS(a_data, "malloc failed");
@@ -807,3 +1200,73 @@ REF_STATUS ref_mpi_blindsend(REF_MPI ref_mpi, REF_INT *proc, void *send,
 
   return REF_SUCCESS;
 }
+
+REF_STATUS ref_mpi_fopen_write(REF_MPI ref_mpi, const char *filename,
+                               void **file) {
+#ifdef HAVE_MPI
+  MPI_File *fh;
+  int mpi_status;
+  ref_malloc(fh, 1, MPI_File);
+  mpi_status = MPI_File_open(ref_mpi_comm(ref_mpi), (char *)filename,
+                             MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL,
+                             fh);
+  if (MPI_SUCCESS != mpi_status) {
+    if (ref_mpi_once(ref_mpi)) printf("unable to open %s\n", filename);
+    ref_free(fh);
+    RSS(REF_FAILURE, "MPI_File_open");
+  }
+  /* truncate a previous file of the same name */
+  REIS(MPI_SUCCESS, MPI_File_set_size(*fh, 0), "MPI_File_set_size");
+  *file = (void *)fh;
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  *file = (void *)fopen(filename, "w");
+  if (NULL == *file) printf("unable to open %s\n", filename);
+  RNS(*file, "unable to open file");
+#endif
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_mpi_fwrite_at_all(REF_MPI ref_mpi, void *file, long offset,
+                                 void *data, REF_INT record_size,
+                                 REF_INT nrecord) {
+#ifdef HAVE_MPI
+  MPI_Datatype record;
+  MPI_Status status;
+
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+
+  /* record datatype keeps the count an int for blocks beyond 2GB */
+  MPI_Type_contiguous(record_size, MPI_BYTE, &record);
+  MPI_Type_commit(&record);
+  REIS(MPI_SUCCESS,
+       MPI_File_write_at_all(*((MPI_File *)file), (MPI_Offset)offset, data,
+                             nrecord, record, &status),
+       "MPI_File_write_at_all");
+  MPI_Type_free(&record);
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  if (0 < nrecord) {
+    REIS(0, fseek((FILE *)file, offset, SEEK_SET), "seek");
+    REIS(nrecord,
+         fwrite(data, (size_t)record_size, (size_t)nrecord, (FILE *)file),
+         "write");
+  }
+#endif
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_mpi_fclose(REF_MPI ref_mpi, void *file) {
+#ifdef HAVE_MPI
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  REIS(MPI_SUCCESS, MPI_File_close((MPI_File *)file), "MPI_File_close");
+  ref_free(file);
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(ref_mpi);
+  REIS(0, fclose((FILE *)file), "fclose");
+#endif
+
+  return REF_SUCCESS;
+}
@@ -35,12 +35,22 @@ struct REF_MPI_STRUCT {
   REF_DBL start_time;
   REF_DBL first_time;
   REF_BOOL debug;
+  REF_BOOL timing;
+  REF_INT ntimer, max_timer, timer_open;
+  REF_INT *timer_parent;
+  REF_INT *timer_count;
+  REF_DBL *timer_total;
+  REF_DBL *timer_start;
+  char *timer_name;
 };
 
+#define REF_MPI_TIMER_NAME_LENGTH (32)
+
 #define ref_mpi_n(ref_mpi) ((ref_mpi)->n)
 #define ref_mpi_rank(ref_mpi) ((ref_mpi)->id)
 #define ref_mpi_para(ref_mpi) ((ref_mpi)->n > 1)
 #define ref_mpi_once(ref_mpi) (0 == (ref_mpi)->id)
+#define ref_mpi_timing(ref_mpi) ((ref_mpi)->timing)
 
 #define each_ref_mpi_part(ref_mpi, part) \
   for ((part) = 0; (part) < ref_mpi_n(ref_mpi); (part)++)
@@ -66,10 +76,25 @@ REF_STATUS ref_mpi_stop();
 REF_STATUS ref_mpi_stopwatch_start(REF_MPI ref_mpi);
 REF_STATUS ref_mpi_stopwatch_stop(REF_MPI ref_mpi, const char *message);
 
+/* nested named regions, no-op unless ref_mpi_timing is set, no barriers */
+REF_STATUS ref_mpi_timer_start(REF_MPI ref_mpi, const char *name);
+REF_STATUS ref_mpi_timer_stop(REF_MPI ref_mpi, const char *name);
+/* local seconds in a closed region under the open region, zero if unseen */
+REF_STATUS ref_mpi_timer_total(REF_MPI ref_mpi, const char *name,
+                               REF_DBL *total);
+/* collective, csv of count and min/avg/max over ranks of rank 0 regions */
+REF_STATUS ref_mpi_timer_report(REF_MPI ref_mpi, const char *filename);
+
 typedef int REF_TYPE;
 #define REF_INT_TYPE (1)
 #define REF_DBL_TYPE (2)
 #define REF_BYTE_TYPE (3)
+#define REF_LONG_TYPE (4)
+#if defined(REF_GLOB_64)
+#define REF_GLOB_TYPE (REF_LONG_TYPE)
+#else
+#define REF_GLOB_TYPE (REF_INT_TYPE)
+#endif
 
 REF_STATUS ref_mpi_bcast(REF_MPI ref_mpi, void *data, REF_INT n, REF_TYPE type);
 
@@ -83,6 +108,11 @@ REF_STATUS ref_mpi_alltoall(REF_MPI ref_mpi, void *send, void *recv,
 REF_STATUS ref_mpi_alltoallv(REF_MPI ref_mpi, void *send, REF_INT *send_size,
                              void *recv, REF_INT *recv_size, REF_INT n,
                              REF_TYPE type);
+/* point-to-point with only the parts of nonzero size, both sides know sizes */
+REF_STATUS ref_mpi_neighbor_alltoallv(REF_MPI ref_mpi, void *send,
+                                      REF_INT *send_size, void *recv,
+                                      REF_INT *recv_size, REF_INT n,
+                                      REF_TYPE type);
 
 REF_STATUS ref_mpi_all_or(REF_MPI ref_mpi, REF_BOOL *boolean);
 REF_STATUS ref_mpi_min(REF_MPI ref_mpi, void *input, void *output,
@@ -93,6 +123,12 @@ REF_STATUS ref_mpi_sum(REF_MPI ref_mpi, void *input, void *output, REF_INT n,
                        REF_TYPE type);
 REF_STATUS ref_mpi_allsum(REF_MPI ref_mpi, void *value, REF_INT n,
                           REF_TYPE type);
+/* elementwise max of value over all ranks, in place */
+REF_STATUS ref_mpi_allmax(REF_MPI ref_mpi, void *value, REF_INT n,
+                          REF_TYPE type);
+/* in place, max of the first nmax values and sum of the next nsum */
+REF_STATUS ref_mpi_allmaxsum(REF_MPI ref_mpi, REF_DBL *value, REF_INT nmax,
+                             REF_INT nsum);
 
 REF_STATUS ref_mpi_allgather(REF_MPI ref_mpi, void *scalar, void *array,
                              REF_TYPE type);
@@ -113,6 +149,14 @@ REF_STATUS ref_mpi_blindsend(REF_MPI ref_mpi, REF_INT *proc, void *send,
                              REF_INT ldim, REF_INT nsend, void **recv,
                              REF_INT *nrecv, REF_TYPE type);
 
+/* collective MPI-IO when available, stdio otherwise */
+REF_STATUS ref_mpi_fopen_write(REF_MPI ref_mpi, const char *filename,
+                               void **file);
+REF_STATUS ref_mpi_fwrite_at_all(REF_MPI ref_mpi, void *file, long offset,
+                                 void *data, REF_INT record_size,
+                                 REF_INT nrecord);
+REF_STATUS ref_mpi_fclose(REF_MPI ref_mpi, void *file);
+
 END_C_DECLORATION
 
 #endif /* REF_MPI_H */
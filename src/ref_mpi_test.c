@@ -48,6 +48,88 @@ int main(int argc, char *argv[]) {
     REIS(5, bc, "bc wrong");
   }
 
+  /* allmax */
+  {
+    REF_DBL value[2];
+    REF_INT count[2];
+
+    value[0] = (REF_DBL)ref_mpi_rank(ref_mpi);
+    value[1] = -(REF_DBL)ref_mpi_rank(ref_mpi);
+    RSS(ref_mpi_allmax(ref_mpi, value, 2, REF_DBL_TYPE), "dbl max");
+    RWDS((REF_DBL)(ref_mpi_n(ref_mpi) - 1), value[0], -1, "max rank");
+    RWDS(0.0, value[1], -1, "max negated rank");
+
+    count[0] = ref_mpi_rank(ref_mpi) + 10;
+    count[1] = 7;
+    RSS(ref_mpi_allmax(ref_mpi, count, 2, REF_INT_TYPE), "int max");
+    REIS(ref_mpi_n(ref_mpi) + 9, count[0], "max rank");
+    REIS(7, count[1], "same");
+  }
+
+  /* allmaxsum */
+  {
+    REF_DBL value[3];
+
+    value[0] = (REF_DBL)ref_mpi_rank(ref_mpi);
+    value[1] = 1.0;
+    value[2] = (REF_DBL)ref_mpi_rank(ref_mpi);
+    RSS(ref_mpi_allmaxsum(ref_mpi, value, 1, 2), "max sum");
+    RWDS((REF_DBL)(ref_mpi_n(ref_mpi) - 1), value[0], -1, "max rank");
+    RWDS((REF_DBL)ref_mpi_n(ref_mpi), value[1], -1, "sum one");
+    RWDS(0.5 * (REF_DBL)(ref_mpi_n(ref_mpi) * (ref_mpi_n(ref_mpi) - 1)),
+         value[2], -1, "sum rank");
+  }
+
+  /* nested timers */
+  {
+    REF_INT i;
+    REF_DBL total;
+    FILE *check;
+    char line[256];
+    char filename[] = "ref_mpi_test_timer.csv";
+
+    RSS(ref_mpi_timer_start(ref_mpi, "off"), "disabled start");
+    RSS(ref_mpi_timer_stop(ref_mpi, "off"), "disabled stop");
+    REIS(0, ref_mpi->ntimer, "disabled timers recorded");
+
+    ref_mpi_timing(ref_mpi) = REF_TRUE;
+    for (i = 0; i < 2; i++) {
+      RSS(ref_mpi_timer_start(ref_mpi, "outer"), "start");
+      RSS(ref_mpi_timer_start(ref_mpi, "inner"), "start");
+      RSS(ref_mpi_timer_stop(ref_mpi, "inner"), "stop");
+      RSS(ref_mpi_timer_stop(ref_mpi, "outer"), "stop");
+    }
+    REIS(2, ref_mpi->ntimer, "regions");
+    REIS(REF_EMPTY, ref_mpi->timer_parent[0], "outer parent");
+    REIS(0, ref_mpi->timer_parent[1], "inner parent");
+    REIS(2, ref_mpi->timer_count[1], "inner count");
+    REIS(REF_EMPTY, ref_mpi->timer_open, "left open");
+    RSS(ref_mpi_timer_total(ref_mpi, "outer", &total), "total");
+    RAS(0.0 <= total, "outer total");
+    RAS(ref_mpi->timer_total[0] == total, "outer total");
+    RSS(ref_mpi_timer_total(ref_mpi, "inner", &total), "total");
+    RAS(0.0 == total, "inner is not a root region");
+
+    RSS(ref_mpi_timer_start(ref_mpi, "outer"), "start");
+    REIS(REF_FAILURE, ref_mpi_timer_stop(ref_mpi, "inner"), "mismatch");
+    RSS(ref_mpi_timer_stop(ref_mpi, "outer"), "stop");
+
+    RSS(ref_mpi_timer_report(ref_mpi, filename), "report");
+    if (ref_mpi_once(ref_mpi)) {
+      check = fopen(filename, "r");
+      RNS(check, "unable to open");
+      RNS(fgets(line, 256, check), "header");
+      RNS(fgets(line, 256, check), "outer");
+      REIS(0, strncmp("outer,0,3,", line, 10), "outer line");
+      RNS(fgets(line, 256, check), "inner");
+      REIS(0, strncmp("outer/inner,1,2,", line, 16), "inner line");
+      REIS(EOF, fgetc(check), "extra lines");
+      fclose(check);
+      REIS(0, remove(filename), "test clean up");
+    }
+    ref_mpi_timing(ref_mpi) = REF_FALSE;
+  }
+
   /* alltoall */
   {
     REF_INT part;
@@ -228,6 +310,32 @@ int main(int argc, char *argv[]) {
     ref_free(proc);
   }
 
+  /* collective write at offset */
+  {
+    void *file;
+    FILE *check;
+    REF_INT rank, part;
+    char filename[] = "ref_mpi_test.bin";
+
+    rank = ref_mpi_rank(ref_mpi);
+    RSS(ref_mpi_fopen_write(ref_mpi, filename, &file), "open");
+    RSS(ref_mpi_fwrite_at_all(ref_mpi, file, (long)(sizeof(REF_INT) * rank),
+                              &rank, sizeof(REF_INT), 1),
+        "write");
+    RSS(ref_mpi_fclose(ref_mpi, file), "close");
+    if (ref_mpi_once(ref_mpi)) {
+      check = fopen(filename, "r");
+      RNS(check, "unable to open");
+      each_ref_mpi_part(ref_mpi, part) {
+        REIS(1, fread(&rank, sizeof(REF_INT), 1, check), "read");
+        REIS(part, rank, "rank mismatch");
+      }
+      REIS(EOF, fgetc(check), "extra bytes");
+      fclose(check);
+      REIS(0, remove(filename), "test clean up");
+    }
+  }
+
   /* split */
   {
     REF_MPI new_mpi;
@@ -31,6 +31,87 @@
 #define next2index(next) (-(next)-2)
 #define index2next(index) (-2 - (index))
 
+/* hash slots are kept at most half full for short linear probes */
+static REF_INT ref_node_hash_size(REF_INT n) {
+  REF_INT nhash = 64;
+  while (nhash < 4 * n) nhash *= 2;
+  return nhash;
+}
+
+static REF_INT ref_node_hash_slot(REF_NODE ref_node, REF_GLOB global) {
+  unsigned long wide = (unsigned long)global;
+  unsigned int key = (unsigned int)(wide ^ (wide >> 16 >> 16));
+  /* murmur3 finalizer, scatters strided and sequential globals */
+  key ^= key >> 16;
+  key *= 0x85ebca6bu;
+  key ^= key >> 13;
+  key *= 0xc2b2ae35u;
+  key ^= key >> 16;
+  return (REF_INT)(key & (unsigned int)(ref_node->nhash - 1));
+}
+
+static REF_STATUS ref_node_hash_insert(REF_NODE ref_node, REF_GLOB global,
+                                       REF_INT local) {
+  REF_INT slot;
+
+  if (2 * ref_node_n(ref_node) > ref_node->nhash)
+    RSS(ref_node_rebuild_index(ref_node), "grow");
+
+  slot = ref_node_hash_slot(ref_node, global);
+  while (REF_EMPTY != ref_node->hash_local[slot]) {
+    if (global == ref_node->hash_global[slot]) {
+      ref_node->hash_local[slot] = local;
+      return REF_SUCCESS;
+    }
+    slot = (slot + 1) & (ref_node->nhash - 1);
+  }
+  ref_node->hash_global[slot] = global;
+  ref_node->hash_local[slot] = local;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_node_hash_remove(REF_NODE ref_node, REF_GLOB global) {
+  REF_INT mask = ref_node->nhash - 1;
+  REF_INT slot, empty, home;
+
+  slot = ref_node_hash_slot(ref_node, global);
+  while (global != ref_node->hash_global[slot]) {
+    if (REF_EMPTY == ref_node->hash_local[slot]) return REF_NOT_FOUND;
+    slot = (slot + 1) & mask;
+  }
+
+  /* backward shift deletion, no tombstones to slow later probes */
+  empty = slot;
+  while (REF_TRUE) {
+    slot = (slot + 1) & mask;
+    if (REF_EMPTY == ref_node->hash_local[slot]) break;
+    home = ref_node_hash_slot(ref_node, ref_node->hash_global[slot]);
+    if ((slot > empty && (home <= empty || home > slot)) ||
+        (slot < empty && (home <= empty && home > slot))) {
+      ref_node->hash_global[empty] = ref_node->hash_global[slot];
+      ref_node->hash_local[empty] = ref_node->hash_local[slot];
+      empty = slot;
+    }
+  }
+  ref_node->hash_global[empty] = REF_EMPTY;
+  ref_node->hash_local[empty] = REF_EMPTY;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_node_push_unused(REF_NODE ref_node,
+                                       REF_GLOB unused_global) {
+  if (ref_node->max_unused == ref_node->n_unused) {
+    ref_node->max_unused += MAX(1000, ref_node->max_unused);
+    ref_realloc(ref_node->unused_global, ref_node->max_unused, REF_GLOB);
+  }
+  ref_node->unused_global[ref_node->n_unused] = unused_global;
+  (ref_node->n_unused)++;
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_node_create(REF_NODE *ref_node_ptr, REF_MPI ref_mpi) {
   REF_INT max, node;
   REF_NODE ref_node;
@@ -44,15 +125,16 @@ REF_STATUS ref_node_create(REF_NODE *ref_node_ptr, REF_MPI ref_mpi) {
   ref_node_n(ref_node) = 0;
   ref_node_max(ref_node) = max;
 
-  ref_malloc(ref_node->global, max, REF_INT);
+  ref_malloc(ref_node->global, max, REF_GLOB);
 
   for (node = 0; node < ref_node_max(ref_node); node++)
     ref_node->global[node] = index2next(node + 1);
   ref_node->global[(ref_node->max) - 1] = REF_EMPTY;
   ref_node->blank = index2next(0);
 
-  ref_malloc(ref_node->sorted_global, max, REF_INT);
-  ref_malloc(ref_node->sorted_local, max, REF_INT);
+  ref_node->nhash = ref_node_hash_size(max);
+  ref_malloc_init(ref_node->hash_global, ref_node->nhash, REF_GLOB, REF_EMPTY);
+  ref_malloc_init(ref_node->hash_local, ref_node->nhash, REF_INT, REF_EMPTY);
 
   ref_malloc(ref_node->part, max, REF_INT);
   ref_malloc(ref_node->age, max, REF_INT);
@@ -63,7 +145,9 @@ REF_STATUS ref_node_create(REF_NODE *ref_node_ptr, REF_MPI ref_mpi) {
   ref_node->aux = NULL;
 
   ref_node_mpi(ref_node) = ref_mpi; /* reference only */
-  RSS(ref_list_create(&(ref_node->unused_global_list)), "create list");
+  ref_node->n_unused = 0;
+  ref_node->max_unused = 10;
+  ref_malloc(ref_node->unused_global, ref_node->max_unused, REF_GLOB);
 
   ref_node->old_n_global = REF_EMPTY;
   ref_node->new_n_global = REF_EMPTY;
@@ -75,19 +159,36 @@ REF_STATUS ref_node_create(REF_NODE *ref_node_ptr, REF_MPI ref_mpi) {
   ref_node->tet_quality = REF_NODE_JAC_QUALITY;
   ref_node->tri_quality = REF_NODE_JAC_QUALITY;
 
+  ref_node->halo = NULL;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_node_halo_free(REF_NODE ref_node) {
+  REF_HALO ref_halo = ref_node->halo;
+  if (NULL == (void *)ref_halo) return REF_SUCCESS;
+  ref_free(ref_halo->recv_global);
+  ref_free(ref_halo->recv_local);
+  ref_free(ref_halo->send_global);
+  ref_free(ref_halo->send_local);
+  ref_free(ref_halo->recv_size);
+  ref_free(ref_halo->send_size);
+  ref_free(ref_halo);
+  ref_node->halo = NULL;
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_node_free(REF_NODE ref_node) {
   if (NULL == (void *)ref_node) return REF_NULL;
-  ref_list_free(ref_node->unused_global_list);
+  RSS(ref_node_halo_free(ref_node), "halo");
+  ref_free(ref_node->unused_global);
   /* ref_mpi reference only */
   ref_free(ref_node->aux);
   ref_free(ref_node->real);
   ref_free(ref_node->age);
   ref_free(ref_node->part);
-  ref_free(ref_node->sorted_local);
-  ref_free(ref_node->sorted_global);
+  ref_free(ref_node->hash_local);
+  ref_free(ref_node->hash_global);
   ref_free(ref_node->global);
   ref_free(ref_node);
   return REF_SUCCESS;
@@ -105,17 +206,18 @@ REF_STATUS ref_node_deep_copy(REF_NODE *ref_node_ptr, REF_NODE original) {
   ref_node_n(ref_node) = ref_node_n(original);
   ref_node_max(ref_node) = max;
 
-  ref_malloc(ref_node->global, max, REF_INT);
+  ref_malloc(ref_node->global, max, REF_GLOB);
   ref_node->blank = original->blank;
   for (node = 0; node < max; node++)
     ref_node->global[node] = original->global[node];
 
-  ref_malloc(ref_node->sorted_global, max, REF_INT);
-  ref_malloc(ref_node->sorted_local, max, REF_INT);
-  for (node = 0; node < max; node++)
-    ref_node->sorted_global[node] = original->sorted_global[node];
-  for (node = 0; node < max; node++)
-    ref_node->sorted_local[node] = original->sorted_local[node];
+  ref_node->nhash = original->nhash;
+  ref_malloc(ref_node->hash_global, ref_node->nhash, REF_GLOB);
+  ref_malloc(ref_node->hash_local, ref_node->nhash, REF_INT);
+  for (i = 0; i < ref_node->nhash; i++)
+    ref_node->hash_global[i] = original->hash_global[i];
+  for (i = 0; i < ref_node->nhash; i++)
+    ref_node->hash_local[i] = original->hash_local[i];
 
   ref_malloc(ref_node->part, max, REF_INT);
   for (node = 0; node < max; node++)
@@ -141,9 +243,11 @@ REF_STATUS ref_node_deep_copy(REF_NODE *ref_node_ptr, REF_NODE original) {
   }
 
   ref_node_mpi(ref_node) = ref_node_mpi(original); /* reference only */
-  RSS(ref_list_deep_copy(&(ref_node->unused_global_list),
-                         original->unused_global_list),
-      "deep copy list");
+  ref_node->n_unused = original->n_unused;
+  ref_node->max_unused = original->max_unused;
+  ref_malloc(ref_node->unused_global, ref_node->max_unused, REF_GLOB);
+  for (i = 0; i < ref_node->n_unused; i++)
+    ref_node->unused_global[i] = original->unused_global[i];
 
   ref_node->old_n_global = original->old_n_global;
   ref_node->new_n_global = original->new_n_global;
@@ -155,6 +259,8 @@ REF_STATUS ref_node_deep_copy(REF_NODE *ref_node_ptr, REF_NODE original) {
   ref_node->tet_quality = original->tet_quality;
   ref_node->tri_quality = original->tri_quality;
 
+  ref_node->halo = NULL;
+
   return REF_SUCCESS;
 }
 
@@ -174,8 +280,9 @@ REF_STATUS ref_node_pack(REF_NODE ref_node, REF_INT *o2n, REF_INT *n2o) {
     ref_node->blank = REF_EMPTY;
   }
 
-  for (node = 0; node < ref_node_n(ref_node); node++)
-    ref_node->sorted_local[node] = o2n[copy->sorted_local[node]];
+  for (i = 0; i < ref_node->nhash; i++)
+    if (REF_EMPTY != copy->hash_local[i])
+      ref_node->hash_local[i] = o2n[copy->hash_local[i]];
 
   for (node = 0; node < ref_node_n(ref_node); node++)
     ref_node->part[node] = copy->part[n2o[node]];
@@ -194,6 +301,7 @@ REF_STATUS ref_node_pack(REF_NODE ref_node, REF_INT *o2n, REF_INT *n2o) {
   }
 
   RSS(ref_node_free(copy), "release copy");
+  RSS(ref_node_halo_free(ref_node), "local indexes changed");
 
   return REF_SUCCESS;
 }
@@ -206,13 +314,15 @@ REF_STATUS ref_node_inspect(REF_NODE ref_node) {
   printf(" blank = %d\n", ref_node->blank);
   for (node = 0; node < ref_node_max(ref_node); node++)
     if (0 <= ref_node->global[node])
-      printf(" global[%d] = %3d; part[%d] = %3d;\n", node,
+      printf(" global[%d] = " REF_GLOB_FMT "; part[%d] = %3d;\n", node,
              ref_node->global[node], node, ref_node->part[node]);
-  for (node = 0; node < ref_node_n(ref_node); node++)
-    printf(" sorted_global[%d] = %d sorted_local[%d] = %d\n", node,
-           ref_node->sorted_global[node], node, ref_node->sorted_local[node]);
-  printf(" old_n_global = %d\n", ref_node->old_n_global);
-  printf(" new_n_global = %d\n", ref_node->new_n_global);
+  printf(" nhash = %d\n", ref_node->nhash);
+  for (node = 0; node < ref_node->nhash; node++)
+    if (REF_EMPTY != ref_node->hash_local[node])
+      printf(" hash_global[%d] = " REF_GLOB_FMT " hash_local[%d] = %d\n", node,
+             ref_node->hash_global[node], node, ref_node->hash_local[node]);
+  printf(" old_n_global = " REF_GLOB_FMT "\n", ref_node->old_n_global);
+  printf(" new_n_global = " REF_GLOB_FMT "\n", ref_node->new_n_global);
   return REF_SUCCESS;
 }
 
@@ -231,7 +341,7 @@ REF_STATUS ref_node_location(REF_NODE ref_node, REF_INT node) {
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_tattle_global(REF_NODE ref_node, REF_INT global) {
+REF_STATUS ref_node_tattle_global(REF_NODE ref_node, REF_GLOB global) {
   REF_INT local_from_sorted;
   REF_INT local_from_exhaustive;
   REF_BOOL found_from_sorted;
@@ -258,14 +368,14 @@ REF_STATUS ref_node_tattle_global(REF_NODE ref_node, REF_INT global) {
     }
   }
 
-  printf("%d: global %d: search%d %d exhast%d %d\n",
+  printf("%d: global " REF_GLOB_FMT ": search%d %d exhast%d %d\n",
          ref_mpi_rank(ref_node_mpi(ref_node)), global, found_from_sorted,
          local_from_sorted, found_from_exhaustive, local_from_exhaustive);
 
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_INT global,
+static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_GLOB global,
                                     REF_INT *node) {
   REF_INT orig, chunk, extra;
 
@@ -275,15 +385,12 @@ static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_INT global,
     orig = ref_node_max(ref_node);
     chunk = MAX(5000, (REF_INT)(1.5 * (REF_DBL)orig));
     ref_node->max = orig + chunk;
-    ref_realloc(ref_node->global, ref_node_max(ref_node), REF_INT);
+    ref_realloc(ref_node->global, ref_node_max(ref_node), REF_GLOB);
     for (extra = orig; extra < ref_node_max(ref_node); extra++)
       ref_node->global[extra] = index2next(extra + 1);
     ref_node->global[ref_node_max(ref_node) - 1] = REF_EMPTY;
     ref_node->blank = index2next(orig);
 
-    ref_realloc(ref_node->sorted_global, ref_node_max(ref_node), REF_INT);
-    ref_realloc(ref_node->sorted_local, ref_node_max(ref_node), REF_INT);
-
     ref_realloc(ref_node->part, ref_node_max(ref_node), REF_INT);
     ref_realloc(ref_node->age, ref_node_max(ref_node), REF_INT);
 
@@ -300,7 +407,7 @@ static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_INT global,
   }
 
   *node = next2index(ref_node->blank);
-  ref_node->blank = ref_node->global[*node];
+  ref_node->blank = (REF_INT)ref_node->global[*node];
 
   ref_node->global[*node] = global;
   ref_node->part[*node] =
@@ -311,8 +418,7 @@ static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_INT global,
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_add(REF_NODE ref_node, REF_INT global, REF_INT *node) {
-  REF_INT location, insert_point;
+REF_STATUS ref_node_add(REF_NODE ref_node, REF_GLOB global, REF_INT *node) {
   REF_STATUS status;
 
   if (global < 0) RSS(REF_INVALID, "invalid global node");
@@ -322,40 +428,22 @@ REF_STATUS ref_node_add(REF_NODE ref_node, REF_INT global, REF_INT *node) {
 
   RSS(ref_node_add_core(ref_node, global, node), "core");
 
-  /* general case of non-ascending global node, requires:
-     search and shift (but looks to see if bigger than last early) */
-  insert_point = 0;
-  for (location = ref_node_n(ref_node) - 2; location >= 0; location--) {
-    if (ref_node->sorted_global[location] < global) {
-      insert_point = location + 1;
-      break;
-    }
-  }
-
-  /* shift down to clear insert_point */
-  for (location = ref_node_n(ref_node) - 1; location > insert_point; location--)
-    ref_node->sorted_global[location] = ref_node->sorted_global[location - 1];
-  for (location = ref_node_n(ref_node) - 1; location > insert_point; location--)
-    ref_node->sorted_local[location] = ref_node->sorted_local[location - 1];
-
-  /* insert in empty location */
-  ref_node->sorted_global[insert_point] = global;
-  ref_node->sorted_local[insert_point] = *node;
+  RSS(ref_node_hash_insert(ref_node, global, *node), "index");
 
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_node_add_many(REF_NODE ref_node, REF_INT n,
-                             REF_INT *global_orig) {
+                             REF_GLOB *global_orig) {
   REF_STATUS status;
   REF_INT i, j, local, new;
 
-  REF_INT *global;
+  REF_GLOB *global;
   REF_INT *sorted;
 
   /* copy, removing existing nodes from list */
 
-  ref_malloc(global, n, REF_INT);
+  ref_malloc(global, n, REF_GLOB);
 
   new = 0;
   for (i = 0; i < n; i++) {
@@ -370,7 +458,7 @@ REF_STATUS ref_node_add_many(REF_NODE ref_node, REF_INT n,
 
   ref_malloc(sorted, new, REF_INT);
 
-  RSS(ref_sort_heap_int(new, global, sorted), "heap");
+  RSS(ref_sort_heap_glob(new, global, sorted), "heap");
 
   j = 0;
   for (i = 1; i < new; i++) {
@@ -388,7 +476,7 @@ REF_STATUS ref_node_add_many(REF_NODE ref_node, REF_INT n,
       RSS(ref_node_add_core(ref_node, global[i], &local), "add core");
     }
 
-  RSS(ref_node_rebuild_sorted_global(ref_node), "rebuild globals");
+  RSS(ref_node_rebuild_index(ref_node), "rebuild globals");
 
   ref_free(sorted);
   ref_free(global);
@@ -396,24 +484,46 @@ REF_STATUS ref_node_add_many(REF_NODE ref_node, REF_INT n,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_node_adopt(REF_NODE ref_node, REF_INT n, REF_GLOB *global,
+                          REF_INT *part, REF_DBL *real) {
+  REF_INT node;
+
+  RAS(0 == ref_node_n(ref_node), "adopt needs an empty ref_node");
+  RAS(0 < n, "adopt needs nodes");
+  for (node = 0; node < n; node++)
+    RAS(0 <= global[node], "invalid global node");
+
+  ref_free(ref_node->aux);
+  ref_free(ref_node->real);
+  ref_free(ref_node->age);
+  ref_free(ref_node->part);
+  ref_free(ref_node->global);
+
+  ref_node->global = global;
+  ref_node->part = part;
+  ref_node->real = real;
+  ref_node_max(ref_node) = n;
+  ref_node_n(ref_node) = n;
+  ref_node->blank = REF_EMPTY;
+  ref_malloc_init(ref_node->age, n, REF_INT, 0);
+  ref_node->aux = NULL;
+  if (ref_node_naux(ref_node) > 0)
+    RSS(ref_node_resize_aux(ref_node), "aux");
+
+  /* one pass at the final size, no sort or incremental growth */
+  RSS(ref_node_rebuild_index(ref_node), "index");
+  RSS(ref_node_halo_free(ref_node), "local indexes changed");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_node_remove(REF_NODE ref_node, REF_INT node) {
-  REF_INT location, sorted_node;
   if (!ref_node_valid(ref_node, node)) return REF_INVALID;
 
-  RSS(ref_sort_search(ref_node_n(ref_node), ref_node->sorted_global,
-                      ref_node->global[node], &location),
-      "find global in sort list");
-
-  for (sorted_node = location; sorted_node < ref_node_n(ref_node) - 1;
-       sorted_node++)
-    ref_node->sorted_global[sorted_node] =
-        ref_node->sorted_global[sorted_node + 1];
-  for (sorted_node = location; sorted_node < ref_node_n(ref_node) - 1;
-       sorted_node++)
-    ref_node->sorted_local[sorted_node] =
-        ref_node->sorted_local[sorted_node + 1];
+  RSS(ref_node_hash_remove(ref_node, ref_node->global[node]),
+      "remove global from index");
 
-  RSS(ref_list_push(ref_node->unused_global_list, ref_node->global[node]),
+  RSS(ref_node_push_unused(ref_node, ref_node->global[node]),
       "store unused global");
 
   ref_node->global[node] = ref_node->blank;
@@ -425,21 +535,10 @@ REF_STATUS ref_node_remove(REF_NODE ref_node, REF_INT node) {
 }
 
 REF_STATUS ref_node_remove_without_global(REF_NODE ref_node, REF_INT node) {
-  REF_INT location, sorted_node;
   if (!ref_node_valid(ref_node, node)) return REF_INVALID;
 
-  RSS(ref_sort_search(ref_node_n(ref_node), ref_node->sorted_global,
-                      ref_node->global[node], &location),
-      "find global in sort list");
-
-  for (sorted_node = location; sorted_node < ref_node_n(ref_node) - 1;
-       sorted_node++)
-    ref_node->sorted_global[sorted_node] =
-        ref_node->sorted_global[sorted_node + 1];
-  for (sorted_node = location; sorted_node < ref_node_n(ref_node) - 1;
-       sorted_node++)
-    ref_node->sorted_local[sorted_node] =
-        ref_node->sorted_local[sorted_node + 1];
+  RSS(ref_node_hash_remove(ref_node, ref_node->global[node]),
+      "remove global from index");
 
   ref_node->global[node] = ref_node->blank;
   ref_node->blank = index2next(node);
@@ -449,43 +548,37 @@ REF_STATUS ref_node_remove_without_global(REF_NODE ref_node, REF_INT node) {
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_rebuild_sorted_global(REF_NODE ref_node) {
-  REF_INT node, nnode, *pack;
+REF_STATUS ref_node_rebuild_index(REF_NODE ref_node) {
+  REF_INT node, slot;
 
-  ref_malloc(pack, ref_node_n(ref_node), REF_INT);
+  ref_free(ref_node->hash_local);
+  ref_free(ref_node->hash_global);
+  ref_node->nhash = ref_node_hash_size(ref_node_n(ref_node));
+  ref_malloc_init(ref_node->hash_global, ref_node->nhash, REF_GLOB, REF_EMPTY);
+  ref_malloc_init(ref_node->hash_local, ref_node->nhash, REF_INT, REF_EMPTY);
 
-  nnode = 0;
   each_ref_node_valid_node(ref_node, node) {
-    ref_node->sorted_global[nnode] = ref_node->global[node];
-    pack[nnode] = node;
-    nnode++;
+    slot = ref_node_hash_slot(ref_node, ref_node->global[node]);
+    while (REF_EMPTY != ref_node->hash_local[slot])
+      slot = (slot + 1) & (ref_node->nhash - 1);
+    ref_node->hash_global[slot] = ref_node->global[node];
+    ref_node->hash_local[slot] = node;
   }
 
-  RSS(ref_sort_heap_int(ref_node_n(ref_node), ref_node->sorted_global,
-                        ref_node->sorted_local),
-      "heap");
-
-  for (node = 0; node < ref_node_n(ref_node); node++) {
-    ref_node->sorted_local[node] = pack[ref_node->sorted_local[node]];
-    ref_node->sorted_global[node] =
-        ref_node->global[ref_node->sorted_local[node]];
-  }
-
-  ref_free(pack);
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_initialize_n_global(REF_NODE ref_node, REF_INT n_global) {
+REF_STATUS ref_node_initialize_n_global(REF_NODE ref_node, REF_GLOB n_global) {
   ref_node->old_n_global = n_global;
   ref_node->new_n_global = n_global;
 
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_next_global(REF_NODE ref_node, REF_INT *global) {
-  if (0 < ref_list_n(ref_node->unused_global_list)) {
-    RSS(ref_list_pop(ref_node->unused_global_list, global),
-        "grab an unused global from list");
+REF_STATUS ref_node_next_global(REF_NODE ref_node, REF_GLOB *global) {
+  if (0 < ref_node->n_unused) {
+    (ref_node->n_unused)--;
+    (*global) = ref_node->unused_global[ref_node->n_unused];
   } else {
     if (REF_EMPTY == ref_node->new_n_global)
       RSS(ref_node_initialize_n_global(ref_node, ref_node_n(ref_node)),
@@ -505,15 +598,17 @@ REF_STATUS ref_node_synchronize_globals(REF_NODE ref_node) {
 
 REF_STATUS ref_node_shift_new_globals(REF_NODE ref_node) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT new_nodes;
-  REF_INT *everyones_new_nodes;
-  REF_INT offset, proc, total_new_nodes, node;
+  REF_GLOB new_nodes;
+  REF_GLOB *everyones_new_nodes;
+  REF_GLOB offset, total_new_nodes;
+  REF_INT proc, node, i;
 
-  ref_malloc(everyones_new_nodes, ref_mpi_n(ref_mpi), REF_INT);
+  ref_malloc(everyones_new_nodes, ref_mpi_n(ref_mpi), REF_GLOB);
 
   new_nodes = ref_node->new_n_global - ref_node->old_n_global;
 
-  RSS(ref_mpi_allgather(ref_mpi, &new_nodes, everyones_new_nodes, REF_INT_TYPE),
+  RSS(ref_mpi_allgather(ref_mpi, &new_nodes, everyones_new_nodes,
+                        REF_GLOB_TYPE),
       "allgather");
 
   offset = 0;
@@ -531,14 +626,11 @@ REF_STATUS ref_node_shift_new_globals(REF_NODE ref_node) {
                             ref_node->old_n_global)(ref_node->global[node]) +=
         offset;
 
-    for (node = ref_node_n(ref_node) - 1;
-         node >= 0 && ref_node->sorted_global[node] >= ref_node->old_n_global;
-         node--)
-      ref_node->sorted_global[node] += offset;
+    RSS(ref_node_rebuild_index(ref_node), "rebuild shifted globals");
 
-    RSS(ref_list_apply_offset(ref_node->unused_global_list,
-                              ref_node->old_n_global, offset),
-        "shift");
+    for (i = 0; i < ref_node->n_unused; i++)
+      if (ref_node->unused_global[i] >= ref_node->old_n_global)
+        ref_node->unused_global[i] += offset;
   }
 
   RSS(ref_node_initialize_n_global(ref_node,
@@ -549,46 +641,74 @@ REF_STATUS ref_node_shift_new_globals(REF_NODE ref_node) {
 }
 
 REF_STATUS ref_node_eliminate_unused_globals(REF_NODE ref_node) {
-  REF_LIST ref_list = ref_node->unused_global_list;
-  REF_INT sort, offset, local;
-
-  RSS(ref_list_allgather(ref_list, ref_node_mpi(ref_node)),
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_INT *counts, *sorted;
+  REF_GLOB *unused;
+  REF_INT node, proc, i, total, lower, upper, mid;
+
+  ref_malloc(counts, ref_mpi_n(ref_mpi), REF_INT);
+  RSS(ref_mpi_allgather(ref_mpi, &(ref_node->n_unused), counts, REF_INT_TYPE),
+      "gather size");
+  total = 0;
+  each_ref_mpi_part(ref_mpi, proc) total += counts[proc];
+  ref_malloc(unused, total, REF_GLOB);
+  RSS(ref_mpi_allgatherv(ref_mpi, ref_node->unused_global, counts, unused,
+                         REF_GLOB_TYPE),
       "gather unused global");
-  RSS(ref_list_sort(ref_list), "sort unused global");
-
-  offset = 0;
-  for (sort = 0; sort < ref_node_n(ref_node); sort++) {
-    while ((offset < ref_list_n(ref_list)) &&
-           (ref_list_value(ref_list, offset) < ref_node->sorted_global[sort])) {
-      offset++;
+  ref_free(counts);
+
+  ref_malloc(sorted, total, REF_INT);
+  RSS(ref_sort_heap_glob(total, unused, sorted), "sort unused global");
+  if (total > ref_node->max_unused) {
+    ref_free(ref_node->unused_global);
+    ref_node->max_unused = total;
+    ref_malloc(ref_node->unused_global, ref_node->max_unused, REF_GLOB);
+  }
+  for (i = 0; i < total; i++) ref_node->unused_global[i] = unused[sorted[i]];
+  ref_free(sorted);
+  ref_free(unused);
+
+  if (0 < total) {
+    each_ref_node_valid_node(ref_node, node) {
+      /* bisect for the count of unused globals below this global */
+      lower = 0;
+      upper = total;
+      while (lower < upper) {
+        mid = lower + (upper - lower) / 2;
+        if (ref_node->unused_global[mid] < ref_node->global[node]) {
+          lower = mid + 1;
+        } else {
+          upper = mid;
+        }
+      }
+      ref_node->global[node] -= lower;
     }
-    local = ref_node->sorted_local[sort];
-    ref_node->global[local] -= offset; /* move to separate loop for cashe? */
-    ref_node->sorted_global[sort] -= offset;
+    RSS(ref_node_rebuild_index(ref_node), "rebuild compressed globals");
   }
 
-  RSS(ref_node_initialize_n_global(
-          ref_node, ref_node->old_n_global - ref_list_n(ref_list)),
+  RSS(ref_node_initialize_n_global(ref_node, ref_node->old_n_global - total),
       "re-init");
 
-  RSS(ref_list_erase(ref_list), "erase unused list");
+  ref_node->n_unused = 0;
 
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_local(REF_NODE ref_node, REF_INT global, REF_INT *local) {
-  REF_INT location;
+REF_STATUS ref_node_local(REF_NODE ref_node, REF_GLOB global, REF_INT *local) {
+  REF_INT slot;
 
   (*local) = REF_EMPTY;
 
-  RAISE(ref_sort_search(ref_node_n(ref_node), ref_node->sorted_global, global,
-                        &location));
-
-  if ((location) == REF_EMPTY) return REF_NOT_FOUND;
-
-  (*local) = ref_node->sorted_local[location];
+  slot = ref_node_hash_slot(ref_node, global);
+  while (REF_EMPTY != ref_node->hash_local[slot]) {
+    if (global == ref_node->hash_global[slot]) {
+      (*local) = ref_node->hash_local[slot];
+      return REF_SUCCESS;
+    }
+    slot = (slot + 1) & (ref_node->nhash - 1);
+  }
 
-  return REF_SUCCESS;
+  return REF_NOT_FOUND;
 }
 
 REF_STATUS ref_node_compact(REF_NODE ref_node, REF_INT **o2n_ptr,
@@ -631,155 +751,217 @@ REF_STATUS ref_node_ghost_real(REF_NODE ref_node) {
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_ghost_int(REF_NODE ref_node, REF_INT *scalar) {
+static REF_STATUS ref_node_halo_build(REF_NODE ref_node) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT *a_size, *b_size;
-  REF_INT a_total, b_total;
-  REF_INT *a_global, *b_global;
-  REF_INT part, node;
-  REF_INT *a_next;
-  REF_INT *a_scalar, *b_scalar;
-  REF_INT local;
+  REF_HALO ref_halo;
+  REF_INT part, node, i;
+  REF_INT *recv_next;
 
-  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+  ref_malloc(ref_node->halo, 1, REF_HALO_STRUCT);
+  ref_halo = ref_node->halo;
 
-  ref_malloc_init(a_size, ref_mpi_n(ref_mpi), REF_INT, 0);
-  ref_malloc_init(b_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(ref_halo->recv_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(ref_halo->send_size, ref_mpi_n(ref_mpi), REF_INT, 0);
 
   each_ref_node_valid_node(ref_node, node) {
     if (!ref_node_owned(ref_node, node)) {
-      a_size[ref_node_part(ref_node, node)]++;
+      ref_halo->recv_size[ref_node_part(ref_node, node)]++;
     }
   }
 
-  RSS(ref_mpi_alltoall(ref_mpi, a_size, b_size, REF_INT_TYPE),
+  RSS(ref_mpi_alltoall(ref_mpi, ref_halo->recv_size, ref_halo->send_size,
+                       REF_INT_TYPE),
       "alltoall sizes");
 
-  a_total = 0;
-  each_ref_mpi_part(ref_mpi, part) { a_total += a_size[part]; }
-  ref_malloc(a_global, a_total, REF_INT);
-  ref_malloc(a_scalar, a_total, REF_INT);
+  ref_halo->nrecv = 0;
+  each_ref_mpi_part(ref_mpi, part) ref_halo->nrecv += ref_halo->recv_size[part];
+  ref_halo->nsend = 0;
+  each_ref_mpi_part(ref_mpi, part) ref_halo->nsend += ref_halo->send_size[part];
 
-  b_total = 0;
-  each_ref_mpi_part(ref_mpi, part) { b_total += b_size[part]; }
-  ref_malloc(b_global, b_total, REF_INT);
-  ref_malloc(b_scalar, b_total, REF_INT);
+  ref_malloc(ref_halo->recv_local, ref_halo->nrecv, REF_INT);
+  ref_malloc(ref_halo->recv_global, ref_halo->nrecv, REF_GLOB);
+  ref_malloc(ref_halo->send_local, ref_halo->nsend, REF_INT);
+  ref_malloc(ref_halo->send_global, ref_halo->nsend, REF_GLOB);
 
-  ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
-  a_next[0] = 0;
+  ref_malloc(recv_next, ref_mpi_n(ref_mpi), REF_INT);
+  recv_next[0] = 0;
   each_ref_mpi_worker(ref_mpi, part) {
-    a_next[part] = a_next[part - 1] + a_size[part - 1];
+    recv_next[part] = recv_next[part - 1] + ref_halo->recv_size[part - 1];
   }
-
   each_ref_node_valid_node(ref_node, node) {
     if (!ref_node_owned(ref_node, node)) {
       part = ref_node_part(ref_node, node);
-      a_global[a_next[part]] = ref_node_global(ref_node, node);
-      a_next[ref_node_part(ref_node, node)]++;
+      ref_halo->recv_local[recv_next[part]] = node;
+      ref_halo->recv_global[recv_next[part]] = ref_node_global(ref_node, node);
+      recv_next[part]++;
     }
   }
+  ref_free(recv_next);
 
-  RSS(ref_mpi_alltoallv(ref_mpi, a_global, a_size, b_global, b_size, 1,
-                        REF_INT_TYPE),
+  RSS(ref_mpi_alltoallv(ref_mpi, ref_halo->recv_global, ref_halo->recv_size,
+                        ref_halo->send_global, ref_halo->send_size, 1,
+                        REF_GLOB_TYPE),
       "alltoallv global");
 
-  for (node = 0; node < b_total; node++) {
-    RSS(ref_node_local(ref_node, b_global[node], &local), "g2l");
-    b_scalar[node] = scalar[local];
+  for (i = 0; i < ref_halo->nsend; i++) {
+    RSS(ref_node_local(ref_node, ref_halo->send_global[i],
+                       &(ref_halo->send_local[i])),
+        "g2l");
   }
 
-  RSS(ref_mpi_alltoallv(ref_mpi, b_scalar, b_size, a_scalar, a_size, 1,
-                        REF_INT_TYPE),
-      "alltoallv global");
+  return REF_SUCCESS;
+}
+
+/* local check that ghosts, owners, and local indexes are unchanged */
+static REF_BOOL ref_node_halo_stale(REF_NODE ref_node) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_HALO ref_halo = ref_node->halo;
+  REF_INT part, node, i, k, nghost;
+
+  if (NULL == (void *)ref_halo) return REF_TRUE;
 
-  for (node = 0; node < a_total; node++) {
-    RSS(ref_node_local(ref_node, a_global[node], &local), "g2l");
-    scalar[local] = a_scalar[node];
+  nghost = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_owned(ref_node, node)) nghost++;
+  }
+  if (nghost != ref_halo->nrecv) return REF_TRUE;
+
+  i = 0;
+  each_ref_mpi_part(ref_mpi, part) {
+    for (k = 0; k < ref_halo->recv_size[part]; k++, i++) {
+      node = ref_halo->recv_local[i];
+      if (!ref_node_valid(ref_node, node) ||
+          ref_halo->recv_global[i] != ref_node_global(ref_node, node) ||
+          part != ref_node_part(ref_node, node))
+        return REF_TRUE;
+    }
   }
 
-  free(a_next);
-  free(b_scalar);
-  free(b_global);
-  free(a_scalar);
-  free(a_global);
-  free(b_size);
-  free(a_size);
+  for (i = 0; i < ref_halo->nsend; i++) {
+    node = ref_halo->send_local[i];
+    if (!ref_node_valid(ref_node, node) ||
+        ref_halo->send_global[i] != ref_node_global(ref_node, node) ||
+        !ref_node_owned(ref_node, node))
+      return REF_TRUE;
+  }
+
+  return REF_FALSE;
+}
+
+/* collective, ranks agree to rebuild when any of their plans is stale */
+static REF_STATUS ref_node_halo_current(REF_NODE ref_node) {
+  REF_BOOL stale;
+
+  stale = ref_node_halo_stale(ref_node);
+  RSS(ref_mpi_all_or(ref_node_mpi(ref_node), &stale), "agree");
+  if (stale) {
+    RSS(ref_node_halo_free(ref_node), "free stale");
+    RSS(ref_node_halo_build(ref_node), "build");
+  }
 
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_node_ghost_dbl(REF_NODE ref_node, REF_DBL *vector,
-                              REF_INT ldim) {
+REF_STATUS ref_node_ghost_int(REF_NODE ref_node, REF_INT *scalar) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT *a_size, *b_size;
-  REF_INT a_total, b_total;
-  REF_INT *a_global, *b_global;
-  REF_INT part, node;
-  REF_INT *a_next;
-  REF_DBL *a_vector, *b_vector;
-  REF_INT i, local;
+  REF_HALO ref_halo;
+  REF_INT *send_scalar, *recv_scalar;
+  REF_INT i;
 
   if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
 
-  ref_malloc_init(a_size, ref_mpi_n(ref_mpi), REF_INT, 0);
-  ref_malloc_init(b_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  RSS(ref_node_halo_current(ref_node), "halo plan");
+  ref_halo = ref_node->halo;
 
-  each_ref_node_valid_node(ref_node, node) if (ref_mpi_rank(ref_mpi) !=
-                                               ref_node_part(ref_node, node))
-      a_size[ref_node_part(ref_node, node)]++;
+  ref_malloc(send_scalar, ref_halo->nsend, REF_INT);
+  ref_malloc(recv_scalar, ref_halo->nrecv, REF_INT);
 
-  RSS(ref_mpi_alltoall(ref_mpi, a_size, b_size, REF_INT_TYPE),
-      "alltoall sizes");
+  for (i = 0; i < ref_halo->nsend; i++) {
+    send_scalar[i] = scalar[ref_halo->send_local[i]];
+  }
 
-  a_total = 0;
-  each_ref_mpi_part(ref_mpi, part) a_total += a_size[part];
-  ref_malloc(a_global, a_total, REF_INT);
-  ref_malloc(a_vector, ldim * a_total, REF_DBL);
+  RSS(ref_mpi_neighbor_alltoallv(ref_mpi, send_scalar, ref_halo->send_size,
+                                 recv_scalar, ref_halo->recv_size, 1,
+                                 REF_INT_TYPE),
+      "exchange");
+
+  for (i = 0; i < ref_halo->nrecv; i++) {
+    scalar[ref_halo->recv_local[i]] = recv_scalar[i];
+  }
 
-  b_total = 0;
-  each_ref_mpi_part(ref_mpi, part) b_total += b_size[part];
-  ref_malloc(b_global, b_total, REF_INT);
-  ref_malloc(b_vector, ldim * b_total, REF_DBL);
+  ref_free(recv_scalar);
+  ref_free(send_scalar);
 
-  ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
-  a_next[0] = 0;
-  each_ref_mpi_worker(ref_mpi, part) a_next[part] =
-      a_next[part - 1] + a_size[part - 1];
+  return REF_SUCCESS;
+}
 
-  each_ref_node_valid_node(ref_node, node) if (ref_mpi_rank(ref_mpi) !=
-                                               ref_node_part(ref_node, node)) {
-    part = ref_node_part(ref_node, node);
-    a_global[a_next[part]] = ref_node_global(ref_node, node);
-    a_next[ref_node_part(ref_node, node)]++;
+REF_STATUS ref_node_ghost_glob(REF_NODE ref_node, REF_GLOB *scalar) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_HALO ref_halo;
+  REF_GLOB *send_scalar, *recv_scalar;
+  REF_INT i;
+
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
+
+  RSS(ref_node_halo_current(ref_node), "halo plan");
+  ref_halo = ref_node->halo;
+
+  ref_malloc(send_scalar, ref_halo->nsend, REF_GLOB);
+  ref_malloc(recv_scalar, ref_halo->nrecv, REF_GLOB);
+
+  for (i = 0; i < ref_halo->nsend; i++) {
+    send_scalar[i] = scalar[ref_halo->send_local[i]];
   }
 
-  RSS(ref_mpi_alltoallv(ref_mpi, a_global, a_size, b_global, b_size, 1,
-                        REF_INT_TYPE),
-      "alltoallv global");
+  RSS(ref_mpi_neighbor_alltoallv(ref_mpi, send_scalar, ref_halo->send_size,
+                                 recv_scalar, ref_halo->recv_size, 1,
+                                 REF_GLOB_TYPE),
+      "exchange");
 
-  for (node = 0; node < b_total; node++) {
-    RSS(ref_node_local(ref_node, b_global[node], &local), "g2l");
-    for (i = 0; i < ldim; i++)
-      b_vector[i + ldim * node] = vector[i + ldim * local];
+  for (i = 0; i < ref_halo->nrecv; i++) {
+    scalar[ref_halo->recv_local[i]] = recv_scalar[i];
   }
 
-  RSS(ref_mpi_alltoallv(ref_mpi, b_vector, b_size, a_vector, a_size, ldim,
-                        REF_DBL_TYPE),
-      "alltoallv global");
+  ref_free(recv_scalar);
+  ref_free(send_scalar);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_node_ghost_dbl(REF_NODE ref_node, REF_DBL *vector,
+                              REF_INT ldim) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_HALO ref_halo;
+  REF_DBL *send_vector, *recv_vector;
+  REF_INT i, j;
+
+  if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
 
-  for (node = 0; node < a_total; node++) {
-    RSS(ref_node_local(ref_node, a_global[node], &local), "g2l");
-    for (i = 0; i < ldim; i++)
-      vector[i + ldim * local] = a_vector[i + ldim * node];
+  RSS(ref_node_halo_current(ref_node), "halo plan");
+  ref_halo = ref_node->halo;
+
+  ref_malloc(send_vector, ldim * ref_halo->nsend, REF_DBL);
+  ref_malloc(recv_vector, ldim * ref_halo->nrecv, REF_DBL);
+
+  for (i = 0; i < ref_halo->nsend; i++) {
+    for (j = 0; j < ldim; j++) {
+      send_vector[j + ldim * i] = vector[j + ldim * ref_halo->send_local[i]];
+    }
   }
 
-  free(a_next);
-  free(b_vector);
-  free(b_global);
-  free(a_vector);
-  free(a_global);
-  free(b_size);
-  free(a_size);
+  RSS(ref_mpi_neighbor_alltoallv(ref_mpi, send_vector, ref_halo->send_size,
+                                 recv_vector, ref_halo->recv_size, ldim,
+                                 REF_DBL_TYPE),
+      "exchange");
+
+  for (i = 0; i < ref_halo->nrecv; i++) {
+    for (j = 0; j < ldim; j++) {
+      vector[j + ldim * ref_halo->recv_local[i]] = recv_vector[j + ldim * i];
+    }
+  }
+
+  ref_free(recv_vector);
+  ref_free(send_vector);
 
   return REF_SUCCESS;
 }
@@ -856,6 +1038,73 @@ REF_STATUS ref_node_ratio(REF_NODE ref_node, REF_INT node0, REF_INT node1,
   return REF_SUCCESS;
 }
 
+#define REF_NODE_RATIO_BLOCK (256)
+REF_STATUS ref_node_ratio_many(REF_NODE ref_node, REF_INT n, REF_INT *e2n,
+                               REF_DBL *ratio) {
+  REF_DBL dx[REF_NODE_RATIO_BLOCK], dy[REF_NODE_RATIO_BLOCK];
+  REF_DBL dz[REF_NODE_RATIO_BLOCK], length[REF_NODE_RATIO_BLOCK];
+  REF_DBL ratio0[REF_NODE_RATIO_BLOCK], ratio1[REF_NODE_RATIO_BLOCK];
+  REF_DBL r_min[REF_NODE_RATIO_BLOCK], r[REF_NODE_RATIO_BLOCK];
+  REF_DBL log_mean[REF_NODE_RATIO_BLOCK];
+  REF_DBL *m0, *m1;
+  REF_INT first, nblock, i, node0, node1;
+
+  for (first = 0; first < n; first += REF_NODE_RATIO_BLOCK) {
+    nblock = MIN(REF_NODE_RATIO_BLOCK, n - first);
+
+    /* gather edge direction and v^T M v into structure of arrays */
+    for (i = 0; i < nblock; i++) {
+      node0 = e2n[0 + 2 * (first + i)];
+      node1 = e2n[1 + 2 * (first + i)];
+      if (!ref_node_valid(ref_node, node0) || !ref_node_valid(ref_node, node1))
+        RSS(REF_INVALID, "node invalid");
+      dx[i] =
+          ref_node_xyz(ref_node, 0, node1) - ref_node_xyz(ref_node, 0, node0);
+      dy[i] =
+          ref_node_xyz(ref_node, 1, node1) - ref_node_xyz(ref_node, 1, node0);
+      dz[i] =
+          ref_node_xyz(ref_node, 2, node1) - ref_node_xyz(ref_node, 2, node0);
+      m0 = ref_node_metric_ptr(ref_node, node0);
+      m1 = ref_node_metric_ptr(ref_node, node1);
+      ratio0[i] = dx[i] * (m0[0] * dx[i] + m0[1] * dy[i] + m0[2] * dz[i]) +
+                  dy[i] * (m0[1] * dx[i] + m0[3] * dy[i] + m0[4] * dz[i]) +
+                  dz[i] * (m0[2] * dx[i] + m0[4] * dy[i] + m0[5] * dz[i]);
+      ratio1[i] = dx[i] * (m1[0] * dx[i] + m1[1] * dy[i] + m1[2] * dz[i]) +
+                  dy[i] * (m1[1] * dx[i] + m1[3] * dy[i] + m1[4] * dz[i]) +
+                  dz[i] * (m1[2] * dx[i] + m1[4] * dy[i] + m1[5] * dz[i]);
+    }
+
+    /* straight line sqrt and log over the block, guarded for any edge */
+    for (i = 0; i < nblock; i++) {
+      length[i] = sqrt(dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i]);
+      ratio0[i] = sqrt(ratio0[i]);
+      ratio1[i] = sqrt(ratio1[i]);
+      r_min[i] = MIN(ratio0[i], ratio1[i]);
+      r[i] = r_min[i] / MAX(MAX(ratio0[i], ratio1[i]), 1.0e-12);
+      log_mean[i] = (r[i] > 0.0 && r[i] < 1.0 ? r[i] : 0.5);
+      log_mean[i] =
+          r_min[i] * (log_mean[i] - 1.0) / (log_mean[i] * log(log_mean[i]));
+    }
+
+    /* same special cases as ref_node_ratio */
+    for (i = 0; i < nblock; i++) {
+      if (!ref_math_divisible(dx[i], length[i]) ||
+          !ref_math_divisible(dy[i], length[i]) ||
+          !ref_math_divisible(dz[i], length[i])) {
+        ratio[first + i] = 0.0;
+      } else if (ratio0[i] < 1.0e-12 || ratio1[i] < 1.0e-12) {
+        ratio[first + i] = r_min[i];
+      } else if (ABS(r[i] - 1.0) < 1.0e-12) {
+        ratio[first + i] = 0.5 * (ratio0[i] + ratio1[i]);
+      } else {
+        ratio[first + i] = log_mean[i];
+      }
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_node_dratio_dnode0(REF_NODE ref_node, REF_INT node0,
                                   REF_INT node1, REF_DBL *ratio,
                                   REF_DBL *d_ratio) {
@@ -1762,7 +2011,8 @@ REF_STATUS ref_node_tet_dvol_dnode0(REF_NODE ref_node, REF_INT *nodes,
 REF_STATUS ref_node_twod_clone(REF_NODE ref_node, REF_INT original,
                                REF_INT *clone_ptr) {
   REF_DBL mid_plane = ref_node_twod_mid_plane(ref_node);
-  REF_INT global, clone;
+  REF_GLOB global;
+  REF_INT clone;
   REF_INT i;
 
   RSS(ref_node_next_global(ref_node, &global), "next global");
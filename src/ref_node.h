@@ -24,6 +24,8 @@
 BEGIN_C_DECLORATION
 typedef struct REF_NODE_STRUCT REF_NODE_STRUCT;
 typedef REF_NODE_STRUCT *REF_NODE;
+typedef struct REF_HALO_STRUCT REF_HALO_STRUCT;
+typedef REF_HALO_STRUCT *REF_HALO;
 END_C_DECLORATION
 
 #include "ref_list.h"
@@ -31,25 +33,36 @@ END_C_DECLORATION
 
 BEGIN_C_DECLORATION
 
+/* ghost exchange plan, send and recv lists are grouped by part */
+struct REF_HALO_STRUCT {
+  REF_INT *send_size, *recv_size;
+  REF_INT nsend, nrecv;
+  REF_INT *send_local, *recv_local;
+  REF_GLOB *send_global, *recv_global;
+};
+
 struct REF_NODE_STRUCT {
   REF_INT n, max;
   REF_INT blank;
-  REF_INT *global;
-  REF_INT *sorted_global;
-  REF_INT *sorted_local;
+  REF_GLOB *global;
+  REF_INT nhash; /* open addressing global to local index, power of two */
+  REF_GLOB *hash_global;
+  REF_INT *hash_local;
   REF_INT *part;
   REF_INT *age;
   REF_DBL *real;
   REF_INT naux;
   REF_DBL *aux;
   REF_MPI ref_mpi;
-  REF_LIST unused_global_list;
-  REF_INT old_n_global, new_n_global;
+  REF_INT n_unused, max_unused;
+  REF_GLOB *unused_global;
+  REF_GLOB old_n_global, new_n_global;
   REF_DBL twod_mid_plane;
   REF_DBL min_volume;
   REF_DBL min_uv_area;
   REF_INT tet_quality;
   REF_INT tri_quality;
+  REF_HALO halo;
 };
 
 #define REF_NODE_REAL_PER (9) /* x,y,z, m[6] */
@@ -113,28 +126,35 @@ REF_STATUS ref_node_pack(REF_NODE ref_node, REF_INT *o2n, REF_INT *n2o);
 
 REF_STATUS ref_node_inspect(REF_NODE ref_node);
 REF_STATUS ref_node_location(REF_NODE ref_node, REF_INT node);
-REF_STATUS ref_node_tattle_global(REF_NODE ref_node, REF_INT global);
+REF_STATUS ref_node_tattle_global(REF_NODE ref_node, REF_GLOB global);
 
-REF_STATUS ref_node_local(REF_NODE ref_node, REF_INT global, REF_INT *node);
+REF_STATUS ref_node_local(REF_NODE ref_node, REF_GLOB global, REF_INT *node);
 
-REF_STATUS ref_node_initialize_n_global(REF_NODE ref_node, REF_INT n_global);
-REF_STATUS ref_node_next_global(REF_NODE ref_node, REF_INT *global);
+REF_STATUS ref_node_initialize_n_global(REF_NODE ref_node, REF_GLOB n_global);
+REF_STATUS ref_node_next_global(REF_NODE ref_node, REF_GLOB *global);
 
 REF_STATUS ref_node_synchronize_globals(REF_NODE ref_node);
 REF_STATUS ref_node_shift_new_globals(REF_NODE ref_node);
 REF_STATUS ref_node_eliminate_unused_globals(REF_NODE ref_node);
 
-REF_STATUS ref_node_add(REF_NODE ref_node, REF_INT global, REF_INT *node);
-REF_STATUS ref_node_add_many(REF_NODE ref_node, REF_INT n, REF_INT *global);
+REF_STATUS ref_node_add(REF_NODE ref_node, REF_GLOB global, REF_INT *node);
+REF_STATUS ref_node_add_many(REF_NODE ref_node, REF_INT n, REF_GLOB *global);
+
+/* takes ownership of n malloc'd globals, parts and REF_NODE_REAL_PER
+ * reals per node, which are later grown in place */
+REF_STATUS ref_node_adopt(REF_NODE ref_node, REF_INT n, REF_GLOB *global,
+                          REF_INT *part, REF_DBL *real);
 
 REF_STATUS ref_node_remove(REF_NODE ref_node, REF_INT node);
 REF_STATUS ref_node_remove_without_global(REF_NODE ref_node, REF_INT node);
-REF_STATUS ref_node_rebuild_sorted_global(REF_NODE ref_node);
+REF_STATUS ref_node_rebuild_index(REF_NODE ref_node);
 
 REF_STATUS ref_node_compact(REF_NODE ref_node, REF_INT **o2n, REF_INT **n2o);
 
+/* reuse a cached plan, rebuilt collectively when any rank's ghosts change */
 REF_STATUS ref_node_ghost_real(REF_NODE ref_node);
 REF_STATUS ref_node_ghost_int(REF_NODE ref_node, REF_INT *scalar);
+REF_STATUS ref_node_ghost_glob(REF_NODE ref_node, REF_GLOB *scalar);
 REF_STATUS ref_node_ghost_dbl(REF_NODE ref_node, REF_DBL *vector, REF_INT ldim);
 
 REF_STATUS ref_node_edge_twod(REF_NODE ref_node, REF_INT node0, REF_INT node1,
@@ -144,6 +164,9 @@ REF_STATUS ref_node_node_twod(REF_NODE ref_node, REF_INT node, REF_BOOL *twod);
 
 REF_STATUS ref_node_ratio(REF_NODE ref_node, REF_INT node0, REF_INT node1,
                           REF_DBL *ratio);
+/* ratio of n edges given as node pairs, e2n[0 + 2 * i], e2n[1 + 2 * i] */
+REF_STATUS ref_node_ratio_many(REF_NODE ref_node, REF_INT n, REF_INT *e2n,
+                               REF_DBL *ratio);
 REF_STATUS ref_node_dratio_dnode0(REF_NODE ref_node, REF_INT node0,
                                   REF_INT node1, REF_DBL *ratio,
                                   REF_DBL *dratio_dnode0);
@@ -35,6 +35,68 @@ int main(int argc, char *argv[]) {
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "make mpi");
 
+  if (2 == argc) { /* global to local index benchmark vs sorted array */
+    REF_NODE ref_node;
+    REF_INT n, i, global, node, location, shift;
+    REF_INT *globals, *sorted_global, *sorted_local, nsorted;
+
+    n = atoi(argv[1]);
+    ref_malloc(globals, n, REF_INT);
+    /* scrambled but unique globals, like split and collapse generate */
+    for (i = 0; i < n; i++) globals[i] = (REF_INT)((7919L * (long)i) % n);
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    ref_mpi_stopwatch_start(ref_mpi);
+    for (i = 0; i < n; i++)
+      RSS(ref_node_add(ref_node, globals[i], &node), "add");
+    ref_mpi_stopwatch_stop(ref_mpi, "hash add");
+    for (i = 0; i < n; i++)
+      RSS(ref_node_local(ref_node, globals[i], &node), "local");
+    ref_mpi_stopwatch_stop(ref_mpi, "hash local");
+    for (i = 0; i < n; i += 2) RSS(ref_node_remove(ref_node, i), "remove");
+    ref_mpi_stopwatch_stop(ref_mpi, "hash remove");
+    RSS(ref_node_free(ref_node), "free");
+
+    ref_malloc(sorted_global, n, REF_INT);
+    ref_malloc(sorted_local, n, REF_INT);
+    nsorted = 0;
+    ref_mpi_stopwatch_start(ref_mpi);
+    for (i = 0; i < n; i++) {
+      global = globals[i];
+      location = nsorted;
+      while (location > 0 && sorted_global[location - 1] > global) location--;
+      for (shift = nsorted; shift > location; shift--) {
+        sorted_global[shift] = sorted_global[shift - 1];
+        sorted_local[shift] = sorted_local[shift - 1];
+      }
+      sorted_global[location] = global;
+      sorted_local[location] = i;
+      nsorted++;
+    }
+    ref_mpi_stopwatch_stop(ref_mpi, "sorted add");
+    for (i = 0; i < n; i++)
+      RSS(ref_sort_search(nsorted, sorted_global, globals[i], &location),
+          "search");
+    ref_mpi_stopwatch_stop(ref_mpi, "sorted local");
+    for (i = 0; i < n; i += 2) {
+      RSS(ref_sort_search(nsorted, sorted_global, globals[i], &location),
+          "search");
+      for (shift = location; shift < nsorted - 1; shift++) {
+        sorted_global[shift] = sorted_global[shift + 1];
+        sorted_local[shift] = sorted_local[shift + 1];
+      }
+      nsorted--;
+    }
+    ref_mpi_stopwatch_stop(ref_mpi, "sorted remove");
+    ref_free(sorted_local);
+    ref_free(sorted_global);
+
+    ref_free(globals);
+    RSS(ref_mpi_free(ref_mpi), "mpi free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   REIS(REF_NULL, ref_node_free(NULL), "dont free NULL");
 
   { /* init */
@@ -263,7 +325,7 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
-  { /* sorted_global rebuild */
+  { /* index rebuild */
     REF_INT global, node;
     REF_NODE ref_node;
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
@@ -284,7 +346,7 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_local(ref_node, 30, &node), "return global");
     REIS(2, node, "wrong local");
 
-    RSS(ref_node_rebuild_sorted_global(ref_node), "rebuild");
+    RSS(ref_node_rebuild_index(ref_node), "rebuild");
 
     RSS(ref_node_local(ref_node, 20, &node), "return global");
     REIS(0, node, "wrong local");
@@ -296,9 +358,34 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  { /* index survives scattered add and remove */
+    REF_INT n = 1000, i, global, node;
+    REF_NODE ref_node;
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+
+    for (i = 0; i < n; i++) {
+      global = (REF_INT)((7919L * (long)i) % n);
+      RSS(ref_node_add(ref_node, global, &node), "add");
+      REIS(i, node, "local in add order");
+    }
+    for (i = 0; i < n; i += 3) RSS(ref_node_remove(ref_node, i), "remove");
+    for (i = 0; i < n; i++) {
+      global = (REF_INT)((7919L * (long)i) % n);
+      if (0 == i % 3) {
+        REIS(REF_NOT_FOUND, ref_node_local(ref_node, global, &node),
+             "removed global found");
+      } else {
+        RSS(ref_node_local(ref_node, global, &node), "local");
+        REIS(i, node, "wrong local");
+      }
+    }
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
   { /* add many to empty */
     REF_INT n = 2, node;
-    REF_INT global[2];
+    REF_GLOB global[2];
     REF_NODE ref_node;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
@@ -320,7 +407,7 @@ int main(int argc, char *argv[]) {
 
   { /* add many to existing */
     REF_INT n = 2, node;
-    REF_INT global[2];
+    REF_GLOB global[2];
     REF_NODE ref_node;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
@@ -344,7 +431,7 @@ int main(int argc, char *argv[]) {
 
   { /* add many duplicates */
     REF_INT n = 2, node;
-    REF_INT global[2];
+    REF_GLOB global[2];
     REF_NODE ref_node;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
@@ -362,9 +449,43 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  { /* adopt arrays, then grow */
+    REF_NODE ref_node;
+    REF_GLOB *global;
+    REF_INT *part, node;
+    REF_DBL *real;
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    ref_malloc(global, 3, REF_GLOB);
+    ref_malloc(part, 3, REF_INT);
+    ref_malloc_init(real, 3 * REF_NODE_REAL_PER, REF_DBL, 0.0);
+    global[0] = 30;
+    global[1] = 10;
+    global[2] = 20;
+    for (node = 0; node < 3; node++) part[node] = ref_mpi_rank(ref_mpi);
+    real[0 + REF_NODE_REAL_PER * 2] = 2.0;
+
+    RSS(ref_node_adopt(ref_node, 3, global, part, real), "adopt");
+    REIS(3, ref_node_n(ref_node), "n");
+    RAS(real == ref_node_xyz_ptr(ref_node, 0), "not adopted in place");
+    RSS(ref_node_local(ref_node, 20, &node), "adopted global");
+    REIS(2, node, "wrong local");
+    RWDS(2.0, ref_node_xyz(ref_node, 0, node), -1.0, "x");
+
+    RSS(ref_node_add(ref_node, 40, &node), "grow");
+    REIS(3, node, "appended");
+    RSS(ref_node_local(ref_node, 30, &node), "kept global");
+    REIS(0, node, "wrong local");
+    REIS(REF_FAILURE, ref_node_adopt(ref_node, 3, global, part, real),
+         "adopt into a populated ref_node");
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
   { /* reuse removed global */
     REF_NODE ref_node;
-    REF_INT node, global;
+    REF_INT node;
+    REF_GLOB global, reused;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
 
@@ -373,14 +494,15 @@ int main(int argc, char *argv[]) {
 
     RSS(ref_node_remove(ref_node, node), "remove node");
 
-    RSS(ref_node_next_global(ref_node, &node), "next gloabal");
-    REIS(global, node, "not reused");
+    RSS(ref_node_next_global(ref_node, &reused), "next gloabal");
+    REIS(global, reused, "not reused");
 
     RSS(ref_node_free(ref_node), "free");
   }
 
   if (!ref_mpi_para(ref_mpi)) { /* shift globals */
-    REF_INT local, global, node;
+    REF_INT local, node;
+    REF_GLOB global;
     REF_NODE ref_node;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
@@ -461,6 +583,38 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  { /* ghost glob */
+    REF_NODE ref_node;
+    REF_INT local, ghost, global;
+    REF_GLOB data[2];
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+
+    global = ref_mpi_rank(ref_mpi);
+    RSS(ref_node_add(ref_node, global, &local), "add");
+    ref_node_part(ref_node, local) = global;
+    data[local] = REF_GLOB_MAX - ref_mpi_rank(ref_mpi);
+
+    global = ref_mpi_rank(ref_mpi) + 1;
+    if (global >= ref_mpi_n(ref_mpi)) global = 0;
+    if (ref_mpi_para(ref_mpi)) {
+      RSS(ref_node_add(ref_node, global, &ghost), "add");
+      ref_node_part(ref_node, ghost) = global;
+      data[ghost] = REF_EMPTY;
+    }
+
+    RSS(ref_node_ghost_glob(ref_node, data), "update ghosts");
+
+    global = ref_mpi_rank(ref_mpi);
+    REIS(REF_GLOB_MAX - global, data[local], "local changed");
+    if (ref_mpi_para(ref_mpi)) {
+      global = ref_mpi_rank(ref_mpi) + 1;
+      if (global >= ref_mpi_n(ref_mpi)) global = 0;
+      REIS(REF_GLOB_MAX - global, data[ghost], "ghost");
+    }
+    RSS(ref_node_free(ref_node), "free");
+  }
+
   { /* ghost dbl */
     REF_NODE ref_node;
     REF_INT local, ghost, global;
@@ -499,6 +653,45 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  if (ref_mpi_para(ref_mpi)) { /* ghost plan reused, rebuilt after remove */
+    REF_NODE ref_node;
+    REF_HALO ref_halo;
+    REF_INT local, ghost, global;
+    REF_INT data[2];
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+
+    global = ref_mpi_rank(ref_mpi);
+    RSS(ref_node_add(ref_node, global, &local), "add");
+    ref_node_part(ref_node, local) = global;
+    data[local] = global;
+
+    global = ref_mpi_rank(ref_mpi) + 1;
+    if (global >= ref_mpi_n(ref_mpi)) global = 0;
+    RSS(ref_node_add(ref_node, global, &ghost), "add");
+    ref_node_part(ref_node, ghost) = global;
+    data[ghost] = REF_EMPTY;
+
+    RSS(ref_node_ghost_int(ref_node, data), "update ghosts");
+    ref_halo = ref_node->halo;
+    RNS(ref_halo, "plan cached");
+    REIS(1, ref_halo->nsend, "send one");
+    REIS(1, ref_halo->nrecv, "recv one");
+    data[ghost] = REF_EMPTY;
+    RSS(ref_node_ghost_int(ref_node, data), "update ghosts");
+    RAS(ref_halo == ref_node->halo, "plan reused");
+    REIS(global, data[ghost], "ghost");
+
+    if (ref_mpi_once(ref_mpi)) RSS(ref_node_remove(ref_node, ghost), "rm");
+    RSS(ref_node_ghost_int(ref_node, data), "update ghosts");
+    if (1 == ref_mpi_rank(ref_mpi)) {
+      REIS(0, ref_node->halo->nsend, "rank 0 ghost removed");
+    }
+    REIS(ref_mpi_rank(ref_mpi), data[local], "local changed");
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
   { /* twod edge */
     REF_NODE ref_node;
     REF_INT node0, node1, global;
@@ -580,6 +773,38 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  { /* batch ratio matches one at a time */
+    REF_NODE ref_node;
+    REF_INT n = 300, node, i, e2n[600];
+    REF_DBL ratio, many[300];
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    for (i = 0; i < n; i++) {
+      RSS(ref_node_add(ref_node, i, &node), "add");
+      ref_node_xyz(ref_node, 0, node) = (REF_DBL)(i % 3);
+      ref_node_xyz(ref_node, 1, node) = 0.1 * (REF_DBL)(i % 5);
+      ref_node_xyz(ref_node, 2, node) = 0.01 * (REF_DBL)(i % 7);
+      ref_node_metric(ref_node, 0, node) = 1.0 + (REF_DBL)(i % 4);
+      ref_node_metric(ref_node, 1, node) = 0.0;
+      ref_node_metric(ref_node, 2, node) = 0.0;
+      ref_node_metric(ref_node, 3, node) = 1.0 + 100.0 * (REF_DBL)(i % 2);
+      ref_node_metric(ref_node, 4, node) = 0.0;
+      ref_node_metric(ref_node, 5, node) = (REF_DBL)(i % 9);
+    }
+    for (i = 0; i < n; i++) {
+      e2n[0 + 2 * i] = i;
+      e2n[1 + 2 * i] = (7 * i + i % 4) % n;
+    }
+    RSS(ref_node_ratio_many(ref_node, n, e2n, many), "many");
+    for (i = 0; i < n; i++) {
+      RSS(ref_node_ratio(ref_node, e2n[0 + 2 * i], e2n[1 + 2 * i], &ratio),
+          "ratio");
+      RAS(ratio == many[i], "batch ratio differs");
+    }
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
 #define FD_NODE0(xfuncx)                                         \
   {                                                              \
     REF_DBL f, d[3];                                             \
@@ -1415,7 +1640,8 @@ int main(int argc, char *argv[]) {
 
   { /* interpolate */
     REF_NODE ref_node;
-    REF_INT node0, node1, new_node, global;
+    REF_INT node0, node1, new_node;
+    REF_GLOB global;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
 
@@ -1473,7 +1699,8 @@ int main(int argc, char *argv[]) {
 
   { /* clone a twod node  */
     REF_NODE ref_node;
-    REF_INT node0, node1, global;
+    REF_INT node0, node1;
+    REF_GLOB global;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
 
@@ -1511,7 +1738,8 @@ int main(int argc, char *argv[]) {
 
   { /* interpolate aux */
     REF_NODE ref_node;
-    REF_INT node0, node1, new_node, global;
+    REF_INT node0, node1, new_node;
+    REF_GLOB global;
 
     RSS(ref_node_create(&ref_node, ref_mpi), "create");
 
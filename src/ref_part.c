@@ -35,13 +35,14 @@
 #include "ref_import.h"
 #include "ref_twod.h"
 
-static REF_STATUS ref_part_node(FILE *file, REF_BOOL swap_endian,
-                                REF_BOOL has_id, REF_NODE ref_node,
-                                REF_INT nnode) {
+static REF_STATUS ref_part_node(FILE *file, REF_INT version,
+                                REF_BOOL swap_endian, REF_BOOL has_id,
+                                REF_NODE ref_node, REF_GLOB nnode) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT node, new_node;
   REF_INT part;
-  REF_INT n, id;
+  REF_INT n;
+  REF_GLOB id;
   REF_DBL dbl;
   REF_DBL *xyz;
 
@@ -62,11 +63,11 @@ static REF_STATUS ref_part_node(FILE *file, REF_BOOL swap_endian,
       RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "z");
       if (swap_endian) SWAP_DBL(dbl);
       ref_node_xyz(ref_node, 2, new_node) = dbl;
-      if (has_id) REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+      if (has_id) RSS(ref_import_meshb_ints(file, version, 1, &id), "id");
     }
     each_ref_mpi_worker(ref_mpi, part) {
-      n = ref_part_first(nnode, ref_mpi_n(ref_mpi), part + 1) -
-          ref_part_first(nnode, ref_mpi_n(ref_mpi), part);
+      n = (REF_INT)(ref_part_first(nnode, ref_mpi_n(ref_mpi), part + 1) -
+                    ref_part_first(nnode, ref_mpi_n(ref_mpi), part));
       RSS(ref_mpi_send(ref_mpi, &n, 1, REF_INT_TYPE, part), "send");
       if (n > 0) {
         ref_malloc(xyz, 3 * n, REF_DBL);
@@ -80,7 +81,8 @@ static REF_STATUS ref_part_node(FILE *file, REF_BOOL swap_endian,
           RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "z");
           if (swap_endian) SWAP_DBL(dbl);
           xyz[2 + 3 * node] = dbl;
-          if (has_id) REIS(1, fread(&(id), sizeof(id), 1, file), "id");
+          if (has_id)
+            RSS(ref_import_meshb_ints(file, version, 1, &id), "id");
         }
         RSS(ref_mpi_send(ref_mpi, xyz, 3 * n, REF_DBL_TYPE, part), "send");
         free(xyz);
@@ -109,21 +111,24 @@ static REF_STATUS ref_part_node(FILE *file, REF_BOOL swap_endian,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_INT ngeom,
+static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_GLOB ngeom,
                                       REF_INT type, REF_NODE ref_node,
-                                      REF_INT nnode, FILE *file) {
+                                      REF_GLOB nnode, REF_INT version,
+                                      FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT end_of_message = REF_EMPTY;
   REF_INT chunk;
-  REF_INT *sent_node;
+  REF_GLOB *sent_node;
   REF_INT *sent_id;
   REF_DBL *sent_param;
-  REF_INT *read_node;
+  REF_GLOB *read_node;
   REF_INT *read_id;
   REF_DBL *read_param;
   REF_DBL filler;
+  REF_GLOB id;
 
-  REF_INT ngeom_read, ngeom_keep;
+  REF_GLOB ngeom_read;
+  REF_INT ngeom_keep;
   REF_INT section_size;
 
   REF_INT *dest;
@@ -136,27 +141,28 @@ static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_INT ngeom,
   REF_INT part, node;
   REF_INT new_location;
 
-  chunk = MAX(1000000, ngeom / ref_mpi_n(ref_mpi));
-  chunk = MIN(chunk, ngeom);
+  chunk = (REF_INT)MAX(1000000, ngeom / ref_mpi_n(ref_mpi));
+  chunk = (REF_INT)MIN(chunk, ngeom);
 
-  ref_malloc(sent_node, chunk, REF_INT);
+  ref_malloc(sent_node, chunk, REF_GLOB);
   ref_malloc(sent_id, chunk, REF_INT);
   ref_malloc(sent_param, 2 * chunk, REF_DBL);
 
   if (ref_mpi_once(ref_mpi)) {
     ref_malloc(geom_to_send, ref_mpi_n(ref_mpi), REF_INT);
     ref_malloc(start_to_send, ref_mpi_n(ref_mpi), REF_INT);
-    ref_malloc(read_node, chunk, REF_INT);
+    ref_malloc(read_node, chunk, REF_GLOB);
     ref_malloc(read_id, chunk, REF_INT);
     ref_malloc(read_param, 2 * chunk, REF_DBL);
     ref_malloc(dest, chunk, REF_INT);
 
     ngeom_read = 0;
     while (ngeom_read < ngeom) {
-      section_size = MIN(chunk, ngeom - ngeom_read);
+      section_size = (REF_INT)MIN(chunk, ngeom - ngeom_read);
       for (geom = 0; geom < section_size; geom++) {
-        REIS(1, fread(&(read_node[geom]), sizeof(REF_INT), 1, file), "n");
-        REIS(1, fread(&(read_id[geom]), sizeof(REF_INT), 1, file), "n");
+        RSS(ref_import_meshb_ints(file, version, 1, &(read_node[geom])), "n");
+        RSS(ref_import_meshb_ints(file, version, 1, &id), "id");
+        read_id[geom] = (REF_INT)id;
         for (i = 0; i < 2; i++)
           read_param[i + 2 * geom] = 0.0; /* ensure init */
         for (i = 0; i < type; i++)
@@ -170,8 +176,8 @@ static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_INT ngeom,
       ngeom_read += section_size;
 
       for (geom = 0; geom < section_size; geom++)
-        dest[geom] =
-            ref_part_implicit(nnode, ref_mpi_n(ref_mpi), read_node[geom]);
+        dest[geom] = (REF_INT)ref_part_implicit(nnode, ref_mpi_n(ref_mpi),
+                                                read_node[geom]);
 
       each_ref_mpi_part(ref_mpi, part) geom_to_send[part] = 0;
       for (geom = 0; geom < section_size; geom++) geom_to_send[dest[geom]]++;
@@ -204,7 +210,7 @@ static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_INT ngeom,
         RSS(ref_mpi_send(ref_mpi, &(geom_to_send[part]), 1, REF_INT_TYPE, part),
             "send");
         RSS(ref_mpi_send(ref_mpi, &(sent_node[start_to_send[part]]),
-                         geom_to_send[part], REF_INT_TYPE, part),
+                         geom_to_send[part], REF_GLOB_TYPE, part),
             "send");
         RSS(ref_mpi_send(ref_mpi, &(sent_id[start_to_send[part]]),
                          geom_to_send[part], REF_INT_TYPE, part),
@@ -230,7 +236,8 @@ static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_INT ngeom,
     do {
       RSS(ref_mpi_recv(ref_mpi, &geom_to_receive, 1, REF_INT_TYPE, 0), "recv");
       if (geom_to_receive > 0) {
-        RSS(ref_mpi_recv(ref_mpi, sent_node, geom_to_receive, REF_INT_TYPE, 0),
+        RSS(ref_mpi_recv(ref_mpi, sent_node, geom_to_receive, REF_GLOB_TYPE,
+                         0),
             "send");
         RSS(ref_mpi_recv(ref_mpi, sent_id, geom_to_receive, REF_INT_TYPE, 0),
             "send");
@@ -254,36 +261,39 @@ static REF_STATUS ref_part_meshb_geom(REF_GEOM ref_geom, REF_INT ngeom,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_part_meshb_geom_bcast(REF_GEOM ref_geom, REF_INT ngeom,
-                                            REF_INT type, REF_NODE ref_node,
+static REF_STATUS ref_part_meshb_geom_bcast(REF_GEOM ref_geom,
+                                            REF_GLOB ngeom, REF_INT type,
+                                            REF_NODE ref_node, REF_INT version,
                                             FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
-  REF_INT *read_node;
+  REF_GLOB *read_node;
   REF_INT *read_id;
   REF_DBL *read_param;
   REF_DBL filler;
+  REF_GLOB id;
 
-  REF_INT ngeom_read;
+  REF_GLOB ngeom_read;
   REF_INT section_size;
 
   REF_INT geom;
   REF_INT i, local;
 
-  chunk = MAX(1000000, ngeom / ref_mpi_n(ref_mpi));
-  chunk = MIN(chunk, ngeom);
+  chunk = (REF_INT)MAX(1000000, ngeom / ref_mpi_n(ref_mpi));
+  chunk = (REF_INT)MIN(chunk, ngeom);
 
-  ref_malloc(read_node, chunk, REF_INT);
+  ref_malloc(read_node, chunk, REF_GLOB);
   ref_malloc(read_id, chunk, REF_INT);
   ref_malloc(read_param, 2 * chunk, REF_DBL);
 
   ngeom_read = 0;
   while (ngeom_read < ngeom) {
-    section_size = MIN(chunk, ngeom - ngeom_read);
+    section_size = (REF_INT)MIN(chunk, ngeom - ngeom_read);
     if (ref_mpi_once(ref_mpi)) {
       for (geom = 0; geom < section_size; geom++) {
-        REIS(1, fread(&(read_node[geom]), sizeof(REF_INT), 1, file), "n");
-        REIS(1, fread(&(read_id[geom]), sizeof(REF_INT), 1, file), "n");
+        RSS(ref_import_meshb_ints(file, version, 1, &(read_node[geom])), "n");
+        RSS(ref_import_meshb_ints(file, version, 1, &id), "id");
+        read_id[geom] = (REF_INT)id;
         for (i = 0; i < 2; i++)
           read_param[i + 2 * geom] = 0.0; /* ensure init */
         for (i = 0; i < type; i++)
@@ -294,7 +304,7 @@ static REF_STATUS ref_part_meshb_geom_bcast(REF_GEOM ref_geom, REF_INT ngeom,
       }
       for (geom = 0; geom < section_size; geom++) read_node[geom]--;
     }
-    RSS(ref_mpi_bcast(ref_mpi, read_node, section_size, REF_INT_TYPE), "nd");
+    RSS(ref_mpi_bcast(ref_mpi, read_node, section_size, REF_GLOB_TYPE), "nd");
     RSS(ref_mpi_bcast(ref_mpi, read_id, section_size, REF_INT_TYPE), "id");
     RSS(ref_mpi_bcast(ref_mpi, read_param, 2 * section_size, REF_DBL_TYPE),
         "pm");
@@ -317,17 +327,17 @@ static REF_STATUS ref_part_meshb_geom_bcast(REF_GEOM ref_geom, REF_INT ngeom,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
-                                      REF_NODE ref_node, REF_INT nnode,
-                                      FILE *file) {
+static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_GLOB ncell,
+                                      REF_NODE ref_node, REF_GLOB nnode,
+                                      REF_INT version, FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT ncell_read;
+  REF_GLOB ncell_read;
   REF_INT chunk;
   REF_INT end_of_message = REF_EMPTY;
   REF_INT elements_to_receive;
-  REF_INT *c2n;
-  REF_INT *c2t;
-  REF_INT *sent_c2n;
+  REF_GLOB *c2n;
+  REF_GLOB *c2t;
+  REF_GLOB *sent_c2n;
   REF_INT *dest;
   REF_INT *sent_part;
   REF_INT *elements_to_send;
@@ -339,33 +349,33 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
   REF_INT ncell_keep;
   REF_INT new_location;
 
-  chunk = MAX(1000000, ncell / ref_mpi_n(ref_mpi));
+  chunk = (REF_INT)MAX(1000000, ncell / ref_mpi_n(ref_mpi));
 
   size_per = ref_cell_size_per(ref_cell);
   node_per = ref_cell_node_per(ref_cell);
 
-  ref_malloc(sent_c2n, size_per * chunk, REF_INT);
+  ref_malloc(sent_c2n, size_per * chunk, REF_GLOB);
 
   if (ref_mpi_once(ref_mpi)) {
     ref_malloc(elements_to_send, ref_mpi_n(ref_mpi), REF_INT);
     ref_malloc(start_to_send, ref_mpi_n(ref_mpi), REF_INT);
-    ref_malloc(c2n, size_per * chunk, REF_INT);
-    ref_malloc(c2t, (node_per + 1) * chunk, REF_INT);
+    ref_malloc(c2n, size_per * chunk, REF_GLOB);
+    ref_malloc(c2t, (node_per + 1) * chunk, REF_GLOB);
     ref_malloc(dest, chunk, REF_INT);
 
     ncell_read = 0;
     while (ncell_read < ncell) {
-      section_size = MIN(chunk, ncell - ncell_read);
+      section_size = (REF_INT)MIN(chunk, ncell - ncell_read);
       if (node_per == size_per) {
-        RES((size_t)(section_size * (node_per + 1)),
-            fread(c2t, sizeof(REF_INT), section_size * (node_per + 1), file),
+        RSS(ref_import_meshb_ints(file, version, section_size * (node_per + 1),
+                                  c2t),
             "cn");
         for (cell = 0; cell < section_size; cell++)
           for (node = 0; node < node_per; node++)
             c2n[node + size_per * cell] = c2t[node + (node_per + 1) * cell];
       } else {
-        RES((size_t)(section_size * size_per),
-            fread(c2n, sizeof(REF_INT), section_size * size_per, file), "cn");
+        RSS(ref_import_meshb_ints(file, version, section_size * size_per, c2n),
+            "cn");
       }
       for (cell = 0; cell < section_size; cell++)
         for (node = 0; node < node_per; node++) c2n[node + size_per * cell]--;
@@ -373,8 +383,8 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
       ncell_read += section_size;
 
       for (cell = 0; cell < section_size; cell++)
-        dest[cell] =
-            ref_part_implicit(nnode, ref_mpi_n(ref_mpi), c2n[size_per * cell]);
+        dest[cell] = (REF_INT)ref_part_implicit(nnode, ref_mpi_n(ref_mpi),
+                                                c2n[size_per * cell]);
 
       each_ref_mpi_part(ref_mpi, part) elements_to_send[part] = 0;
       for (cell = 0; cell < section_size; cell++)
@@ -401,7 +411,7 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
 
         for (cell = 0; cell < ncell_keep; cell++)
           for (node = 0; node < node_per; node++)
-            sent_part[node + size_per * cell] = ref_part_implicit(
+            sent_part[node + size_per * cell] = (REF_INT)ref_part_implicit(
                 nnode, ref_mpi_n(ref_mpi), sent_c2n[node + size_per * cell]);
 
         RSS(ref_cell_add_many_global(ref_cell, ref_node, ncell_keep, sent_c2n,
@@ -416,7 +426,8 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
                          part),
             "send");
         RSS(ref_mpi_send(ref_mpi, &(sent_c2n[size_per * start_to_send[part]]),
-                         size_per * elements_to_send[part], REF_INT_TYPE, part),
+                         size_per * elements_to_send[part], REF_GLOB_TYPE,
+                         part),
             "send");
       }
     }
@@ -437,7 +448,7 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
           "recv");
       if (elements_to_receive > 0) {
         RSS(ref_mpi_recv(ref_mpi, sent_c2n, size_per * elements_to_receive,
-                         REF_INT_TYPE, 0),
+                         REF_GLOB_TYPE, 0),
             "send");
 
         ref_malloc_init(sent_part, size_per * elements_to_receive, REF_INT,
@@ -445,7 +456,7 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
 
         for (cell = 0; cell < elements_to_receive; cell++)
           for (node = 0; node < node_per; node++)
-            sent_part[node + size_per * cell] = ref_part_implicit(
+            sent_part[node + size_per * cell] = (REF_INT)ref_part_implicit(
                 nnode, ref_mpi_n(ref_mpi), sent_c2n[node + size_per * cell]);
 
         RSS(ref_cell_add_many_global(ref_cell, ref_node, elements_to_receive,
@@ -465,47 +476,48 @@ static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_INT ncell,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell, REF_INT ncell,
-                                            REF_NODE ref_node, FILE *file) {
+static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell,
+                                            REF_GLOB ncell, REF_NODE ref_node,
+                                            REF_INT version, FILE *file) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_INT ncell_read;
+  REF_GLOB ncell_read;
   REF_INT chunk;
   REF_INT section_size;
-  REF_INT *c2n;
-  REF_INT *c2t;
+  REF_GLOB *c2n;
+  REF_GLOB *c2t;
   REF_INT node_per, size_per;
   REF_INT cell, node, local, new_cell;
   REF_BOOL have_all_nodes, one_node_local;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
 
-  chunk = MAX(1000000, ncell / ref_mpi_n(ref_mpi));
+  chunk = (REF_INT)MAX(1000000, ncell / ref_mpi_n(ref_mpi));
 
   size_per = ref_cell_size_per(ref_cell);
   node_per = ref_cell_node_per(ref_cell);
 
-  ref_malloc(c2n, size_per * chunk, REF_INT);
+  ref_malloc(c2n, size_per * chunk, REF_GLOB);
 
   ncell_read = 0;
   while (ncell_read < ncell) {
-    section_size = MIN(chunk, ncell - ncell_read);
+    section_size = (REF_INT)MIN(chunk, ncell - ncell_read);
     if (ref_mpi_once(ref_mpi)) {
       if (node_per == size_per) {
-        ref_malloc(c2t, (node_per + 1) * section_size, REF_INT);
-        RES((size_t)(section_size * (node_per + 1)),
-            fread(c2t, sizeof(REF_INT), section_size * (node_per + 1), file),
+        ref_malloc(c2t, (node_per + 1) * section_size, REF_GLOB);
+        RSS(ref_import_meshb_ints(file, version, section_size * (node_per + 1),
+                                  c2t),
             "cn");
         for (cell = 0; cell < section_size; cell++)
           for (node = 0; node < node_per; node++)
             c2n[node + size_per * cell] = c2t[node + (node_per + 1) * cell];
         ref_free(c2t);
       } else {
-        RES((size_t)(section_size * size_per),
-            fread(c2n, sizeof(REF_INT), section_size * size_per, file), "cn");
+        RSS(ref_import_meshb_ints(file, version, section_size * size_per, c2n),
+            "cn");
       }
       for (cell = 0; cell < section_size; cell++)
         for (node = 0; node < node_per; node++) c2n[node + size_per * cell]--;
     }
-    RSS(ref_mpi_bcast(ref_mpi, c2n, size_per * section_size, REF_INT_TYPE),
+    RSS(ref_mpi_bcast(ref_mpi, c2n, size_per * section_size, REF_GLOB_TYPE),
         "broadcast read c2n");
 
     /* convert to local nodes and add if local */
@@ -523,7 +535,7 @@ static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell, REF_INT ncell,
       }
       if (have_all_nodes) {
         if (node_per != size_per)
-          nodes[node_per] = c2n[node_per + size_per * cell];
+          nodes[node_per] = (REF_INT)c2n[node_per + size_per * cell];
         one_node_local = REF_FALSE;
         for (node = 0; node < node_per; node++) {
           one_node_local =
@@ -542,8 +554,8 @@ static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell, REF_INT ncell,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
-                                 const char *filename) {
+REF_STATUS ref_part_meshb_once(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
+                               const char *filename) {
   REF_BOOL verbose = REF_FALSE;
   REF_INT version, dim;
   REF_BOOL available;
@@ -555,8 +567,8 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
   FILE *file;
   REF_BOOL swap_endian = REF_FALSE;
   REF_BOOL has_id = REF_TRUE;
-  REF_INT nnode, ncell;
-  REF_INT type, geom_keyword, ngeom;
+  REF_GLOB nnode, ncell, ngeom, cad_data_size;
+  REF_INT type, geom_keyword;
   REF_INT cad_data_keyword;
 
   file = NULL;
@@ -586,11 +598,12 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                               &next_position),
         "jump");
     RAS(available, "meshb missing vertex");
-    REIS(1, fread((unsigned char *)&nnode, 4, 1, file), "nnode");
-    if (verbose) printf("nnode %d\n", nnode);
+    RSS(ref_import_meshb_ints(file, version, 1, &nnode), "nnode");
+    if (verbose) printf("nnode " REF_GLOB_FMT "\n", nnode);
   }
-  RSS(ref_mpi_bcast(ref_mpi, &nnode, 1, REF_INT_TYPE), "bcast");
-  RSS(ref_part_node(file, swap_endian, has_id, ref_node, nnode), "part node");
+  RSS(ref_mpi_bcast(ref_mpi, &nnode, 1, REF_GLOB_TYPE), "bcast");
+  RSS(ref_part_node(file, version, swap_endian, has_id, ref_node, nnode),
+      "part node");
   if (ref_grid_once(ref_grid))
     REIS(next_position, ftello(file), "end location");
 
@@ -599,15 +612,15 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                               &next_position),
         "jump");
     if (available) {
-      REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "ntet");
-      if (verbose) printf("ntet %d\n", ncell);
+      RSS(ref_import_meshb_ints(file, version, 1, &ncell), "ntet");
+      if (verbose) printf("ntet " REF_GLOB_FMT "\n", ncell);
     }
   }
   RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
   if (available) {
-    RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_INT_TYPE), "bcast");
+    RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_GLOB_TYPE), "bcast");
     RSS(ref_part_meshb_cell(ref_grid_tet(ref_grid), ncell, ref_node, nnode,
-                            file),
+                            version, file),
         "part cell");
     if (ref_grid_once(ref_grid))
       REIS(next_position, ftello(file), "end location");
@@ -618,15 +631,15 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                               &next_position),
         "jump");
     if (available) {
-      REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "ntri");
-      if (verbose) printf("ntri %d\n", ncell);
+      RSS(ref_import_meshb_ints(file, version, 1, &ncell), "ntri");
+      if (verbose) printf("ntri " REF_GLOB_FMT "\n", ncell);
     }
   }
   RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
   if (available) {
-    RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_INT_TYPE), "bcast");
+    RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_GLOB_TYPE), "bcast");
     RSS(ref_part_meshb_cell(ref_grid_tri(ref_grid), ncell, ref_node, nnode,
-                            file),
+                            version, file),
         "part cell");
     if (ref_grid_once(ref_grid))
       REIS(next_position, ftello(file), "end location");
@@ -637,15 +650,15 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                               &next_position),
         "jump");
     if (available) {
-      REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "nedge");
-      if (verbose) printf("nedge %d\n", ncell);
+      RSS(ref_import_meshb_ints(file, version, 1, &ncell), "nedge");
+      if (verbose) printf("nedge " REF_GLOB_FMT "\n", ncell);
     }
   }
   RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
   if (available) {
-    RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_INT_TYPE), "bcast");
+    RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_GLOB_TYPE), "bcast");
     RSS(ref_part_meshb_cell(ref_grid_edg(ref_grid), ncell, ref_node, nnode,
-                            file),
+                            version, file),
         "part cell");
     if (ref_grid_once(ref_grid))
       REIS(next_position, ftello(file), "end location");
@@ -658,14 +671,15 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                                 &available, &next_position),
           "jump");
       if (available) {
-        REIS(1, fread((unsigned char *)&ngeom, 4, 1, file), "ngeom");
-        if (verbose) printf("type %d ngeom %d\n", type, ngeom);
+        RSS(ref_import_meshb_ints(file, version, 1, &ngeom), "ngeom");
+        if (verbose) printf("type %d ngeom " REF_GLOB_FMT "\n", type, ngeom);
       }
     }
     RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
     if (available) {
-      RSS(ref_mpi_bcast(ref_mpi, &ngeom, 1, REF_INT_TYPE), "bcast");
-      RSS(ref_part_meshb_geom(ref_geom, ngeom, type, ref_node, nnode, file),
+      RSS(ref_mpi_bcast(ref_mpi, &ngeom, 1, REF_GLOB_TYPE), "bcast");
+      RSS(ref_part_meshb_geom(ref_geom, ngeom, type, ref_node, nnode, version,
+                              file),
           "part geom");
       if (ref_grid_once(ref_grid))
         REIS(next_position, ftello(file), "end location");
@@ -678,10 +692,10 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
                               &available, &next_position),
         "jump");
     if (available) {
-      REIS(
-          1,
-          fread((unsigned char *)&ref_geom_cad_data_size(ref_geom), 4, 1, file),
+      RSS(ref_import_meshb_ints(file, version, 1, &cad_data_size),
           "cad_data_size");
+      RAS(cad_data_size <= REF_INT_MAX, "cad_data_size exceeds int");
+      ref_geom_cad_data_size(ref_geom) = (REF_INT)cad_data_size;
       if (verbose)
         printf("cad_data_size %d\n", ref_geom_cad_data_size(ref_geom));
       /* safe non-NULL free, if already allocated, to prevent mem leaks */
@@ -721,6 +735,293 @@ static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_part_meshb_slice_node(FILE *file, REF_INT version,
+                                            REF_FILEPOS start,
+                                            REF_NODE ref_node, REF_GLOB nnode) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_GLOB first, last, global, id;
+  REF_INT ixyz, new_node;
+  REF_DBL dbl;
+  REF_FILEPOS record = 3 * sizeof(REF_DBL) + (4 == version ? 8 : 4);
+
+  RSS(ref_node_initialize_n_global(ref_node, nnode), "init nnodesg");
+
+  first = ref_part_first(nnode, ref_mpi_n(ref_mpi), ref_mpi_rank(ref_mpi));
+  last = ref_part_first(nnode, ref_mpi_n(ref_mpi), ref_mpi_rank(ref_mpi) + 1);
+
+  REIS(0, fseeko(file, start + (REF_FILEPOS)first * record, SEEK_SET),
+       "seek node slice");
+  for (global = first; global < last; global++) {
+    RSS(ref_node_add(ref_node, global, &new_node), "new_node");
+    ref_node_part(ref_node, new_node) = ref_mpi_rank(ref_mpi);
+    for (ixyz = 0; ixyz < 3; ixyz++) {
+      RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "xyz");
+      ref_node_xyz(ref_node, ixyz, new_node) = dbl;
+    }
+    RSS(ref_import_meshb_ints(file, version, 1, &id), "id");
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_part_meshb_slice_cell(REF_CELL ref_cell, REF_GLOB ncell,
+                                            REF_NODE ref_node, REF_GLOB nnode,
+                                            REF_INT version, FILE *file,
+                                            REF_FILEPOS start) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_GLOB first, last;
+  REF_INT nread;
+  REF_INT node_per, size_per;
+  REF_INT cell, node;
+  REF_GLOB *c2t, *c2n, *recv_c2n;
+  REF_INT *dest, *recv_part;
+  REF_INT nrecv;
+  REF_FILEPOS int_size = (4 == version ? 8 : 4);
+
+  size_per = ref_cell_size_per(ref_cell);
+  node_per = ref_cell_node_per(ref_cell);
+
+  first = ref_part_first(ncell, ref_mpi_n(ref_mpi), ref_mpi_rank(ref_mpi));
+  last = ref_part_first(ncell, ref_mpi_n(ref_mpi), ref_mpi_rank(ref_mpi) + 1);
+  nread = (REF_INT)(last - first);
+
+  ref_malloc(c2t, (node_per + 1) * nread, REF_GLOB);
+  ref_malloc(c2n, size_per * nread, REF_GLOB);
+  ref_malloc(dest, nread, REF_INT);
+
+  if (0 < nread) {
+    REIS(0,
+         fseeko(file,
+                start + (REF_FILEPOS)first * (REF_FILEPOS)(node_per + 1) *
+                            int_size,
+                SEEK_SET),
+         "seek cell slice");
+    RSS(ref_import_meshb_ints(file, version, nread * (node_per + 1), c2t),
+        "cn");
+  }
+  for (cell = 0; cell < nread; cell++) {
+    for (node = 0; node < size_per; node++)
+      c2n[node + size_per * cell] = c2t[node + (node_per + 1) * cell];
+    for (node = 0; node < node_per; node++) c2n[node + size_per * cell]--;
+    dest[cell] = (REF_INT)ref_part_implicit(nnode, ref_mpi_n(ref_mpi),
+                                            c2n[size_per * cell]);
+  }
+  ref_free(c2t);
+
+  RSS(ref_mpi_blindsend(ref_mpi, dest, c2n, size_per, nread,
+                        (void **)(&recv_c2n), &nrecv, REF_GLOB_TYPE),
+      "blind send cells");
+  ref_free(dest);
+  ref_free(c2n);
+
+  ref_malloc_init(recv_part, size_per * nrecv, REF_INT, REF_EMPTY);
+  for (cell = 0; cell < nrecv; cell++)
+    for (node = 0; node < node_per; node++)
+      recv_part[node + size_per * cell] = (REF_INT)ref_part_implicit(
+          nnode, ref_mpi_n(ref_mpi), recv_c2n[node + size_per * cell]);
+
+  RSS(ref_cell_add_many_global(ref_cell, ref_node, nrecv, recv_c2n, recv_part,
+                               ref_mpi_rank(ref_mpi)),
+      "many glob");
+
+  ref_free(recv_part);
+  ref_free(recv_c2n);
+
+  RSS(ref_migrate_shufflin_cell(ref_node, ref_cell), "fill ghosts");
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_part_meshb_slice_geom(REF_GEOM ref_geom, REF_GLOB ngeom,
+                                            REF_INT type, REF_NODE ref_node,
+                                            REF_GLOB nnode, REF_INT version,
+                                            FILE *file, REF_FILEPOS start) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_GLOB first, last;
+  REF_INT nread;
+  REF_INT geom, i, node;
+  REF_GLOB *node_id;
+  REF_INT *dest;
+  REF_DBL *param;
+  REF_GLOB *recv_node_id;
+  REF_DBL *recv_param;
+  REF_INT nrecv;
+  REF_DBL filler;
+  REF_FILEPOS record;
+
+  record = 2 * (4 == version ? 8 : 4) + type * sizeof(REF_DBL);
+  if (0 < type) record += sizeof(REF_DBL);
+
+  first = ref_part_first(ngeom, ref_mpi_n(ref_mpi), ref_mpi_rank(ref_mpi));
+  last = ref_part_first(ngeom, ref_mpi_n(ref_mpi), ref_mpi_rank(ref_mpi) + 1);
+  nread = (REF_INT)(last - first);
+
+  ref_malloc(node_id, 2 * nread, REF_GLOB);
+  ref_malloc_init(param, 2 * nread, REF_DBL, 0.0);
+  ref_malloc(dest, nread, REF_INT);
+
+  REIS(0, fseeko(file, start + (REF_FILEPOS)first * record, SEEK_SET),
+       "seek geom slice");
+  for (geom = 0; geom < nread; geom++) {
+    RSS(ref_import_meshb_ints(file, version, 1, &(node_id[0 + 2 * geom])),
+        "n");
+    RSS(ref_import_meshb_ints(file, version, 1, &(node_id[1 + 2 * geom])),
+        "id");
+    for (i = 0; i < type; i++)
+      REIS(1, fread(&(param[i + 2 * geom]), sizeof(REF_DBL), 1, file),
+           "param");
+    if (0 < type) REIS(1, fread(&(filler), sizeof(REF_DBL), 1, file), "fill");
+    node_id[0 + 2 * geom]--;
+    dest[geom] = (REF_INT)ref_part_implicit(nnode, ref_mpi_n(ref_mpi),
+                                            node_id[0 + 2 * geom]);
+  }
+
+  /* blindsend is stable, so both arrays arrive in the same order */
+  RSS(ref_mpi_blindsend(ref_mpi, dest, node_id, 2, nread,
+                        (void **)(&recv_node_id), &nrecv, REF_GLOB_TYPE),
+      "blind send node id");
+  RSS(ref_mpi_blindsend(ref_mpi, dest, param, 2, nread, (void **)(&recv_param),
+                        &nrecv, REF_DBL_TYPE),
+      "blind send param");
+
+  for (geom = 0; geom < nrecv; geom++) {
+    RSS(ref_node_local(ref_node, recv_node_id[0 + 2 * geom], &node), "g2l");
+    RSS(ref_geom_add(ref_geom, node, type,
+                     (REF_INT)recv_node_id[1 + 2 * geom],
+                     &(recv_param[2 * geom])),
+        "add geom");
+  }
+
+  ref_free(recv_param);
+  ref_free(recv_node_id);
+  ref_free(dest);
+  ref_free(param);
+  ref_free(node_id);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_part_meshb_slice(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
+                                const char *filename) {
+  REF_INT version, dim;
+  REF_BOOL available;
+  REF_FILEPOS next_position;
+  REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
+  REF_GRID ref_grid;
+  REF_NODE ref_node;
+  REF_GEOM ref_geom;
+  FILE *file;
+  REF_GLOB nnode, ncell, ngeom, cad_data_size;
+  REF_FILEPOS int_size;
+  REF_INT type, geom_keyword;
+  REF_INT cad_data_keyword;
+  REF_INT cell_keyword[3] = {8, 6, 5}; /* tet, tri, edge */
+  REF_CELL cell_of_keyword[3];
+  REF_INT i;
+
+  /* only rank 0 walks the keyword chain, then every rank seeks directly */
+  if (ref_mpi_once(ref_mpi))
+    RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+  RSS(ref_mpi_bcast(ref_mpi, &version, 1, REF_INT_TYPE), "bcast");
+  int_size = (4 == version ? 8 : 4);
+  RSS(ref_mpi_bcast(ref_mpi, key_pos, (REF_INT)sizeof(key_pos),
+                    REF_BYTE_TYPE),
+      "bcast");
+
+  file = fopen(filename, "r");
+  if (NULL == (void *)file) printf("unable to open %s\n", filename);
+  RNS(file, "unable to open file");
+
+  RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+                            &next_position),
+      "jump");
+  RAS(available, "meshb missing dimension");
+  REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+  REIS(3, dim, "only 3D supported");
+
+  RSS(ref_grid_create(ref_grid_ptr, ref_mpi), "create grid");
+  ref_grid = *ref_grid_ptr;
+  ref_node = ref_grid_node(ref_grid);
+  ref_geom = ref_grid_geom(ref_grid);
+  ref_grid_twod(ref_grid) = REF_FALSE;
+
+  RSS(ref_import_meshb_jump(file, version, key_pos, 4, &available,
+                            &next_position),
+      "jump");
+  RAS(available, "meshb missing vertex");
+  RSS(ref_import_meshb_ints(file, version, 1, &nnode), "nnode");
+  REIS(next_position,
+       ftello(file) + (REF_FILEPOS)nnode *
+                          ((REF_FILEPOS)(3 * sizeof(REF_DBL)) + int_size),
+       "vertex end location");
+  RSS(ref_part_meshb_slice_node(file, version, ftello(file), ref_node, nnode),
+      "part node");
+
+  cell_of_keyword[0] = ref_grid_tet(ref_grid);
+  cell_of_keyword[1] = ref_grid_tri(ref_grid);
+  cell_of_keyword[2] = ref_grid_edg(ref_grid);
+  for (i = 0; i < 3; i++) {
+    RSS(ref_import_meshb_jump(file, version, key_pos, cell_keyword[i],
+                              &available, &next_position),
+        "jump");
+    if (available) {
+      RSS(ref_import_meshb_ints(file, version, 1, &ncell), "ncell");
+      REIS(next_position,
+           ftello(file) +
+               (REF_FILEPOS)ncell *
+                   (REF_FILEPOS)(ref_cell_node_per(cell_of_keyword[i]) + 1) *
+                   int_size,
+           "cell end location");
+      RSS(ref_part_meshb_slice_cell(cell_of_keyword[i], ncell, ref_node, nnode,
+                                    version, file, ftello(file)),
+          "part cell");
+    }
+  }
+
+  each_ref_type(ref_geom, type) {
+    geom_keyword = 40 + type;
+    RSS(ref_import_meshb_jump(file, version, key_pos, geom_keyword, &available,
+                              &next_position),
+        "jump");
+    if (available) {
+      RSS(ref_import_meshb_ints(file, version, 1, &ngeom), "ngeom");
+      RSS(ref_part_meshb_slice_geom(ref_geom, ngeom, type, ref_node, nnode,
+                                    version, file, ftello(file)),
+          "part geom");
+    }
+  }
+
+  cad_data_keyword = 126; /* GmfByteFlow */
+  RSS(ref_import_meshb_jump(file, version, key_pos, cad_data_keyword,
+                            &available, &next_position),
+      "jump");
+  if (available) {
+    RSS(ref_import_meshb_ints(file, version, 1, &cad_data_size),
+        "cad_data_size");
+    RAS(cad_data_size <= REF_INT_MAX, "cad_data_size exceeds int");
+    ref_geom_cad_data_size(ref_geom) = (REF_INT)cad_data_size;
+    /* safe non-NULL free, if already allocated, to prevent mem leaks */
+    ref_free(ref_geom_cad_data(ref_geom));
+    ref_malloc(ref_geom_cad_data(ref_geom), ref_geom_cad_data_size(ref_geom),
+               REF_BYTE);
+    REIS(ref_geom_cad_data_size(ref_geom),
+         fread(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
+               ref_geom_cad_data_size(ref_geom), file),
+         "cad_data");
+    REIS(next_position, ftello(file), "end location");
+  }
+
+  REIS(0, fclose(file), "close file");
+
+  RSS(ref_geom_ghost(ref_geom, ref_node), "fill geom ghosts");
+  RSS(ref_node_ghost_real(ref_node), "ghost real");
+
+  RSS(ref_grid_inward_boundary_orientation(ref_grid),
+      "inward boundary orientation");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
@@ -731,6 +1032,7 @@ REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
   REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
   REF_DICT ref_dict;
   REF_INT cad_data_keyword;
+  REF_GLOB cad_data_size;
   REF_BOOL verbose = REF_FALSE;
   size_t end_of_string;
 
@@ -763,10 +1065,10 @@ REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
                               &available, &next_position),
         "jump");
     if (available) {
-      REIS(
-          1,
-          fread((unsigned char *)&ref_geom_cad_data_size(ref_geom), 4, 1, file),
+      RSS(ref_import_meshb_ints(file, version, 1, &cad_data_size),
           "cad_data_size");
+      RAS(cad_data_size <= REF_INT_MAX, "cad_data_size exceeds int");
+      ref_geom_cad_data_size(ref_geom) = (REF_INT)cad_data_size;
       if (verbose)
         printf("cad_data_size %d\n", ref_geom_cad_data_size(ref_geom));
       /* safe non-NULL free, if already allocated, to prevent mem leaks */
@@ -813,7 +1115,7 @@ REF_STATUS ref_part_cad_association(REF_GRID ref_grid, const char *filename) {
   REF_FILEPOS next_position;
   REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
   REF_INT type, geom_keyword;
-  REF_INT ngeom;
+  REF_GLOB ngeom;
   REF_BOOL verbose = REF_FALSE;
   size_t end_of_string;
 
@@ -848,14 +1150,15 @@ REF_STATUS ref_part_cad_association(REF_GRID ref_grid, const char *filename) {
                                 &available, &next_position),
           "jump");
       if (available) {
-        REIS(1, fread((unsigned char *)&ngeom, 4, 1, file), "ngeom");
-        if (verbose) printf("type %d ngeom %d\n", type, ngeom);
+        RSS(ref_import_meshb_ints(file, version, 1, &ngeom), "ngeom");
+        if (verbose) printf("type %d ngeom " REF_GLOB_FMT "\n", type, ngeom);
       }
     }
     RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
     if (available) {
-      RSS(ref_mpi_bcast(ref_mpi, &ngeom, 1, REF_INT_TYPE), "bcast");
-      RSS(ref_part_meshb_geom_bcast(ref_geom, ngeom, type, ref_node, file),
+      RSS(ref_mpi_bcast(ref_mpi, &ngeom, 1, REF_GLOB_TYPE), "bcast");
+      RSS(ref_part_meshb_geom_bcast(ref_geom, ngeom, type, ref_node, version,
+                                    file),
           "part geom bcast");
       if (ref_grid_once(ref_grid))
         REIS(next_position, ftello(file), "end location");
@@ -877,7 +1180,7 @@ REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid, const char *filename) {
   REF_BOOL available;
   REF_FILEPOS next_position;
   REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
-  REF_INT ncell;
+  REF_GLOB ncell;
   REF_BOOL verbose = REF_FALSE;
   size_t end_of_string;
 
@@ -911,17 +1214,18 @@ REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid, const char *filename) {
                               &next_position),
         "jump");
     if (available) {
-      REIS(1, fread((unsigned char *)&ncell, 4, 1, file), "nedge");
-      if (verbose) printf("nedge %d\n", ncell);
+      RSS(ref_import_meshb_ints(file, version, 1, &ncell), "nedge");
+      if (verbose) printf("nedge " REF_GLOB_FMT "\n", ncell);
     }
   }
   RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
 
   RAS(available, "no edge available in meshb");
 
-  RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_INT_TYPE), "bcast");
+  RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_GLOB_TYPE), "bcast");
 
-  RSS(ref_part_meshb_cell_bcast(ref_grid_edg(ref_grid), ncell, ref_node, file),
+  RSS(ref_part_meshb_cell_bcast(ref_grid_edg(ref_grid), ncell, ref_node,
+                                version, file),
       "part cell");
 
   if (ref_grid_once(ref_grid)) {
@@ -945,7 +1249,7 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
   REF_INT *c2n;
   REF_INT *tag;
   REF_INT *c2t;
-  REF_INT *sent_c2n;
+  REF_GLOB *sent_c2n;
   REF_INT *dest;
   REF_INT *sent_part;
   REF_INT *elements_to_send;
@@ -962,7 +1266,7 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
   size_per = ref_cell_size_per(ref_cell);
   node_per = ref_cell_node_per(ref_cell);
 
-  ref_malloc(sent_c2n, size_per * chunk, REF_INT);
+  ref_malloc(sent_c2n, size_per * chunk, REF_GLOB);
 
   if (ref_mpi_once(ref_mpi)) {
     ref_malloc(elements_to_send, ref_mpi_n(ref_mpi), REF_INT);
@@ -974,7 +1278,7 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
 
     ncell_read = 0;
     while (ncell_read < ncell) {
-      section_size = MIN(chunk, ncell - ncell_read);
+      section_size = (REF_INT)MIN(chunk, ncell - ncell_read);
 
       REIS(0,
            fseeko(file,
@@ -1011,8 +1315,8 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
       ncell_read += section_size;
 
       for (cell = 0; cell < section_size; cell++)
-        dest[cell] =
-            ref_part_implicit(nnode, ref_mpi_n(ref_mpi), c2n[size_per * cell]);
+        dest[cell] = (REF_INT)ref_part_implicit(nnode, ref_mpi_n(ref_mpi),
+                                                c2n[size_per * cell]);
 
       each_ref_mpi_part(ref_mpi, part) elements_to_send[part] = 0;
       for (cell = 0; cell < section_size; cell++)
@@ -1039,7 +1343,7 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
 
         for (cell = 0; cell < ncell_keep; cell++)
           for (node = 0; node < node_per; node++)
-            sent_part[node + size_per * cell] = ref_part_implicit(
+            sent_part[node + size_per * cell] = (REF_INT)ref_part_implicit(
                 nnode, ref_mpi_n(ref_mpi), sent_c2n[node + size_per * cell]);
 
         RSS(ref_cell_add_many_global(ref_cell, ref_node, ncell_keep, sent_c2n,
@@ -1054,7 +1358,8 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
                          part),
             "send");
         RSS(ref_mpi_send(ref_mpi, &(sent_c2n[size_per * start_to_send[part]]),
-                         size_per * elements_to_send[part], REF_INT_TYPE, part),
+                         size_per * elements_to_send[part], REF_GLOB_TYPE,
+                         part),
             "send");
       }
     }
@@ -1076,7 +1381,7 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
           "recv");
       if (elements_to_receive > 0) {
         RSS(ref_mpi_recv(ref_mpi, sent_c2n, size_per * elements_to_receive,
-                         REF_INT_TYPE, 0),
+                         REF_GLOB_TYPE, 0),
             "send");
 
         ref_malloc_init(sent_part, size_per * elements_to_receive, REF_INT,
@@ -1084,7 +1389,7 @@ static REF_STATUS ref_part_bin_ugrid_cell(REF_CELL ref_cell, REF_INT ncell,
 
         for (cell = 0; cell < elements_to_receive; cell++)
           for (node = 0; node < node_per; node++)
-            sent_part[node + size_per * cell] = ref_part_implicit(
+            sent_part[node + size_per * cell] = (REF_INT)ref_part_implicit(
                 nnode, ref_mpi_n(ref_mpi), sent_c2n[node + size_per * cell]);
 
         RSS(ref_cell_add_many_global(ref_cell, ref_node, elements_to_receive,
@@ -1163,7 +1468,9 @@ REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
   if (0 == ntet && 0 == npyr && (0 != npri || 0 != nhex))
     ref_grid_twod(ref_grid) = REF_TRUE;
 
-  RSS(ref_part_node(file, swap_endian, has_id, ref_node, nnode), "part node");
+  /* ugrid has no node ids, so the meshb version is unused */
+  RSS(ref_part_node(file, 2, swap_endian, has_id, ref_node, nnode),
+      "part node");
   if (instrument) ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "nodes");
 
   if (0 < ntri) {
@@ -1264,10 +1571,11 @@ REF_STATUS ref_part_metric_solb(REF_NODE ref_node, const char *filename) {
   FILE *file;
   REF_INT chunk;
   REF_DBL *metric;
-  REF_INT nnode_read, section_size;
-  REF_INT node, local, global, im;
+  REF_GLOB nnode_read, global, nnode;
+  REF_INT section_size;
+  REF_INT node, local, im;
   REF_BOOL available;
-  REF_INT version, dim, nnode, ntype, type;
+  REF_INT version, dim, ntype, type;
 
   file = NULL;
   if (ref_mpi_once(ref_mpi)) {
@@ -1289,7 +1597,7 @@ REF_STATUS ref_part_metric_solb(REF_NODE ref_node, const char *filename) {
                               &next_position),
         "jump");
     RAS(available, "SolAtVertices missing");
-    REIS(1, fread((unsigned char *)&nnode, 4, 1, file), "nnode");
+    RSS(ref_import_meshb_ints(file, version, 1, &nnode), "nnode");
     REIS(1, fread((unsigned char *)&ntype, 4, 1, file), "ntype");
     REIS(1, fread((unsigned char *)&type, 4, 1, file), "type");
     if (3 == dim) {
@@ -1302,17 +1610,17 @@ REF_STATUS ref_part_metric_solb(REF_NODE ref_node, const char *filename) {
   }
   RSS(ref_mpi_bcast(ref_node_mpi(ref_node), &dim, 1, REF_INT_TYPE),
       "bcast dim");
-  RSS(ref_mpi_bcast(ref_node_mpi(ref_node), &nnode, 1, REF_INT_TYPE),
+  RSS(ref_mpi_bcast(ref_node_mpi(ref_node), &nnode, 1, REF_GLOB_TYPE),
       "bcast nnode");
 
-  chunk = MAX(100000, nnode / ref_mpi_n(ref_node_mpi(ref_node)));
-  chunk = MIN(chunk, nnode);
+  chunk = (REF_INT)MAX(100000, nnode / ref_mpi_n(ref_node_mpi(ref_node)));
+  chunk = (REF_INT)MIN(chunk, nnode);
 
   ref_malloc_init(metric, 6 * chunk, REF_DBL, -1.0);
 
   nnode_read = 0;
   while (nnode_read < nnode) {
-    section_size = MIN(chunk, nnode - nnode_read);
+    section_size = (REF_INT)MIN(chunk, nnode - nnode_read);
     if (ref_mpi_once(ref_node_mpi(ref_node))) {
       for (node = 0; node < section_size; node++) {
         if (3 == dim) {
@@ -1379,8 +1687,9 @@ REF_STATUS ref_part_metric(REF_NODE ref_node, const char *filename) {
   FILE *file;
   REF_INT chunk;
   REF_DBL *metric;
-  REF_INT nnode_read, section_size;
-  REF_INT node, local, global, im;
+  REF_GLOB nnode_read, global;
+  REF_INT section_size;
+  REF_INT node, local, im;
   size_t end_of_string;
   REF_BOOL sol_format, found_keyword;
   REF_INT nnode, ntype, type;
@@ -1432,15 +1741,16 @@ REF_STATUS ref_part_metric(REF_NODE ref_node, const char *filename) {
     }
   }
 
-  chunk = MAX(100000,
-              ref_node_n_global(ref_node) / ref_mpi_n(ref_node_mpi(ref_node)));
-  chunk = MIN(chunk, ref_node_n_global(ref_node));
+  chunk = (REF_INT)MAX(
+      100000, ref_node_n_global(ref_node) / ref_mpi_n(ref_node_mpi(ref_node)));
+  chunk = (REF_INT)MIN(chunk, ref_node_n_global(ref_node));
 
   ref_malloc_init(metric, 6 * chunk, REF_DBL, -1.0);
 
   nnode_read = 0;
   while (nnode_read < ref_node_n_global(ref_node)) {
-    section_size = MIN(chunk, ref_node_n_global(ref_node) - nnode_read);
+    section_size =
+        (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_read);
     if (ref_mpi_once(ref_node_mpi(ref_node))) {
       for (node = 0; node < section_size; node++)
         if (sol_format) {
@@ -1492,7 +1802,7 @@ REF_STATUS ref_part_bamg_metric(REF_GRID ref_grid, const char *filename) {
   REF_INT node, local, opposite, global;
   REF_INT nterm, nnode;
 
-  nnode = ref_node_n_global(ref_node) / 2;
+  nnode = (REF_INT)(ref_node_n_global(ref_node) / 2);
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
@@ -1511,7 +1821,8 @@ REF_STATUS ref_part_bamg_metric(REF_GRID ref_grid, const char *filename) {
 
   nnode_read = 0;
   while (nnode_read < nnode) {
-    section_size = MIN(chunk, ref_node_n_global(ref_node) - nnode_read);
+    section_size =
+        (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_read);
     if (ref_grid_once(ref_grid)) {
       for (node = 0; node < section_size; node++) {
         REIS(3,
@@ -1563,11 +1874,12 @@ REF_STATUS ref_part_scalar(REF_NODE ref_node, REF_INT *ldim, REF_DBL **scalar,
   FILE *file;
   REF_INT chunk;
   REF_DBL *data;
-  REF_INT nnode_read, section_size;
-  REF_INT node, local, global;
+  REF_GLOB nnode_read, global, nnode;
+  REF_INT section_size;
+  REF_INT node, local;
   size_t end_of_string;
   REF_BOOL available;
-  REF_INT version, dim, nnode, ntype, type, i;
+  REF_INT version, dim, ntype, type, i;
 
   file = NULL;
   if (ref_mpi_once(ref_node_mpi(ref_node))) {
@@ -1591,7 +1903,7 @@ REF_STATUS ref_part_scalar(REF_NODE ref_node, REF_INT *ldim, REF_DBL **scalar,
                               &next_position),
         "jmp");
     RAS(available, "SolAtVertices missing");
-    REIS(1, fread((unsigned char *)&nnode, 4, 1, file), "nnode");
+    RSS(ref_import_meshb_ints(file, version, 1, &nnode), "nnode");
     REIS(1, fread((unsigned char *)&ntype, 4, 1, file), "ntype");
     REIS(ref_node_n_global(ref_node), nnode, "global nnode");
     *ldim = ntype;
@@ -1604,15 +1916,16 @@ REF_STATUS ref_part_scalar(REF_NODE ref_node, REF_INT *ldim, REF_DBL **scalar,
       "bcast ldim");
   ref_malloc(*scalar, (*ldim) * ref_node_max(ref_node), REF_DBL);
 
-  chunk = MAX(100000,
-              ref_node_n_global(ref_node) / ref_mpi_n(ref_node_mpi(ref_node)));
-  chunk = MIN(chunk, ref_node_n_global(ref_node));
+  chunk = (REF_INT)MAX(
+      100000, ref_node_n_global(ref_node) / ref_mpi_n(ref_node_mpi(ref_node)));
+  chunk = (REF_INT)MIN(chunk, ref_node_n_global(ref_node));
 
   ref_malloc_init(data, (*ldim) * chunk, REF_DBL, -1.0);
 
   nnode_read = 0;
   while (nnode_read < ref_node_n_global(ref_node)) {
-    section_size = MIN(chunk, ref_node_n_global(ref_node) - nnode_read);
+    section_size =
+        (REF_INT)MIN(chunk, ref_node_n_global(ref_node) - nnode_read);
     if (ref_mpi_once(ref_node_mpi(ref_node))) {
       REIS((*ldim) * section_size,
            fread(data, sizeof(REF_DBL), (*ldim) * section_size, file), "dat");
@@ -1662,7 +1975,8 @@ REF_STATUS ref_part_by_extension(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     return REF_SUCCESS;
   }
   if (strcmp(&filename[end_of_string - 6], ".meshb") == 0) {
-    RSS(ref_part_meshb(ref_grid_ptr, ref_mpi, filename), "meshb failed");
+    RSS(ref_part_meshb_slice(ref_grid_ptr, ref_mpi, filename),
+        "meshb failed");
     return REF_SUCCESS;
   }
   printf("%s: %d: %s %s\n", __FILE__, __LINE__,
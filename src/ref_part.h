@@ -71,6 +71,13 @@ BEGIN_C_DECLORATION
 REF_STATUS ref_part_by_extension(REF_GRID *ref_grid, REF_MPI ref_mpi,
                                  const char *filename);
 
+/* rank 0 reads the meshb and streams chunks to the other ranks */
+REF_STATUS ref_part_meshb_once(REF_GRID *ref_grid, REF_MPI ref_mpi,
+                               const char *filename);
+/* each rank seeks to and reads its own slice of the meshb */
+REF_STATUS ref_part_meshb_slice(REF_GRID *ref_grid, REF_MPI ref_mpi,
+                                const char *filename);
+
 REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename);
 REF_STATUS ref_part_cad_association(REF_GRID ref_grid, const char *filename);
 REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid, const char *filename);
@@ -52,10 +52,33 @@
 
 int main(int argc, char *argv[]) {
   REF_MPI ref_mpi;
-  REF_INT ngeom;
+  REF_GLOB ngeom;
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "make mpi");
 
+  if (3 == argc && 0 == strcmp(argv[2], "--compare")) { /* meshb readers */
+    REF_GRID once_grid, slice_grid;
+
+    ref_mpi_stopwatch_start(ref_mpi);
+    RSS(ref_part_meshb_once(&once_grid, ref_mpi, argv[1]), "once");
+    ref_mpi_stopwatch_stop(ref_mpi, "rank 0 read");
+    RSS(ref_part_meshb_slice(&slice_grid, ref_mpi, argv[1]), "slice");
+    ref_mpi_stopwatch_stop(ref_mpi, "slice read");
+
+    REIS(ref_node_n_global(ref_grid_node(once_grid)),
+         ref_node_n_global(ref_grid_node(slice_grid)), "nnode");
+    REIS(ref_node_n(ref_grid_node(once_grid)),
+         ref_node_n(ref_grid_node(slice_grid)), "local nnode");
+    REIS(ref_cell_n(ref_grid_tet(once_grid)),
+         ref_cell_n(ref_grid_tet(slice_grid)), "local ntet");
+
+    RSS(ref_grid_free(slice_grid), "free");
+    RSS(ref_grid_free(once_grid), "free");
+    RSS(ref_mpi_free(ref_mpi), "mpi free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   if (1 < argc) { /* part */
     REF_GRID import_grid;
     char viz_file[256];
@@ -322,6 +345,62 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
   }
 
+  { /* slice meshb with geom and cad_data matches rank 0 read */
+    REF_GRID export_grid, once_grid, slice_grid;
+    char grid_file[] = "ref_part_test.meshb";
+    char once_file[] = "ref_part_test_once.meshb";
+    char slice_file[] = "ref_part_test_slice.meshb";
+    REF_GEOM ref_geom;
+    REF_INT node;
+    REF_DBL param[2] = {0.5, 0.25};
+    REF_GLOB ngeom_once, ngeom_slice;
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_tet_brick_grid(&export_grid, ref_mpi), "set up tet");
+      ref_geom = ref_grid_geom(export_grid);
+      each_ref_node_valid_node(ref_grid_node(export_grid), node) {
+        RSS(ref_geom_add(ref_geom, node, REF_GEOM_FACE, 1, param), "face");
+        if (0 == node % 7)
+          RSS(ref_geom_add(ref_geom, node, REF_GEOM_NODE, 2, param), "node");
+      }
+      ref_geom_cad_data_size(ref_geom) = 3;
+      ref_malloc(ref_geom_cad_data(ref_geom), ref_geom_cad_data_size(ref_geom),
+                 REF_BYTE);
+      ref_geom_cad_data(ref_geom)[0] = 5;
+      ref_geom_cad_data(ref_geom)[1] = 4;
+      ref_geom_cad_data(ref_geom)[2] = 3;
+      RSS(ref_export_meshb(export_grid, grid_file), "export");
+      RSS(ref_grid_free(export_grid), "free");
+    }
+
+    RSS(ref_part_meshb_once(&once_grid, ref_mpi, grid_file), "once");
+    RSS(ref_part_meshb_slice(&slice_grid, ref_mpi, grid_file), "slice");
+
+    ref_geom = ref_grid_geom(slice_grid);
+    REIS(3, ref_geom_cad_data_size(ref_geom), "cad size");
+    REIS(5, ref_geom_cad_data(ref_geom)[0], "cad[0]");
+    REIS(4, ref_geom_cad_data(ref_geom)[1], "cad[1]");
+    REIS(3, ref_geom_cad_data(ref_geom)[2], "cad[2]");
+    RSS(ref_gather_ngeom(ref_grid_node(once_grid), ref_grid_geom(once_grid),
+                         REF_GEOM_FACE, &ngeom_once),
+        "count ngeom");
+    RSS(ref_gather_ngeom(ref_grid_node(slice_grid), ref_grid_geom(slice_grid),
+                         REF_GEOM_FACE, &ngeom_slice),
+        "count ngeom");
+    REIS(ngeom_once, ngeom_slice, "face geom");
+
+    RSS(ref_gather_by_extension(once_grid, once_file), "gather");
+    RSS(ref_gather_by_extension(slice_grid, slice_file), "gather");
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_same_file(once_file, slice_file), "same");
+      REIS(0, remove(once_file), "test clean up");
+      REIS(0, remove(slice_file), "test clean up");
+      REIS(0, remove(grid_file), "test clean up");
+    }
+
+    RSS(ref_grid_free(slice_grid), "free");
+    RSS(ref_grid_free(once_grid), "free");
+  }
+
   { /* metric */
     REF_GRID ref_grid;
     char metric_file[] = "ref_part_test.metric";
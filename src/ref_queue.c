@@ -0,0 +1,456 @@
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_queue.h"
+
+#include "ref_cell.h"
+#include "ref_geom.h"
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+#include "ref_node.h"
+
+REF_STATUS ref_queue_create(REF_QUEUE *ref_queue_ptr, REF_GRID ref_grid) {
+  REF_QUEUE ref_queue;
+
+  ref_malloc(*ref_queue_ptr, 1, REF_QUEUE_STRUCT);
+
+  ref_queue = (*ref_queue_ptr);
+
+  ref_queue_grid(ref_queue) = ref_grid;
+
+  ref_queue_n(ref_queue) = 0;
+  ref_queue->max = 100;
+  ref_malloc(ref_queue->kind, ref_queue->max, REF_INT);
+  ref_malloc(ref_queue->group, ref_queue->max, REF_INT);
+  ref_malloc(ref_queue->global, REF_CELL_MAX_SIZE_PER * ref_queue->max,
+             REF_GLOB);
+  ref_queue->nreal =
+      REF_NODE_REAL_PER + ref_node_naux(ref_grid_node(ref_grid));
+  ref_malloc(ref_queue->real, ref_queue->nreal * ref_queue->max, REF_DBL);
+
+  ref_queue_ntransaction(ref_queue) = 0;
+  ref_queue->maxtransaction = 100;
+  ref_malloc(ref_queue->first, ref_queue->maxtransaction + 1, REF_INT);
+  ref_malloc(ref_queue->dest_first, ref_queue->maxtransaction + 1, REF_INT);
+  ref_queue->first[0] = 0;
+  ref_queue->dest_first[0] = 0;
+
+  ref_queue->ndest = 0;
+  ref_queue->maxdest = 100;
+  ref_malloc(ref_queue->dest, ref_queue->maxdest, REF_INT);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_free(REF_QUEUE ref_queue) {
+  if (NULL == (void *)ref_queue) return REF_NULL;
+  ref_free(ref_queue->dest);
+  ref_free(ref_queue->dest_first);
+  ref_free(ref_queue->first);
+  ref_free(ref_queue->real);
+  ref_free(ref_queue->global);
+  ref_free(ref_queue->group);
+  ref_free(ref_queue->kind);
+  ref_free(ref_queue);
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_allowed(REF_GRID ref_grid, REF_INT node0, REF_INT node1,
+                             REF_BOOL *allowed) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT rank = ref_mpi_rank(ref_grid_mpi(ref_grid));
+  REF_INT item, cell, node;
+  REF_BOOL has_node1;
+
+  *allowed = REF_FALSE;
+
+  if (!ref_node_owned(ref_node, node0)) return REF_SUCCESS;
+
+  each_ref_cell_having_node(ref_cell, node0, item, cell) {
+    has_node1 = (REF_EMPTY == node1);
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++)
+      if (node1 == ref_cell_c2n(ref_cell, node, cell)) has_node1 = REF_TRUE;
+    if (!has_node1) continue;
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++) {
+      if (rank > ref_node_part(ref_node, ref_cell_c2n(ref_cell, node, cell))) {
+        return REF_SUCCESS;
+      }
+    }
+  }
+
+  *allowed = REF_TRUE;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_queue_dest(REF_QUEUE ref_queue, REF_INT part) {
+  REF_INT i;
+
+  if (ref_mpi_rank(ref_grid_mpi(ref_queue_grid(ref_queue))) == part)
+    return REF_SUCCESS;
+
+  for (i = ref_queue->dest_first[ref_queue_ntransaction(ref_queue)];
+       i < ref_queue->ndest; i++)
+    if (part == ref_queue->dest[i]) return REF_SUCCESS;
+
+  if (ref_queue->ndest >= ref_queue->maxdest) {
+    ref_queue->maxdest += 1000;
+    ref_realloc(ref_queue->dest, ref_queue->maxdest, REF_INT);
+  }
+
+  ref_queue->dest[ref_queue->ndest] = part;
+  ref_queue->ndest++;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_queue_record(REF_QUEUE ref_queue, REF_INT kind,
+                                   REF_INT group, REF_INT *record) {
+  REF_INT i;
+
+  if (ref_queue_n(ref_queue) >= ref_queue->max) {
+    ref_queue->max += 1000;
+    ref_realloc(ref_queue->kind, ref_queue->max, REF_INT);
+    ref_realloc(ref_queue->group, ref_queue->max, REF_INT);
+    ref_realloc(ref_queue->global, REF_CELL_MAX_SIZE_PER * ref_queue->max,
+                REF_GLOB);
+    ref_realloc(ref_queue->real, ref_queue->nreal * ref_queue->max, REF_DBL);
+  }
+
+  *record = ref_queue_n(ref_queue);
+  ref_queue->kind[*record] = kind;
+  ref_queue->group[*record] = group;
+  for (i = 0; i < REF_CELL_MAX_SIZE_PER; i++)
+    ref_queue->global[i + REF_CELL_MAX_SIZE_PER * (*record)] = REF_EMPTY;
+  for (i = 0; i < ref_queue->nreal; i++)
+    ref_queue->real[i + ref_queue->nreal * (*record)] = 0.0;
+  ref_queue_n(ref_queue)++;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_node(REF_QUEUE ref_queue, REF_INT node) {
+  REF_GRID ref_grid = ref_queue_grid(ref_queue);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT group, item, cell, cell_node, record, i, part;
+
+  RSS(ref_queue_record(ref_queue, REF_QUEUE_NODE,
+                       ref_node_part(ref_node, node), &record),
+      "record");
+  ref_queue->global[REF_CELL_MAX_SIZE_PER * record] =
+      ref_node_global(ref_node, node);
+  for (i = 0; i < REF_NODE_REAL_PER; i++)
+    ref_queue->real[i + ref_queue->nreal * record] =
+        ref_node_real(ref_node, i, node);
+  for (i = 0; i < ref_node_naux(ref_node); i++)
+    ref_queue->real[REF_NODE_REAL_PER + i + ref_queue->nreal * record] =
+        ref_node_aux(ref_node, i, node);
+
+  /* every part with a cell about node holds a copy of node */
+  each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+    each_ref_cell_having_node(ref_cell, node, item, cell) {
+      each_ref_cell_cell_node(ref_cell, cell_node) {
+        part = ref_node_part(ref_node, ref_cell_c2n(ref_cell, cell_node, cell));
+        RSS(ref_queue_dest(ref_queue, part), "dest");
+      }
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_queue_cell(REF_QUEUE ref_queue, REF_INT kind,
+                                 REF_INT group, REF_INT cell) {
+  REF_GRID ref_grid = ref_queue_grid(ref_queue);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_cell(ref_grid, group);
+  REF_INT cell_node, node, record;
+
+  RSS(ref_queue_record(ref_queue, kind, group, &record), "record");
+  each_ref_cell_cell_node(ref_cell, cell_node) {
+    node = ref_cell_c2n(ref_cell, cell_node, cell);
+    ref_queue->global[cell_node + REF_CELL_MAX_SIZE_PER * record] =
+        ref_node_global(ref_node, node);
+    RSS(ref_queue_dest(ref_queue, ref_node_part(ref_node, node)), "dest");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_remove_cell(REF_QUEUE ref_queue, REF_INT group,
+                                 REF_INT cell) {
+  RSS(ref_queue_cell(ref_queue, REF_QUEUE_REMOVE, group, cell), "remove");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_add_cell(REF_QUEUE ref_queue, REF_INT group,
+                              REF_INT cell) {
+  RSS(ref_queue_cell(ref_queue, REF_QUEUE_ADD, group, cell), "add");
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_commit(REF_QUEUE ref_queue) {
+  REF_INT t = ref_queue_ntransaction(ref_queue);
+
+  if (ref_queue->first[t] == ref_queue_n(ref_queue)) return REF_SUCCESS;
+
+  if (t + 1 >= ref_queue->maxtransaction) {
+    ref_queue->maxtransaction += 1000;
+    ref_realloc(ref_queue->first, ref_queue->maxtransaction + 1, REF_INT);
+    ref_realloc(ref_queue->dest_first, ref_queue->maxtransaction + 1,
+                REF_INT);
+  }
+
+  ref_queue_ntransaction(ref_queue)++;
+  ref_queue->first[t + 1] = ref_queue_n(ref_queue);
+  ref_queue->dest_first[t + 1] = ref_queue->ndest;
+
+  return REF_SUCCESS;
+}
+
+/* new globals are shifted past the globals of lower ranks */
+static REF_STATUS ref_queue_shift_globals(REF_QUEUE ref_queue) {
+  REF_NODE ref_node = ref_grid_node(ref_queue_grid(ref_queue));
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_GLOB new_nodes, offset, old_n_global;
+  REF_GLOB *everyones_new_nodes;
+  REF_INT proc, i;
+
+  ref_malloc(everyones_new_nodes, ref_mpi_n(ref_mpi), REF_GLOB);
+  new_nodes = ref_node->new_n_global - ref_node->old_n_global;
+  RSS(ref_mpi_allgather(ref_mpi, &new_nodes, everyones_new_nodes,
+                        REF_GLOB_TYPE),
+      "allgather");
+  offset = 0;
+  for (proc = 0; proc < ref_mpi_rank(ref_mpi); proc++)
+    offset += everyones_new_nodes[proc];
+  ref_free(everyones_new_nodes);
+
+  old_n_global = ref_node->old_n_global;
+  RSS(ref_node_shift_new_globals(ref_node), "shift");
+
+  if (0 == offset) return REF_SUCCESS;
+  for (i = 0; i < REF_CELL_MAX_SIZE_PER * ref_queue_n(ref_queue); i++)
+    if (ref_queue->global[i] >= old_n_global) ref_queue->global[i] += offset;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_queue_locals(REF_NODE ref_node, REF_CELL ref_cell,
+                                   REF_GLOB *global, REF_INT *nodes,
+                                   REF_BOOL *found) {
+  REF_INT cell_node;
+
+  *found = REF_FALSE;
+  each_ref_cell_cell_node(ref_cell, cell_node) {
+    if (REF_SUCCESS !=
+        ref_node_local(ref_node, global[cell_node], &(nodes[cell_node])))
+      return REF_SUCCESS;
+  }
+  *found = REF_TRUE;
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_queue_replay(REF_GRID ref_grid, REF_INT kind,
+                                   REF_INT group, REF_GLOB *global,
+                                   REF_DBL *real) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT node, cell, cell_node, i;
+  REF_BOOL found, has_local;
+  REF_STATUS status;
+
+  if (REF_QUEUE_NODE == kind) {
+    status = ref_node_local(ref_node, global[0], &node);
+    if (REF_NOT_FOUND == status) {
+      RSS(ref_node_add(ref_node, global[0], &node), "add");
+    } else {
+      RSS(status, "local");
+      if (ref_node_owned(ref_node, node)) return REF_SUCCESS;
+    }
+    ref_node_part(ref_node, node) = group;
+    for (i = 0; i < REF_NODE_REAL_PER; i++)
+      ref_node_real(ref_node, i, node) = real[i];
+    for (i = 0; i < ref_node_naux(ref_node); i++)
+      ref_node_aux(ref_node, i, node) = real[REF_NODE_REAL_PER + i];
+    return REF_SUCCESS;
+  }
+
+  ref_cell = ref_grid_cell(ref_grid, group);
+  RSS(ref_queue_locals(ref_node, ref_cell, global, nodes, &found), "locals");
+
+  if (REF_QUEUE_REMOVE == kind) {
+    if (!found) return REF_SUCCESS;
+    status = ref_cell_with(ref_cell, nodes, &cell);
+    if (REF_NOT_FOUND == status) return REF_SUCCESS;
+    RSS(status, "with");
+    RSS(ref_cell_remove(ref_cell, cell), "remove");
+    return REF_SUCCESS;
+  }
+
+  RAS(REF_QUEUE_ADD == kind, "unknown kind");
+  has_local = REF_FALSE;
+  each_ref_cell_cell_node(ref_cell, cell_node) {
+    status = ref_node_local(ref_node, global[cell_node], &node);
+    if (REF_SUCCESS == status && ref_node_owned(ref_node, node))
+      has_local = REF_TRUE;
+  }
+  if (!has_local) return REF_SUCCESS;
+  RAS(found, "added cell node missing");
+  status = ref_cell_with(ref_cell, nodes, &cell);
+  if (REF_SUCCESS == status) return REF_SUCCESS;
+  RXS(status, REF_NOT_FOUND, "with");
+  RSS(ref_cell_add(ref_cell, nodes, &cell), "add");
+
+  return REF_SUCCESS;
+}
+
+/* drop own added cells without an owned node and unused ghost nodes */
+static REF_STATUS ref_queue_trim(REF_QUEUE ref_queue) {
+  REF_GRID ref_grid = ref_queue_grid(ref_queue);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT record, group, cell, cell_node, node;
+  REF_BOOL found, has_local, unused;
+
+  for (record = 0; record < ref_queue_n(ref_queue); record++) {
+    if (REF_QUEUE_ADD != ref_queue->kind[record]) continue;
+    ref_cell = ref_grid_cell(ref_grid, ref_queue->group[record]);
+    RSS(ref_queue_locals(ref_node, ref_cell,
+                         &(ref_queue->global[REF_CELL_MAX_SIZE_PER * record]),
+                         nodes, &found),
+        "locals");
+    if (!found) continue;
+    has_local = REF_FALSE;
+    each_ref_cell_cell_node(ref_cell, cell_node) {
+      if (ref_node_owned(ref_node, nodes[cell_node])) has_local = REF_TRUE;
+    }
+    if (has_local) continue;
+    if (REF_SUCCESS != ref_cell_with(ref_cell, nodes, &cell)) continue;
+    RSS(ref_cell_remove(ref_cell, cell), "remove");
+  }
+
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) continue;
+    unused = ref_cell_node_empty(ref_grid_tri(ref_grid), node) &&
+             ref_cell_node_empty(ref_grid_qua(ref_grid), node) &&
+             ref_cell_node_empty(ref_grid_edg(ref_grid), node);
+    each_ref_grid_ref_cell(ref_grid, group, ref_cell) {
+      unused = unused && ref_cell_node_empty(ref_cell, node);
+    }
+    if (!unused) continue;
+    RSS(ref_node_remove_without_global(ref_node, node), "rm");
+    RSS(ref_geom_remove_all(ref_grid_geom(ref_grid), node), "rm");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_queue_apply(REF_QUEUE ref_queue) {
+  REF_GRID ref_grid = ref_queue_grid(ref_queue);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_INT nreal = ref_queue->nreal;
+  REF_INT total, nsend, nrecv, t, d, record, i, l;
+  REF_INT *send_proc, *send_int, *recv_int;
+  REF_GLOB *send_glob, *recv_glob;
+  REF_DBL *send_real, *recv_real;
+
+  total = ref_queue_n(ref_queue);
+  RSS(ref_mpi_allsum(ref_mpi, &total, 1, REF_INT_TYPE), "total");
+  if (0 == total || !ref_mpi_para(ref_mpi)) {
+    ref_queue_n(ref_queue) = 0;
+    ref_queue_ntransaction(ref_queue) = 0;
+    ref_queue->ndest = 0;
+    return REF_SUCCESS;
+  }
+  RAS(ref_queue->first[ref_queue_ntransaction(ref_queue)] ==
+          ref_queue_n(ref_queue),
+      "uncommitted records");
+
+  RSS(ref_queue_shift_globals(ref_queue), "shift");
+
+  nsend = 0;
+  for (t = 0; t < ref_queue_ntransaction(ref_queue); t++)
+    nsend += (ref_queue->dest_first[t + 1] - ref_queue->dest_first[t]) *
+             (ref_queue->first[t + 1] - ref_queue->first[t]);
+
+  ref_malloc(send_proc, nsend, REF_INT);
+  ref_malloc(send_int, 2 * nsend, REF_INT);
+  ref_malloc(send_glob, REF_CELL_MAX_SIZE_PER * nsend, REF_GLOB);
+  ref_malloc(send_real, nreal * nsend, REF_DBL);
+
+  i = 0;
+  for (t = 0; t < ref_queue_ntransaction(ref_queue); t++) {
+    for (d = ref_queue->dest_first[t]; d < ref_queue->dest_first[t + 1]; d++) {
+      for (record = ref_queue->first[t]; record < ref_queue->first[t + 1];
+           record++) {
+        send_proc[i] = ref_queue->dest[d];
+        send_int[0 + 2 * i] = ref_queue->kind[record];
+        send_int[1 + 2 * i] = ref_queue->group[record];
+        for (l = 0; l < REF_CELL_MAX_SIZE_PER; l++)
+          send_glob[l + REF_CELL_MAX_SIZE_PER * i] =
+              ref_queue->global[l + REF_CELL_MAX_SIZE_PER * record];
+        for (l = 0; l < nreal; l++)
+          send_real[l + nreal * i] = ref_queue->real[l + nreal * record];
+        i++;
+      }
+    }
+  }
+
+  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_int, 2, nsend,
+                        (void **)(&recv_int), &nrecv, REF_INT_TYPE),
+      "blind send int");
+  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_glob,
+                        REF_CELL_MAX_SIZE_PER, nsend, (void **)(&recv_glob),
+                        &nrecv, REF_GLOB_TYPE),
+      "blind send glob");
+  RSS(ref_mpi_blindsend(ref_mpi, send_proc, (void *)send_real, nreal, nsend,
+                        (void **)(&recv_real), &nrecv, REF_DBL_TYPE),
+      "blind send real");
+
+  ref_free(send_real);
+  ref_free(send_glob);
+  ref_free(send_int);
+  ref_free(send_proc);
+
+  /* transactions of different parts touch different cells */
+  for (i = 0; i < nrecv; i++) {
+    RSS(ref_queue_replay(ref_grid, recv_int[0 + 2 * i], recv_int[1 + 2 * i],
+                         &(recv_glob[REF_CELL_MAX_SIZE_PER * i]),
+                         &(recv_real[nreal * i])),
+        "replay");
+  }
+
+  ref_free(recv_real);
+  ref_free(recv_glob);
+  ref_free(recv_int);
+
+  RSS(ref_queue_trim(ref_queue), "trim");
+
+  ref_queue_n(ref_queue) = 0;
+  ref_queue_ntransaction(ref_queue) = 0;
+  ref_queue->ndest = 0;
+
+  return REF_SUCCESS;
+}
@@ -0,0 +1,76 @@
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef REF_QUEUE_H
+#define REF_QUEUE_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_QUEUE_STRUCT REF_QUEUE_STRUCT;
+typedef REF_QUEUE_STRUCT *REF_QUEUE;
+END_C_DECLORATION
+
+#include "ref_grid.h"
+
+BEGIN_C_DECLORATION
+
+#define REF_QUEUE_NODE (0)
+#define REF_QUEUE_REMOVE (1)
+#define REF_QUEUE_ADD (2)
+
+/* log of volume cell and node changes that are replayed on the parts
+ * that hold copies of the changed cells */
+struct REF_QUEUE_STRUCT {
+  REF_GRID grid;
+  REF_INT n, max;
+  REF_INT *kind;
+  REF_INT *group; /* cell group or owning part of a node */
+  REF_GLOB *global;
+  REF_INT nreal;
+  REF_DBL *real;
+  REF_INT ntransaction, maxtransaction;
+  REF_INT *first;
+  REF_INT *dest_first;
+  REF_INT ndest, maxdest;
+  REF_INT *dest;
+};
+
+REF_STATUS ref_queue_create(REF_QUEUE *ref_queue, REF_GRID ref_grid);
+REF_STATUS ref_queue_free(REF_QUEUE ref_queue);
+
+#define ref_queue_grid(ref_queue) ((ref_queue)->grid)
+#define ref_queue_n(ref_queue) ((ref_queue)->n)
+#define ref_queue_ntransaction(ref_queue) ((ref_queue)->ntransaction)
+
+/* node0 is owned and the tets having node0 (and node1 when not empty)
+ * only touch parts of higher rank, so no other part can change them */
+REF_STATUS ref_queue_allowed(REF_GRID ref_grid, REF_INT node0, REF_INT node1,
+                             REF_BOOL *allowed);
+
+REF_STATUS ref_queue_node(REF_QUEUE ref_queue, REF_INT node);
+REF_STATUS ref_queue_remove_cell(REF_QUEUE ref_queue, REF_INT group,
+                                 REF_INT cell);
+REF_STATUS ref_queue_add_cell(REF_QUEUE ref_queue, REF_INT group,
+                              REF_INT cell);
+REF_STATUS ref_queue_commit(REF_QUEUE ref_queue);
+
+/* collective, ships committed transactions and empties the queue */
+REF_STATUS ref_queue_apply(REF_QUEUE ref_queue);
+
+END_C_DECLORATION
+
+#endif /* REF_QUEUE_H */
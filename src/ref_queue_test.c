@@ -0,0 +1,320 @@
+/* Copyright 2014 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine platform is licensed under the Apache License, Version
+ * 2.0 (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ref_queue.h"
+
+#include "ref_cell.h"
+#include "ref_collapse.h"
+#include "ref_edge.h"
+#include "ref_fixture.h"
+#include "ref_grid.h"
+#include "ref_malloc.h"
+#include "ref_metric.h"
+#include "ref_mpi.h"
+#include "ref_node.h"
+#include "ref_part.h"
+#include "ref_split.h"
+#include "ref_validation.h"
+
+/* brick with implicit node parts and cells that touch an owned node */
+static REF_STATUS ref_queue_test_brick(REF_GRID *ref_grid_ptr,
+                                       REF_MPI ref_mpi) {
+  REF_GRID ref_grid;
+  REF_NODE ref_node;
+  REF_CELL ref_cell;
+  REF_INT cell, cell_node, node, nodes[REF_CELL_MAX_SIZE_PER];
+  REF_BOOL has_local;
+
+  RSS(ref_fixture_tet_brick_grid(ref_grid_ptr, ref_mpi), "brick");
+  ref_grid = *ref_grid_ptr;
+  ref_node = ref_grid_node(ref_grid);
+  RSS(ref_metric_unit_node(ref_node), "unit metric");
+
+  each_ref_node_valid_node(ref_node, node) {
+    ref_node_part(ref_node, node) =
+        ref_part_implicit(ref_node_n_global(ref_node), ref_mpi_n(ref_mpi),
+                          ref_node_global(ref_node, node));
+  }
+
+  ref_cell = ref_grid_tet(ref_grid);
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    has_local = REF_FALSE;
+    each_ref_cell_cell_node(ref_cell, cell_node) {
+      if (ref_node_owned(ref_node, nodes[cell_node])) has_local = REF_TRUE;
+    }
+    if (!has_local) RSS(ref_cell_remove(ref_cell, cell), "rm tet");
+  }
+  ref_cell = ref_grid_tri(ref_grid);
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    has_local = REF_FALSE;
+    each_ref_cell_cell_node(ref_cell, cell_node) {
+      if (ref_node_owned(ref_node, nodes[cell_node])) has_local = REF_TRUE;
+    }
+    if (!has_local) RSS(ref_cell_remove(ref_cell, cell), "rm tri");
+  }
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_cell_node_empty(ref_grid_tet(ref_grid), node))
+      RSS(ref_node_remove_without_global(ref_node, node), "rm node");
+  }
+
+  return REF_SUCCESS;
+}
+
+/* each tet is counted by the owner of its lowest global node */
+static REF_STATUS ref_queue_test_ntet(REF_GRID ref_grid, REF_INT *ntet) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT cell, cell_node, lowest, nodes[REF_CELL_MAX_SIZE_PER];
+
+  *ntet = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    lowest = nodes[0];
+    each_ref_cell_cell_node(ref_cell, cell_node) {
+      if (ref_node_global(ref_node, nodes[cell_node]) <
+          ref_node_global(ref_node, lowest))
+        lowest = nodes[cell_node];
+    }
+    if (ref_node_owned(ref_node, lowest)) (*ntet)++;
+  }
+  RSS(ref_mpi_allsum(ref_grid_mpi(ref_grid), ntet, 1, REF_INT_TYPE), "sum");
+
+  return REF_SUCCESS;
+}
+
+/* ghost copies already match their owners */
+static REF_STATUS ref_queue_test_ghosts(REF_GRID ref_grid) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL *xyz;
+  REF_INT node, i;
+
+  ref_malloc(xyz, 3 * ref_node_max(ref_node), REF_DBL);
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < 3; i++) xyz[i + 3 * node] = ref_node_xyz(ref_node, i, node);
+  }
+  RSS(ref_node_ghost_real(ref_node), "ghost");
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < 3; i++)
+      RWDS(xyz[i + 3 * node], ref_node_xyz(ref_node, i, node), -1.0,
+           "stale ghost");
+  }
+  ref_free(xyz);
+
+  return REF_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  {
+    REF_GRID ref_grid;
+    REF_QUEUE ref_queue;
+    REIS(REF_NULL, ref_queue_free(NULL), "dont free NULL");
+    RSS(ref_grid_create(&ref_grid, ref_mpi), "grid");
+    RSS(ref_queue_create(&ref_queue, ref_grid), "create");
+    REIS(0, ref_queue_n(ref_queue), "init zero");
+    REIS(0, ref_queue_ntransaction(ref_queue), "init zero");
+    RSS(ref_queue_apply(ref_queue), "apply empty");
+    RSS(ref_queue_free(ref_queue), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* local ball */
+    REF_GRID ref_grid;
+    REF_BOOL allowed;
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "fix");
+    RSS(ref_queue_allowed(ref_grid, 0, REF_EMPTY, &allowed), "allowed");
+    RAS(allowed, "local ball");
+    RSS(ref_queue_allowed(ref_grid, 0, 1, &allowed), "allowed");
+    RAS(allowed, "local edge");
+    ref_node_part(ref_grid_node(ref_grid), 0) = 1;
+    RSS(ref_queue_allowed(ref_grid, 0, REF_EMPTY, &allowed), "allowed");
+    RAS(!allowed, "ghost center");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  { /* commit groups records and skips empty transactions */
+    REF_GRID ref_grid;
+    REF_QUEUE ref_queue;
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "fix");
+    RSS(ref_queue_create(&ref_queue, ref_grid), "create");
+    RSS(ref_queue_commit(ref_queue), "empty commit");
+    REIS(0, ref_queue_ntransaction(ref_queue), "empty");
+    if (ref_cell_valid(ref_grid_tet(ref_grid), 0)) {
+      RSS(ref_queue_remove_cell(ref_queue, 0, 0), "rm");
+      RSS(ref_queue_add_cell(ref_queue, 0, 0), "add");
+      RSS(ref_queue_commit(ref_queue), "commit");
+      REIS(2, ref_queue_n(ref_queue), "two records");
+      REIS(1, ref_queue_ntransaction(ref_queue), "one transaction");
+    }
+    RSS(ref_queue_free(ref_queue), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  { /* split volume edges next to ghosts and ship them */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_EDGE ref_edge;
+    REF_QUEUE ref_queue;
+    REF_INT edge, node0, node1, new_node, ncell, ntet0, ntet1;
+    REF_INT cells[100];
+    REF_BOOL allowed;
+    REF_GLOB global;
+
+    RSS(ref_queue_test_brick(&ref_grid, ref_mpi), "brick");
+    ref_node = ref_grid_node(ref_grid);
+    RSS(ref_queue_test_ntet(ref_grid, &ntet0), "count");
+    REIS(6 * 27, ntet0, "brick tets");
+
+    RSS(ref_queue_create(&ref_queue, ref_grid), "create");
+    RSS(ref_edge_create(&ref_edge, ref_grid), "edges");
+    ncell = 0;
+    for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
+      node0 = ref_edge_e2n(ref_edge, 0, edge);
+      node1 = ref_edge_e2n(ref_edge, 1, edge);
+      RSS(ref_split_edge_local_tets(ref_grid, node0, node1, &allowed), "loc");
+      if (allowed) continue;
+      RSS(ref_split_edge_queue(ref_grid, node0, node1, &allowed), "queue");
+      if (!allowed) continue;
+      RSS(ref_cell_list_with2(ref_grid_tet(ref_grid), node0, node1, 100,
+                              &ncell, cells),
+          "ball");
+      RSS(ref_node_next_global(ref_node, &global), "next global");
+      RSS(ref_node_add(ref_node, global, &new_node), "new node");
+      RSS(ref_node_interpolate_edge(ref_node, node0, node1, new_node),
+          "interp");
+      RSS(ref_split_edge_queued(ref_grid, ref_queue, node0, node1, new_node),
+          "split");
+      break;
+    }
+    RSS(ref_edge_free(ref_edge), "free");
+    if (ref_mpi_para(ref_mpi)) {
+      REF_INT ntransaction = ref_queue_ntransaction(ref_queue);
+      RSS(ref_mpi_allsum(ref_mpi, &ntransaction, 1, REF_INT_TYPE), "sum");
+      RAS(0 < ntransaction, "lower parts split");
+    }
+
+    RSS(ref_queue_apply(ref_queue), "apply");
+    REIS(0, ref_queue_n(ref_queue), "emptied");
+
+    RSS(ref_queue_test_ntet(ref_grid, &ntet1), "count");
+    RSS(ref_mpi_allsum(ref_mpi, &ncell, 1, REF_INT_TYPE), "sum");
+    REIS(ntet0 + ncell, ntet1, "tets after split");
+    RSS(ref_validation_cell_node(ref_grid), "cell node");
+    RSS(ref_validation_unused_node(ref_grid), "unused node");
+    RSS(ref_queue_test_ghosts(ref_grid), "ghosts");
+
+    RSS(ref_queue_free(ref_queue), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  { /* collapse volume edges next to ghosts and ship them */
+    REF_GRID ref_grid;
+    REF_CELL ref_cell;
+    REF_EDGE ref_edge;
+    REF_QUEUE ref_queue;
+    REF_INT edge, node0, node1, ncell, ntet0, ntet1, cell;
+    REF_INT cells[100];
+    REF_BOOL allowed;
+
+    RSS(ref_queue_test_brick(&ref_grid, ref_mpi), "brick");
+    /* without boundary faces the whole brick is volume */
+    ref_cell = ref_grid_tri(ref_grid);
+    each_ref_cell_valid_cell(ref_cell, cell) {
+      RSS(ref_cell_remove(ref_cell, cell), "rm tri");
+    }
+    RSS(ref_queue_test_ntet(ref_grid, &ntet0), "count");
+
+    RSS(ref_queue_create(&ref_queue, ref_grid), "create");
+    RSS(ref_edge_create(&ref_edge, ref_grid), "edges");
+    ncell = 0;
+    for (edge = 0; edge < 2 * ref_edge_n(ref_edge); edge++) {
+      node0 = ref_edge_e2n(ref_edge, edge % 2, edge / 2);
+      node1 = ref_edge_e2n(ref_edge, 1 - edge % 2, edge / 2);
+      RSS(ref_collapse_edge_local_tets(ref_grid, node0, node1, &allowed),
+          "loc");
+      if (allowed) continue;
+      RSS(ref_collapse_edge_queue(ref_grid, node0, node1, &allowed),
+          "queue");
+      if (!allowed) continue;
+      RSS(ref_collapse_edge_quality(ref_grid, node0, node1, &allowed),
+          "qual");
+      if (!allowed) continue;
+      RSS(ref_cell_list_with2(ref_grid_tet(ref_grid), node0, node1, 100,
+                              &ncell, cells),
+          "ball");
+      RSS(ref_collapse_edge_queued(ref_grid, ref_queue, node0, node1),
+          "collapse");
+      break;
+    }
+    RSS(ref_edge_free(ref_edge), "free");
+    if (ref_mpi_para(ref_mpi)) {
+      REF_INT ntransaction = ref_queue_ntransaction(ref_queue);
+      RSS(ref_mpi_allsum(ref_mpi, &ntransaction, 1, REF_INT_TYPE), "sum");
+      RAS(0 < ntransaction, "lower parts collapse");
+    }
+
+    RSS(ref_queue_apply(ref_queue), "apply");
+    REIS(0, ref_queue_n(ref_queue), "emptied");
+
+    RSS(ref_queue_test_ntet(ref_grid, &ntet1), "count");
+    RSS(ref_mpi_allsum(ref_mpi, &ncell, 1, REF_INT_TYPE), "sum");
+    REIS(ntet0 - ncell, ntet1, "tets after collapse");
+    RSS(ref_validation_cell_node(ref_grid), "cell node");
+    RSS(ref_validation_unused_node(ref_grid), "unused node");
+    RSS(ref_validation_cell_volume(ref_grid), "volume");
+    RSS(ref_queue_test_ghosts(ref_grid), "ghosts");
+
+    RSS(ref_queue_free(ref_queue), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  { /* move a node next to ghosts and ship it */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_QUEUE ref_queue;
+    REF_INT node;
+    REF_BOOL allowed;
+
+    RSS(ref_queue_test_brick(&ref_grid, ref_mpi), "brick");
+    ref_node = ref_grid_node(ref_grid);
+    RSS(ref_queue_create(&ref_queue, ref_grid), "create");
+    each_ref_node_valid_node(ref_node, node) {
+      if (!ref_cell_node_empty(ref_grid_tri(ref_grid), node)) continue;
+      RSS(ref_queue_allowed(ref_grid, node, REF_EMPTY, &allowed), "queue");
+      if (!allowed) continue;
+      ref_node_xyz(ref_node, 2, node) += 0.01;
+      RSS(ref_queue_node(ref_queue, node), "moved");
+      RSS(ref_queue_commit(ref_queue), "commit");
+    }
+    RSS(ref_queue_apply(ref_queue), "apply");
+    RSS(ref_queue_test_ghosts(ref_grid), "ghosts");
+    RSS(ref_validation_cell_node(ref_grid), "cell node");
+
+    RSS(ref_queue_free(ref_queue), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
@@ -20,6 +20,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "ref_recon.h"
 
 #include "ref_cell.h"
@@ -37,6 +41,7 @@
 #include "ref_twod.h"
 
 #define REF_RECON_MAX_DEGREE (1000)
+#define REF_RECON_BATCH (4096)
 
 /* Alauzet and A. Loseille doi:10.1016/j.jcp.2009.09.020
  * section 2.2.4.1. A double L2-projection */
@@ -148,35 +153,28 @@ static REF_STATUS ref_recon_l2_projection_hessian(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
-static REF_STATUS ref_recon_kexact_with_aux(REF_INT center_global,
-                                            REF_DICT ref_dict, REF_BOOL twod,
-                                            REF_DBL mid_plane,
-                                            REF_DBL *hessian) {
+/* least squares fit of a quadratic to a cloud about center (x y z s),
+ * a and q hold m x 9 and r 9 x 9 where m is ncloud (+1 for twod) */
+static REF_STATUS ref_recon_kexact_cloud(REF_DBL *xyzs, REF_INT ncloud,
+                                         REF_DBL *cloud, REF_BOOL twod,
+                                         REF_DBL mid_plane, REF_DBL *a,
+                                         REF_DBL *q, REF_DBL *r,
+                                         REF_DBL *hessian) {
   REF_DBL geom[9], ab[90];
   REF_DBL dx, dy, dz, dq;
-  REF_DBL *a, *q, *r;
   REF_INT m, n;
-  REF_INT cloud_global, key_index, im, i, j;
-  REF_DBL xyzs[4];
+  REF_INT item, im, i, j;
   REF_BOOL verbose = REF_FALSE;
 
-  RSS(ref_dict_location(ref_dict, center_global, &key_index), "missing center");
-  xyzs[0] = ref_dict_keyvalueaux(ref_dict, 0, key_index);
-  xyzs[1] = ref_dict_keyvalueaux(ref_dict, 1, key_index);
-  xyzs[2] = ref_dict_keyvalueaux(ref_dict, 2, key_index);
-  xyzs[3] = ref_dict_keyvalueaux(ref_dict, 3, key_index);
   /* solve A with QR factorization size m x n */
-  m = ref_dict_n(ref_dict) - 1; /* skip self */
-  if (twod) m++;                /* add mid node */
+  m = ncloud;
+  if (twod) m++; /* add mid node */
   n = 9;
   if (verbose)
     printf("m %d at %f %f %f %f\n", m, xyzs[0], xyzs[1], xyzs[2], xyzs[3]);
   if (m < n) {           /* underdetermined, will end badly */
     return REF_DIV_ZERO; /* signal cloud growth required */
   }
-  ref_malloc(a, m * n, REF_DBL);
-  ref_malloc(q, m * n, REF_DBL);
-  ref_malloc(r, n * n, REF_DBL);
   i = 0;
   if (twod) {
     dx = 0;
@@ -196,11 +194,10 @@ static REF_STATUS ref_recon_kexact_with_aux(REF_INT center_global,
     }
     i++;
   }
-  each_ref_dict_key(ref_dict, key_index, cloud_global) {
-    if (center_global == cloud_global) continue; /* skip self */
-    dx = ref_dict_keyvalueaux(ref_dict, 0, key_index) - xyzs[0];
-    dy = ref_dict_keyvalueaux(ref_dict, 1, key_index) - xyzs[1];
-    dz = ref_dict_keyvalueaux(ref_dict, 2, key_index) - xyzs[2];
+  for (item = 0; item < ncloud; item++) {
+    dx = cloud[0 + 4 * item] - xyzs[0];
+    dy = cloud[1 + 4 * item] - xyzs[1];
+    dz = cloud[2 + 4 * item] - xyzs[2];
     geom[0] = 0.5 * dx * dx;
     geom[1] = dx * dy;
     geom[2] = dx * dz;
@@ -234,9 +231,8 @@ static REF_STATUS ref_recon_kexact_with_aux(REF_INT center_global,
     }
     i++;
   }
-  each_ref_dict_key(ref_dict, key_index, cloud_global) {
-    if (center_global == cloud_global) continue; /* skip self */
-    dq = ref_dict_keyvalueaux(ref_dict, 3, key_index) - xyzs[3];
+  for (item = 0; item < ncloud; item++) {
+    dq = cloud[3 + 4 * item] - xyzs[3];
     for (j = 0; j < 9; j++) {
       ab[j + 9 * 9] += q[i + m * j] * dq;
     }
@@ -250,11 +246,42 @@ static REF_STATUS ref_recon_kexact_with_aux(REF_INT center_global,
   for (im = 0; im < 6; im++) {
     hessian[im] = ab[im + 9 * j];
   }
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_recon_kexact_with_aux(REF_INT center_global,
+                                            REF_DICT ref_dict, REF_BOOL twod,
+                                            REF_DBL mid_plane,
+                                            REF_DBL *hessian) {
+  REF_DBL *a, *q, *r, *cloud;
+  REF_INT m, ncloud, cloud_global, key_index, i;
+  REF_DBL xyzs[4];
+  REF_STATUS status;
+
+  RSS(ref_dict_location(ref_dict, center_global, &key_index), "missing center");
+  for (i = 0; i < 4; i++)
+    xyzs[i] = ref_dict_keyvalueaux(ref_dict, i, key_index);
+  m = ref_dict_n(ref_dict); /* self skipped, room for twod mid node */
+  ref_malloc(cloud, 4 * m, REF_DBL);
+  ref_malloc(a, m * 9, REF_DBL);
+  ref_malloc(q, m * 9, REF_DBL);
+  ref_malloc(r, 9 * 9, REF_DBL);
+  ncloud = 0;
+  each_ref_dict_key(ref_dict, key_index, cloud_global) {
+    if (center_global == cloud_global) continue; /* skip self */
+    for (i = 0; i < 4; i++)
+      cloud[i + 4 * ncloud] = ref_dict_keyvalueaux(ref_dict, i, key_index);
+    ncloud++;
+  }
+  status = ref_recon_kexact_cloud(xyzs, ncloud, cloud, twod, mid_plane, a, q,
+                                  r, hessian);
   ref_free(r);
   ref_free(q);
   ref_free(a);
+  ref_free(cloud);
 
-  return REF_SUCCESS;
+  return status;
 }
 
 static REF_STATUS ref_recon_local_immediate_cloud(REF_DICT *one_layer,
@@ -268,7 +295,7 @@ static REF_STATUS ref_recon_local_immediate_cloud(REF_DICT *one_layer,
       each_ref_cell_having_node(ref_cell, node, item, cell) {
         each_ref_cell_cell_node(ref_cell, cell_node) {
           target = ref_cell_c2n(ref_cell, cell_node, cell);
-          global = ref_node_global(ref_node, target);
+          global = (REF_INT)ref_node_global(ref_node, target);
           xyzs[0] = ref_node_xyz(ref_node, 0, target);
           xyzs[1] = ref_node_xyz(ref_node, 1, target);
           xyzs[2] = ref_node_xyz(ref_node, 2, target);
@@ -335,7 +362,7 @@ REF_STATUS ref_recon_ghost_cloud(REF_DICT *one_layer, REF_NODE ref_node) {
   each_ref_node_valid_node(ref_node, node) {
     if (ref_mpi_rank(ref_mpi) != ref_node_part(ref_node, node)) {
       part = ref_node_part(ref_node, node);
-      a_global[a_next[part]] = ref_node_global(ref_node, node);
+      a_global[a_next[part]] = (REF_INT)ref_node_global(ref_node, node);
       a_part[a_next[part]] = ref_mpi_rank(ref_mpi);
       a_next[ref_node_part(ref_node, node)]++;
     }
@@ -456,6 +483,79 @@ static REF_STATUS ref_recon_grow_cloud_one_layer(REF_DICT ref_dict,
   return REF_SUCCESS;
 }
 
+static REF_STATUS ref_recon_two_layer(REF_DICT *one_layer, REF_NODE ref_node,
+                                      REF_INT node, REF_DICT *ref_dict) {
+  RSS(ref_dict_deep_copy(ref_dict, one_layer[node]), "create ref_dict");
+  RSS(ref_recon_grow_cloud_one_layer(*ref_dict, one_layer, ref_node), "grow");
+  return REF_SUCCESS;
+}
+
+/* the two layer stencil of each owned node without the node itself,
+ * as x y z s rows first[node] to first[node+1]-1 of cloud,
+ * grown by threads in batches to bound the number of live dicts */
+static REF_STATUS ref_recon_kexact_stencil(REF_DICT *one_layer,
+                                           REF_NODE ref_node, REF_INT *first,
+                                           REF_DBL **cloud_ptr) {
+  REF_DICT *grown;
+  REF_INT batch, nbatch, node, key_index, global, i, max, nfail, row;
+  REF_DBL *cloud;
+
+  max = 32 * ref_node_n(ref_node) + 1;
+  ref_malloc(*cloud_ptr, 4 * max, REF_DBL);
+  ref_malloc_init(grown, REF_RECON_BATCH, REF_DICT, NULL);
+  first[0] = 0;
+  for (batch = 0; batch < ref_node_max(ref_node); batch += REF_RECON_BATCH) {
+    nbatch = MIN(REF_RECON_BATCH, ref_node_max(ref_node) - batch);
+    nfail = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nfail) schedule(dynamic, 64)
+#endif
+    for (node = batch; node < batch + nbatch; node++) {
+      grown[node - batch] = NULL;
+      if (!ref_node_valid(ref_node, node) || !ref_node_owned(ref_node, node))
+        continue;
+      if (REF_SUCCESS != ref_recon_two_layer(one_layer, ref_node, node,
+                                             &(grown[node - batch])))
+        nfail++;
+    }
+    REIS(0, nfail, "grow two layers");
+
+    for (node = batch; node < batch + nbatch; node++) {
+      first[node + 1] = first[node];
+      if (NULL == grown[node - batch]) continue;
+      RSS(ref_dict_location(grown[node - batch],
+                            (REF_INT)ref_node_global(ref_node, node),
+                            &key_index),
+          "missing center");
+      first[node + 1] += ref_dict_n(grown[node - batch]) - 1; /* skip self */
+    }
+    if (first[batch + nbatch] > max) {
+      max = MAX(2 * max, first[batch + nbatch]);
+      ref_realloc(*cloud_ptr, 4 * max, REF_DBL);
+    }
+    cloud = *cloud_ptr;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(key_index, global, i, row)
+#endif
+    for (node = batch; node < batch + nbatch; node++) {
+      if (NULL == grown[node - batch]) continue;
+      row = first[node];
+      each_ref_dict_key(grown[node - batch], key_index, global) {
+        if (ref_node_global(ref_node, node) == global) continue; /* self */
+        for (i = 0; i < 4; i++)
+          cloud[i + 4 * row] =
+              ref_dict_keyvalueaux(grown[node - batch], i, key_index);
+        row++;
+      }
+      ref_dict_free(grown[node - batch]);
+    }
+  }
+  ref_free(grown);
+
+  return REF_SUCCESS;
+}
+
 static REF_STATUS ref_recon_kexact_hessian(REF_GRID ref_grid, REF_DBL *scalar,
                                            REF_DBL *hessian) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
@@ -467,9 +567,14 @@ static REF_STATUS ref_recon_kexact_hessian(REF_GRID ref_grid, REF_DBL *scalar,
   REF_DICT *one_layer;
   REF_BOOL report_large_eig = REF_FALSE;
   REF_INT layer;
+  REF_INT *first, *node_status, nthread, thread, max_m, i;
+  REF_DBL *cloud, *work, xyzs[4];
 
   if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_pri(ref_grid);
 
+  /* the stencil dictionaries are keyed by global node as REF_INT */
+  RAS(ref_node_n_global(ref_node) <= REF_INT_MAX, "k-exact needs int globals");
+
   ref_malloc_init(one_layer, ref_node_max(ref_node), REF_DICT, NULL);
   each_ref_node_valid_node(ref_node, node) {
     RSS(ref_dict_create(&(one_layer[node])), "cloud storage");
@@ -480,8 +585,47 @@ static REF_STATUS ref_recon_kexact_hessian(REF_GRID ref_grid, REF_DBL *scalar,
       "fill immediate cloud");
   RSS(ref_recon_ghost_cloud(one_layer, ref_node), "fill ghosts");
 
+  ref_malloc(first, ref_node_max(ref_node) + 1, REF_INT);
+  RSS(ref_recon_kexact_stencil(one_layer, ref_node, first, &cloud),
+      "stencil");
+
+  /* independent least squares systems, workspace a, q, r per thread */
+  max_m = 1;
+  for (node = 0; node < ref_node_max(ref_node); node++)
+    max_m = MAX(max_m, first[node + 1] - first[node] + 1);
+  nthread = 1;
+#ifdef _OPENMP
+  nthread = omp_get_max_threads();
+#endif
+  ref_malloc(work, nthread * (2 * 9 * max_m + 9 * 9), REF_DBL);
+  ref_malloc_init(node_status, ref_node_max(ref_node), REF_INT, REF_SUCCESS);
+#ifdef _OPENMP
+#pragma omp parallel for private(thread, xyzs, i) schedule(dynamic, 64)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    if (!ref_node_valid(ref_node, node) || !ref_node_owned(ref_node, node))
+      continue;
+    thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    for (i = 0; i < 3; i++) xyzs[i] = ref_node_xyz(ref_node, i, node);
+    xyzs[3] = scalar[node];
+    node_status[node] = ref_recon_kexact_cloud(
+        xyzs, first[node + 1] - first[node], &(cloud[4 * first[node]]),
+        ref_grid_twod(ref_grid), ref_node_twod_mid_plane(ref_node),
+        &(work[thread * (2 * 9 * max_m + 9 * 9)]),
+        &(work[thread * (2 * 9 * max_m + 9 * 9) + 9 * max_m]),
+        &(work[thread * (2 * 9 * max_m + 9 * 9) + 2 * 9 * max_m]),
+        &(hessian[6 * node]));
+  }
+  ref_free(work);
+  ref_free(cloud);
+  ref_free(first);
+
+  /* the rare node that needs a wider cloud grows it one layer at a time */
   each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
+    if (ref_node_owned(ref_node, node) && REF_SUCCESS != node_status[node]) {
       /* use ref_dict to get a unique list of halo(2) nodes */
       RSS(ref_dict_deep_copy(&ref_dict, one_layer[node]), "create ref_dict");
       status = REF_INVALID;
@@ -489,8 +633,9 @@ static REF_STATUS ref_recon_kexact_hessian(REF_GRID ref_grid, REF_DBL *scalar,
         RSS(ref_recon_grow_cloud_one_layer(ref_dict, one_layer, ref_node),
             "grow");
         status = ref_recon_kexact_with_aux(
-            ref_node_global(ref_node, node), ref_dict, ref_grid_twod(ref_grid),
-            ref_node_twod_mid_plane(ref_node), node_hessian);
+            (REF_INT)ref_node_global(ref_node, node), ref_dict,
+            ref_grid_twod(ref_grid), ref_node_twod_mid_plane(ref_node),
+            node_hessian);
         if (REF_DIV_ZERO == status) {
           ref_node_location(ref_node, node);
           printf(" caught %s, for %d layers to kexact cloud; retry\n",
@@ -506,14 +651,10 @@ static REF_STATUS ref_recon_kexact_hessian(REF_GRID ref_grid, REF_DBL *scalar,
       for (im = 0; im < 6; im++) {
         hessian[im + 6 * node] = node_hessian[im];
       }
-      if (ref_grid_twod(ref_grid)) {
-        node_hessian[1] = 0.0;
-        node_hessian[3] = 0.0;
-        node_hessian[4] = 0.0;
-      }
       RSS(ref_dict_free(ref_dict), "free ref_dict");
     }
   }
+  ref_free(node_status);
 
   each_ref_node_valid_node(ref_node, node) {
     ref_dict_free(one_layer[node]); /* no-op for null */
@@ -569,6 +710,7 @@ REF_STATUS ref_recon_extrapolate_boundary_multipass(REF_DBL *recon,
 
   RSS(ref_node_ghost_int(ref_node, needs_donor), "update ghosts");
 
+  RSS(ref_cell_freeze(tets), "freeze");
   for (pass = 0; pass < 10; pass++) {
     each_ref_node_valid_node(
         ref_node,
@@ -605,6 +747,7 @@ REF_STATUS ref_recon_extrapolate_boundary_multipass(REF_DBL *recon,
 
     if (0 == remain) break;
   }
+  RSS(ref_cell_thaw(tets), "thaw");
 
   ref_free(needs_donor);
 
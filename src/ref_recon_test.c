@@ -65,6 +65,42 @@ int main(int argc, char *argv[]) {
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "create");
 
+  if (2 == argc) {
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_DBL *scalar, *hessian, total, elapsed;
+    REF_INT node;
+    ref_mpi_stopwatch_start(ref_mpi);
+    RSS(ref_part_by_extension(&ref_grid, ref_mpi, argv[1]), "part grid");
+    RSS(ref_migrate_to_balance(ref_grid), "balance");
+    ref_node = ref_grid_node(ref_grid);
+    ref_mpi_stopwatch_stop(ref_mpi, "read grid");
+    ref_malloc(scalar, ref_node_max(ref_node), REF_DBL);
+    ref_malloc(hessian, 6 * ref_node_max(ref_node), REF_DBL);
+    each_ref_node_valid_node(ref_node, node) {
+      scalar[node] = tanh(5.0 * ref_node_xyz(ref_node, 0, node) *
+                          ref_node_xyz(ref_node, 1, node)) +
+                     sin(3.0 * ref_node_xyz(ref_node, 2, node));
+    }
+    ref_mpi_timing(ref_mpi) = REF_TRUE;
+    RSS(ref_mpi_timer_start(ref_mpi, "k-exact hessian"), "timer");
+    RSS(ref_recon_hessian(ref_grid, scalar, hessian, REF_RECON_KEXACT),
+        "k-exact hess");
+    RSS(ref_mpi_timer_stop(ref_mpi, "k-exact hessian"), "timer");
+    ref_mpi_stopwatch_stop(ref_mpi, "k-exact hessian");
+    RSS(ref_mpi_timer_total(ref_mpi, "k-exact hessian", &total), "total");
+    RSS(ref_mpi_max(ref_mpi, &total, &elapsed, REF_DBL_TYPE), "max");
+    if (ref_mpi_once(ref_mpi) && elapsed > 0.0)
+      printf("%.0f nodes per second\n",
+             (REF_DBL)ref_node_n_global(ref_node) / elapsed);
+    ref_free(hessian);
+    ref_free(scalar);
+    RSS(ref_grid_free(ref_grid), "free");
+    RSS(ref_mpi_free(ref_mpi), "free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   { /* l2-projection grad */
     REF_DBL tol = -1.0;
     REF_GRID ref_grid;
@@ -336,7 +372,7 @@ int main(int argc, char *argv[]) {
     xyzs[1] = 20.0 * ref_node_part(ref_node, local);
     xyzs[2] = 30.0 * ref_node_part(ref_node, local);
     xyzs[3] = 40.0 * ref_node_part(ref_node, local);
-    global = ref_node_global(ref_node, local);
+    global = (REF_INT)ref_node_global(ref_node, local);
     RSS(ref_dict_store_with_aux(one_layer[0], global, REF_EMPTY, xyzs),
         "store cloud stencil");
     local = 1;
@@ -345,7 +381,7 @@ int main(int argc, char *argv[]) {
       xyzs[1] = 20.0 * ref_node_part(ref_node, local);
       xyzs[2] = 30.0 * ref_node_part(ref_node, local);
       xyzs[3] = 40.0 * ref_node_part(ref_node, local);
-      global = ref_node_global(ref_node, local);
+      global = (REF_INT)ref_node_global(ref_node, local);
       RSS(ref_dict_store_with_aux(one_layer[0], global, REF_EMPTY, xyzs),
           "store cloud stencil");
     }
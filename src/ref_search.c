@@ -16,7 +16,6 @@
  * permissions and limitations under the License.
  */
 
-#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -24,7 +23,8 @@
 
 #include "ref_malloc.h"
 
-#define MAX_NODE_LIST (100)
+#define REF_SEARCH_LEAF_SIZE (4)
+#define REF_SEARCH_STACK_SIZE (128)
 
 REF_STATUS ref_search_create(REF_SEARCH *ref_search_ptr, REF_INT n) {
   REF_SEARCH ref_search;
@@ -37,84 +37,36 @@ REF_STATUS ref_search_create(REF_SEARCH *ref_search_ptr, REF_INT n) {
   ref_search->empty = 0;
 
   ref_malloc_init(ref_search->item, ref_search->n, REF_INT, REF_EMPTY);
-  ref_malloc_init(ref_search->left, ref_search->n, REF_INT, REF_EMPTY);
-  ref_malloc_init(ref_search->right, ref_search->n, REF_INT, REF_EMPTY);
-
   ref_malloc(ref_search->pos, ref_search->d * ref_search->n, REF_DBL);
   ref_malloc(ref_search->radius, ref_search->n, REF_DBL);
-  ref_malloc_init(ref_search->children_ball, ref_search->n, REF_DBL, 0.0);
+
+  /* a binary tree with at least one ball per leaf has fewer than 2n nodes */
+  ref_search->built = REF_FALSE;
+  ref_search->ntree = 0;
+  ref_malloc(ref_search->order, ref_search->n, REF_INT);
+  ref_malloc(ref_search->left, 2 * ref_search->n + 1, REF_INT);
+  ref_malloc(ref_search->first, 2 * ref_search->n + 1, REF_INT);
+  ref_malloc(ref_search->size, 2 * ref_search->n + 1, REF_INT);
+  ref_malloc(ref_search->box, 2 * ref_search->d * (2 * ref_search->n + 1),
+             REF_DBL);
 
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_search_free(REF_SEARCH ref_search) {
   if (NULL == (void *)ref_search) return REF_NULL;
-  ref_free(ref_search->children_ball);
+  ref_free(ref_search->box);
+  ref_free(ref_search->size);
+  ref_free(ref_search->first);
+  ref_free(ref_search->left);
+  ref_free(ref_search->order);
   ref_free(ref_search->radius);
   ref_free(ref_search->pos);
-  ref_free(ref_search->right);
-  ref_free(ref_search->left);
   ref_free(ref_search->item);
   ref_free(ref_search);
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_search_distance(REF_SEARCH ref_search, REF_INT a, REF_INT b,
-                               REF_DBL *distance) {
-  REF_INT i;
-  *distance = 0.0;
-  for (i = 0; i < ref_search->d; i++)
-    (*distance) += pow(ref_search->pos[i + ref_search->d * b] -
-                           ref_search->pos[i + ref_search->d * a],
-                       2);
-  (*distance) = sqrt(*distance);
-  return REF_SUCCESS;
-}
-
-REF_STATUS ref_search_home(REF_SEARCH ref_search, REF_INT child,
-                           REF_INT parent) {
-  REF_DBL child_distance;
-  REF_DBL left_distance, right_distance;
-
-  RUS(REF_EMPTY, child, "empty child");
-  RUS(REF_EMPTY, parent, "empty parent");
-
-  /* done, don't add self to children */
-  if (child == parent) return REF_SUCCESS;
-
-  RSS(ref_search_distance(ref_search, child, parent, &child_distance), "d");
-  ref_search->children_ball[parent] =
-      MAX(ref_search->children_ball[parent],
-          child_distance + ref_search->radius[child]);
-
-  if (REF_EMPTY == ref_search->left[parent]) {
-    ref_search->left[parent] = child;
-    return REF_SUCCESS;
-  }
-
-  if (REF_EMPTY == ref_search->right[parent]) {
-    ref_search->right[parent] = child;
-    return REF_SUCCESS;
-  }
-
-  RSS(ref_search_distance(ref_search, child, ref_search->left[parent],
-                          &left_distance),
-      "left dist");
-  RSS(ref_search_distance(ref_search, child, ref_search->right[parent],
-                          &right_distance),
-      "right dist");
-
-  if (left_distance < right_distance) {
-    RSS(ref_search_home(ref_search, child, ref_search->left[parent]),
-        "recursively add to left child");
-  } else {
-    RSS(ref_search_home(ref_search, child, ref_search->right[parent]),
-        "recursively add to right child");
-  }
-
-  return REF_SUCCESS;
-}
-
 REF_STATUS ref_search_insert(REF_SEARCH ref_search, REF_INT item,
                              REF_DBL *position, REF_DBL radius) {
   REF_INT i, location;
@@ -131,47 +83,176 @@ REF_STATUS ref_search_insert(REF_SEARCH ref_search, REF_INT item,
     ref_search->pos[i + ref_search->d * location] = position[i];
   ref_search->radius[location] = radius;
 
-  RSS(ref_search_home(ref_search, location, 0), "top level home");
+  ref_search->built = REF_FALSE;
 
   return REF_SUCCESS;
 }
 
-REF_STATUS ref_search_gather(REF_SEARCH ref_search, REF_LIST ref_list,
-                             REF_INT parent, REF_DBL *position,
-                             REF_DBL radius) {
-  REF_INT i;
-  REF_DBL distance;
+/* partial sort of order[lo..hi] so that order[k] has the kth center */
+static REF_STATUS ref_search_select(REF_SEARCH ref_search, REF_INT axis,
+                                    REF_INT lo, REF_INT hi, REF_INT k) {
+  REF_INT d = ref_search->d;
+  REF_INT *order = ref_search->order;
+  REF_INT i, j, temp;
+  REF_DBL pivot;
+
+  while (lo < hi) {
+    pivot = ref_search->pos[axis + d * order[k]];
+    i = lo;
+    j = hi;
+    while (i <= j) {
+      while (ref_search->pos[axis + d * order[i]] < pivot) i++;
+      while (pivot < ref_search->pos[axis + d * order[j]]) j--;
+      if (i <= j) {
+        temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+        i++;
+        j--;
+      }
+    }
+    if (j < k) lo = i;
+    if (k < i) hi = j;
+  }
+
+  return REF_SUCCESS;
+}
 
-  if (REF_EMPTY == parent) return REF_SUCCESS;
-  if (REF_EMPTY == ref_search->item[parent]) return REF_SUCCESS;
+/* top down median split on the longest axis of the ball centers,
+ * children of node are left[node] and left[node]+1 */
+static REF_STATUS ref_search_build(REF_SEARCH ref_search) {
+  REF_INT d = ref_search->d;
+  REF_INT node, i, j, ball, axis, half;
+  REF_DBL *box, lo[3], hi[3];
 
-  distance = 0.0;
-  for (i = 0; i < ref_search->d; i++)
-    distance +=
-        pow(position[i] - ref_search->pos[i + ref_search->d * parent], 2);
-  distance = sqrt(distance);
+  for (i = 0; i < ref_search->empty; i++) ref_search->order[i] = i;
 
-  /* if the distance between me and the target are less than combined radii */
-  if (distance <= ref_search->radius[parent] + radius) {
-    RSS(ref_list_push(ref_list, ref_search->item[parent]), "add item");
+  ref_search->ntree = 0;
+  if (0 < ref_search->empty) {
+    ref_search->first[0] = 0;
+    ref_search->size[0] = ref_search->empty;
+    ref_search->ntree = 1;
   }
 
-  /* if the distance between me and the target are less than children
-   * children_ball includes child radii, so only subtract target radius */
-  if (distance - radius <= ref_search->children_ball[parent]) {
-    RSS(ref_search_gather(ref_search, ref_list, ref_search->left[parent],
-                          position, radius),
-        "gthr");
-    RSS(ref_search_gather(ref_search, ref_list, ref_search->right[parent],
-                          position, radius),
-        "gthr");
+  /* children are appended, so a single sweep visits the whole tree */
+  for (node = 0; node < ref_search->ntree; node++) {
+    box = &(ref_search->box[2 * d * node]);
+    for (j = 0; j < d; j++) {
+      box[j] = 1.0e100;
+      box[j + d] = -1.0e100;
+      lo[j] = 1.0e100;
+      hi[j] = -1.0e100;
+    }
+    for (i = ref_search->first[node];
+         i < ref_search->first[node] + ref_search->size[node]; i++) {
+      ball = ref_search->order[i];
+      for (j = 0; j < d; j++) {
+        box[j] = MIN(box[j], ref_search->pos[j + d * ball] -
+                                 ref_search->radius[ball]);
+        box[j + d] = MAX(box[j + d], ref_search->pos[j + d * ball] +
+                                         ref_search->radius[ball]);
+        lo[j] = MIN(lo[j], ref_search->pos[j + d * ball]);
+        hi[j] = MAX(hi[j], ref_search->pos[j + d * ball]);
+      }
+    }
+
+    ref_search->left[node] = REF_EMPTY;
+    if (ref_search->size[node] <= REF_SEARCH_LEAF_SIZE) continue;
+
+    axis = 0;
+    for (j = 1; j < d; j++)
+      if (hi[j] - lo[j] > hi[axis] - lo[axis]) axis = j;
+    half = ref_search->size[node] / 2;
+    RSS(ref_search_select(
+            ref_search, axis, ref_search->first[node],
+            ref_search->first[node] + ref_search->size[node] - 1,
+            ref_search->first[node] + half),
+        "median");
+
+    RAS(ref_search->ntree + 2 <= 2 * ref_search->n + 1, "tree overflow");
+    ref_search->left[node] = ref_search->ntree;
+    ref_search->first[ref_search->ntree] = ref_search->first[node];
+    ref_search->size[ref_search->ntree] = half;
+    ref_search->first[ref_search->ntree + 1] = ref_search->first[node] + half;
+    ref_search->size[ref_search->ntree + 1] = ref_search->size[node] - half;
+    ref_search->ntree += 2;
   }
 
+  ref_search->built = REF_TRUE;
+
   return REF_SUCCESS;
 }
 
 REF_STATUS ref_search_touching(REF_SEARCH ref_search, REF_LIST ref_list,
                                REF_DBL *position, REF_DBL radius) {
-  RSS(ref_search_gather(ref_search, ref_list, 0, position, radius), "gthr");
+  REF_INT d = ref_search->d;
+  REF_INT stack[REF_SEARCH_STACK_SIZE];
+  REF_INT nstack, node, i, j, ball;
+  REF_DBL *box, dx, distance2, reach;
+
+  if (!ref_search->built) RSS(ref_search_build(ref_search), "build");
+  if (0 == ref_search->ntree) return REF_SUCCESS;
+
+  nstack = 0;
+  stack[nstack] = 0;
+  nstack++;
+  while (0 < nstack) {
+    nstack--;
+    node = stack[nstack];
+
+    /* skip when the position is farther than radius from the box */
+    box = &(ref_search->box[2 * d * node]);
+    distance2 = 0.0;
+    for (j = 0; j < d; j++) {
+      dx = 0.0;
+      if (position[j] < box[j]) dx = box[j] - position[j];
+      if (position[j] > box[j + d]) dx = position[j] - box[j + d];
+      distance2 += dx * dx;
+    }
+    if (distance2 > radius * radius) continue;
+
+    if (REF_EMPTY == ref_search->left[node]) {
+      for (i = ref_search->first[node];
+           i < ref_search->first[node] + ref_search->size[node]; i++) {
+        ball = ref_search->order[i];
+        distance2 = 0.0;
+        for (j = 0; j < d; j++) {
+          dx = position[j] - ref_search->pos[j + d * ball];
+          distance2 += dx * dx;
+        }
+        /* if the distance between me and the target are less than radii */
+        reach = ref_search->radius[ball] + radius;
+        if (distance2 <= reach * reach) {
+          RSS(ref_list_push(ref_list, ref_search->item[ball]), "add item");
+        }
+      }
+      continue;
+    }
+
+    RAS(nstack + 2 <= REF_SEARCH_STACK_SIZE, "search stack overflow");
+    stack[nstack] = ref_search->left[node] + 1;
+    nstack++;
+    stack[nstack] = ref_search->left[node];
+    nstack++;
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_search_touching_many(REF_SEARCH ref_search, REF_LIST ref_list,
+                                    REF_INT n, REF_DBL *position,
+                                    REF_DBL radius, REF_INT *first) {
+  REF_INT i;
+
+  if (!ref_search->built) RSS(ref_search_build(ref_search), "build");
+
+  for (i = 0; i < n; i++) {
+    first[i] = ref_list_n(ref_list);
+    RSS(ref_search_touching(ref_search, ref_list,
+                            &(position[ref_search->d * i]), radius),
+        "touch");
+  }
+  first[n] = ref_list_n(ref_list);
+
   return REF_SUCCESS;
 }
@@ -30,14 +30,19 @@ END_C_DECLORATION
 #include "ref_list.h"
 
 BEGIN_C_DECLORATION
+/* balls are appended by insert, the first query bulk builds an aabb tree */
 struct REF_SEARCH_STRUCT {
   REF_INT d, n;
   REF_INT empty;
   REF_INT *item;
-  REF_INT *left, *right;
   REF_DBL *pos;
   REF_DBL *radius;
-  REF_DBL *children_ball;
+  REF_BOOL built;
+  REF_INT ntree;
+  REF_INT *order;
+  REF_INT *left;
+  REF_INT *first, *size;
+  REF_DBL *box;
 };
 
 REF_STATUS ref_search_create(REF_SEARCH *ref_search, REF_INT n);
@@ -50,6 +55,12 @@ REF_STATUS ref_search_insert(REF_SEARCH ref_search, REF_INT item,
 REF_STATUS ref_search_touching(REF_SEARCH ref_search, REF_LIST ref_list,
                                REF_DBL *position, REF_DBL radius);
 
+/* appends items touching each of n positions to ref_list,
+ * the items of position i are first[i] to first[i+1]-1 */
+REF_STATUS ref_search_touching_many(REF_SEARCH ref_search, REF_LIST ref_list,
+                                    REF_INT n, REF_DBL *position,
+                                    REF_DBL radius, REF_INT *first);
+
 END_C_DECLORATION
 
 #endif /* REF_SEARCH_H */
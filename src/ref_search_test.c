@@ -16,6 +16,7 @@
  * permissions and limitations under the License.
  */
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -36,7 +37,9 @@
 #include "ref_geom.h"
 #include "ref_grid.h"
 #include "ref_import.h"
+#include "ref_interp.h"
 #include "ref_list.h"
+#include "ref_malloc.h"
 #include "ref_math.h"
 #include "ref_matrix.h"
 #include "ref_migrate.h"
@@ -56,6 +59,12 @@ int main(int argc, char *argv[]) {
   if (argc == 3 && !ref_mpi_para(ref_mpi)) {
     REF_GRID from, to;
     REF_SEARCH ref_search;
+    REF_LIST ref_list;
+    REF_CELL ref_cell;
+    REF_NODE ref_node;
+    REF_INT cell, nodes[REF_CELL_MAX_SIZE_PER], node;
+    REF_DBL center[3], radius, fuzz = 1.0e-12;
+    REF_INT touched;
 
     RSS(ref_mpi_stopwatch_start(ref_mpi), "sw start");
     RSS(ref_part_by_extension(&from, ref_mpi, argv[1]), "import");
@@ -63,9 +72,33 @@ int main(int argc, char *argv[]) {
     RSS(ref_part_by_extension(&to, ref_mpi, argv[2]), "import");
     RSS(ref_mpi_stopwatch_stop(ref_mpi, "read to grid"), "sw start");
 
-    RSS(ref_search_create(&ref_search, ref_node_n(ref_grid_node(from))),
-        "mk search");
+    ref_cell = ref_grid_tet(from);
+    ref_node = ref_grid_node(to);
+    RSS(ref_list_create(&ref_list), "make list");
+    RSS(ref_search_create(&ref_search, ref_cell_n(ref_cell)), "mk search");
+    each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+      RSS(ref_interp_bounding_sphere(ref_grid_node(from), nodes, center,
+                                     &radius),
+          "b");
+      RSS(ref_search_insert(ref_search, cell, center, 2.0 * radius), "ins");
+    }
+    /* first query completes a deferred build */
+    RSS(ref_search_touching(ref_search, ref_list, center, fuzz), "touch");
+    RSS(ref_list_erase(ref_list), "erase");
+    RSS(ref_mpi_stopwatch_stop(ref_mpi, "build"), "sw start");
+    touched = 0;
+    each_ref_node_valid_node(ref_node, node) {
+      RSS(ref_search_touching(ref_search, ref_list,
+                              ref_node_xyz_ptr(ref_node, node), fuzz),
+          "touch");
+      touched += ref_list_n(ref_list);
+      RSS(ref_list_erase(ref_list), "erase");
+    }
+    RSS(ref_mpi_stopwatch_stop(ref_mpi, "query"), "sw start");
+    printf("%d tets, %d nodes, %d touched\n", ref_cell_n(ref_cell),
+           ref_node_n(ref_node), touched);
 
+    RSS(ref_list_free(ref_list), "list free");
     RSS(ref_search_free(ref_search), "search free");
     RSS(ref_grid_free(to), "free");
     RSS(ref_grid_free(from), "free");
@@ -166,6 +199,70 @@ int main(int argc, char *argv[]) {
     RSS(ref_search_free(ref_search), "search free");
   }
 
+  { /* many balls match brute force, insert after query rebuilds */
+    REF_SEARCH ref_search;
+    REF_LIST ref_list;
+    REF_INT n = 200, nquery = 50;
+    REF_INT i, j, k, item, expected, *first;
+    REF_DBL xyz[3], r, *query, dist;
+
+    RSS(ref_search_create(&ref_search, n), "make search");
+    RSS(ref_list_create(&ref_list), "make list");
+    ref_malloc(query, 3 * nquery, REF_DBL);
+    ref_malloc(first, nquery + 1, REF_INT);
+
+    for (item = 0; item < n / 2; item++) {
+      xyz[0] = sin(1.1 * (REF_DBL)item);
+      xyz[1] = cos(2.3 * (REF_DBL)item);
+      xyz[2] = sin(3.7 * (REF_DBL)item);
+      r = 0.1 + 0.05 * cos(0.7 * (REF_DBL)item);
+      RSS(ref_search_insert(ref_search, item, xyz, r), "insert");
+    }
+    RSS(ref_search_touching(ref_search, ref_list, xyz, r), "touches");
+    RAS(0 < ref_list_n(ref_list), "should find itself");
+    RSS(ref_list_erase(ref_list), "erase");
+    for (item = n / 2; item < n; item++) {
+      xyz[0] = sin(1.1 * (REF_DBL)item);
+      xyz[1] = cos(2.3 * (REF_DBL)item);
+      xyz[2] = sin(3.7 * (REF_DBL)item);
+      r = 0.1 + 0.05 * cos(0.7 * (REF_DBL)item);
+      RSS(ref_search_insert(ref_search, item, xyz, r), "insert");
+    }
+
+    for (i = 0; i < nquery; i++) {
+      query[0 + 3 * i] = cos(5.3 * (REF_DBL)i);
+      query[1 + 3 * i] = sin(0.9 * (REF_DBL)i);
+      query[2 + 3 * i] = cos(1.9 * (REF_DBL)i);
+    }
+    r = 0.2;
+    RSS(ref_search_touching_many(ref_search, ref_list, nquery, query, r,
+                                 first),
+        "touch many");
+    REIS(0, first[0], "first");
+    REIS(ref_list_n(ref_list), first[nquery], "last");
+
+    for (i = 0; i < nquery; i++) {
+      expected = 0;
+      for (item = 0; item < n; item++) {
+        dist = sqrt(pow(query[0 + 3 * i] - sin(1.1 * (REF_DBL)item), 2) +
+                    pow(query[1 + 3 * i] - cos(2.3 * (REF_DBL)item), 2) +
+                    pow(query[2 + 3 * i] - sin(3.7 * (REF_DBL)item), 2));
+        if (dist > r + 0.1 + 0.05 * cos(0.7 * (REF_DBL)item)) continue;
+        expected++;
+        k = REF_EMPTY;
+        for (j = first[i]; j < first[i + 1]; j++)
+          if (item == ref_list_value(ref_list, j)) k = j;
+        RAS(REF_EMPTY != k, "missing item");
+      }
+      REIS(expected, first[i + 1] - first[i], "count");
+    }
+
+    ref_free(first);
+    ref_free(query);
+    RSS(ref_list_free(ref_list), "list free");
+    RSS(ref_search_free(ref_search), "search free");
+  }
+
   RSS(ref_mpi_free(ref_mpi), "mpi free");
   RSS(ref_mpi_stop(), "stop");
   return 0;
@@ -28,6 +28,7 @@
 #include "ref_matrix.h"
 #include "ref_metric.h"
 #include "ref_mpi.h"
+#include "ref_queue.h"
 #include "ref_smooth.h"
 #include "ref_twod.h"
 
@@ -1097,7 +1098,11 @@ REF_STATUS ref_smooth_threed_pass(REF_GRID ref_grid) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
   REF_INT geom, node;
-  REF_BOOL allowed, geom_node, geom_edge, interior;
+  REF_BOOL allowed, geom_node, geom_edge, interior, queued;
+  REF_QUEUE ref_queue = NULL;
+
+  if (ref_mpi_para(ref_grid_mpi(ref_grid)))
+    RSS(ref_queue_create(&ref_queue, ref_grid), "queue");
 
   /* smooth edges first if we have geom */
   each_ref_geom_edge(ref_geom, geom) {
@@ -1148,10 +1153,13 @@ REF_STATUS ref_smooth_threed_pass(REF_GRID ref_grid) {
     RSS(ref_smooth_no_geom_tri_improve(ref_grid, node), "no geom smooth");
   }
 
-  /* smooth interior */
+  /* smooth interior, moves next to ghosts are queued */
   each_ref_node_valid_node(ref_node, node) {
     RSS(ref_smooth_local_tet_about(ref_grid, node, &allowed), "para");
-    if (!allowed) {
+    queued = REF_FALSE;
+    if (!allowed && NULL != (void *)ref_queue)
+      RSS(ref_queue_allowed(ref_grid, node, REF_EMPTY, &queued), "queue");
+    if (!allowed && !queued) {
       ref_node_age(ref_node, node)++;
       continue;
     }
@@ -1161,6 +1169,10 @@ REF_STATUS ref_smooth_threed_pass(REF_GRID ref_grid) {
     if (interior) {
       RSS(ref_smooth_tet_improve(ref_grid, node), "ideal tet node");
       ref_node_age(ref_node, node) = 0;
+      if (queued) {
+        RSS(ref_queue_node(ref_queue, node), "moved");
+        RSS(ref_queue_commit(ref_queue), "commit");
+      }
     }
   }
 
@@ -1177,7 +1189,11 @@ REF_STATUS ref_smooth_threed_pass(REF_GRID ref_grid) {
         each_ref_cell_cell_node(ref_grid_tet(ref_grid), cell_node) {
           node = nodes[cell_node];
           RSS(ref_smooth_local_tet_about(ref_grid, node, &allowed), "para");
-          if (!allowed) {
+          queued = REF_FALSE;
+          if (!allowed && NULL != (void *)ref_queue)
+            RSS(ref_queue_allowed(ref_grid, node, REF_EMPTY, &queued),
+                "queue");
+          if (!allowed && !queued) {
             ref_node_age(ref_node, node)++;
             continue;
           }
@@ -1187,11 +1203,21 @@ REF_STATUS ref_smooth_threed_pass(REF_GRID ref_grid) {
           if (interior) {
             RSS(ref_smooth_tet_improve(ref_grid, node), "ideal");
             ref_node_age(ref_node, node) = 0;
+            if (queued) {
+              RSS(ref_queue_node(ref_queue, node), "moved");
+              RSS(ref_queue_commit(ref_queue), "commit");
+            }
           }
         }
       }
     }
   }
+
+  if (ref_mpi_para(ref_grid_mpi(ref_grid))) {
+    RSS(ref_queue_apply(ref_queue), "ship queued moves");
+    RSS(ref_queue_free(ref_queue), "queue");
+  }
+
   return REF_SUCCESS;
 }
 
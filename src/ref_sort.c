@@ -21,6 +21,8 @@
 
 #include "ref_sort.h"
 
+#include "ref_malloc.h"
+
 REF_STATUS ref_sort_insertion_int(REF_INT n, REF_INT *original,
                                   REF_INT *sorted) {
   REF_INT i, j, smallest, temp;
@@ -88,6 +90,55 @@ REF_STATUS ref_sort_heap_int(REF_INT n, REF_INT *original,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_sort_heap_glob(REF_INT n, REF_GLOB *original,
+                              REF_INT *sorted_index) {
+  REF_INT i, j, l, ir, indxt;
+  REF_GLOB q;
+
+  for (i = 0; i < n; i++) sorted_index[i] = i;
+
+  if (n < 2) return REF_SUCCESS;
+
+  l = (n >> 1) + 1;
+  ir = n - 1;
+  for (;;) {
+    if (l > 1) {
+      l--;
+      indxt = sorted_index[l - 1];
+      q = original[indxt];
+    } else {
+      indxt = sorted_index[ir];
+      q = original[indxt];
+      sorted_index[ir] = sorted_index[0];
+      if (--ir == 0) {
+        sorted_index[0] = indxt;
+        break;
+      }
+    }
+    i = l - 1;
+    j = l + i;
+
+    while (j <= ir) {
+      if (j < ir) {
+        if (original[sorted_index[j]] < original[sorted_index[j + 1]]) j++;
+      }
+      if (q < original[sorted_index[j]]) {
+        sorted_index[i] = sorted_index[j];
+        i = j;
+
+        j++;
+        j <<= 1;
+        j--;
+
+      } else
+        break;
+    }
+    sorted_index[i] = indxt;
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_sort_heap_dbl(REF_INT n, REF_DBL *original,
                              REF_INT *sorted_index) {
   REF_INT i, j, l, ir, indxt;
@@ -137,6 +188,85 @@ REF_STATUS ref_sort_heap_dbl(REF_INT n, REF_DBL *original,
   return REF_SUCCESS;
 }
 
+/* J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707 (2004) */
+static REF_DBL ref_sort_hilbert_key(REF_INT bits, unsigned int *x) {
+  unsigned int m, p, q, t;
+  REF_INT i, bit;
+  REF_DBL key;
+
+  m = 1u << (bits - 1);
+  for (q = m; q > 1; q >>= 1) {
+    p = q - 1;
+    for (i = 0; i < 3; i++) {
+      if (x[i] & q) {
+        x[0] ^= p;
+      } else {
+        t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  for (i = 1; i < 3; i++) x[i] ^= x[i - 1];
+  t = 0;
+  for (q = m; q > 1; q >>= 1)
+    if (x[2] & q) t ^= q - 1;
+  for (i = 0; i < 3; i++) x[i] ^= t;
+
+  /* interleave, 3 * bits <= 53 is exact in a double */
+  key = 0.0;
+  for (bit = bits - 1; bit >= 0; bit--)
+    for (i = 0; i < 3; i++) key = 2.0 * key + (REF_DBL)((x[i] >> bit) & 1u);
+
+  return key;
+}
+
+REF_STATUS ref_sort_hilbert_keys(REF_INT n, REF_DBL *xyz, REF_DBL *lo,
+                                 REF_DBL *hi, REF_DBL *key) {
+  REF_INT bits = 17;
+  REF_DBL scale;
+  unsigned int x[3];
+  REF_INT i, point;
+
+  for (point = 0; point < n; point++) {
+    for (i = 0; i < 3; i++) {
+      scale = 0.0;
+      if (hi[i] > lo[i]) scale = (xyz[i + 3 * point] - lo[i]) / (hi[i] - lo[i]);
+      scale = MIN(1.0, MAX(0.0, scale));
+      x[i] = (unsigned int)(scale * (REF_DBL)((1u << bits) - 1u));
+    }
+    key[point] = ref_sort_hilbert_key(bits, x);
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_sort_hilbert_dbl(REF_INT n, REF_DBL *xyz,
+                                REF_INT *sorted_index) {
+  REF_DBL lo[3], hi[3];
+  REF_DBL *key;
+  REF_INT i, point;
+
+  if (0 >= n) return REF_SUCCESS;
+
+  for (i = 0; i < 3; i++) {
+    lo[i] = xyz[i];
+    hi[i] = xyz[i];
+  }
+  for (point = 1; point < n; point++)
+    for (i = 0; i < 3; i++) {
+      lo[i] = MIN(lo[i], xyz[i + 3 * point]);
+      hi[i] = MAX(hi[i], xyz[i + 3 * point]);
+    }
+
+  ref_malloc(key, n, REF_DBL);
+  RSS(ref_sort_hilbert_keys(n, xyz, lo, hi, key), "keys");
+  RSS(ref_sort_heap_dbl(n, key, sorted_index), "sort keys");
+  ref_free(key);
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_sort_unique_int(REF_INT n, REF_INT *original, REF_INT *nunique,
                                REF_INT *unique) {
   REF_INT i, j;
@@ -195,3 +325,43 @@ REF_STATUS ref_sort_search(REF_INT n, REF_INT *ascending_list, REF_INT target,
 
   return REF_NOT_FOUND;
 }
+
+REF_STATUS ref_sort_search_glob(REF_INT n, REF_GLOB *ascending_list,
+                                REF_GLOB target, REF_INT *position) {
+  REF_INT lower, upper, mid;
+
+  *position = REF_EMPTY;
+
+  if (n < 1) return REF_NOT_FOUND;
+
+  if (target < ascending_list[0] || target > ascending_list[n - 1])
+    return REF_NOT_FOUND;
+
+  lower = 0;
+  upper = n - 1;
+  mid = n >> 1; /* fast divide by two */
+
+  if (target == ascending_list[lower]) {
+    *position = lower;
+    return REF_SUCCESS;
+  }
+  if (target == ascending_list[upper]) {
+    *position = upper;
+    return REF_SUCCESS;
+  }
+
+  while ((lower < mid) && (mid < upper)) {
+    if (target >= ascending_list[mid]) {
+      if (target == ascending_list[mid]) {
+        *position = mid;
+        return REF_SUCCESS;
+      }
+      lower = mid;
+    } else {
+      upper = mid;
+    }
+    mid = (lower + upper) >> 1;
+  }
+
+  return REF_NOT_FOUND;
+}
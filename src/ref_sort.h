@@ -28,14 +28,25 @@ REF_STATUS ref_sort_insertion_int(REF_INT n, REF_INT *original,
 
 REF_STATUS ref_sort_heap_int(REF_INT n, REF_INT *original,
                              REF_INT *sorted_index);
+REF_STATUS ref_sort_heap_glob(REF_INT n, REF_GLOB *original,
+                              REF_INT *sorted_index);
 REF_STATUS ref_sort_heap_dbl(REF_INT n, REF_DBL *original,
                              REF_INT *sorted_index);
 
+/* Hilbert curve position of xyz points in the box lo to hi */
+REF_STATUS ref_sort_hilbert_keys(REF_INT n, REF_DBL *xyz, REF_DBL *lo,
+                                 REF_DBL *hi, REF_DBL *key);
+/* order xyz points along a Hilbert curve through their bounding box */
+REF_STATUS ref_sort_hilbert_dbl(REF_INT n, REF_DBL *xyz,
+                                REF_INT *sorted_index);
+
 REF_STATUS ref_sort_unique_int(REF_INT n, REF_INT *original, REF_INT *nunique,
                                REF_INT *unique);
 
 REF_STATUS ref_sort_search(REF_INT n, REF_INT *ascending_list, REF_INT target,
                            REF_INT *position);
+REF_STATUS ref_sort_search_glob(REF_INT n, REF_GLOB *ascending_list,
+                                REF_GLOB target, REF_INT *position);
 
 END_C_DECLORATION
 
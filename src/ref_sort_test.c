@@ -158,6 +158,23 @@ int main(void) {
     REIS(REF_EMPTY, position, "50");
   }
 
+  { /* search glob */
+    REF_INT n = 3, position;
+    REF_GLOB ascending_list[3];
+    ascending_list[0] = 10;
+    ascending_list[1] = 20;
+    ascending_list[2] = REF_GLOB_MAX;
+
+    RSS(ref_sort_search_glob(n, ascending_list, 20, &position), "search");
+    REIS(1, position, "1");
+    RSS(ref_sort_search_glob(n, ascending_list, REF_GLOB_MAX, &position),
+        "search");
+    REIS(2, position, "2");
+    REIS(REF_NOT_FOUND, ref_sort_search_glob(n, ascending_list, 15, &position),
+         "search");
+    REIS(REF_EMPTY, position, "15");
+  }
+
   { /* search 0 */
     REF_INT n = 0, *ascending_list = NULL, position;
 
@@ -249,5 +266,26 @@ int main(void) {
     REIS(1, sorted_index[3], "sorted_index[3]");
   }
 
+  { /* hilbert curve visits 2x2x2 corners face to face */
+    REF_INT n = 8, point, i, steps;
+    REF_DBL xyz[24];
+    REF_INT sorted_index[8];
+    for (point = 0; point < n; point++) {
+      xyz[0 + 3 * point] = (REF_DBL)(point % 2);
+      xyz[1 + 3 * point] = (REF_DBL)((point / 2) % 2);
+      xyz[2 + 3 * point] = (REF_DBL)(point / 4);
+    }
+    RSS(ref_sort_hilbert_dbl(n, xyz, sorted_index), "sort");
+    REIS(0, sorted_index[0], "starts at origin");
+    for (point = 1; point < n; point++) {
+      steps = 0;
+      for (i = 0; i < 3; i++)
+        if (xyz[i + 3 * sorted_index[point]] !=
+            xyz[i + 3 * sorted_index[point - 1]])
+          steps++;
+      REIS(1, steps, "neighbors along curve");
+    }
+  }
+
   return 0;
 }
@@ -22,6 +22,7 @@
 
 #include "ref_cell.h"
 #include "ref_edge.h"
+#include "ref_heap.h"
 #include "ref_malloc.h"
 #include "ref_mpi.h"
 #include "ref_sort.h"
@@ -42,21 +43,48 @@
 
 #define MAX_CELL_SPLIT (100)
 
+static REF_STATUS ref_split_requeue(REF_GRID ref_grid, REF_EDGE ref_edge,
+                                    REF_HEAP ref_heap, REF_INT node) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT nnode, neighbors[MAX_CELL_SPLIT];
+  REF_INT i, edge;
+  REF_DBL ratio;
+  REF_STATUS status;
+
+  status = ref_cell_node_list_around(ref_grid_tet(ref_grid), node,
+                                     MAX_CELL_SPLIT, &nnode, neighbors);
+  if (REF_INCREASE_LIMIT == status) return REF_SUCCESS;
+  RSS(status, "neighbors");
+  for (i = 0; i < nnode; i++) {
+    RSS(ref_node_ratio(ref_node, node, neighbors[i], &ratio), "ratio");
+    if (ratio <= ref_grid_adapt(ref_grid, split_ratio)) continue;
+    RSS(ref_edge_append(ref_edge, node, neighbors[i], &edge), "append");
+    RSS(ref_heap_push(ref_heap, edge, ratio), "push");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_split_pass(REF_GRID ref_grid) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_EDGE ref_edge;
-  REF_DBL *ratio;
-  REF_INT *edges, *order;
-  REF_INT i, n, edge;
+  REF_HEAP ref_heap;
+  REF_DBL *ratio, edge_ratio;
+  REF_INT i, edge;
   REF_BOOL allowed_tet_ratio, allowed_tri_quality, allowed_tet_quality;
   REF_BOOL allowed, allowed_local, geom_support, valid_cavity;
-  REF_INT global, new_node;
+  REF_INT new_node;
+  REF_GLOB global;
   REF_CAVITY ref_cavity = (REF_CAVITY)NULL;
   REF_BOOL span_parts;
   REF_LIST para_no_geom = NULL;
   REF_LIST para_cavity = NULL;
   REF_SUBDIV ref_subdiv = NULL;
+  REF_QUEUE ref_queue = NULL;
+  REF_BOOL queued;
+  REF_GLOB *deferred;
+  REF_INT node0, node1;
 
   RAS(!ref_grid_twod(ref_grid), "only 3D");
 
@@ -65,30 +93,25 @@ REF_STATUS ref_split_pass(REF_GRID ref_grid) {
   if (span_parts) {
     RSS(ref_list_create(&para_no_geom), "list for stuck edges");
     RSS(ref_list_create(&para_cavity), "list for stuck cavity");
+    RSS(ref_queue_create(&ref_queue, ref_grid), "queue");
   }
 
   RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
 
   ref_malloc(ratio, ref_edge_n(ref_edge), REF_DBL);
-  ref_malloc(order, ref_edge_n(ref_edge), REF_INT);
-  ref_malloc(edges, ref_edge_n(ref_edge), REF_INT);
-
-  n = 0;
+  RSS(ref_node_ratio_many(ref_node, ref_edge_n(ref_edge),
+                          &ref_edge_e2n(ref_edge, 0, 0), ratio),
+      "ratio");
+  RSS(ref_heap_create(&ref_heap, REF_TRUE), "heap");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
-    RSS(ref_node_ratio(ref_node, ref_edge_e2n(ref_edge, 0, edge),
-                       ref_edge_e2n(ref_edge, 1, edge), &(ratio[n])),
-        "ratio");
-    if (ratio[n] > ref_grid_adapt(ref_grid, split_ratio)) {
-      edges[n] = edge;
-      n++;
+    if (ratio[edge] > ref_grid_adapt(ref_grid, split_ratio)) {
+      RSS(ref_heap_push(ref_heap, edge, ratio[edge]), "push");
     }
   }
+  ref_free(ratio);
 
-  RSS(ref_sort_heap_dbl(n, ratio, order), "sort lengths");
-
-  for (i = n - 1; i >= 0; i--) {
-    edge = edges[order[i]];
-
+  /* longest first, in serial the edges of each new node join the queue */
+  while (REF_SUCCESS == ref_heap_pop(ref_heap, &edge, &edge_ratio)) {
     RSS(ref_cell_has_side(ref_grid_tet(ref_grid),
                           ref_edge_e2n(ref_edge, 0, edge),
                           ref_edge_e2n(ref_edge, 1, edge), &allowed),
@@ -174,7 +197,13 @@ REF_STATUS ref_split_pass(REF_GRID ref_grid) {
                                   ref_edge_e2n(ref_edge, 1, edge),
                                   &allowed_local),
         "local tet");
-    if (!allowed_local) {
+    queued = REF_FALSE;
+    if (!allowed_local && span_parts && !valid_cavity) {
+      RSS(ref_split_edge_queue(ref_grid, ref_edge_e2n(ref_edge, 0, edge),
+                               ref_edge_e2n(ref_edge, 1, edge), &queued),
+          "queue");
+    }
+    if (!allowed_local && !queued) {
       if (span_parts) {
         RSS(ref_list_push(para_no_geom, edge), "push");
       } else {
@@ -186,9 +215,16 @@ REF_STATUS ref_split_pass(REF_GRID ref_grid) {
       continue;
     }
 
-    RSS(ref_split_edge(ref_grid, ref_edge_e2n(ref_edge, 0, edge),
-                       ref_edge_e2n(ref_edge, 1, edge), new_node),
-        "split");
+    if (queued) {
+      RSS(ref_split_edge_queued(ref_grid, ref_queue,
+                                ref_edge_e2n(ref_edge, 0, edge),
+                                ref_edge_e2n(ref_edge, 1, edge), new_node),
+          "queued split");
+    } else {
+      RSS(ref_split_edge(ref_grid, ref_edge_e2n(ref_edge, 0, edge),
+                         ref_edge_e2n(ref_edge, 1, edge), new_node),
+          "split");
+    }
     if (valid_cavity) {
       RSS(ref_cavity_create(&ref_cavity, 3), "cav create");
       RSS(ref_cavity_add_ball(ref_cavity, ref_grid, new_node), "cav split");
@@ -207,27 +243,45 @@ REF_STATUS ref_split_pass(REF_GRID ref_grid) {
 
     RSS(ref_smooth_threed_post_edge_split(ref_grid, new_node),
         "smooth after split");
+    /* part interfaces wait for migration, a cascade would refine the part
+     * interiors against a coarse interface */
+    if (!span_parts)
+      RSS(ref_split_requeue(ref_grid, ref_edge, ref_heap, new_node),
+          "requeue");
   }
 
-  ref_free(edges);
-  ref_free(order);
-  ref_free(ratio);
+  RSS(ref_heap_free(ref_heap), "heap");
 
   if (span_parts) {
+    /* replay and trim reuse node slots, so carry the deferred edges by
+     * global, they are original edges with globals that are not shifted */
+    ref_malloc(deferred, 2 * ref_list_n(para_no_geom), REF_GLOB);
+    each_ref_list_item(para_no_geom, i) {
+      edge = ref_list_value(para_no_geom, i);
+      deferred[0 + 2 * i] =
+          ref_node_global(ref_node, ref_edge_e2n(ref_edge, 0, edge));
+      deferred[1 + 2 * i] =
+          ref_node_global(ref_node, ref_edge_e2n(ref_edge, 1, edge));
+    }
+
+    RSS(ref_queue_apply(ref_queue), "ship queued splits");
+    RSS(ref_queue_free(ref_queue), "queue");
+
     RSS(ref_subdiv_create(&ref_subdiv, ref_grid), "create");
     ref_subdiv->instrument = REF_TRUE;
     each_ref_list_item(para_no_geom, i) {
-      edge = ref_list_value(para_no_geom, i);
-      RSS(ref_cell_has_side(ref_grid_tet(ref_grid),
-                            ref_edge_e2n(ref_edge, 0, edge),
-                            ref_edge_e2n(ref_edge, 1, edge), &allowed),
+      if (REF_SUCCESS !=
+              ref_node_local(ref_node, deferred[0 + 2 * i], &node0) ||
+          REF_SUCCESS != ref_node_local(ref_node, deferred[1 + 2 * i], &node1))
+        continue;
+      RSS(ref_cell_has_side(ref_grid_tet(ref_grid), node0, node1, &allowed),
           "has side");
       if (!allowed) continue;
 
-      RSS(ref_subdiv_mark_to_split(ref_subdiv, ref_edge_e2n(ref_edge, 0, edge),
-                                   ref_edge_e2n(ref_edge, 1, edge)),
+      RSS(ref_subdiv_mark_to_split(ref_subdiv, node0, node1),
           "mark edge to para split");
     }
+    ref_free(deferred);
 
     RSS(ref_subdiv_split(ref_subdiv), "split");
     RSS(ref_subdiv_free(ref_subdiv), "free");
@@ -458,6 +512,51 @@ REF_STATUS ref_split_edge_local_tets(REF_GRID ref_grid, REF_INT node0,
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_split_edge_queue(REF_GRID ref_grid, REF_INT node0,
+                                REF_INT node1, REF_BOOL *allowed) {
+  REF_BOOL has_side;
+
+  *allowed = REF_FALSE;
+
+  RSS(ref_cell_has_side(ref_grid_tri(ref_grid), node0, node1, &has_side),
+      "boundary edge");
+  if (has_side) return REF_SUCCESS;
+
+  if (ref_node_owned(ref_grid_node(ref_grid), node0)) {
+    RSS(ref_queue_allowed(ref_grid, node0, node1, allowed), "queue");
+  } else {
+    RSS(ref_queue_allowed(ref_grid, node1, node0, allowed), "queue");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_split_edge_queued(REF_GRID ref_grid, REF_QUEUE ref_queue,
+                                 REF_INT node0, REF_INT node1,
+                                 REF_INT new_node) {
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT ncell, cell_in_list, item, cell;
+  REF_INT cell_to_split[MAX_CELL_SPLIT];
+
+  RSS(ref_cell_list_with2(ref_cell, node0, node1, MAX_CELL_SPLIT, &ncell,
+                          cell_to_split),
+      "sides");
+  for (cell_in_list = 0; cell_in_list < ncell; cell_in_list++)
+    RSS(ref_queue_remove_cell(ref_queue, 0, cell_to_split[cell_in_list]),
+        "old tet");
+
+  RSS(ref_split_edge(ref_grid, node0, node1, new_node), "split");
+
+  /* node record before the cells that use it */
+  RSS(ref_queue_node(ref_queue, new_node), "new node");
+  each_ref_cell_having_node(ref_cell, new_node, item, cell) {
+    RSS(ref_queue_add_cell(ref_queue, 0, cell), "new tet");
+  }
+  RSS(ref_queue_commit(ref_queue), "commit");
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_split_edge_tet_quality(REF_GRID ref_grid, REF_INT node0,
                                       REF_INT node1, REF_INT new_node,
                                       REF_BOOL *allowed) {
@@ -663,7 +762,7 @@ REF_STATUS ref_split_twod_pass(REF_GRID ref_grid) {
   REF_INT edge, n, i;
   REF_BOOL active, allowed;
   REF_INT node0, node1, node2, node3, new_node0, new_node1;
-  REF_INT global;
+  REF_GLOB global;
 
   RAS(ref_grid_twod(ref_grid), "only 2D");
 
@@ -1044,7 +1143,8 @@ REF_STATUS ref_split_edge_pattern(REF_GRID ref_grid, REF_INT first,
   REF_EDGE ref_edge;
   REF_INT edge;
   REF_BOOL allowed, geom_support;
-  REF_INT global, new_node;
+  REF_INT new_node;
+  REF_GLOB global;
 
   RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
 
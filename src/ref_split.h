@@ -22,6 +22,7 @@
 #include "ref_defs.h"
 
 #include "ref_grid.h"
+#include "ref_queue.h"
 
 BEGIN_C_DECLORATION
 
@@ -37,6 +38,12 @@ REF_STATUS ref_split_edge_mixed(REF_GRID ref_grid, REF_INT node0, REF_INT node1,
 
 REF_STATUS ref_split_edge_local_tets(REF_GRID ref_grid, REF_INT node0,
                                      REF_INT node1, REF_BOOL *allowed);
+/* volume edge next to ghosts that can be split and shipped in a queue */
+REF_STATUS ref_split_edge_queue(REF_GRID ref_grid, REF_INT node0,
+                                REF_INT node1, REF_BOOL *allowed);
+REF_STATUS ref_split_edge_queued(REF_GRID ref_grid, REF_QUEUE ref_queue,
+                                 REF_INT node0, REF_INT node1,
+                                 REF_INT new_node);
 
 REF_STATUS ref_split_edge_tet_quality(REF_GRID ref_grid, REF_INT node0,
                                       REF_INT node1, REF_INT new_node,
@@ -268,8 +268,9 @@ int main(void) {
 
     RSS(ref_split_pass(ref_grid), "pass");
 
-    REIS(7, ref_node_n(ref_grid_node(ref_grid)), "nodes");
-    REIS(4, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+    /* the sweep also splits the long edges it creates */
+    REIS(10, ref_node_n(ref_grid_node(ref_grid)), "nodes");
+    REIS(7, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
 
     /* ref_export_by_extension(ref_grid,"ref_split_test.tec"); */
 
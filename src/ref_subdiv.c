@@ -374,8 +374,8 @@ REF_STATUS ref_subdiv_unmark_one_of_two(REF_SUBDIV ref_subdiv, REF_INT e0,
                                         REF_INT e1) {
   REF_NODE ref_node = ref_grid_node(ref_subdiv_grid(ref_subdiv));
   REF_EDGE ref_edge = ref_subdiv_edge(ref_subdiv);
-  REF_INT e0min, e0max;
-  REF_INT e1min, e1max;
+  REF_GLOB e0min, e0max;
+  REF_GLOB e1min, e1max;
   e0min = MIN(ref_node_global(ref_node, ref_edge_e2n(ref_edge, 0, e0)),
               ref_node_global(ref_node, ref_edge_e2n(ref_edge, 1, e0)));
   e0max = MAX(ref_node_global(ref_node, ref_edge_e2n(ref_edge, 0, e0)),
@@ -573,10 +573,12 @@ static REF_STATUS ref_subdiv_new_node(REF_SUBDIV ref_subdiv) {
   REF_NODE ref_node = ref_grid_node(ref_subdiv_grid(ref_subdiv));
   REF_EDGE ref_edge = ref_subdiv_edge(ref_subdiv);
   REF_MPI ref_mpi = ref_subdiv_mpi(ref_subdiv);
-  REF_INT edge, global, node, i;
+  REF_INT edge, node, i;
   REF_INT part;
+  REF_GLOB global;
 
-  REF_INT *edge_global, *edge_part;
+  REF_GLOB *edge_global;
+  REF_INT *edge_part;
   REF_DBL *edge_real;
   REF_DBL *edge_aux;
 
@@ -598,7 +600,7 @@ static REF_STATUS ref_subdiv_new_node(REF_SUBDIV ref_subdiv) {
 
   RSS(ref_node_shift_new_globals(ref_node), "shift glob");
 
-  ref_malloc_init(edge_global, ref_edge_n(ref_edge), REF_INT, REF_EMPTY);
+  ref_malloc_init(edge_global, ref_edge_n(ref_edge), REF_GLOB, REF_EMPTY);
   ref_malloc_init(edge_part, ref_edge_n(ref_edge), REF_INT, REF_EMPTY);
   ref_malloc_init(edge_real, REF_NODE_REAL_PER * ref_edge_n(ref_edge), REF_DBL,
                   -999.0);
@@ -621,7 +623,7 @@ static REF_STATUS ref_subdiv_new_node(REF_SUBDIV ref_subdiv) {
     }
   }
 
-  RSS(ref_edge_ghost_int(ref_edge, ref_mpi, edge_global), "global ghost");
+  RSS(ref_edge_ghost_glob(ref_edge, ref_mpi, edge_global), "global ghost");
   RSS(ref_edge_ghost_int(ref_edge, ref_mpi, edge_part), "part ghost");
   RSS(ref_edge_ghost_dbl(ref_edge, ref_mpi, edge_real, REF_NODE_REAL_PER),
       "xyz ghost");
@@ -21,6 +21,14 @@
 
 #include "ref_swap.h"
 
+#include "ref_adapt.h"
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+#include "ref_sort.h"
+#include "ref_split.h"
+
+#define REF_SWAP_MAX_RING (8)
+
 /* parallel requirement, all local */
 REF_STATUS ref_swap_remove_two_face_cell(REF_GRID ref_grid, REF_INT cell) {
   REF_CELL ref_cell;
@@ -225,3 +233,344 @@ REF_STATUS ref_swap_pass(REF_GRID ref_grid) {
   }
   return REF_SUCCESS;
 }
+
+/* even when perm is an even permutation of the four orig nodes */
+static REF_STATUS ref_swap_even(REF_INT *orig, REF_INT *perm,
+                                REF_BOOL *even) {
+  REF_INT i, j, location[4], inversions;
+
+  for (i = 0; i < 4; i++) {
+    location[i] = REF_EMPTY;
+    for (j = 0; j < 4; j++)
+      if (perm[i] == orig[j]) location[i] = j;
+    RUS(REF_EMPTY, location[i], "perm node not in orig");
+  }
+  inversions = 0;
+  for (i = 0; i < 4; i++)
+    for (j = i + 1; j < 4; j++)
+      if (location[i] > location[j]) inversions++;
+  *even = (0 == inversions % 2);
+
+  return REF_SUCCESS;
+}
+
+/* nodes around an interior edge, ordered like (node0,node1,r[i],r[i+1]) */
+static REF_STATUS ref_swap_ring(REF_GRID ref_grid, REF_INT node0,
+                                REF_INT node1, REF_INT ncell, REF_INT *cells,
+                                REF_INT *ring, REF_BOOL *closed) {
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER], test[4];
+  REF_INT from[REF_SWAP_MAX_RING], to[REF_SWAP_MAX_RING];
+  REF_BOOL used[REF_SWAP_MAX_RING];
+  REF_INT i, node, n, temp;
+  REF_BOOL even, found;
+
+  *closed = REF_FALSE;
+  if (ncell < 3) return REF_SUCCESS;
+
+  for (i = 0; i < ncell; i++) {
+    RSS(ref_cell_nodes(ref_cell, cells[i], nodes), "nodes");
+    n = 0;
+    for (node = 0; node < 4; node++)
+      if (node0 != nodes[node] && node1 != nodes[node]) {
+        RAS(n < 2, "tet with repeated nodes");
+        test[2 + n] = nodes[node];
+        n++;
+      }
+    REIS(2, n, "edge not in tet");
+    test[0] = node0;
+    test[1] = node1;
+    RSS(ref_swap_even(nodes, test, &even), "even");
+    if (!even) {
+      temp = test[2];
+      test[2] = test[3];
+      test[3] = temp;
+    }
+    from[i] = test[2];
+    to[i] = test[3];
+    used[i] = REF_FALSE;
+  }
+
+  ring[0] = from[0];
+  used[0] = REF_TRUE;
+  node = to[0];
+  for (n = 1; n < ncell; n++) {
+    ring[n] = node;
+    found = REF_FALSE;
+    for (i = 0; i < ncell && !found; i++) {
+      if (used[i] || from[i] != node) continue;
+      used[i] = REF_TRUE;
+      node = to[i];
+      found = REF_TRUE;
+    }
+    if (!found) return REF_SUCCESS;
+  }
+  *closed = (node == ring[0]);
+
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_swap_ring_tri_quality(REF_NODE ref_node, REF_INT node0,
+                                            REF_INT node1, REF_INT *ring,
+                                            REF_INT i, REF_INT j, REF_INT k,
+                                            REF_DBL *quality) {
+  REF_INT nodes[4];
+  REF_DBL quality0, quality1;
+
+  nodes[0] = ring[i];
+  nodes[1] = ring[j];
+  nodes[2] = ring[k];
+  nodes[3] = node1;
+  RSS(ref_node_tet_quality(ref_node, nodes, &quality1), "q1");
+  nodes[1] = ring[k];
+  nodes[2] = ring[j];
+  nodes[3] = node0;
+  RSS(ref_node_tet_quality(ref_node, nodes, &quality0), "q0");
+  *quality = MIN(quality0, quality1);
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_swap_edge(REF_GRID ref_grid, REF_INT node0, REF_INT node1,
+                         REF_BOOL *swapped) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT cells[REF_SWAP_MAX_RING], ncell;
+  REF_INT ring[REF_SWAP_MAX_RING], nring;
+  REF_DBL best[REF_SWAP_MAX_RING][REF_SWAP_MAX_RING];
+  REF_INT split[REF_SWAP_MAX_RING][REF_SWAP_MAX_RING];
+  REF_INT tri[3 * (REF_SWAP_MAX_RING - 2)], ntri;
+  REF_INT stack[2 * REF_SWAP_MAX_RING], nstack;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER], cell;
+  REF_INT i, j, k, gap, side;
+  REF_DBL quality, min_quality;
+  REF_BOOL allowed, closed, has_side;
+  REF_STATUS status;
+
+  *swapped = REF_FALSE;
+
+  RSS(ref_cell_has_side(ref_grid_tri(ref_grid), node0, node1, &has_side),
+      "boundary edge");
+  if (has_side) return REF_SUCCESS;
+  RSS(ref_split_edge_mixed(ref_grid, node0, node1, &allowed), "mixed");
+  if (!allowed) return REF_SUCCESS;
+  RSS(ref_split_edge_local_tets(ref_grid, node0, node1, &allowed), "local");
+  if (!allowed) return REF_SUCCESS;
+
+  status = ref_cell_list_with2(ref_cell, node0, node1, REF_SWAP_MAX_RING,
+                               &ncell, cells);
+  if (REF_INCREASE_LIMIT == status) return REF_SUCCESS;
+  RSS(status, "gem");
+  RSS(ref_swap_ring(ref_grid, node0, node1, ncell, cells, ring, &closed),
+      "ring");
+  if (!closed) return REF_SUCCESS;
+  nring = ncell;
+
+  min_quality = 1.0;
+  for (i = 0; i < ncell; i++) {
+    RSS(ref_cell_nodes(ref_cell, cells[i], nodes), "nodes");
+    RSS(ref_node_tet_quality(ref_node, nodes, &quality), "q");
+    min_quality = MIN(min_quality, quality);
+  }
+
+  /* triangulation of the ring polygon with the best worst tet pair */
+  for (i = 0; i + 1 < nring; i++) best[i][i + 1] = 2.0;
+  for (gap = 2; gap < nring; gap++) {
+    for (i = 0; i + gap < nring; i++) {
+      j = i + gap;
+      best[i][j] = -2.0;
+      split[i][j] = REF_EMPTY;
+      for (k = i + 1; k < j; k++) {
+        RSS(ref_swap_ring_tri_quality(ref_node, node0, node1, ring, i, k, j,
+                                      &quality),
+            "tri quality");
+        quality = MIN(quality, MIN(best[i][k], best[k][j]));
+        if (quality > best[i][j]) {
+          best[i][j] = quality;
+          split[i][j] = k;
+        }
+      }
+    }
+  }
+  if (best[0][nring - 1] <= min_quality) return REF_SUCCESS;
+
+  ntri = 0;
+  nstack = 0;
+  stack[0] = 0;
+  stack[1] = nring - 1;
+  nstack = 1;
+  while (nstack > 0) {
+    nstack--;
+    i = stack[0 + 2 * nstack];
+    j = stack[1 + 2 * nstack];
+    if (j - i < 2) continue;
+    k = split[i][j];
+    tri[0 + 3 * ntri] = ring[i];
+    tri[1 + 3 * ntri] = ring[k];
+    tri[2 + 3 * ntri] = ring[j];
+    ntri++;
+    stack[0 + 2 * nstack] = i;
+    stack[1 + 2 * nstack] = k;
+    nstack++;
+    stack[0 + 2 * nstack] = k;
+    stack[1 + 2 * nstack] = j;
+    nstack++;
+  }
+  REIS(nring - 2, ntri, "ring triangulation");
+
+  /* new diagonals must not already be mesh edges */
+  for (i = 0; i < ntri; i++)
+    for (side = 0; side < 3; side++) {
+      RSS(ref_cell_has_side(ref_cell, tri[side + 3 * i],
+                            tri[(side + 1) % 3 + 3 * i], &has_side),
+          "diagonal");
+      if (has_side) {
+        for (j = 0; j < nring; j++)
+          if (tri[side + 3 * i] == ring[j] &&
+              (tri[(side + 1) % 3 + 3 * i] == ring[(j + 1) % nring] ||
+               tri[(side + 1) % 3 + 3 * i] == ring[(j + nring - 1) % nring]))
+            has_side = REF_FALSE;
+        if (has_side) return REF_SUCCESS;
+      }
+    }
+
+  for (i = 0; i < ncell; i++) RSS(ref_cell_remove(ref_cell, cells[i]), "rm");
+  for (i = 0; i < ntri; i++) {
+    nodes[0] = tri[0 + 3 * i];
+    nodes[1] = tri[1 + 3 * i];
+    nodes[2] = tri[2 + 3 * i];
+    nodes[3] = node1;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add node1 side");
+    nodes[1] = tri[2 + 3 * i];
+    nodes[2] = tri[1 + 3 * i];
+    nodes[3] = node0;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add node0 side");
+  }
+  *swapped = REF_TRUE;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_swap_face(REF_GRID ref_grid, REF_INT *face_nodes,
+                         REF_BOOL *swapped) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT rank = ref_mpi_rank(ref_grid_mpi(ref_grid));
+  REF_INT face[4], cell0, cell1, cell;
+  REF_INT nodes0[REF_CELL_MAX_SIZE_PER], nodes1[REF_CELL_MAX_SIZE_PER];
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT apex0, apex1, node, side, temp;
+  REF_DBL quality, min_quality, new_quality;
+  REF_BOOL even, has_side;
+
+  *swapped = REF_FALSE;
+
+  for (node = 0; node < 3; node++) face[node] = face_nodes[node];
+  face[3] = face[0];
+  RSS(ref_cell_with_face(ref_cell, face, &cell0, &cell1), "tets of face");
+  if (REF_EMPTY == cell0 || REF_EMPTY == cell1) return REF_SUCCESS;
+  if (REF_SUCCESS == ref_cell_with(ref_grid_tri(ref_grid), face, &cell))
+    return REF_SUCCESS;
+
+  RSS(ref_cell_nodes(ref_cell, cell0, nodes0), "nodes0");
+  RSS(ref_cell_nodes(ref_cell, cell1, nodes1), "nodes1");
+  for (node = 0; node < 4; node++) {
+    if (rank != ref_node_part(ref_node, nodes0[node]) ||
+        rank != ref_node_part(ref_node, nodes1[node]))
+      return REF_SUCCESS;
+  }
+  apex0 = nodes0[0] + nodes0[1] + nodes0[2] + nodes0[3] - face[0] - face[1] -
+          face[2];
+  apex1 = nodes1[0] + nodes1[1] + nodes1[2] + nodes1[3] - face[0] - face[1] -
+          face[2];
+  RSS(ref_cell_has_side(ref_cell, apex0, apex1, &has_side), "new edge");
+  if (has_side) return REF_SUCCESS;
+
+  face[3] = apex0;
+  RSS(ref_swap_even(nodes0, face, &even), "even");
+  if (!even) {
+    temp = face[0];
+    face[0] = face[1];
+    face[1] = temp;
+  }
+
+  RSS(ref_node_tet_quality(ref_node, nodes0, &quality), "q0");
+  min_quality = quality;
+  RSS(ref_node_tet_quality(ref_node, nodes1, &quality), "q1");
+  min_quality = MIN(min_quality, quality);
+
+  new_quality = 1.0;
+  for (side = 0; side < 3; side++) {
+    nodes[0] = face[side];
+    nodes[1] = face[(side + 1) % 3];
+    nodes[2] = apex1;
+    nodes[3] = apex0;
+    RSS(ref_node_tet_quality(ref_node, nodes, &quality), "q");
+    new_quality = MIN(new_quality, quality);
+  }
+  if (new_quality <= min_quality) return REF_SUCCESS;
+
+  RSS(ref_cell_remove(ref_cell, cell0), "rm tet0");
+  RSS(ref_cell_remove(ref_cell, cell1), "rm tet1");
+  for (side = 0; side < 3; side++) {
+    nodes[0] = face[side];
+    nodes[1] = face[(side + 1) % 3];
+    nodes[2] = apex1;
+    nodes[3] = apex0;
+    RSS(ref_cell_add(ref_cell, nodes, &cell), "add");
+  }
+  *swapped = REF_TRUE;
+
+  return REF_SUCCESS;
+}
+
+REF_STATUS ref_swap_threed_pass(REF_GRID ref_grid) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER], face[3];
+  REF_INT *cells, *order, ncell, cell, i;
+  REF_INT cell_edge, cell_face, node;
+  REF_DBL *quality, tet_quality;
+  REF_BOOL swapped;
+
+  RAS(!ref_grid_twod(ref_grid), "only 3D");
+
+  ref_malloc(cells, ref_cell_n(ref_cell), REF_INT);
+  ref_malloc(quality, ref_cell_n(ref_cell), REF_DBL);
+  ref_malloc(order, ref_cell_n(ref_cell), REF_INT);
+  ncell = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    RSS(ref_node_tet_quality(ref_node, nodes, &tet_quality), "qual");
+    if (tet_quality < ref_grid_adapt(ref_grid, swap_min_quality)) {
+      cells[ncell] = cell;
+      quality[ncell] = tet_quality;
+      ncell++;
+    }
+  }
+  RSS(ref_sort_heap_dbl(ncell, quality, order), "sort quality");
+
+  /* worst first, swaps reuse cell indexes so recheck each one */
+  for (i = 0; i < ncell; i++) {
+    cell = cells[order[i]];
+    if (REF_SUCCESS != ref_cell_nodes(ref_cell, cell, nodes)) continue;
+    RSS(ref_node_tet_quality(ref_node, nodes, &tet_quality), "qual");
+    if (tet_quality >= ref_grid_adapt(ref_grid, swap_min_quality)) continue;
+    swapped = REF_FALSE;
+    for (cell_edge = 0; cell_edge < 6 && !swapped; cell_edge++) {
+      RSS(ref_swap_edge(ref_grid, ref_cell_e2n(ref_cell, 0, cell_edge, cell),
+                        ref_cell_e2n(ref_cell, 1, cell_edge, cell), &swapped),
+          "edge swap");
+    }
+    for (cell_face = 0; cell_face < 4 && !swapped; cell_face++) {
+      for (node = 0; node < 3; node++)
+        face[node] = ref_cell_f2n(ref_cell, node, cell_face, cell);
+      RSS(ref_swap_face(ref_grid, face, &swapped), "face swap");
+    }
+  }
+
+  ref_free(order);
+  ref_free(quality);
+  ref_free(cells);
+
+  return REF_SUCCESS;
+}
@@ -29,6 +29,13 @@ REF_STATUS ref_swap_remove_two_face_cell(REF_GRID ref_grid, REF_INT cell);
 REF_STATUS ref_swap_remove_three_face_cell(REF_GRID ref_grid, REF_INT cell);
 REF_STATUS ref_swap_pass(REF_GRID ref_grid);
 
+/* metric quality improving interior n-m edge and 2-3 face swaps */
+REF_STATUS ref_swap_edge(REF_GRID ref_grid, REF_INT node0, REF_INT node1,
+                         REF_BOOL *swapped);
+REF_STATUS ref_swap_face(REF_GRID ref_grid, REF_INT *face_nodes,
+                         REF_BOOL *swapped);
+REF_STATUS ref_swap_threed_pass(REF_GRID ref_grid);
+
 END_C_DECLORATION
 
 #endif /* REF_SWAP_H */
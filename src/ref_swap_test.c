@@ -25,6 +25,7 @@
 #include "ref_cell.h"
 #include "ref_grid.h"
 #include "ref_list.h"
+#include "ref_math.h"
 #include "ref_matrix.h"
 #include "ref_node.h"
 #include "ref_sort.h"
@@ -34,6 +35,61 @@
 #include "ref_swap.h"
 
 #include "ref_fixture.h"
+#include "ref_metric.h"
+#include "ref_validation.h"
+
+static REF_STATUS ref_swap_test_tet(REF_GRID ref_grid, REF_INT n0, REF_INT n1,
+                                    REF_INT n2, REF_INT n3) {
+  REF_INT nodes[4] = {n0, n1, n2, n3}, cell;
+  REF_DBL volume;
+  RSS(ref_node_tet_vol(ref_grid_node(ref_grid), nodes, &volume), "vol");
+  if (volume < 0.0) {
+    nodes[0] = n1;
+    nodes[1] = n0;
+  }
+  RSS(ref_cell_add(ref_grid_tet(ref_grid), nodes, &cell), "add");
+  return REF_SUCCESS;
+}
+
+/* nodes (0,0,-half), (0,0,half) and a ring of nring at radius 0.5 */
+static REF_STATUS ref_swap_test_nodes(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
+                                      REF_INT nring, REF_DBL half) {
+  REF_GRID ref_grid;
+  REF_NODE ref_node;
+  REF_INT i, node;
+
+  RSS(ref_grid_create(ref_grid_ptr, ref_mpi), "create");
+  ref_grid = *ref_grid_ptr;
+  ref_node = ref_grid_node(ref_grid);
+  for (i = 0; i < nring + 2; i++) {
+    RSS(ref_node_add(ref_node, i, &node), "add");
+    ref_node_xyz(ref_node, 0, node) = 0.0;
+    ref_node_xyz(ref_node, 1, node) = 0.0;
+    ref_node_xyz(ref_node, 2, node) = (0 == i ? -half : half);
+    if (i > 1) {
+      ref_node_xyz(ref_node, 0, node) =
+          0.5 * cos(2.0 * ref_math_pi * (REF_DBL)i / (REF_DBL)nring);
+      ref_node_xyz(ref_node, 1, node) =
+          0.5 * sin(2.0 * ref_math_pi * (REF_DBL)i / (REF_DBL)nring);
+      ref_node_xyz(ref_node, 2, node) = 0.0;
+    }
+  }
+  RSS(ref_node_initialize_n_global(ref_node, nring + 2), "init glob");
+  RSS(ref_metric_unit_node(ref_node), "id metric");
+
+  return REF_SUCCESS;
+}
+
+/* nring tets around the edge between nodes 0 and 1 */
+static REF_STATUS ref_swap_test_gem(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
+                                    REF_INT nring, REF_DBL half) {
+  REF_INT i;
+  RSS(ref_swap_test_nodes(ref_grid_ptr, ref_mpi, nring, half), "nodes");
+  for (i = 0; i < nring; i++)
+    RSS(ref_swap_test_tet(*ref_grid_ptr, 0, 1, 2 + i, 2 + (i + 1) % nring),
+        "tet");
+  return REF_SUCCESS;
+}
 
 int main(void) {
   REF_MPI ref_mpi;
@@ -126,6 +182,74 @@ int main(void) {
     RSS(ref_grid_free(ref_grid), "free grid");
   }
 
+  if (!ref_mpi_para(ref_mpi)) { /* edge swap 3-2 */
+    REF_GRID ref_grid;
+    REF_BOOL swapped;
+
+    RSS(ref_swap_test_gem(&ref_grid, ref_mpi, 3, 1.0), "gem");
+    RSS(ref_swap_edge(ref_grid, 0, 1, &swapped), "swap");
+    RAS(swapped, "expected swap");
+    REIS(2, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+
+    RSS(ref_grid_free(ref_grid), "free grid");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* edge swap 5-6 */
+    REF_GRID ref_grid;
+    REF_BOOL swapped;
+
+    RSS(ref_swap_test_gem(&ref_grid, ref_mpi, 5, 1.0), "gem");
+    RSS(ref_swap_edge(ref_grid, 0, 1, &swapped), "swap");
+    RAS(swapped, "expected swap");
+    REIS(6, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+
+    RSS(ref_grid_free(ref_grid), "free grid");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* keep good gem */
+    REF_GRID ref_grid;
+    REF_BOOL swapped;
+
+    RSS(ref_swap_test_gem(&ref_grid, ref_mpi, 4, 0.3), "gem");
+    RSS(ref_swap_edge(ref_grid, 0, 1, &swapped), "swap");
+    RAS(!swapped, "expected no swap");
+    REIS(4, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+
+    RSS(ref_grid_free(ref_grid), "free grid");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* keep boundary edge */
+    REF_GRID ref_grid;
+    REF_INT nodes[4] = {0, 1, 2, 10}, cell;
+    REF_BOOL swapped;
+
+    RSS(ref_swap_test_gem(&ref_grid, ref_mpi, 3, 1.0), "gem");
+    RSS(ref_cell_add(ref_grid_tri(ref_grid), nodes, &cell), "tri");
+    RSS(ref_swap_edge(ref_grid, 0, 1, &swapped), "swap");
+    RAS(!swapped, "expected no swap");
+    REIS(3, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+
+    RSS(ref_grid_free(ref_grid), "free grid");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* face swap 2-3 undoes 3-2 */
+    REF_GRID ref_grid;
+    REF_INT face[3] = {2, 3, 4};
+    REF_BOOL swapped;
+
+    RSS(ref_swap_test_nodes(&ref_grid, ref_mpi, 3, 0.2), "nodes");
+    RSS(ref_swap_test_tet(ref_grid, 2, 3, 4, 0), "tet0");
+    RSS(ref_swap_test_tet(ref_grid, 2, 3, 4, 1), "tet1");
+    RSS(ref_swap_face(ref_grid, face, &swapped), "swap");
+    RAS(swapped, "expected swap");
+    REIS(3, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+
+    RSS(ref_grid_free(ref_grid), "free grid");
+  }
+
   RSS(ref_mpi_free(ref_mpi), "free");
   return 0;
 }
@@ -86,8 +86,9 @@ REF_STATUS ref_validation_boundary_face(REF_GRID ref_grid) {
     RSS(ref_grid_cell_has_face(ref_grid, nodes, &has_face), "has_face");
     if (!has_face) {
       problem = REF_TRUE;
-      printf("triangle %d nodes %d %d %d global %d %d %d\n", cell, nodes[0],
-             nodes[1], nodes[2],
+      printf("triangle %d nodes %d %d %d global " REF_GLOB_FMT " " REF_GLOB_FMT
+             " " REF_GLOB_FMT "\n",
+             cell, nodes[0], nodes[1], nodes[2],
              ref_node_global(ref_grid_node(ref_grid), nodes[0]),
              ref_node_global(ref_grid_node(ref_grid), nodes[1]),
              ref_node_global(ref_grid_node(ref_grid), nodes[2]));
@@ -166,8 +167,9 @@ REF_STATUS ref_validation_cell_face(REF_GRID ref_grid) {
       printf(" hits %d\n", hits[face]);
       for (node = 0; node < 3; node++)
         nodes[node] = ref_face_f2n(ref_face, node, face);
-      printf("face %d nodes %d %d %d global %d %d %d\n", face, nodes[0],
-             nodes[1], nodes[2],
+      printf("face %d nodes %d %d %d global " REF_GLOB_FMT " " REF_GLOB_FMT
+             " " REF_GLOB_FMT "\n",
+             face, nodes[0], nodes[1], nodes[2],
              ref_node_global(ref_grid_node(ref_grid), nodes[0]),
              ref_node_global(ref_grid_node(ref_grid), nodes[1]),
              ref_node_global(ref_grid_node(ref_grid), nodes[2]));
@@ -279,6 +281,27 @@ REF_STATUS ref_validation_cell_volume(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
+REF_STATUS ref_validation_cell_volume_census(REF_GRID ref_grid,
+                                             REF_CENSUS ref_census) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT cell, nodes[REF_CELL_MAX_SIZE_PER];
+
+  ref_cell = ref_grid_tet(ref_grid);
+  if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_tri(ref_grid);
+
+  cell = ref_census_invalid_cell(ref_census);
+  RAB(REF_EMPTY == cell, "negative volume tet", {
+    REF_INT cell_node;
+    printf("cell %d\n", cell);
+    RSS(ref_cell_nodes(ref_cell, cell, nodes), "nodes");
+    each_ref_cell_cell_node(ref_cell, cell_node)
+        ref_node_location(ref_node, nodes[cell_node]);
+  });
+
+  return REF_SUCCESS;
+}
+
 REF_STATUS ref_validation_all(REF_GRID ref_grid) {
   RSS(ref_validation_unused_node(ref_grid), "unused node");
   RSS(ref_validation_boundary_face(ref_grid), "boundary face");
@@ -21,6 +21,7 @@
 
 #include "ref_defs.h"
 
+#include "ref_census.h"
 #include "ref_grid.h"
 
 BEGIN_C_DECLORATION
@@ -30,6 +31,8 @@ REF_STATUS ref_validation_boundary_face(REF_GRID ref_grid);
 REF_STATUS ref_validation_cell_face(REF_GRID ref_grid);
 REF_STATUS ref_validation_cell_node(REF_GRID ref_grid);
 REF_STATUS ref_validation_cell_volume(REF_GRID ref_grid);
+REF_STATUS ref_validation_cell_volume_census(REF_GRID ref_grid,
+                                             REF_CENSUS ref_census);
 
 REF_STATUS ref_validation_all(REF_GRID ref_grid);
 